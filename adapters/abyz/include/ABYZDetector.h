@@ -4,6 +4,8 @@
 #include "uxdi/IDetectorListener.h"
 #include "uxdi/IDetectorSynchronous.h"
 #include "uxdi/Types.h"
+#include "uxdi/FrameBufferPool.h"
+#include "uxdi/FrameRateMeter.h"
 #include "abyz_sdk.h"
 #include <memory>
 #include <mutex>
@@ -58,6 +60,8 @@ public:
     ErrorInfo getLastError() const override;
     void clearError() override;
 
+    DetectorStatistics getStatistics() const override;
+
 private:
     // Configuration
     std::string config_;
@@ -92,6 +96,12 @@ private:
     // Synchronous interface
     std::shared_ptr<IDetectorSynchronous> syncInterface_;
 
+    // Delivered frame rate, throughput and listener callback time
+    FrameRateMeter frameRate_;
+
+    // Destination buffers for the mandatory copy of SDK frames
+    FrameBufferPool framePool_;
+
     // SDK callback bridges (static for C compatibility)
     static void imageCallbackBridge(const AbyzImage* img, void* ctx);
     static void stateCallbackBridge(AbyzState sdkState, void* ctx);
@@ -106,7 +116,7 @@ private:
     void setError(ErrorCode code, const std::string& message);
     void notifyStateChanged(DetectorState newState);
     void notifyError(const ErrorInfo& error);
-    void notifyImageReceived(const ImageData& image);
+    void notifyImageReceived(ImageData& image);  // Stamps image.latency.dispatchNs
     std::string stateToString(DetectorState state) const;
 
     // Error code mapping
@@ -1,4 +1,6 @@
 #include "ABYZDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 
 using namespace uxdi::adapters::abyz;
 
@@ -7,7 +9,9 @@ using namespace uxdi::adapters::abyz;
 //=============================================================================
 
 // Export macros for adapter DLL
-#ifdef UXDI_ABYZ_EXPORTS
+#if !defined(_WIN32)
+#define ADAPTER_API __attribute__((visibility("default")))
+#elif defined(UXDI_ABYZ_EXPORTS)
 #define ADAPTER_API __declspec(dllexport)
 #else
 #define ADAPTER_API __declspec(dllimport)
@@ -27,6 +31,9 @@ extern "C" {
  * - {"vendor": "drtech"}   - DRTech detector
  * - "" or null             - Default (Rayence)
  *
+ * Mock frame timing keys (frame_rate, jitter, burst, max_rate) may be
+ * combined with the vendor, e.g. {"vendor": "samsung", "frame_rate": 200}.
+ *
  * @param config JSON configuration string with "vendor" field
  * @return Pointer to IDetector interface, or nullptr on failure
  */
@@ -71,4 +78,25 @@ ADAPTER_API void DestroyDetector(uxdi::IDetector* detector) {
     }
 }
 
+/**
+ * @brief Route this adapter's trace points to the host's recorder
+ *
+ * Called by DetectorFactory right after loading, since the adapter links its
+ * own copy of uxdi_core.
+ *
+ * @param recorder Host recorder, or nullptr to use the adapter's own
+ */
+ADAPTER_API void AttachTraceRecorder(uxdi::TraceRecorder* recorder) {
+    uxdi::TraceRecorder::Attach(recorder);
+}
+
+/**
+ * @brief Count this adapter's allocations in the host's tracker
+ *
+ * @param tracker Host tracker, or nullptr to use the adapter's own
+ */
+ADAPTER_API void AttachAllocationTracker(uxdi::AllocationTracker* tracker) {
+    uxdi::AllocationTracker::Attach(tracker);
+}
+
 } // extern "C"
@@ -1,4 +1,6 @@
 #include "ABYZDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 #include "abyz_sdk.h"
 #include <cstring>
 #include <chrono>
@@ -307,6 +309,8 @@ IDetectorListener* ABYZDetector::getListener() const {
 }
 
 bool ABYZDetector::startAcquisition() {
+    UXDI_TRACE_SCOPE(State, "abyz.startAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -351,6 +355,8 @@ bool ABYZDetector::startAcquisition() {
 }
 
 bool ABYZDetector::stopAcquisition() {
+    UXDI_TRACE_SCOPE(State, "abyz.stopAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -414,24 +420,34 @@ void ABYZDetector::clearError() {
     lastError_.details.clear();
 }
 
+DetectorStatistics ABYZDetector::getStatistics() const {
+    return frameRate_.GetStatistics();
+}
+
 //=============================================================================
 // Callback Bridges
 //=============================================================================
 
 void ABYZDetector::imageCallbackBridge(const AbyzImage* img, void* ctx) {
     if (!ctx || !img) return;
+    UXDI_TRACE_SCOPE_ARG(Callback, "abyz.imageCallback", img->frameNumber);
+    UXDI_ALLOC_SCOPE(Adapter);
     auto* detector = static_cast<ABYZDetector*>(ctx);
     detector->onImageReceived(img);
 }
 
 void ABYZDetector::stateCallbackBridge(AbyzState sdkState, void* ctx) {
     if (!ctx) return;
+    UXDI_TRACE_INSTANT(Callback, "abyz.stateCallback", static_cast<uint64_t>(sdkState));
+    UXDI_ALLOC_SCOPE(Adapter);
     auto* detector = static_cast<ABYZDetector*>(ctx);
     detector->onStateChanged(sdkState);
 }
 
 void ABYZDetector::errorCallbackBridge(AbyzError err, const char* msg, void* ctx) {
     if (!ctx) return;
+    UXDI_TRACE_INSTANT(Callback, "abyz.errorCallback", static_cast<uint64_t>(err));
+    UXDI_ALLOC_SCOPE(Adapter);
     auto* detector = static_cast<ABYZDetector*>(ctx);
     detector->onError(err, msg);
 }
@@ -443,10 +459,15 @@ void ABYZDetector::errorCallbackBridge(AbyzError err, const char* msg, void* ctx
 void ABYZDetector::onImageReceived(const AbyzImage* img) {
     if (!img) return;
 
+    // The SDK image carries no monotonic stamp, so delivery is stamped on callback entry
+    const uint64_t deliveredNs = MonotonicNowNs();
+
     // MANDATORY COPY: SDK owns the buffer, must copy immediately
     const size_t bufferBytes = img->dataLength;
-    auto buffer = std::shared_ptr<uint8_t[]>(new uint8_t[bufferBytes]);
+    UXDI_TRACE_BEGIN(Callback, "abyz.copyFrame");
+    auto buffer = framePool_.Acquire(bufferBytes);
     std::memcpy(buffer.get(), img->data, bufferBytes);
+    UXDI_TRACE_END(Callback, "abyz.copyFrame");
 
     // Create UXDI image structure
     ImageData image;
@@ -457,6 +478,8 @@ void ABYZDetector::onImageReceived(const AbyzImage* img) {
     image.timestamp = img->timestamp;
     image.data = buffer;
     image.dataLength = bufferBytes;
+    image.latency.sdkDeliveryNs = deliveredNs;
+    image.latency.adapterConvertedNs = MonotonicNowNs();
 
     notifyImageReceived(image);
 }
@@ -493,6 +516,8 @@ void ABYZDetector::setError(ErrorCode code, const std::string& message) {
 }
 
 void ABYZDetector::notifyStateChanged(DetectorState newState) {
+    UXDI_TRACE_INSTANT(State, "abyz.stateChanged", static_cast<uint64_t>(newState));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -505,6 +530,8 @@ void ABYZDetector::notifyStateChanged(DetectorState newState) {
 }
 
 void ABYZDetector::notifyError(const ErrorInfo& error) {
+    UXDI_TRACE_INSTANT(State, "abyz.error", static_cast<uint64_t>(error.code));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -516,15 +543,23 @@ void ABYZDetector::notifyError(const ErrorInfo& error) {
     }
 }
 
-void ABYZDetector::notifyImageReceived(const ImageData& image) {
+void ABYZDetector::notifyImageReceived(ImageData& image) {
+    UXDI_TRACE_SCOPE_ARG(Dispatch, "abyz.notifyImage", image.frameNumber);
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
         listener = listener_;
     }
 
+    const uint64_t dispatchNs = MonotonicNowNs();
+    frameRate_.RecordFrame(image.dataLength, dispatchNs);
+
     if (listener) {
+        image.latency.dispatchNs = dispatchNs;
+        UXDI_ALLOC_SCOPE(Listener);
         listener->onImageReceived(image);
+        frameRate_.RecordCallback(MonotonicNowNs() - dispatchNs);
     }
 }
 
@@ -4,6 +4,8 @@
 #include "uxdi/IDetectorListener.h"
 #include "uxdi/IDetectorSynchronous.h"
 #include "uxdi/Types.h"
+#include "uxdi/FrameBufferPool.h"
+#include "uxdi/FrameRateMeter.h"
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -53,6 +55,8 @@ public:
     ErrorInfo getLastError() const override;
     void clearError() override;
 
+    DetectorStatistics getStatistics() const override;
+
 private:
     // State management
     std::atomic<DetectorState> state_;
@@ -79,6 +83,12 @@ private:
     // Synchronous interface
     std::shared_ptr<IDetectorSynchronous> syncInterface_;
 
+    // Delivered frame rate, throughput and listener callback time
+    FrameRateMeter frameRate_;
+
+    // Black frame buffers, recycled once the caller releases them
+    FrameBufferPool framePool_;
+
     // Helper methods
     void setError(ErrorCode code, const std::string& message);
     void notifyStateChanged(DetectorState newState);
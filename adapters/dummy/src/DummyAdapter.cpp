@@ -1,4 +1,6 @@
 #include "DummyDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 #include <cstring>
 
 using namespace uxdi::adapters::dummy;
@@ -8,7 +10,9 @@ using namespace uxdi::adapters::dummy;
 //=============================================================================
 
 // Export macros for adapter DLL
-#ifdef UXDI_DUMMY_EXPORTS
+#if !defined(_WIN32)
+#define ADAPTER_API __attribute__((visibility("default")))
+#elif defined(UXDI_DUMMY_EXPORTS)
 #define ADAPTER_API __declspec(dllexport)
 #else
 #define ADAPTER_API __declspec(dllimport)
@@ -65,4 +69,25 @@ ADAPTER_API void DestroyDetector(uxdi::IDetector* detector) {
     }
 }
 
+/**
+ * @brief Route this adapter's trace points to the host's recorder
+ *
+ * Called by DetectorFactory right after loading, since the adapter links its
+ * own copy of uxdi_core.
+ *
+ * @param recorder Host recorder, or nullptr to use the adapter's own
+ */
+ADAPTER_API void AttachTraceRecorder(uxdi::TraceRecorder* recorder) {
+    uxdi::TraceRecorder::Attach(recorder);
+}
+
+/**
+ * @brief Count this adapter's allocations in the host's tracker
+ *
+ * @param tracker Host tracker, or nullptr to use the adapter's own
+ */
+ADAPTER_API void AttachAllocationTracker(uxdi::AllocationTracker* tracker) {
+    uxdi::AllocationTracker::Attach(tracker);
+}
+
 } // extern "C"
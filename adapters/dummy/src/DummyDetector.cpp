@@ -1,4 +1,5 @@
 #include "DummyDetector.h"
+#include "uxdi/AllocationTracker.h"
 #include <cstring>
 #include <chrono>
 #include <thread>
@@ -250,6 +251,10 @@ void DummyDetector::clearError() {
     lastError_.details.clear();
 }
 
+DetectorStatistics DummyDetector::getStatistics() const {
+    return frameRate_.GetStatistics();
+}
+
 //=============================================================================
 // Private Helper Methods
 //=============================================================================
@@ -310,8 +315,10 @@ ImageData DummyDetector::generateBlackFrame() {
     const size_t bytesPerPixel = 2;
     const size_t frameSize = params.width * params.height * bytesPerPixel;
 
-    // Allocate black frame buffer
-    auto buffer = std::shared_ptr<uint8_t[]>(new uint8_t[frameSize]);
+    const uint64_t generatedNs = MonotonicNowNs();
+
+    // Black frame buffer
+    auto buffer = framePool_.Acquire(frameSize);
     std::memset(buffer.get(), 0, frameSize);
 
     // Create image data structure
@@ -325,6 +332,8 @@ ImageData DummyDetector::generateBlackFrame() {
     ).count();
     image.data = buffer;
     image.dataLength = frameSize;
+    image.latency.sdkDeliveryNs = generatedNs;
+    image.latency.adapterConvertedNs = MonotonicNowNs();
 
     return image;
 }
@@ -365,10 +374,16 @@ bool DummyDetectorSynchronous::acquireFrame(ImageData& outImage, uint32_t timeou
     // Generate and return black frame
     outImage = detector_->generateBlackFrame();
 
+    const uint64_t dispatchNs = MonotonicNowNs();
+    detector_->frameRate_.RecordFrame(outImage.dataLength, dispatchNs);
+
     // Notify listener if set
     auto listener = detector_->getListener();
     if (listener) {
+        outImage.latency.dispatchNs = dispatchNs;
+        UXDI_ALLOC_SCOPE(Listener);
         listener->onImageReceived(outImage);
+        detector_->frameRate_.RecordCallback(MonotonicNowNs() - dispatchNs);
     }
 
     return true;
@@ -4,9 +4,12 @@
 #include "uxdi/IDetectorListener.h"
 #include "uxdi/IDetectorSynchronous.h"
 #include "uxdi/Types.h"
+#include "uxdi/FrameRateMeter.h"
 #include "ScenarioEngine.h"
+#include "EmulatorFarm.h"
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 #include <atomic>
 #include <string>
@@ -21,8 +24,13 @@ namespace uxdi::adapters::emul {
  * uses ScenarioEngine for realistic detector simulation based on
  * configurable test scenarios. Supports inline JSON scenarios,
  * file-based scenarios, and default behavior.
+ *
+ * Each detector runs its own acquisition thread unless the config sets
+ * "farm": true, in which case frames are paced and delivered by the shared
+ * EmulatorFarm so that dozens of emulated detectors run on a handful of
+ * threads.
  */
-class EmulDetector : public IDetector {
+class EmulDetector : public IDetector, private EmulatorFarm::Client {
 public:
     /**
      * @brief Construct EmulDetector with optional configuration
@@ -32,6 +40,8 @@ public:
      * - Inline: {"scenario": {"name": "Test", "actions": [{"type": "acquire", "count": 10}]}}
      * - File:   {"scenario_file": "scenarios/test_scenario.json"}
      * - Empty:  "" (uses built-in default scenario)
+     *
+     * Either object form may add "farm": true to run on the shared EmulatorFarm.
      */
     explicit EmulDetector(const std::string& config = "");
     virtual ~EmulDetector();
@@ -63,6 +73,8 @@ public:
     ErrorInfo getLastError() const override;
     void clearError() override;
 
+    DetectorStatistics getStatistics() const override;
+
 private:
     // ScenarioEngine integration
     ScenarioEngine scenarioEngine_;
@@ -94,15 +106,25 @@ private:
     // Synchronous interface
     std::shared_ptr<IDetectorSynchronous> syncInterface_;
 
+    // Delivered frame rate, throughput and listener callback time
+    FrameRateMeter frameRate_;
+
     // Thread for frame generation
     std::atomic<bool> acquisitionActive_;
     std::thread acquisitionThread_;
 
+    // Farm mode: the shared farm replaces the acquisition thread. The next
+    // frame is rendered one service call ahead of its deadline
+    bool farmMode_ = false;
+    std::shared_ptr<EmulatorFarm> farm_;
+    std::optional<FrameData> pendingFrame_;
+    uint64_t pendingDeadlineNs_ = 0;
+
     // Helper methods
     void setError(ErrorCode code, const std::string& message);
     void notifyStateChanged(DetectorState newState);
     void notifyError(const ErrorInfo& error);
-    void notifyImageReceived(const ImageData& image);
+    void notifyImageReceived(ImageData& image);  // Stamps image.latency.dispatchNs
     std::string stateToString(DetectorState state) const;
 
     // Scenario loading
@@ -112,6 +134,10 @@ private:
 
     // Frame generation thread
     void acquisitionThreadFunc();
+    std::optional<uint64_t> ServiceFarmTick(uint64_t nowNs) override;
+    bool raiseInjectedError();           // True if a scenario error ended the acquisition
+    void deliverFrame(const FrameData& frameData);
+    void finishAcquisition();            // Back to READY after the scenario completes
     ImageData convertFrameDataToImageData(const FrameData& frameData);
 
     // Allow synchronous interface to access internals
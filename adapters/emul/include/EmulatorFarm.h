@@ -0,0 +1,120 @@
+#pragma once
+
+#include "uxdi/TimerWheel.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uxdi::adapters::emul {
+
+/**
+ * @brief Shared scheduler that drives many emulated detectors
+ *
+ * Instead of one acquisition thread per detector, clients register with the
+ * farm and are serviced by a small worker pool. A single scheduler thread
+ * keeps every client's next due time in a TimerWheel and hands clients to
+ * the workers as they fall due, so dozens of detectors cost a fixed number
+ * of threads.
+ *
+ * Clients are handed over one tick (TimerWheel::kDefaultTickNs) ahead of
+ * their due time, leaving them to wait out the remainder precisely. A
+ * client is never serviced by two workers at once.
+ *
+ * Thread-safe. Non-copyable, non-movable.
+ */
+class EmulatorFarm {
+public:
+    /**
+     * @brief Work scheduled on the farm
+     */
+    class Client {
+    public:
+        virtual ~Client() = default;
+
+        /**
+         * @brief Do the work that fell due; runs on a farm worker
+         * @param nowNs MonotonicNowNs() when the worker picked the client up
+         * @return Next due time, or nullopt to leave the farm
+         */
+        virtual std::optional<uint64_t> ServiceFarmTick(uint64_t nowNs) = 0;
+    };
+
+    static constexpr size_t kMaxWorkers = 8;
+
+    /**
+     * @brief Process-wide farm, started on first use
+     *
+     * The farm stops once the last holder releases it; a holder must not be
+     * the last to release it from inside ServiceFarmTick().
+     */
+    static std::shared_ptr<EmulatorFarm> Acquire();
+
+    /**
+     * @param workerCount Worker threads; 0 picks one per core, 2 to kMaxWorkers
+     */
+    explicit EmulatorFarm(size_t workerCount = 0);
+    ~EmulatorFarm();
+
+    // Non-copyable, non-movable
+    EmulatorFarm(const EmulatorFarm&) = delete;
+    EmulatorFarm& operator=(const EmulatorFarm&) = delete;
+    EmulatorFarm(EmulatorFarm&&) = delete;
+    EmulatorFarm& operator=(EmulatorFarm&&) = delete;
+
+    /**
+     * @brief Schedule a client to be serviced at dueNs (MonotonicNowNs() clock)
+     *
+     * Adding a client that is already scheduled moves it to dueNs.
+     */
+    void Add(Client* client, uint64_t dueNs);
+
+    /**
+     * @brief Take a client off the farm
+     *
+     * Waits for a service call in progress to return, so the client may be
+     * destroyed afterwards. Called from the client's own ServiceFarmTick(),
+     * it only stops further calls.
+     */
+    void Remove(Client* client);
+
+    size_t GetWorkerCount() const { return m_workers.size(); }
+    size_t GetClientCount() const;
+
+private:
+    struct Member {
+        Client* client = nullptr;
+        bool running = false;                   // Being serviced by a worker
+        bool removed = false;                   // Remove() called during service
+        std::optional<uint64_t> restart_ns;     // Add() called during service
+    };
+
+    void SchedulerLoop();
+    void WorkerLoop();
+    void Finish(uint64_t id, std::optional<uint64_t> nextNs);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_scheduler_cv;     // Wheel changed or stopping
+    std::condition_variable m_worker_cv;        // Ready queue filled or stopping
+    std::condition_variable m_idle_cv;          // A service call returned
+    bool m_stopping = false;
+
+    // Members are keyed by a fresh id per Add(), so wheel entries left by a
+    // removed or rescheduled client are recognised and dropped when they pop
+    TimerWheel m_wheel;
+    std::unordered_map<uint64_t, Member> m_members;
+    std::unordered_map<Client*, uint64_t> m_ids;
+    std::deque<uint64_t> m_ready;
+    uint64_t m_next_id = 1;
+
+    std::thread m_scheduler;
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace uxdi::adapters::emul
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace uxdi {
+namespace adapters {
+namespace emul {
+
+/**
+ * @brief Base image rendered once per frame configuration
+ */
+enum class FramePattern {
+    Gradient,       ///< Horizontal ramp with a vertical tilt
+    Checkerboard,   ///< 64-pixel squares at 1/4 and 3/4 of full scale
+    Flat,           ///< Mid-scale everywhere
+    Phantom         ///< Synthetic chest radiograph with detector artifacts
+};
+
+/**
+ * @brief How consecutive frames differ from the template
+ */
+enum class FrameVariation {
+    None,           ///< Every frame equals the template
+    Offset,         ///< Frame n adds n * step to every pixel (wrapping)
+    Roll            ///< Frame n rotates every row left by n * step pixels
+};
+
+/**
+ * @brief Noise added on top of the varied frame
+ */
+enum class FrameNoise {
+    None,
+    Gaussian,       ///< Constant sigma of noise_level counts
+    Poisson         ///< Shot noise: sigma = sqrt(value * noise_level)
+};
+
+inline std::optional<FramePattern> stringToFramePattern(const std::string& str) {
+    if (str == "gradient") return FramePattern::Gradient;
+    if (str == "checkerboard") return FramePattern::Checkerboard;
+    if (str == "flat") return FramePattern::Flat;
+    if (str == "phantom") return FramePattern::Phantom;
+    return std::nullopt;
+}
+
+inline std::optional<FrameVariation> stringToFrameVariation(const std::string& str) {
+    if (str == "none") return FrameVariation::None;
+    if (str == "offset") return FrameVariation::Offset;
+    if (str == "roll") return FrameVariation::Roll;
+    return std::nullopt;
+}
+
+inline std::optional<FrameNoise> stringToFrameNoise(const std::string& str) {
+    if (str == "none") return FrameNoise::None;
+    if (str == "gaussian") return FrameNoise::Gaussian;
+    if (str == "poisson") return FrameNoise::Poisson;
+    return std::nullopt;
+}
+
+/**
+ * @brief Synthetic frame settings from the scenario's "generator" object
+ */
+struct GeneratorConfig {
+    FramePattern pattern = FramePattern::Gradient;
+    FrameVariation variation = FrameVariation::None;
+    FrameNoise noise = FrameNoise::None;
+    double noise_level = 0.0;   ///< Gaussian sigma, or Poisson counts per photon (sigma capped at 4095;
+                                ///< 0 with the phantom derives it from the detector gain)
+    uint32_t step = 64;         ///< Offset counts or roll pixels per frame
+    uint64_t seed = 0;          ///< Noise seed; each frame's noise follows (seed, frame index) (0 = nondeterministic)
+};
+
+/**
+ * @brief Immutable frame template: the rendered pattern and its defect map
+ */
+struct FrameTemplate {
+    std::vector<uint8_t> pixels;            // One frame, rendered pattern
+    std::vector<uint32_t> dead_pixels;      // Phantom defects, read as 0
+    std::vector<uint32_t> hot_pixels;       // Phantom defects, read as full scale
+};
+
+/**
+ * @brief Synthetic frame generator for ScenarioEngine
+ *
+ * The pattern is rendered once per frame configuration; each frame is then
+ * a single pass over the template: a copy, a wrapping add or a per-row
+ * rotation, written straight into the caller's buffer. Noise is a second
+ * pass driven by eight interleaved xorshift generators; the Gaussian sample
+ * and the Poisson sigma are computed arithmetically rather than looked up,
+ * so the per-pixel loops have no gathers, branches or divides and the
+ * compiler can vectorize them.
+ *
+ * The phantom pattern models a flat-panel exposure: Beer-Lambert
+ * attenuation through a few ellipsoids and slabs, the anode heel effect,
+ * per-pixel dark offset and gain nonuniformity, all rendered once across
+ * row bands on worker threads. Dead and hot pixels and dead lines are kept
+ * as an index list and stamped on after variation and noise, so they stay
+ * fixed on the panel while the image moves. Signal scales with exposure
+ * time and gain; Poisson noise then gives exposure-dependent quantum noise.
+ *
+ * Templates depend only on the pattern, geometry and (for the phantom)
+ * exposure, so generators with the same settings share one immutable copy
+ * from a process-wide cache: dozens of emulated detectors cost one
+ * template, rendered once. The cache holds templates only while a
+ * generator uses them.
+ *
+ * Not thread-safe; ScenarioEngine calls it under its own lock. The
+ * template cache is thread-safe.
+ */
+class FrameGenerator {
+public:
+    FrameGenerator();
+
+    // Non-copyable, non-movable
+    FrameGenerator(const FrameGenerator&) = delete;
+    FrameGenerator& operator=(const FrameGenerator&) = delete;
+    FrameGenerator(FrameGenerator&&) = delete;
+    FrameGenerator& operator=(FrameGenerator&&) = delete;
+
+    /**
+     * @brief Change pattern, variation and noise; the template is re-rendered lazily
+     */
+    void Configure(const GeneratorConfig& config);
+
+    /**
+     * @brief Change the frame geometry; the template is re-rendered lazily
+     */
+    void SetFrameConfig(uint32_t width, uint32_t height, uint32_t bitDepth);
+
+    /**
+     * @brief Change the exposure the phantom is rendered for (re-rendered lazily)
+     * @param exposureTimeMs Exposure time; 100 ms at gain 1 puts open beam near 55% of full scale
+     * @param gain Detector gain factor
+     */
+    void SetExposure(double exposureTimeMs, double gain);
+
+    /**
+     * @brief Size of one frame in bytes
+     */
+    size_t FrameBytes() const;
+
+    /**
+     * @brief Render frame frameIndex into out (FrameBytes() bytes)
+     */
+    void Render(uint64_t frameIndex, uint8_t* out);
+
+    const GeneratorConfig& GetConfig() const { return m_config; }
+
+    /**
+     * @brief Template of the last rendered frame; shared with generators of the same settings
+     */
+    std::shared_ptr<const FrameTemplate> GetTemplate() const { return m_template; }
+
+private:
+    static constexpr size_t kLanes = 8;
+
+    std::shared_ptr<const FrameTemplate> AcquireTemplate() const;
+    template <typename Pixel> void RenderTemplate(FrameTemplate& out) const;
+    template <typename Pixel> void RenderPhantom(FrameTemplate& out) const;
+    template <typename Pixel> void ApplyDefects(Pixel* out) const;
+    void BuildDefects(FrameTemplate& out) const;
+    template <typename Pixel> void RenderFrame(uint64_t frameIndex, Pixel* out);
+    template <typename Pixel, bool kPoisson> void AddNoise(Pixel* out, size_t count);
+    void SeedNoise(uint64_t seed);
+    void PrepareNoise();
+
+    GeneratorConfig m_config;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_bytes_per_pixel = 2;
+    double m_exposure_ms = 100.0;
+    double m_gain = 1.0;
+    bool m_dirty = true;
+
+    std::shared_ptr<const FrameTemplate> m_template;
+    float m_noise_level = 0.0f;
+    uint32_t m_lanes[kLanes] = {};              // xorshift32 states
+};
+
+} // namespace emul
+} // namespace adapters
+} // namespace uxdi
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "uxdi/Types.h"
+#include "uxdi/DeadlinePacer.h"
+#include "uxdi/FrameBufferPool.h"
+#include "uxdi/TimingTrace.h"
+#include "FrameGenerator.h"
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <optional>
 #include <mutex>
 #include <chrono>
+#include <filesystem>
 #include <random>
 
 namespace uxdi {
@@ -23,7 +28,11 @@ enum class ActionType {
     Acquire,        ///< Generate frames
     InjectError,    ///< Simulate errors
     SetParameter,   ///< Modify detector parameters
-    Calibration     ///< Simulate calibration sequence
+    Calibration,    ///< Simulate calibration sequence
+    Repeat,         ///< Run nested actions count times (0 = forever)
+    Sweep,          ///< Run nested actions once per value of a parameter
+    Random,         ///< Run one of several nested action lists, chosen by weight
+    Replay          ///< Play back the timing of a recorded session
 };
 
 /**
@@ -37,6 +46,10 @@ inline const char* actionTypeToString(ActionType type) {
         case ActionType::InjectError: return "inject_error";
         case ActionType::SetParameter: return "set_parameter";
         case ActionType::Calibration: return "calibration";
+        case ActionType::Repeat: return "repeat";
+        case ActionType::Sweep: return "sweep";
+        case ActionType::Random: return "random";
+        case ActionType::Replay: return "replay";
         default: return "unknown";
     }
 }
@@ -51,6 +64,10 @@ inline std::optional<ActionType> stringToActionType(const std::string& str) {
     if (str == "inject_error") return ActionType::InjectError;
     if (str == "set_parameter") return ActionType::SetParameter;
     if (str == "calibration") return ActionType::Calibration;
+    if (str == "repeat") return ActionType::Repeat;
+    if (str == "sweep") return ActionType::Sweep;
+    if (str == "random") return ActionType::Random;
+    if (str == "replay") return ActionType::Replay;
     return std::nullopt;
 }
 
@@ -85,45 +102,161 @@ inline std::optional<ErrorCode> stringToErrorCode(const std::string& str) {
 }
 
 /**
- * @brief Scenario action structure
+ * @brief Convert string to frame pacing policy
  */
-struct ScenarioAction {
-    ActionType type;
-    int duration_ms = 0;
-    std::string state;
-    int count = 0;
-    int interval_ms = 0;
-    std::string error;
-    double probability = 0.0;
-    std::string parameter;
-    std::string value;
+inline std::optional<PacingPolicy> stringToPacingPolicy(const std::string& str) {
+    if (str == "catch_up") return PacingPolicy::CatchUp;
+    if (str == "skip") return PacingPolicy::Skip;
+    return std::nullopt;
+}
+
+/**
+ * @brief Operations of a compiled scenario
+ *
+ * The first seven mirror the leaf actions; the rest implement blocks with
+ * counters and jumps, so nested scenarios run without recursion.
+ */
+enum class OpCode : uint8_t {
+    Wait,           ///< Pause for count milliseconds
+    SetState,       ///< Report state
+    Acquire,        ///< Deliver count frames (0 = endless) every value ms, with faults[slot]
+    InjectError,    ///< Raise error with probability value
+    SetParameter,   ///< parameters[slot] = constants[constant]
+    Calibration,    ///< Report READY
+    Replay,         ///< Play traces[slot] back at its recorded times
+    LoopBegin,      ///< Reset loop counter slot
+    LoopEnd,        ///< Jump to target until loop slot has run count times (0 = forever)
+    SweepBegin,     ///< Reset loop counter slot; parameters[parameter] = value
+    SweepEnd,       ///< Like LoopEnd; parameters[parameter] = value + iteration * step
+    Branch,         ///< Jump to a random arm among branches[slot, slot + count)
+    Jump            ///< Continue at target
+};
+
+/**
+ * @brief One compiled scenario step
+ *
+ * Strings are resolved at compile time: states and errors to enums,
+ * parameter names to slots and set_parameter values to constant indices,
+ * so executing a step never hashes or compares strings.
+ *
+ * Acquire steps deliver a frame every value milliseconds (fractional values
+ * are allowed, 0 = as fast as frames can be generated) on an absolute
+ * schedule. pacing selects what happens to frames the generator falls
+ * behind on: "catch_up" (default) delivers them late, "skip" drops their
+ * slots. slot selects the acquire step's performance faults.
+ *
+ * Replay steps play a timing trace (see TimingTraceRecorder) back: each
+ * frame is due at its recorded offset from the step's start, carrying its
+ * recorded frame number, and state changes and errors take effect at their
+ * recorded times. The schedule is absolute, so a frame delivered late does
+ * not push back the frames after it.
+ */
+struct Instruction {
+    OpCode op = OpCode::Jump;
+    uint32_t slot = 0;          // Loop counter, parameter, first branch arm, fault profile or trace
+    uint32_t parameter = 0;     // Swept parameter
+    uint32_t constant = 0;      // Index into Scenario::constants
+    uint32_t target = 0;        // Jump target
+    int64_t count = 0;          // Frames, milliseconds, iterations or arms
+    double value = 0.0;         // Interval, probability or first swept value
+    double step = 0.0;          // Swept value increment
+    PacingPolicy pacing = PacingPolicy::CatchUp;
+    DetectorState state = DetectorState::IDLE;
+    ErrorCode error = ErrorCode::SUCCESS;
+};
+
+/**
+ * @brief One arm of a random branch
+ */
+struct BranchArm {
+    double cumulative_weight = 0.0;
+    uint32_t target = 0;
+};
+
+/**
+ * @brief Performance faults of an acquire step
+ *
+ * Each fault is rolled per frame with its probability:
+ * - latency: the frame arrives latency_ms late; its timestamp still marks
+ *   its slot, so the delay shows up as transport latency
+ * - stall: the frame arrives on time, then delivery stops for stall_ms as
+ *   if the callback thread hung; frames due meanwhile follow when it ends
+ * - drop: the frame number and slot are used up, the frame is never sent
+ * - duplicate: the frame is delivered twice in a row
+ * - reorder: the frame is held back and delivered after the next one
+ *
+ * bandwidth_mbps (0 = unlimited) models a link that carries one frame at a
+ * time: every frame takes size / bandwidth to arrive and queues behind the
+ * one before it, so a stream faster than the link falls behind its
+ * schedule and the acquire step's pacing policy takes over.
+ */
+struct FaultProfile {
+    double latency_ms = 0.0;
+    double latency_probability = 0.0;
+    double stall_ms = 0.0;
+    double stall_probability = 0.0;
+    double bandwidth_mbps = 0.0;
+    double drop_probability = 0.0;
+    double duplicate_probability = 0.0;
+    double reorder_probability = 0.0;
+};
+
+/**
+ * @brief Performance faults injected since the last Start()
+ */
+struct FaultStats {
+    uint64_t dropped = 0;
+    uint64_t duplicated = 0;
+    uint64_t reordered = 0;
+    uint64_t delayed = 0;           // Latency spikes
+    uint64_t stalls = 0;
+    uint64_t throttled = 0;         // Frames queued behind the previous one on the link
 };
 
 /**
- * @brief Scenario definition
+ * @brief Scenario definition, compiled
  */
 struct Scenario {
+    // Parameters the engine applies to the frame generator when set
+    static constexpr uint32_t kExposureSlot = 0;    // "exposure_ms"
+    static constexpr uint32_t kGainSlot = 1;        // "gain"
+
     std::string name;
     std::string description;
-    std::vector<ScenarioAction> actions;
+    uint64_t seed = 0;                          // Random rolls and noise; 0 = nondeterministic
+    bool virtual_clock = false;                 // Simulated time instead of the monotonic clock
+    GeneratorConfig generator;
+    std::vector<Instruction> program;
+    std::vector<std::string> parameter_names;   // Indexed by parameter slot; see kExposureSlot
+    std::vector<std::string> constants;         // set_parameter values
+    std::vector<BranchArm> branches;
+    std::vector<FaultProfile> faults = std::vector<FaultProfile>(1);  // Acquire slot; 0 = none
+    std::vector<std::vector<TimingEvent>> traces;  // Replay slot
+    uint32_t loop_count = 0;                    // Loop counter slots
 };
 
 /**
  * @brief Execution context for scenario
  */
 struct ExecutionContext {
-    size_t current_action = 0;
+    size_t pc = 0;                              // Next instruction
     size_t frames_generated = 0;
     DetectorState current_state = DetectorState::IDLE;
-    std::unordered_map<std::string, std::string> parameters;
+    std::vector<std::string> parameters;        // Indexed by parameter slot
+    std::vector<int64_t> loop_counters;         // Indexed by loop slot
+    size_t trace_event = 0;                     // Next event of the replay step at pc
+    bool trace_started = false;                 // trace_start_ns is set for the step at pc
+    uint64_t trace_start_ns = 0;                // When that replay step started
     std::chrono::steady_clock::time_point last_action_time;
     bool waiting = false;
     std::chrono::steady_clock::time_point wait_start;
-    int wait_duration_ms = 0;
+    int64_t wait_duration_ms = 0;
 };
 
 /**
  * @brief Frame data for generated frames
+ *
+ * With a virtual clock the timestamp counts simulated seconds from Start().
  */
 struct FrameData {
     uint32_t width;
@@ -133,6 +266,7 @@ struct FrameData {
     double timestamp;
     std::shared_ptr<uint8_t[]> data;
     size_t dataLength;
+    uint64_t injectedLatencyNs = 0;   // Latency fault; the timestamp is backdated by it
 };
 
 /**
@@ -140,9 +274,31 @@ struct FrameData {
  *
  * Provides DSL-based test scenario execution for EmulAdapter.
  * Supports configurable test patterns, error injection, and state management.
+ *
+ * Scenarios are compiled once, at load time, into a flat instruction array.
+ * repeat, sweep and random blocks become counters and jumps, so a scenario
+ * that runs for a day is a few instructions. Each frame costs O(1)
+ * instructions. A step that runs kMaxStepsPerCall instructions without
+ * producing a frame or a wait yields, so an empty endless loop cannot hold
+ * the engine.
+ *
+ * Stepping the program and rendering pixels take separate locks, and the
+ * detector state, completion and pending-error flag are published as
+ * atomics after each step. GetCurrentState() and IsComplete() never lock,
+ * and GetNextError() locks only when an error step is due, so status
+ * polling from other threads never delays frame production.
+ *
+ * A scenario with a "seed" is deterministic: every Start() replays the same
+ * branch and fault rolls, and frame noise derives from (seed, frame
+ * number) alone. With "clock": "virtual" the engine runs on simulated time
+ * that starts at 0: waits and frame deadlines advance the clock instead of
+ * sleeping, so a scenario runs as fast as frames can be rendered and its
+ * timestamps are the same on every run and machine.
  */
 class ScenarioEngine {
 public:
+    static constexpr size_t kMaxStepsPerCall = 1u << 16;
+
     ScenarioEngine();
     ~ScenarioEngine() = default;
 
@@ -155,17 +311,27 @@ public:
     /**
      * @brief Load scenario from JSON string
      * @param json_scenario JSON string containing scenario definition
-     * @return true if loading succeeded
+     * @return true if loading succeeded; GetParseError() explains a failure
      */
     bool LoadScenario(const std::string& json_scenario);
 
     /**
      * @brief Load scenario from file
+     *
+     * Relative replay trace paths are resolved against the file's directory
+     * (against the working directory for LoadScenario()).
+     *
      * @param file_path Path to scenario JSON file
-     * @return true if loading succeeded
+     * @return true if loading succeeded; GetParseError() explains a failure
      */
     bool LoadScenarioFromFile(const std::string& file_path);
 
+    /**
+     * @brief Why the last load failed, with line and column for malformed JSON
+     * @return Empty after a successful load
+     */
+    std::string GetParseError() const;
+
     /**
      * @brief Start scenario execution
      */
@@ -178,12 +344,54 @@ public:
 
     /**
      * @brief Get next frame based on scenario
+     *
+     * Blocks until the frame's deadline when the current acquire action has
+     * an interval, and until a replayed state change or error falls due;
+     * Stop() ends the wait early.
+     *
      * @return FrameData if frame should be generated, nullopt otherwise
      */
     std::optional<FrameData> GetNextFrame();
 
+    /**
+     * @brief Step to the next frame and render it without waiting for it
+     *
+     * The non-blocking half of GetNextFrame() for callers that schedule
+     * delivery themselves: the frame is due at deadlineNs (MonotonicNowNs()
+     * clock) and carries no timestamp yet. With a virtual clock the frame
+     * is already stamped and deadlineNs is simulated time, which is always
+     * in the past.
+     *
+     * @param deadlineNs Set to the frame's delivery deadline; without a
+     *                   frame, to when a replayed state change or error
+     *                   falls due and the scenario should be stepped again,
+     *                   or 0
+     * @return FrameData if a frame is due, nullopt otherwise
+     */
+    std::optional<FrameData> PrepareNextFrame(uint64_t& deadlineNs);
+
+    /**
+     * @brief Stamp a prepared frame's timestamp as it is delivered
+     *
+     * Does nothing with a virtual clock; PrepareNextFrame() stamped it.
+     */
+    void StampTimestamp(FrameData& frame) const;
+
+    /**
+     * @brief Get pacing counters of the current acquire action
+     */
+    PacerStats GetPacingStats() const;
+
+    /**
+     * @brief Get counters of the performance faults injected so far
+     */
+    FaultStats GetFaultStats() const;
+
     /**
      * @brief Get current detector state
+     *
+     * Lock-free; may trail a step running on another thread.
+     *
      * @return Current detector state
      */
     DetectorState GetCurrentState() const;
@@ -195,7 +403,7 @@ public:
     std::optional<ErrorCode> GetNextError();
 
     /**
-     * @brief Check if scenario is complete
+     * @brief Check if scenario is complete (lock-free)
      * @return true if all actions have been executed
      */
     bool IsComplete() const;
@@ -219,6 +427,13 @@ public:
      */
     void SetFrameConfig(uint32_t width, uint32_t height, uint32_t bitDepth);
 
+    /**
+     * @brief Set the exposure the phantom pattern is rendered for
+     * @param exposureTimeMs Exposure time in milliseconds
+     * @param gain Detector gain factor
+     */
+    void SetExposure(double exposureTimeMs, double gain);
+
     /**
      * @brief Get parameter value
      * @param name Parameter name
@@ -234,35 +449,81 @@ public:
     void SetParameter(const std::string& name, const std::string& value);
 
 private:
+    // m_mutex guards the scenario and its execution context. It is held
+    // only to step the program, never while pixels are rendered
     Scenario m_scenario;
     ExecutionContext m_context;
     mutable std::mutex m_mutex;
-    bool m_running = false;
+    std::atomic<bool> m_running{false};
+
+    // Status published after every step, read without locking
+    std::atomic<DetectorState> m_state{DetectorState::IDLE};
+    std::atomic<bool> m_complete{true};
+    std::atomic<bool> m_error_due{false};   // GetNextError() has something to do
+    std::atomic<bool> m_virtual_clock{false};
+    uint64_t m_virtual_now_ns = 0;          // Simulated time since Start()
+
+    // Frame schedule of the acquire instruction at m_paced_action
+    static constexpr size_t kNoAction = static_cast<size_t>(-1);
+    DeadlinePacer m_pacer;
+    size_t m_paced_action = kNoAction;
+
+    // Error raised by an inject_error step, delivered by GetNextError()
+    std::optional<ErrorCode> m_pending_error;
+
+    // Performance faults. Duplicated and reordered frames wait in
+    // m_replay_frames and go out, oldest first, right after the frame
+    // that was delivered ahead of them
+    static constexpr size_t kMaxDropsPerCall = 256;
+    std::vector<FrameData> m_replay_frames;
+    bool m_holding_frame = false;   // A reordered frame waits for its successor
+    uint64_t m_link_free_ns = 0;    // Bandwidth limit: the link is busy until then
+    uint64_t m_stall_until_ns = 0;
+    FaultStats m_fault_stats;
+
+    std::string m_parse_error;
+
+    // m_generator_mutex guards everything below up to m_frame_pool. It may
+    // be taken while m_mutex is held, never the other way round
+    std::mutex m_generator_mutex;
+
+    // Exposure the generator renders for; set by the detector and by the
+    // exposure_ms and gain parameters, whichever came last
+    double m_exposure_ms = 100.0;
+    double m_gain = 1.0;
 
     // Frame configuration
     uint32_t m_frame_width = 1024;
     uint32_t m_frame_height = 1024;
     uint32_t m_frame_bit_depth = 16;
 
-    // Random number generation for error injection
+    // Generated frames are rendered into recycled buffers
+    FrameGenerator m_generator;
+    FrameBufferPool m_frame_pool;
+
+    // Random number generation for error injection, branches and
+    // performance faults. mt19937 is specified bit for bit, and RollUnit()
+    // avoids the library-specific distributions, so a seeded scenario rolls
+    // the same on every platform
     mutable std::mt19937 m_rng;
-    mutable std::uniform_real_distribution<double> m_dist;
 
     // Helper methods
-    std::optional<ScenarioAction> GetCurrentAction() const;
-    bool ExecuteAction(const ScenarioAction& action);
-    FrameData GenerateFrame();
-    void ProcessWaiting();
+    uint64_t NowNs() const;
+    void SeedRandom();
+    double RollUnit() const;
+    std::optional<uint64_t> AdvanceToNextFrame(uint64_t& deadlineNs, uint32_t& faults);
+    std::optional<FrameData> ApplyFaults(FrameData frame, const FaultProfile& faults, uint64_t& deadlineNs);
+    void ResetFaults();
+    void AdvanceVirtualClock(FrameData& frame, uint64_t deadlineNs);
+    void SetParameterSlot(uint32_t slot, std::string value);
+    uint32_t FindParameterSlot(const std::string& name) const;
+    FrameData GenerateFrame(uint64_t frameNumber);
+    bool ProcessWaiting();
+    void PublishStatus();
     bool ShouldInjectError(double probability) const;
 
-    // JSON parsing helpers
-    bool ParseScenario(const std::string& json);
-    std::string Trim(const std::string& str) const;
-    std::optional<std::string> ExtractString(const std::string& json, const std::string& key);
-    std::optional<int> ExtractInt(const std::string& json, const std::string& key);
-    std::optional<double> ExtractDouble(const std::string& json, const std::string& key);
-    std::vector<std::string> ExtractArray(const std::string& json, const std::string& key);
-    std::string UnescapeString(const std::string& str) const;
+    // JSON parsing
+    bool ParseScenario(const std::string& json, const std::filesystem::path& base_dir = {});
 };
 
 } // namespace emul
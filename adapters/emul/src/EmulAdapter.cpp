@@ -1,9 +1,13 @@
 #include "EmulDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 #include <cstring>
 
 // When building the DLL, we need to export these functions
 // When using the DLL, we need to import them
-#ifdef UXDI_EMUL_EXPORTS
+#if !defined(_WIN32)
+#define EMUL_API __attribute__((visibility("default")))
+#elif defined(UXDI_EMUL_EXPORTS)
 #define EMUL_API __declspec(dllexport)
 #else
 #define EMUL_API __declspec(dllimport)
@@ -70,4 +74,25 @@ EMUL_API void DestroyDetector(uxdi::IDetector* detector) {
     }
 }
 
+/**
+ * @brief Route this adapter's trace points to the host's recorder
+ *
+ * Called by DetectorFactory right after loading, since the adapter links its
+ * own copy of uxdi_core.
+ *
+ * @param recorder Host recorder, or nullptr to use the adapter's own
+ */
+EMUL_API void AttachTraceRecorder(uxdi::TraceRecorder* recorder) {
+    uxdi::TraceRecorder::Attach(recorder);
+}
+
+/**
+ * @brief Count this adapter's allocations in the host's tracker
+ *
+ * @param tracker Host tracker, or nullptr to use the adapter's own
+ */
+EMUL_API void AttachAllocationTracker(uxdi::AllocationTracker* tracker) {
+    uxdi::AllocationTracker::Attach(tracker);
+}
+
 } // extern "C"
@@ -1,4 +1,8 @@
 #include "EmulDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/JsonReader.h"
+#include "uxdi/DeadlinePacer.h"
 #include <fstream>
 #include <sstream>
 #include <cstring>
@@ -63,6 +67,7 @@ EmulDetector::EmulDetector(const std::string& config)
 
     // Configure frame generation
     scenarioEngine_.SetFrameConfig(params_.width, params_.height, 16);
+    scenarioEngine_.SetExposure(params_.exposureTimeMs, params_.gain);
 }
 
 EmulDetector::~EmulDetector() {
@@ -82,9 +87,11 @@ bool EmulDetector::initialize() {
     state_ = DetectorState::INITIALIZING;
 
     // Load scenario from config or use default
+    std::string configError;
     if (!scenarioConfig_.empty()) {
         if (!loadScenarioFromConfig(scenarioConfig_)) {
-            // Fall back to default scenario on error
+            // Fall back to default scenario on error, but keep the reason
+            configError = scenarioEngine_.GetParseError();
             if (!loadDefaultScenario()) {
                 state_ = DetectorState::ERROR;
                 setError(ErrorCode::INVALID_PARAMETER, "Failed to load scenario configuration");
@@ -99,9 +106,23 @@ bool EmulDetector::initialize() {
         }
     }
 
+    if (farmMode_ && !farm_) {
+        farm_ = EmulatorFarm::Acquire();
+    }
+
+    // A seeded scenario names the same detector on every run
+    if (const uint64_t seed = scenarioEngine_.GetScenario().seed; seed != 0) {
+        serialNumber_ = "EMUL-S" + std::to_string(seed);
+        detectorInfo_.serialNumber = serialNumber_;
+    }
+
     initialized_ = true;
     state_ = DetectorState::READY;
-    clearError();
+    if (configError.empty()) {
+        clearError();
+    } else {
+        setError(ErrorCode::INVALID_PARAMETER, "Scenario configuration ignored, using default: " + configError);
+    }
 
     notifyStateChanged(DetectorState::READY);
     return true;
@@ -124,6 +145,10 @@ bool EmulDetector::shutdown() {
     if (acquisitionThread_.joinable()) {
         acquisitionThread_.join();
     }
+    if (farm_) {
+        farm_->Remove(this);
+        farm_.reset();
+    }
 
     initialized_ = false;
     state_ = DetectorState::IDLE;
@@ -195,6 +220,7 @@ bool EmulDetector::setAcquisitionParams(const AcquisitionParams& params) {
 
     // Update scenario engine frame configuration
     scenarioEngine_.SetFrameConfig(params_.width, params_.height, detectorInfo_.bitDepth);
+    scenarioEngine_.SetExposure(params_.exposureTimeMs, params_.gain);
 
     clearError();
     return true;
@@ -216,6 +242,8 @@ IDetectorListener* EmulDetector::getListener() const {
 }
 
 bool EmulDetector::startAcquisition() {
+    UXDI_TRACE_SCOPE(State, "emul.startAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -252,7 +280,14 @@ bool EmulDetector::startAcquisition() {
         listener->onAcquisitionStarted();
     }
 
-    // Start frame generation thread
+    // Start frame generation thread, or hand the detector to the farm
+    if (farm_) {
+        farm_->Remove(this);  // Waits out a service call of the last acquisition
+        pendingFrame_.reset();
+        pendingDeadlineNs_ = 0;
+        farm_->Add(this, MonotonicNowNs());
+        return true;
+    }
     if (acquisitionThread_.joinable()) {
         acquisitionThread_.join();
     }
@@ -262,6 +297,8 @@ bool EmulDetector::startAcquisition() {
 }
 
 bool EmulDetector::stopAcquisition() {
+    UXDI_TRACE_SCOPE(State, "emul.stopAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -316,6 +353,10 @@ void EmulDetector::clearError() {
     lastError_.details.clear();
 }
 
+DetectorStatistics EmulDetector::getStatistics() const {
+    return frameRate_.GetStatistics();
+}
+
 //=============================================================================
 // Private Helper Methods
 //=============================================================================
@@ -328,6 +369,8 @@ void EmulDetector::setError(ErrorCode code, const std::string& message) {
 }
 
 void EmulDetector::notifyStateChanged(DetectorState newState) {
+    UXDI_TRACE_INSTANT(State, "emul.stateChanged", static_cast<uint64_t>(newState));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -340,6 +383,8 @@ void EmulDetector::notifyStateChanged(DetectorState newState) {
 }
 
 void EmulDetector::notifyError(const ErrorInfo& error) {
+    UXDI_TRACE_INSTANT(State, "emul.error", static_cast<uint64_t>(error.code));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -351,15 +396,23 @@ void EmulDetector::notifyError(const ErrorInfo& error) {
     }
 }
 
-void EmulDetector::notifyImageReceived(const ImageData& image) {
+void EmulDetector::notifyImageReceived(ImageData& image) {
+    UXDI_TRACE_SCOPE_ARG(Dispatch, "emul.notifyImage", image.frameNumber);
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
         listener = listener_;
     }
 
+    const uint64_t dispatchNs = MonotonicNowNs();
+    frameRate_.RecordFrame(image.dataLength, dispatchNs);
+
     if (listener) {
+        image.latency.dispatchNs = dispatchNs;
+        UXDI_ALLOC_SCOPE(Listener);
         listener->onImageReceived(image);
+        frameRate_.RecordCallback(MonotonicNowNs() - dispatchNs);
     }
 }
 
@@ -392,44 +445,19 @@ bool EmulDetector::loadScenarioFromConfig(const std::string& config) {
         return scenarioEngine_.LoadScenarioFromFile(filePath);
     }
 
-    // Check if it contains "scenario_file" key
-    size_t fileKeyPos = trimmedConfig.find("\"scenario_file\"");
-    if (fileKeyPos != std::string::npos) {
-        // Extract file path from JSON
-        size_t colonPos = trimmedConfig.find(':', fileKeyPos);
-        if (colonPos != std::string::npos) {
-            size_t quoteStart = trimmedConfig.find('\"', colonPos);
-            if (quoteStart != std::string::npos) {
-                size_t quoteEnd = trimmedConfig.find('\"', quoteStart + 1);
-                if (quoteEnd != std::string::npos) {
-                    std::string filePath = trimmedConfig.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-                    return scenarioEngine_.LoadScenarioFromFile(filePath);
-                }
-            }
-        }
+    // A JSON object naming a scenario file, wrapping a scenario, or being one
+    JsonDocument document;
+    if (!document.Parse(trimmedConfig)) {
+        return scenarioEngine_.LoadScenario(trimmedConfig);  // Reports the parse error
     }
-
-    // Check if it contains "scenario" key (inline scenario)
-    size_t scenarioKeyPos = trimmedConfig.find("\"scenario\"");
-    if (scenarioKeyPos != std::string::npos) {
-        size_t scenarioStart = trimmedConfig.find('{', scenarioKeyPos);
-        if (scenarioStart != std::string::npos) {
-            // Find matching closing brace
-            int depth = 0;
-            size_t scenarioEnd = scenarioStart;
-            for (; scenarioEnd < trimmedConfig.length(); ++scenarioEnd) {
-                if (trimmedConfig[scenarioEnd] == '{') depth++;
-                else if (trimmedConfig[scenarioEnd] == '}') depth--;
-                if (depth == 0) break;
-            }
-            if (depth == 0) {
-                std::string scenarioJson = trimmedConfig.substr(scenarioStart, scenarioEnd - scenarioStart + 1);
-                return scenarioEngine_.LoadScenario(scenarioJson);
-            }
-        }
+    const JsonValue root = document.Root();
+    farmMode_ = root["farm"].AsBool().value_or(false);
+    if (auto filePath = root["scenario_file"].AsString()) {
+        return scenarioEngine_.LoadScenarioFromFile(*filePath);
+    }
+    if (const JsonValue scenario = root["scenario"]; scenario.IsObject()) {
+        return scenarioEngine_.LoadScenario(std::string(scenario.Raw()));
     }
-
-    // Treat entire config as scenario JSON
     return scenarioEngine_.LoadScenario(trimmedConfig);
 }
 
@@ -449,41 +477,111 @@ std::string EmulDetector::getFileContents(const std::string& filePath) {
 }
 
 void EmulDetector::acquisitionThreadFunc() {
+    UXDI_TRACE_THREAD_NAME("emul acquisition");
+    UXDI_ALLOC_SCOPE(Adapter);
+
     while (acquisitionActive_.load()) {
         // Check for error injection
-        auto error = scenarioEngine_.GetNextError();
-        if (error) {
-            ErrorInfo errorInfo;
-            errorInfo.code = *error;
-            errorInfo.message = "Scenario error injection";
-            errorInfo.details = "Error injected by scenario engine";
-
-            setError(*error, "Scenario error injection");
-            notifyError(errorInfo);
-
-            // Stop acquisition on error
-            acquisitionActive_ = false;
-            state_ = DetectorState::ERROR;
-            notifyStateChanged(DetectorState::ERROR);
+        if (raiseInjectedError()) {
             break;
         }
 
         // Get next frame from scenario engine
+        UXDI_TRACE_BEGIN(Acquisition, "emul.GetNextFrame");
         auto frameData = scenarioEngine_.GetNextFrame();
+        UXDI_TRACE_END(Acquisition, "emul.GetNextFrame");
         if (frameData) {
-            ImageData image = convertFrameDataToImageData(*frameData);
-            notifyImageReceived(image);
+            deliverFrame(*frameData);
         } else {
             // No frame generated this iteration
             if (scenarioEngine_.IsComplete()) {
                 // Scenario completed
                 break;
             }
+            // A replayed error is raised as soon as the scenario steps onto it
+            if (raiseInjectedError()) {
+                break;
+            }
             // Sleep a bit to avoid busy waiting
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     }
 
+    finishAcquisition();
+}
+
+std::optional<uint64_t> EmulDetector::ServiceFarmTick(uint64_t nowNs) {
+    // The farm hands the detector over just ahead of the frame's deadline;
+    // the pacer's sleep-and-spin covers the rest
+    if (pendingFrame_ && acquisitionActive_.load()) {
+        UXDI_TRACE_SCOPE(Acquisition, "emul.farmPace");
+        if (DeadlinePacer::SleepUntil(pendingDeadlineNs_, acquisitionActive_)) {
+            scenarioEngine_.StampTimestamp(*pendingFrame_);
+            deliverFrame(*pendingFrame_);
+        }
+    } else if (pendingDeadlineNs_ != 0 && acquisitionActive_.load()) {
+        // A replayed state change or error is stepped on its deadline too
+        UXDI_TRACE_SCOPE(Acquisition, "emul.farmPaceEvent");
+        DeadlinePacer::SleepUntil(pendingDeadlineNs_, acquisitionActive_);
+    }
+    pendingFrame_.reset();
+
+    if (!acquisitionActive_.load() || raiseInjectedError()) {
+        return std::nullopt;
+    }
+
+    // Render the next frame now and come back when it is due
+    UXDI_TRACE_BEGIN(Acquisition, "emul.PrepareNextFrame");
+    pendingFrame_ = scenarioEngine_.PrepareNextFrame(pendingDeadlineNs_);
+    UXDI_TRACE_END(Acquisition, "emul.PrepareNextFrame");
+    if (pendingFrame_) {
+        return pendingDeadlineNs_;
+    }
+    if (raiseInjectedError()) {
+        return std::nullopt;
+    }
+    if (pendingDeadlineNs_ != 0) {
+        return pendingDeadlineNs_;
+    }
+    if (scenarioEngine_.IsComplete()) {
+        finishAcquisition();
+        return std::nullopt;
+    }
+    // Waiting inside the scenario; poll like the acquisition thread does
+    return nowNs + 10'000'000;
+}
+
+bool EmulDetector::raiseInjectedError() {
+    auto error = scenarioEngine_.GetNextError();
+    if (!error) {
+        return false;
+    }
+
+    UXDI_TRACE_INSTANT(Acquisition, "emul.injectedError", static_cast<uint64_t>(*error));
+    ErrorInfo errorInfo;
+    errorInfo.code = *error;
+    errorInfo.message = "Scenario error injection";
+    errorInfo.details = "Error injected by scenario engine";
+
+    setError(*error, "Scenario error injection");
+    notifyError(errorInfo);
+
+    // Stop acquisition on error
+    acquisitionActive_ = false;
+    state_ = DetectorState::ERROR;
+    notifyStateChanged(DetectorState::ERROR);
+    return true;
+}
+
+void EmulDetector::deliverFrame(const FrameData& frameData) {
+    const uint64_t deliveredNs = MonotonicNowNs();
+    ImageData image = convertFrameDataToImageData(frameData);
+    image.latency.sdkDeliveryNs = deliveredNs;
+    image.latency.adapterConvertedNs = MonotonicNowNs();
+    notifyImageReceived(image);
+}
+
+void EmulDetector::finishAcquisition() {
     // Check if we're still supposed to be acquiring
     if (acquisitionActive_.load() && state_.load() == DetectorState::ACQUIRING) {
         // Transition to ready state
@@ -536,13 +634,13 @@ bool EmulDetectorSynchronous::acquireFrame(ImageData& outImage, uint32_t timeout
         // Access scenario engine through friend declaration
         auto frameData = detector_->scenarioEngine_.GetNextFrame();
         if (frameData) {
+            const uint64_t deliveredNs = MonotonicNowNs();
             outImage = detector_->convertFrameDataToImageData(*frameData);
+            outImage.latency.sdkDeliveryNs = deliveredNs;
+            outImage.latency.adapterConvertedNs = MonotonicNowNs();
 
             // Notify listener if set
-            auto listener = detector_->getListener();
-            if (listener) {
-                listener->onImageReceived(outImage);
-            }
+            detector_->notifyImageReceived(outImage);
 
             return true;
         }
@@ -0,0 +1,209 @@
+#include "EmulatorFarm.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/Types.h"
+#include <algorithm>
+#include <chrono>
+
+namespace uxdi::adapters::emul {
+
+namespace {
+
+// Client being serviced on this thread, so Remove() from inside its own
+// service call does not wait for itself
+thread_local EmulatorFarm::Client* t_current_client = nullptr;
+
+std::chrono::steady_clock::time_point ToTimePoint(uint64_t monotonicNs) {
+    return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(monotonicNs));
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// EmulatorFarm Implementation
+// ============================================================================
+
+std::shared_ptr<EmulatorFarm> EmulatorFarm::Acquire() {
+    static std::mutex mutex;
+    static std::weak_ptr<EmulatorFarm> instance;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<EmulatorFarm> farm = instance.lock();
+    if (!farm) {
+        farm = std::make_shared<EmulatorFarm>();
+        instance = farm;
+    }
+    return farm;
+}
+
+EmulatorFarm::EmulatorFarm(size_t workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, kMaxWorkers);
+    }
+
+    m_scheduler = std::thread(&EmulatorFarm::SchedulerLoop, this);
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&EmulatorFarm::WorkerLoop, this);
+    }
+}
+
+EmulatorFarm::~EmulatorFarm() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_scheduler_cv.notify_all();
+    m_worker_cv.notify_all();
+
+    m_scheduler.join();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void EmulatorFarm::Add(Client* client, uint64_t dueNs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto it = m_ids.find(client); it != m_ids.end()) {
+        Member& member = m_members.at(it->second);
+        if (member.running) {
+            // The worker reschedules it when the call returns
+            member.removed = false;
+            member.restart_ns = dueNs;
+            return;
+        }
+        // Its wheel entry goes stale with the old id
+        m_members.erase(it->second);
+        m_ids.erase(it);
+    }
+
+    const uint64_t id = m_next_id++;
+    Member member;
+    member.client = client;
+    m_members.emplace(id, member);
+    m_ids.emplace(client, id);
+    m_wheel.Schedule(id, dueNs);
+    m_scheduler_cv.notify_one();
+}
+
+void EmulatorFarm::Remove(Client* client) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto idIt = m_ids.find(client);
+    if (idIt == m_ids.end()) {
+        return;
+    }
+    const uint64_t id = idIt->second;
+    auto it = m_members.find(id);
+    if (!it->second.running) {
+        m_members.erase(it);
+        m_ids.erase(idIt);
+        return;
+    }
+
+    // Finish() drops it when the service call returns
+    it->second.removed = true;
+    it->second.restart_ns.reset();
+    if (t_current_client == client) {
+        return;
+    }
+    m_idle_cv.wait(lock, [&] {
+        auto member = m_members.find(id);
+        return member == m_members.end() || !member->second.running;
+    });
+}
+
+size_t EmulatorFarm::GetClientCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_members.size();
+}
+
+void EmulatorFarm::SchedulerLoop() {
+    UXDI_TRACE_THREAD_NAME("emul farm scheduler");
+
+    const uint64_t leadNs = m_wheel.GetTickNs();
+    std::vector<uint64_t> due;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        due.clear();
+        m_wheel.PopDue(MonotonicNowNs() + leadNs, due);
+        for (uint64_t id : due) {
+            if (m_members.count(id) != 0) {
+                m_ready.push_back(id);
+            }
+        }
+        if (!m_ready.empty()) {
+            UXDI_TRACE_INSTANT(Acquisition, "emul.farmDue", m_ready.size());
+            m_worker_cv.notify_all();
+        }
+
+        const std::optional<uint64_t> nextNs = m_wheel.NextDeadline();
+        if (!nextNs) {
+            m_scheduler_cv.wait(lock);
+        } else if (*nextNs > leadNs) {
+            m_scheduler_cv.wait_until(lock, ToTimePoint(*nextNs - leadNs));
+        }
+    }
+}
+
+void EmulatorFarm::WorkerLoop() {
+    UXDI_TRACE_THREAD_NAME("emul farm worker");
+    UXDI_ALLOC_SCOPE(Adapter);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_worker_cv.wait(lock, [this] { return m_stopping || !m_ready.empty(); });
+        if (m_stopping) {
+            return;
+        }
+
+        const uint64_t id = m_ready.front();
+        m_ready.pop_front();
+        auto it = m_members.find(id);
+        if (it == m_members.end() || it->second.running) {
+            continue;
+        }
+        it->second.running = true;
+        Client* client = it->second.client;
+        lock.unlock();
+
+        std::optional<uint64_t> nextNs;
+        {
+            UXDI_TRACE_SCOPE_ARG(Acquisition, "emul.farmService", id);
+            t_current_client = client;
+            nextNs = client->ServiceFarmTick(MonotonicNowNs());
+            t_current_client = nullptr;
+        }
+
+        lock.lock();
+        Finish(id, nextNs);
+    }
+}
+
+void EmulatorFarm::Finish(uint64_t id, std::optional<uint64_t> nextNs) {
+    auto it = m_members.find(id);
+    Member& member = it->second;
+    member.running = false;
+
+    if (member.restart_ns) {
+        nextNs = member.restart_ns;
+        member.restart_ns.reset();
+    } else if (member.removed) {
+        nextNs.reset();
+    }
+
+    if (nextNs) {
+        m_wheel.Schedule(id, *nextNs);
+        m_scheduler_cv.notify_one();
+    } else {
+        if (auto idIt = m_ids.find(member.client); idIt != m_ids.end() && idIt->second == id) {
+            m_ids.erase(idIt);
+        }
+        m_members.erase(it);
+    }
+    m_idle_cv.notify_all();
+}
+
+} // namespace uxdi::adapters::emul
@@ -0,0 +1,504 @@
+#include "FrameGenerator.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace uxdi {
+namespace adapters {
+namespace emul {
+
+namespace {
+
+// Largest noise sigma in counts
+constexpr float kMaxSigma = 4095.0f;
+
+uint64_t SplitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+uint32_t NextRandom(uint32_t& state) {
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+}
+
+// Approximately standard normal: the sum of the four random bytes
+// (Irwin-Hall, mean 510, sigma 147.8), bounded to about +/- 3.5 sigma
+float UnitNormal(uint32_t bits) {
+    const int32_t sum = static_cast<int32_t>((bits & 0xFF) + ((bits >> 8) & 0xFF) +
+                                             ((bits >> 16) & 0xFF) + (bits >> 24));
+    return static_cast<float>(sum - 510) * (1.0f / 147.8f);
+}
+
+// sqrt for v >= 0 without the errno path that keeps std::sqrt from
+// vectorizing; one Newton step gives about 0.2% error, plenty for noise
+float FastSqrt(float v) {
+    const uint32_t bits = 0x5F3759DFu - (std::bit_cast<uint32_t>(v) >> 1);
+    const float inverse = std::bit_cast<float>(bits);
+    return v * inverse * (1.5f - 0.5f * v * inverse * inverse);
+}
+
+// ============================================================================
+// Phantom model
+// ============================================================================
+
+// Fixed so every run emulates the same panel: same gain map, dark map and defects
+constexpr uint64_t kPanelSeed = 0x5EED0F9A4E1ull;
+
+// Open beam at the reference exposure and gain, as a fraction of full scale
+constexpr double kOpenFraction = 0.55;
+constexpr double kReferenceExposureMs = 100.0;
+
+// Quantum noise: counts per detected photon at gain 1 on a 16-bit panel
+constexpr double kCountsPerPhoton = 4.0;
+
+constexpr float kDarkFraction = 0.004f;         // Mean dark offset
+constexpr float kPixelDarkSigma = 0.08f;        // Per-pixel dark spread, relative to the mean
+constexpr float kColumnDarkSigma = 0.05f;       // Per-column dark spread, relative to the mean
+constexpr float kPixelGainSigma = 0.02f;        // Per-pixel gain nonuniformity
+constexpr float kBlockGainSigma = 0.03f;        // Per-readout-block gain step
+constexpr uint32_t kReadoutBlock = 256;         // Columns per readout chip
+constexpr float kHeel = 0.2f;                   // Intensity loss from cathode (top) to anode (bottom)
+constexpr float kFalloff = 0.2f;                // Intensity loss in the corners (inverse square)
+
+constexpr size_t kPixelsPerDeadPixel = 10000;
+constexpr size_t kPixelsPerHotPixel = 50000;
+constexpr uint32_t kMinLineDefectSize = 64;     // Smaller frames get no dead lines
+
+enum class ShapeKind {
+    Ellipsoid,      // Attenuation follows the projected thickness
+    Disk,           // Constant attenuation inside an ellipse
+    Slab            // Constant attenuation inside a rectangle
+};
+
+// Centre and half-extent in frame units (-0.5..0.5, y down); mu is the peak
+// attenuation line integral, negative for air cavities inside the body
+struct PhantomShape {
+    ShapeKind kind;
+    float cx, cy, rx, ry, mu;
+};
+
+constexpr PhantomShape kPhantomShapes[] = {
+    {ShapeKind::Ellipsoid,  0.00f,  0.02f, 0.42f, 0.47f,  2.2f},   // Torso
+    {ShapeKind::Ellipsoid, -0.17f, -0.05f, 0.13f, 0.26f, -1.3f},   // Lungs
+    {ShapeKind::Ellipsoid,  0.17f, -0.05f, 0.13f, 0.26f, -1.3f},
+    {ShapeKind::Ellipsoid,  0.05f,  0.12f, 0.13f, 0.11f,  0.6f},   // Heart
+    {ShapeKind::Slab,       0.00f,  0.02f, 0.03f, 0.45f,  0.9f},   // Spine
+    {ShapeKind::Slab,      -0.15f, -0.33f, 0.12f, 0.012f, 0.5f},   // Clavicles
+    {ShapeKind::Slab,       0.15f, -0.33f, 0.12f, 0.012f, 0.5f},
+    {ShapeKind::Disk,      -0.24f,  0.38f, 0.02f, 0.02f,  0.02f},  // Low-contrast details
+    {ShapeKind::Disk,      -0.12f,  0.38f, 0.02f, 0.02f,  0.05f},
+    {ShapeKind::Disk,       0.00f,  0.38f, 0.02f, 0.02f,  0.1f},
+    {ShapeKind::Disk,       0.12f,  0.38f, 0.02f, 0.02f,  0.2f},
+    {ShapeKind::Disk,       0.24f,  0.38f, 0.02f, 0.02f,  0.4f},
+    {ShapeKind::Slab,       0.36f, -0.40f, 0.025f, 0.035f, 5.0f},  // Lead side marker
+};
+
+// Add one shape's attenuation along row coordinate v
+void AddShape(const PhantomShape& shape, float v, uint32_t width, float* attenuation) {
+    const float dy = (v - shape.cy) / shape.ry;
+    const float rowExtent = 1.0f - dy * dy;
+    if (rowExtent < 0.0f) {
+        return;
+    }
+
+    const float halfWidth = shape.kind == ShapeKind::Slab ? shape.rx : shape.rx * std::sqrt(rowExtent);
+    const float scale = static_cast<float>(width);
+    const int first = std::max(0, static_cast<int>(std::ceil((shape.cx - halfWidth + 0.5f) * scale - 0.5f)));
+    const int last = std::min(static_cast<int>(width) - 1,
+                              static_cast<int>(std::floor((shape.cx + halfWidth + 0.5f) * scale - 0.5f)));
+    for (int x = first; x <= last; ++x) {
+        if (shape.kind == ShapeKind::Ellipsoid) {
+            const float dx = ((x + 0.5f) / scale - 0.5f - shape.cx) / shape.rx;
+            attenuation[x] += shape.mu * std::sqrt(std::max(rowExtent - dx * dx, 0.0f));
+        } else {
+            attenuation[x] += shape.mu;
+        }
+    }
+}
+
+// Calls bandFn(firstRow, lastRow) over contiguous row bands, one per
+// hardware thread; frames too small to amortize a thread stay on the caller
+template <typename BandFn>
+void ForEachRowBand(uint32_t height, size_t pixelCount, const BandFn& bandFn) {
+    constexpr size_t kMinPixelsPerThread = 256 * 1024;
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const size_t bands = std::clamp<size_t>(pixelCount / kMinPixelsPerThread, 1,
+                                            std::min<size_t>(hardware, std::max<uint32_t>(height, 1)));
+    const auto runBand = [&](size_t band) {
+        bandFn(static_cast<uint32_t>(height * band / bands), static_cast<uint32_t>(height * (band + 1) / bands));
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(bands - 1);
+    for (size_t band = 1; band < bands; ++band) {
+        workers.emplace_back(runBand, band);
+    }
+    runBand(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// ============================================================================
+// Template Cache
+// ============================================================================
+
+// Everything a template depends on
+struct TemplateKey {
+    FramePattern pattern;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytes_per_pixel;
+    double exposure_ms;     // Phantom only; 0 otherwise
+    double gain;
+
+    bool operator==(const TemplateKey&) const = default;
+};
+
+/**
+ * @brief Process-wide templates, keyed by their settings
+ *
+ * Entries hold weak references, so a template lives as long as some
+ * generator uses it. Each key has its own build lock: generators asking
+ * for the same new template wait for one render, others are not held up.
+ */
+class TemplateCache {
+public:
+    template <typename Build>
+    std::shared_ptr<const FrameTemplate> Acquire(const TemplateKey& key, Build&& build) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // Drop entries nobody uses any more
+            std::erase_if(m_entries, [](const std::shared_ptr<Entry>& candidate) {
+                return candidate.use_count() == 1 && candidate->frame.expired();
+            });
+            auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                                   [&](const std::shared_ptr<Entry>& candidate) { return candidate->key == key; });
+            if (it == m_entries.end()) {
+                it = m_entries.insert(m_entries.end(), std::make_shared<Entry>(key));
+            }
+            entry = *it;
+        }
+
+        std::lock_guard<std::mutex> build_lock(entry->build_mutex);
+        if (auto frame = entry->frame.lock()) {
+            return frame;
+        }
+        auto frame = std::make_shared<FrameTemplate>();
+        build(*frame);
+        entry->frame = frame;
+        return frame;
+    }
+
+private:
+    struct Entry {
+        explicit Entry(const TemplateKey& entry_key) : key(entry_key) {}
+        TemplateKey key;
+        std::mutex build_mutex;
+        std::weak_ptr<const FrameTemplate> frame;
+    };
+
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<Entry>> m_entries;
+};
+
+TemplateCache& SharedTemplates() {
+    static TemplateCache cache;
+    return cache;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// FrameGenerator Implementation
+// ============================================================================
+
+FrameGenerator::FrameGenerator() = default;
+
+void FrameGenerator::Configure(const GeneratorConfig& config) {
+    m_config = config;
+    m_dirty = true;
+}
+
+void FrameGenerator::SetFrameConfig(uint32_t width, uint32_t height, uint32_t bitDepth) {
+    m_width = width;
+    m_height = height;
+    m_bytes_per_pixel = (bitDepth + 7) / 8;
+    m_dirty = true;
+}
+
+void FrameGenerator::SetExposure(double exposureTimeMs, double gain) {
+    if (exposureTimeMs != m_exposure_ms || gain != m_gain) {
+        m_exposure_ms = exposureTimeMs;
+        m_gain = gain;
+        m_dirty = true;
+    }
+}
+
+size_t FrameGenerator::FrameBytes() const {
+    return static_cast<size_t>(m_width) * m_height * m_bytes_per_pixel;
+}
+
+void FrameGenerator::Render(uint64_t frameIndex, uint8_t* out) {
+    if (m_dirty) {
+        m_template = nullptr;  // Let the cache drop the old template first
+        m_template = AcquireTemplate();
+        PrepareNoise();
+        m_dirty = false;
+    }
+
+    if (m_bytes_per_pixel == 2) {
+        RenderFrame(frameIndex, reinterpret_cast<uint16_t*>(out));
+    } else {
+        // Wider pixels keep the historical 8-bit pattern in the first bytes
+        RenderFrame(frameIndex, out);
+    }
+}
+
+std::shared_ptr<const FrameTemplate> FrameGenerator::AcquireTemplate() const {
+    const bool phantom = m_config.pattern == FramePattern::Phantom;
+    const TemplateKey key{m_config.pattern, m_width, m_height, m_bytes_per_pixel,
+                          phantom ? m_exposure_ms : 0.0, phantom ? m_gain : 0.0};
+    return SharedTemplates().Acquire(key, [this](FrameTemplate& frame) {
+        if (m_bytes_per_pixel == 2) {
+            RenderTemplate<uint16_t>(frame);
+        } else {
+            RenderTemplate<uint8_t>(frame);
+        }
+        BuildDefects(frame);
+    });
+}
+
+template <typename Pixel>
+void FrameGenerator::RenderTemplate(FrameTemplate& out) const {
+    constexpr uint32_t kMax = std::numeric_limits<Pixel>::max();
+    const size_t pixelCount = static_cast<size_t>(m_width) * m_height;
+    out.pixels.assign(pixelCount * sizeof(Pixel), 0);
+    Pixel* pixels = reinterpret_cast<Pixel*>(out.pixels.data());
+    if (m_config.pattern == FramePattern::Phantom) {
+        RenderPhantom<Pixel>(out);
+        return;
+    }
+
+    for (uint32_t y = 0; y < m_height; ++y) {
+        Pixel* row = pixels + static_cast<size_t>(y) * m_width;
+        for (uint32_t x = 0; x < m_width; ++x) {
+            uint32_t value = 0;
+            switch (m_config.pattern) {
+                case FramePattern::Gradient:
+                    // Horizontal gradient with some vertical variation
+                    value = (x * kMax / m_width + y * ((kMax + 1) / 4) / m_height) % (kMax + 1);
+                    break;
+                case FramePattern::Checkerboard:
+                    value = (((x / 64) + (y / 64)) & 1) ? kMax / 4 * 3 : kMax / 4;
+                    break;
+                case FramePattern::Flat:
+                case FramePattern::Phantom:
+                    value = kMax / 2;
+                    break;
+            }
+            row[x] = static_cast<Pixel>(value);
+        }
+    }
+}
+
+template <typename Pixel>
+void FrameGenerator::RenderFrame(uint64_t frameIndex, Pixel* out) {
+    const size_t pixelCount = static_cast<size_t>(m_width) * m_height;
+    const Pixel* templ = reinterpret_cast<const Pixel*>(m_template->pixels.data());
+
+    switch (m_config.variation) {
+        case FrameVariation::None:
+            std::memcpy(out, templ, pixelCount * sizeof(Pixel));
+            break;
+
+        case FrameVariation::Offset: {
+            const Pixel offset = static_cast<Pixel>(frameIndex * m_config.step);
+            for (size_t i = 0; i < pixelCount; ++i) {
+                out[i] = static_cast<Pixel>(templ[i] + offset);
+            }
+            break;
+        }
+
+        case FrameVariation::Roll: {
+            const size_t shift = m_width ? static_cast<size_t>((frameIndex * m_config.step) % m_width) : 0;
+            const size_t tail = m_width - shift;
+            for (uint32_t y = 0; y < m_height; ++y) {
+                const Pixel* src = templ + static_cast<size_t>(y) * m_width;
+                Pixel* dst = out + static_cast<size_t>(y) * m_width;
+                std::memcpy(dst, src + shift, tail * sizeof(Pixel));
+                std::memcpy(dst + tail, src, shift * sizeof(Pixel));
+            }
+            break;
+        }
+    }
+
+    if (m_config.noise != FrameNoise::None && m_config.seed != 0) {
+        // Seeded noise depends on the frame number alone, not on which
+        // frames were rendered before
+        uint64_t frameSeed = m_config.seed + frameIndex * 0xD1B54A32D192ED03ull;
+        SeedNoise(SplitMix64(frameSeed));
+    }
+    if (m_config.noise == FrameNoise::Gaussian) {
+        AddNoise<Pixel, false>(out, pixelCount);
+    } else if (m_config.noise == FrameNoise::Poisson) {
+        AddNoise<Pixel, true>(out, pixelCount);
+    }
+    ApplyDefects(out);
+}
+
+template <typename Pixel>
+void FrameGenerator::RenderPhantom(FrameTemplate& out) const {
+    constexpr float kMax = static_cast<float>(std::numeric_limits<Pixel>::max());
+    const uint32_t width = m_width;
+    const uint32_t height = m_height;
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    Pixel* pixels = reinterpret_cast<Pixel*>(out.pixels.data());
+
+    const auto open = static_cast<float>(kMax * kOpenFraction * (m_exposure_ms / kReferenceExposureMs) * m_gain);
+    const float darkBase = kMax * kDarkFraction;
+
+    // Column artifacts: each readout block has its own gain, each column its own offset
+    std::vector<float> columnGain(width);
+    std::vector<float> columnDark(width);
+    uint64_t columnState = kPanelSeed;
+    float blockGain = 1.0f;
+    for (uint32_t x = 0; x < width; ++x) {
+        if (x % kReadoutBlock == 0) {
+            blockGain = 1.0f + kBlockGainSigma * UnitNormal(static_cast<uint32_t>(SplitMix64(columnState)));
+        }
+        columnGain[x] = blockGain;
+        columnDark[x] = darkBase * (1.0f + kColumnDarkSigma * UnitNormal(static_cast<uint32_t>(SplitMix64(columnState))));
+    }
+
+    // Rows are independent and seeded by index, so the result does not
+    // depend on how many threads rendered it
+    ForEachRowBand(height, pixelCount, [&](uint32_t firstRow, uint32_t lastRow) {
+        std::vector<float> attenuation(width);
+        for (uint32_t y = firstRow; y < lastRow; ++y) {
+            const float v = (y + 0.5f) / static_cast<float>(height) - 0.5f;
+            std::fill(attenuation.begin(), attenuation.end(), 0.0f);
+            for (const PhantomShape& shape : kPhantomShapes) {
+                AddShape(shape, v, width, attenuation.data());
+            }
+
+            uint64_t rowState = kPanelSeed ^ (static_cast<uint64_t>(y) << 32);
+            uint32_t state = static_cast<uint32_t>(SplitMix64(rowState)) | 1u;
+            const float heel = 1.0f - kHeel * (v + 0.5f);
+            Pixel* row = pixels + static_cast<size_t>(y) * width;
+            for (uint32_t x = 0; x < width; ++x) {
+                const float u = (x + 0.5f) / static_cast<float>(width) - 0.5f;
+                const float falloff = 1.0f - kFalloff * 2.0f * (u * u + v * v);
+                const float signal = open * heel * falloff * std::exp(-std::max(attenuation[x], 0.0f));
+                const float gain = columnGain[x] * (1.0f + kPixelGainSigma * UnitNormal(NextRandom(state)));
+                const float dark = columnDark[x] + darkBase * kPixelDarkSigma * UnitNormal(NextRandom(state));
+                row[x] = static_cast<Pixel>(std::clamp(dark + gain * signal + 0.5f, 0.0f, kMax));
+            }
+        }
+    });
+}
+
+template <typename Pixel>
+void FrameGenerator::ApplyDefects(Pixel* out) const {
+    for (uint32_t index : m_template->dead_pixels) {
+        out[index] = 0;
+    }
+    for (uint32_t index : m_template->hot_pixels) {
+        out[index] = std::numeric_limits<Pixel>::max();
+    }
+}
+
+void FrameGenerator::BuildDefects(FrameTemplate& out) const {
+    out.dead_pixels.clear();
+    out.hot_pixels.clear();
+    const size_t pixelCount = static_cast<size_t>(m_width) * m_height;
+    if (m_config.pattern != FramePattern::Phantom || pixelCount == 0) {
+        return;
+    }
+
+    uint64_t state = ~kPanelSeed;
+    for (size_t i = 0; i < pixelCount / kPixelsPerDeadPixel; ++i) {
+        out.dead_pixels.push_back(static_cast<uint32_t>(SplitMix64(state) % pixelCount));
+    }
+    for (size_t i = 0; i < pixelCount / kPixelsPerHotPixel; ++i) {
+        out.hot_pixels.push_back(static_cast<uint32_t>(SplitMix64(state) % pixelCount));
+    }
+
+    // A dead data line across the panel and a gate line dead up to mid-panel
+    if (m_width >= kMinLineDefectSize && m_height >= kMinLineDefectSize) {
+        const uint32_t column = m_width * 7 / 10;
+        for (uint32_t y = 0; y < m_height; ++y) {
+            out.dead_pixels.push_back(y * m_width + column);
+        }
+        const uint32_t row = m_height * 23 / 100;
+        for (uint32_t x = 0; x < m_width / 2; ++x) {
+            out.dead_pixels.push_back(row * m_width + x);
+        }
+    }
+}
+
+template <typename Pixel, bool kPoisson>
+void FrameGenerator::AddNoise(Pixel* out, size_t count) {
+    constexpr float kMax = static_cast<float>(std::numeric_limits<Pixel>::max());
+    const float level = m_noise_level;
+
+    // Eight independent generators per block, kept in locals so the whole
+    // loop body vectorizes: no table lookups, branches or library calls
+    uint32_t lanes[kLanes];
+    std::memcpy(lanes, m_lanes, sizeof(lanes));
+
+    const auto addNoise = [&](Pixel& pixel, uint32_t& state) {
+        const float value = pixel;
+        const float sigma = kPoisson ? std::min(FastSqrt(value * level), kMaxSigma) : level;
+        const float noisy = value + UnitNormal(NextRandom(state)) * sigma + 0.5f;
+        pixel = static_cast<Pixel>(std::clamp(noisy, 0.0f, kMax));
+    };
+
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            addNoise(out[i + lane], lanes[lane]);
+        }
+    }
+    for (size_t lane = 0; i < count; ++i, ++lane) {
+        addNoise(out[i], lanes[lane]);
+    }
+
+    std::memcpy(m_lanes, lanes, sizeof(lanes));
+}
+
+void FrameGenerator::SeedNoise(uint64_t seed) {
+    for (uint32_t& lane : m_lanes) {
+        lane = static_cast<uint32_t>(SplitMix64(seed)) | 1u;  // xorshift state must be nonzero
+    }
+}
+
+void FrameGenerator::PrepareNoise() {
+    if (m_config.seed == 0) {
+        SeedNoise(std::random_device{}());
+    }
+
+    double level = m_config.noise_level;
+    if (m_config.pattern == FramePattern::Phantom && level <= 0.0) {
+        // Counts per photon follow the detector gain, scaled to the pixel range
+        level = kCountsPerPhoton * m_gain * (m_bytes_per_pixel == 2 ? 1.0 : 255.0 / 65535.0);
+    }
+    m_noise_level = static_cast<float>(std::clamp(level, 0.0, static_cast<double>(kMaxSigma)));
+}
+
+} // namespace emul
+} // namespace adapters
+} // namespace uxdi
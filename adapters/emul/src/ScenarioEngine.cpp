@@ -1,29 +1,342 @@
 #include "ScenarioEngine.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/JsonReader.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <unordered_map>
 
 namespace uxdi {
 namespace adapters {
 namespace emul {
 
+// ============================================================================
+// Scenario Compiler
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Compiles the "actions" tree of a scenario into a flat program
+ *
+ * Blocks compile to counters and jumps:
+ *
+ *   repeat:  LoopBegin  <body>  LoopEnd(target = body)
+ *   sweep:   SweepBegin <body>  SweepEnd(target = body)
+ *   random:  Branch  <arm 0> Jump(end)  <arm 1> Jump(end) ...
+ *
+ * Entries that cannot run (unknown types, unknown states or errors, blocks
+ * with nothing to repeat) are dropped here, so the engine never has to
+ * skip or get stuck on them at run time. A trace that cannot be read fails
+ * the whole scenario instead, since replaying nothing would pass silently.
+ */
+class ScenarioCompiler {
+public:
+    ScenarioCompiler(Scenario& scenario, std::filesystem::path base_dir)
+        : m_scenario(scenario)
+        , m_base_dir(std::move(base_dir))
+    {
+        InternParameter("exposure_ms");
+        InternParameter("gain");
+    }
+
+    void CompileBlock(const JsonValue& actions) {
+        for (const JsonValue action : actions) {
+            CompileAction(action);
+        }
+    }
+
+    const std::string& GetError() const { return m_error; }
+
+private:
+    void CompileAction(const JsonValue& action) {
+        auto type_str = action["type"].AsString();
+        auto type = type_str ? stringToActionType(*type_str) : std::nullopt;
+        if (!type) {
+            return;  // Skip invalid and unknown actions
+        }
+
+        Instruction instruction;
+        switch (*type) {
+            case ActionType::Wait:
+                instruction.op = OpCode::Wait;
+                instruction.count = std::max<int64_t>(action["duration_ms"].AsInt().value_or(0), 0);
+                break;
+
+            case ActionType::SetState: {
+                auto state = stringToDetectorState(action["state"].AsString().value_or(""));
+                if (!state) {
+                    return;
+                }
+                instruction.op = OpCode::SetState;
+                instruction.state = *state;
+                break;
+            }
+
+            case ActionType::Acquire:
+                instruction.op = OpCode::Acquire;
+                instruction.count = std::max<int64_t>(action["count"].AsInt().value_or(0), 0);
+                instruction.value = std::max(action["interval_ms"].AsDouble().value_or(0.0), 0.0);
+                if (auto pacing = action["pacing"].AsString()) {
+                    instruction.pacing = stringToPacingPolicy(*pacing).value_or(PacingPolicy::CatchUp);
+                }
+                instruction.slot = CompileFaults(action["faults"]);
+                break;
+
+            case ActionType::InjectError: {
+                auto error = stringToErrorCode(action["error"].AsString().value_or(""));
+                if (!error) {
+                    return;
+                }
+                instruction.op = OpCode::InjectError;
+                instruction.error = *error;
+                instruction.value = action["probability"].AsDouble().value_or(0.0);
+                break;
+            }
+
+            case ActionType::SetParameter: {
+                auto parameter = action["parameter"].AsString();
+                if (!parameter) {
+                    return;
+                }
+                const JsonValue value = action["value"];
+                instruction.op = OpCode::SetParameter;
+                instruction.slot = InternParameter(*parameter);
+                instruction.constant = static_cast<uint32_t>(m_scenario.constants.size());
+                m_scenario.constants.push_back(
+                    value.IsNumber() ? std::string(value.Raw()) : value.AsString().value_or(""));
+                break;
+            }
+
+            case ActionType::Calibration:
+                instruction.op = OpCode::Calibration;
+                break;
+
+            case ActionType::Replay: {
+                auto trace = action["trace"].AsString();
+                if (!trace) {
+                    return;
+                }
+                auto slot = LoadTrace(*trace);
+                if (!slot) {
+                    return;
+                }
+                instruction.op = OpCode::Replay;
+                instruction.slot = *slot;
+                break;
+            }
+
+            case ActionType::Repeat:
+                CompileRepeat(action);
+                return;
+
+            case ActionType::Sweep:
+                CompileSweep(action);
+                return;
+
+            case ActionType::Random:
+                CompileRandom(action);
+                return;
+        }
+        m_scenario.program.push_back(instruction);
+    }
+
+    void CompileRepeat(const JsonValue& action) {
+        Instruction begin;
+        begin.op = OpCode::LoopBegin;
+        begin.slot = m_scenario.loop_count++;
+
+        Instruction end = begin;
+        end.op = OpCode::LoopEnd;
+        end.count = std::max<int64_t>(action["count"].AsInt().value_or(1), 0);
+
+        CompileLoop(begin, end, action["actions"]);
+    }
+
+    void CompileSweep(const JsonValue& action) {
+        auto parameter = action["parameter"].AsString();
+        const auto from = action["from"].AsDouble();
+        const auto to = action["to"].AsDouble();
+        const double step = action["step"].AsDouble().value_or(1.0);
+        if (!parameter || !from || !to || step == 0.0 || (*to - *from) / step < 0.0) {
+            return;
+        }
+
+        // Tolerate rounding so 0 to 1 by 0.1 includes 1
+        const double span = std::floor((*to - *from) / step + 1e-9);
+        if (!std::isfinite(span) || span >= static_cast<double>(std::numeric_limits<int64_t>::max())) {
+            return;
+        }
+
+        Instruction begin;
+        begin.op = OpCode::SweepBegin;
+        begin.slot = m_scenario.loop_count++;
+        begin.parameter = InternParameter(*parameter);
+        begin.value = *from;
+        begin.step = step;
+
+        Instruction end = begin;
+        end.op = OpCode::SweepEnd;
+        end.count = static_cast<int64_t>(span) + 1;
+
+        CompileLoop(begin, end, action["actions"]);
+    }
+
+    void CompileLoop(Instruction begin, Instruction end, const JsonValue& body) {
+        const size_t begin_pc = m_scenario.program.size();
+        m_scenario.program.push_back(begin);
+        const size_t body_pc = m_scenario.program.size();
+        CompileBlock(body);
+
+        if (m_scenario.program.size() == body_pc) {
+            // Nothing to repeat; an empty endless loop would only spin
+            m_scenario.program.resize(begin_pc);
+            return;
+        }
+        end.target = static_cast<uint32_t>(body_pc);
+        m_scenario.program.push_back(end);
+    }
+
+    void CompileRandom(const JsonValue& action) {
+        // Arms with no weight are never taken and need no code
+        std::vector<std::pair<double, JsonValue>> arms;
+        for (const JsonValue branch : action["branches"]) {
+            const double weight = branch["weight"].AsDouble().value_or(1.0);
+            if (weight > 0.0 && std::isfinite(weight)) {
+                arms.emplace_back(weight, branch["actions"]);
+            }
+        }
+        if (arms.empty()) {
+            return;
+        }
+
+        Instruction branch;
+        branch.op = OpCode::Branch;
+        branch.slot = static_cast<uint32_t>(m_scenario.branches.size());
+        branch.count = static_cast<int64_t>(arms.size());
+        m_scenario.program.push_back(branch);
+        m_scenario.branches.resize(m_scenario.branches.size() + arms.size());
+
+        std::vector<size_t> exits;
+        double cumulative = 0.0;
+        for (size_t i = 0; i < arms.size(); ++i) {
+            cumulative += arms[i].first;
+            BranchArm& arm = m_scenario.branches[branch.slot + i];
+            arm.cumulative_weight = cumulative;
+            arm.target = static_cast<uint32_t>(m_scenario.program.size());
+
+            CompileBlock(arms[i].second);
+            exits.push_back(m_scenario.program.size());
+            m_scenario.program.push_back(Instruction{});  // Jump, patched below
+        }
+
+        const auto end_pc = static_cast<uint32_t>(m_scenario.program.size());
+        for (size_t exit : exits) {
+            m_scenario.program[exit].target = end_pc;
+        }
+    }
+
+    // Index into Scenario::faults; 0 when the step injects nothing
+    uint32_t CompileFaults(const JsonValue& faults) {
+        if (!faults.IsObject()) {
+            return 0;
+        }
+        const auto read = [&](const char* key, double max) {
+            return std::clamp(faults[key].AsDouble().value_or(0.0), 0.0, max);
+        };
+        constexpr double kUnbounded = std::numeric_limits<double>::max();
+
+        FaultProfile profile;
+        profile.latency_ms = read("latency_ms", kUnbounded);
+        profile.latency_probability = profile.latency_ms > 0.0 ? read("latency_probability", 1.0) : 0.0;
+        profile.stall_ms = read("stall_ms", kUnbounded);
+        profile.stall_probability = profile.stall_ms > 0.0 ? read("stall_probability", 1.0) : 0.0;
+        profile.bandwidth_mbps = read("bandwidth_mbps", kUnbounded);
+        profile.drop_probability = read("drop_probability", 1.0);
+        profile.duplicate_probability = read("duplicate_probability", 1.0);
+        profile.reorder_probability = read("reorder_probability", 1.0);
+
+        if (profile.latency_probability == 0.0 && profile.stall_probability == 0.0 &&
+            profile.bandwidth_mbps == 0.0 && profile.drop_probability == 0.0 &&
+            profile.duplicate_probability == 0.0 && profile.reorder_probability == 0.0) {
+            return 0;
+        }
+        m_scenario.faults.push_back(profile);
+        return static_cast<uint32_t>(m_scenario.faults.size() - 1);
+    }
+
+    // Index into Scenario::traces; a trace replayed several times is read once
+    std::optional<uint32_t> LoadTrace(const std::string& name) {
+        std::filesystem::path path(name);
+        if (path.is_relative()) {
+            path = m_base_dir / path;
+        }
+        auto [it, inserted] = m_traces.try_emplace(
+            path.string(), static_cast<uint32_t>(m_scenario.traces.size()));
+        if (!inserted) {
+            return it->second;
+        }
+
+        std::vector<TimingEvent> events;
+        std::string error;
+        if (!TimingTraceRecorder::Read(path.string(), events, &error)) {
+            m_traces.erase(it);
+            if (m_error.empty()) {
+                m_error = "replay: " + error;
+            }
+            return std::nullopt;
+        }
+        m_scenario.traces.push_back(std::move(events));
+        return it->second;
+    }
+
+    uint32_t InternParameter(const std::string& name) {
+        auto [it, inserted] = m_slots.try_emplace(
+            name, static_cast<uint32_t>(m_scenario.parameter_names.size()));
+        if (inserted) {
+            m_scenario.parameter_names.push_back(name);
+        }
+        return it->second;
+    }
+
+    Scenario& m_scenario;
+    std::filesystem::path m_base_dir;      // Relative trace paths start here
+    std::unordered_map<std::string, uint32_t> m_slots;
+    std::unordered_map<std::string, uint32_t> m_traces;
+    std::string m_error;
+};
+
+std::string FormatParameter(double value) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return ec == std::errc() ? std::string(buffer, end) : std::string();
+}
+
+} // namespace
+
 // ============================================================================
 // ScenarioEngine Implementation
 // ============================================================================
 
 ScenarioEngine::ScenarioEngine()
     : m_rng(std::random_device{}())
-    , m_dist(0.0, 1.0)
 {
     m_context.current_state = DetectorState::IDLE;
     m_context.last_action_time = std::chrono::steady_clock::now();
+    m_replay_frames.reserve(3);  // A duplicate, a reordered frame and its successor's duplicate
 }
 
 bool ScenarioEngine::LoadScenario(const std::string& json_scenario) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return ParseScenario(json_scenario);
+    const bool loaded = ParseScenario(json_scenario);
+    PublishStatus();
+    return loaded;
 }
 
 bool ScenarioEngine::LoadScenarioFromFile(const std::string& file_path) {
@@ -31,22 +344,38 @@ bool ScenarioEngine::LoadScenarioFromFile(const std::string& file_path) {
 
     std::ifstream file(file_path);
     if (!file.is_open()) {
+        m_parse_error = "cannot open " + file_path;
         return false;
     }
 
     std::stringstream buffer;
     buffer << file.rdbuf();
-    return ParseScenario(buffer.str());
+    const bool loaded = ParseScenario(buffer.str(), std::filesystem::path(file_path).parent_path());
+    PublishStatus();
+    return loaded;
+}
+
+std::string ScenarioEngine::GetParseError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_parse_error;
 }
 
 void ScenarioEngine::Start() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_running = true;
-    m_context.current_action = 0;
+    m_paced_action = kNoAction;
+    m_pending_error.reset();
+    m_context.pc = 0;
     m_context.frames_generated = 0;
+    m_context.trace_event = 0;
+    m_context.trace_started = false;
     m_context.current_state = DetectorState::IDLE;
     m_context.waiting = false;
     m_context.last_action_time = std::chrono::steady_clock::now();
+    m_virtual_now_ns = 0;
+    SeedRandom();
+    ResetFaults();
+    PublishStatus();
 }
 
 void ScenarioEngine::Stop() {
@@ -56,87 +385,401 @@ void ScenarioEngine::Stop() {
 }
 
 std::optional<FrameData> ScenarioEngine::GetNextFrame() {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // The frame is generated ahead of its deadline, so generation time
+    // never shows up as delivery jitter
+    uint64_t deadlineNs = 0;
+    std::optional<FrameData> frame = PrepareNextFrame(deadlineNs);
+    if (m_virtual_clock.load(std::memory_order_relaxed)) {
+        return frame;  // Simulated time never waits
+    }
+
+    // A replayed state change or error is stepped on time, like a frame
+    while (!frame && deadlineNs != 0) {
+        UXDI_TRACE_SCOPE(Scenario, "scenario.paceEvent");
+        if (!DeadlinePacer::SleepUntil(deadlineNs, m_running)) {
+            return std::nullopt;
+        }
+        frame = PrepareNextFrame(deadlineNs);
+    }
+    if (!frame) {
+        return frame;
+    }
+    {
+        // A scenario that just completed still delivers the frames it prepared
+        UXDI_TRACE_SCOPE(Scenario, "scenario.pace");
+        if (!DeadlinePacer::SleepUntil(deadlineNs, m_running) && !IsComplete()) {
+            return std::nullopt;
+        }
+    }
+    StampTimestamp(*frame);
+    return frame;
+}
 
-    if (!m_running) {
+std::optional<FrameData> ScenarioEngine::PrepareNextFrame(uint64_t& deadlineNs) {
+    UXDI_ALLOC_SCOPE(Scenario);
+
+    deadlineNs = 0;
+    std::optional<uint64_t> frameNumber;
+    FaultProfile faults;
+    bool faulty = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_replay_frames.empty()) {
+            // A duplicated or reordered frame follows the previous one at once
+            std::optional<FrameData> frame = std::move(m_replay_frames.front());
+            m_replay_frames.erase(m_replay_frames.begin());
+            deadlineNs = NowNs();
+            if (m_virtual_clock.load(std::memory_order_relaxed)) {
+                AdvanceVirtualClock(*frame, deadlineNs);
+            }
+            PublishStatus();
+            return frame;
+        }
+
+        uint32_t faultSlot = 0;
+        frameNumber = AdvanceToNextFrame(deadlineNs, faultSlot);
+
+        // Dropped frames use up their number and slot but are never rendered
+        for (size_t drops = 0; frameNumber && faultSlot != 0 && drops < kMaxDropsPerCall &&
+                               ShouldInjectError(m_scenario.faults[faultSlot].drop_probability); ++drops) {
+            UXDI_TRACE_INSTANT(Scenario, "scenario.faultDrop", *frameNumber);
+            m_fault_stats.dropped++;
+            frameNumber = AdvanceToNextFrame(deadlineNs, faultSlot);
+        }
+        if (frameNumber && faultSlot != 0) {
+            faults = m_scenario.faults[faultSlot];
+            faulty = true;
+        }
+        PublishStatus();
+    }
+    if (!frameNumber) {
         return std::nullopt;
     }
 
-    ProcessWaiting();
+    // Pixels are rendered outside the step lock, so status readers and
+    // GetNextError() never wait for a frame
+    std::optional<FrameData> frame = GenerateFrame(*frameNumber);
+    if (faulty) {
+        frame = ApplyFaults(std::move(*frame), faults, deadlineNs);
+    }
+    if (frame && m_virtual_clock.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        AdvanceVirtualClock(*frame, deadlineNs);
+    }
+    return frame;
+}
+
+std::optional<FrameData> ScenarioEngine::ApplyFaults(FrameData frame, const FaultProfile& faults,
+                                                     uint64_t& deadlineNs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Frames due during a stall wait for it to end
+    deadlineNs = std::max(deadlineNs, m_stall_until_ns);
 
-    // Execute actions until we find an acquire action or run out of actions
-    while (m_context.current_action < m_scenario.actions.size()) {
-        auto action = GetCurrentAction();
-        if (!action) {
-            break;
+    if (ShouldInjectError(faults.latency_probability)) {
+        frame.injectedLatencyNs = static_cast<uint64_t>(faults.latency_ms * 1e6);
+        deadlineNs += frame.injectedLatencyNs;
+        m_fault_stats.delayed++;
+    }
+
+    if (faults.bandwidth_mbps > 0.0) {
+        // One frame on the link at a time; bits / (Mbit/s) = microseconds
+        const auto transferNs = static_cast<uint64_t>(
+            static_cast<double>(frame.dataLength) * 8e3 / faults.bandwidth_mbps);
+        if (m_link_free_ns > deadlineNs) {
+            deadlineNs = m_link_free_ns;
+            m_fault_stats.throttled++;
         }
+        deadlineNs += transferNs;
+        m_link_free_ns = deadlineNs;
+    }
 
-        if (action->type == ActionType::Acquire) {
-            // Generate frame
-            auto frame = GenerateFrame();
-            m_context.frames_generated++;
+    if (ShouldInjectError(faults.stall_probability)) {
+        UXDI_TRACE_INSTANT(Scenario, "scenario.faultStall", frame.frameNumber);
+        m_stall_until_ns = deadlineNs + static_cast<uint64_t>(faults.stall_ms * 1e6);
+        m_fault_stats.stalls++;
+    }
 
-            // Check if we've generated enough frames
-            if (action->count > 0 &&
-                static_cast<int>(m_context.frames_generated) >= action->count) {
-                m_context.frames_generated = 0;
-                m_context.current_action++;
-            }
+    // The last frame of a scenario has nothing to overtake it
+    const bool hasSuccessor = m_context.pc < m_scenario.program.size();
+    if (!m_holding_frame && hasSuccessor && ShouldInjectError(faults.reorder_probability)) {
+        // Deliver the next frame first; this one goes out right after it
+        m_holding_frame = true;
+        lock.unlock();
+
+        const uint64_t heldDeadlineNs = deadlineNs;
+        std::optional<FrameData> next = PrepareNextFrame(deadlineNs);
 
+        lock.lock();
+        m_holding_frame = false;
+        if (!next) {
+            deadlineNs = heldDeadlineNs;  // Waiting, stopped, erroring or done
             return frame;
         }
+        UXDI_TRACE_INSTANT(Scenario, "scenario.faultReorder", frame.frameNumber);
+        m_fault_stats.reordered++;
+        m_replay_frames.push_back(std::move(frame));
+        PublishStatus();
+        return next;
+    }
+
+    if (ShouldInjectError(faults.duplicate_probability)) {
+        UXDI_TRACE_INSTANT(Scenario, "scenario.faultDuplicate", frame.frameNumber);
+        m_fault_stats.duplicated++;
+        m_replay_frames.push_back(frame);
+        PublishStatus();
+    }
+    return frame;
+}
+
+void ScenarioEngine::AdvanceVirtualClock(FrameData& frame, uint64_t deadlineNs) {
+    // Delivering a frame moves simulated time to its deadline
+    m_virtual_now_ns = std::max(m_virtual_now_ns, deadlineNs);
+    frame.timestamp = static_cast<double>(m_virtual_now_ns - std::min(m_virtual_now_ns, frame.injectedLatencyNs)) * 1e-9;
+}
+
+void ScenarioEngine::ResetFaults() {
+    m_replay_frames.clear();
+    m_holding_frame = false;
+    m_link_free_ns = 0;
+    m_stall_until_ns = 0;
+    m_fault_stats = FaultStats{};
+}
+
+void ScenarioEngine::StampTimestamp(FrameData& frame) const {
+    if (m_virtual_clock.load(std::memory_order_relaxed)) {
+        return;
+    }
+    // A delayed frame keeps the time of its slot
+    frame.timestamp = std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count() -
+        static_cast<double>(frame.injectedLatencyNs) * 1e-9;
+}
+
+FaultStats ScenarioEngine::GetFaultStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fault_stats;
+}
+
+PacerStats ScenarioEngine::GetPacingStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pacer.GetStats();
+}
+
+std::optional<uint64_t> ScenarioEngine::AdvanceToNextFrame(uint64_t& deadlineNs, uint32_t& faults) {
+    if (!m_running || m_pending_error || ProcessWaiting()) {
+        return std::nullopt;
+    }
+
+    const std::vector<Instruction>& program = m_scenario.program;
+    ExecutionContext& context = m_context;
 
-        // Execute non-acquire actions
-        if (!ExecuteAction(*action)) {
+    // Run instructions up to the next frame, wait or error. The step budget
+    // bounds a call through an endless loop that never acquires
+    for (size_t steps = 0; steps < kMaxStepsPerCall; ++steps) {
+        if (context.pc >= program.size()) {
+            m_running = false;  // Scenario complete
             return std::nullopt;
         }
 
-        if (m_context.waiting) {
-            return std::nullopt;  // Waiting, no frame this time
+        const Instruction& instruction = program[context.pc];
+        if (instruction.op == OpCode::Acquire) {
+            // Each acquire step starts its own schedule with an immediate first frame
+            if (m_paced_action != context.pc) {
+                m_pacer.Configure(static_cast<uint64_t>(instruction.value * 1e6), instruction.pacing);
+                m_pacer.Start(NowNs());
+                m_paced_action = context.pc;
+            }
+            deadlineNs = m_pacer.NextDeadline(NowNs());
+            faults = instruction.slot;
+
+            const uint64_t frame_number = context.frames_generated++;
+
+            if (instruction.count > 0 &&
+                static_cast<int64_t>(context.frames_generated) >= instruction.count) {
+                context.frames_generated = 0;
+                context.pc++;
+                m_paced_action = kNoAction;  // A loop back here starts a new schedule
+            }
+            return frame_number;
         }
 
-        m_context.current_action++;
-    }
+        if (instruction.op == OpCode::Replay) {
+            // One trace event per step, so a burst of states and errors is
+            // bounded by the step budget like any other instruction
+            const std::vector<TimingEvent>& events = m_scenario.traces[instruction.slot];
+            if (!context.trace_started) {
+                context.trace_start_ns = NowNs();
+                context.trace_started = true;
+            }
+            if (context.trace_event >= events.size()) {
+                context.trace_event = 0;
+                context.trace_started = false;
+                context.pc++;
+                continue;
+            }
+
+            const TimingEvent& event = events[context.trace_event];
+            const uint64_t due_ns = context.trace_start_ns + event.offsetNs;
+            if (event.type == TimingEventType::Frame) {
+                deadlineNs = due_ns;
+                faults = 0;
+                if (++context.trace_event == events.size()) {
+                    context.trace_event = 0;
+                    context.trace_started = false;
+                    context.pc++;
+                }
+                return event.frameNumber;
+            }
 
-    // Scenario complete
-    if (m_context.current_action >= m_scenario.actions.size()) {
-        m_running = false;
+            // States and errors have deadlines too; the caller steps the
+            // scenario again when one falls due
+            const uint64_t now_ns = NowNs();
+            if (due_ns > now_ns && m_virtual_clock.load(std::memory_order_relaxed)) {
+                m_virtual_now_ns = due_ns;
+            } else if (due_ns > now_ns) {
+                deadlineNs = due_ns;
+                return std::nullopt;
+            }
+            context.trace_event++;
+
+            if (event.type == TimingEventType::StateChanged &&
+                event.code <= static_cast<uint32_t>(DetectorState::ERROR)) {
+                UXDI_TRACE_INSTANT(State, "scenario.setState", event.code);
+                context.current_state = static_cast<DetectorState>(event.code);
+            } else if (event.type == TimingEventType::Error && event.code != 0 &&
+                       event.code <= static_cast<uint32_t>(ErrorCode::OUT_OF_MEMORY)) {
+                m_pending_error = static_cast<ErrorCode>(event.code);
+                return std::nullopt;  // Delivered by GetNextError()
+            }
+            continue;
+        }
+
+        UXDI_TRACE_INSTANT(Scenario, "scenario.action", context.pc);
+        switch (instruction.op) {
+            case OpCode::Wait:
+                context.pc++;
+                if (instruction.count > 0 && m_virtual_clock.load(std::memory_order_relaxed)) {
+                    m_virtual_now_ns += static_cast<uint64_t>(instruction.count) * 1'000'000;
+                } else if (instruction.count > 0) {
+                    context.waiting = true;
+                    context.wait_start = std::chrono::steady_clock::now();
+                    context.wait_duration_ms = instruction.count;
+                    return std::nullopt;  // Waiting, no frame this time
+                }
+                break;
+
+            case OpCode::SetState:
+                UXDI_TRACE_INSTANT(State, "scenario.setState", static_cast<uint64_t>(instruction.state));
+                context.current_state = instruction.state;
+                context.pc++;
+                break;
+
+            case OpCode::InjectError:
+                context.pc++;
+                if (ShouldInjectError(instruction.value)) {
+                    m_pending_error = instruction.error;
+                    return std::nullopt;  // Delivered by GetNextError()
+                }
+                break;
+
+            case OpCode::SetParameter:
+                SetParameterSlot(instruction.slot, m_scenario.constants[instruction.constant]);
+                context.pc++;
+                break;
+
+            case OpCode::Calibration:
+                // Calibration is a no-op in emulation, just advance state
+                context.current_state = DetectorState::READY;
+                context.pc++;
+                break;
+
+            case OpCode::LoopBegin:
+                context.loop_counters[instruction.slot] = 0;
+                context.pc++;
+                break;
+
+            case OpCode::SweepBegin:
+                context.loop_counters[instruction.slot] = 0;
+                SetParameterSlot(instruction.parameter, FormatParameter(instruction.value));
+                context.pc++;
+                break;
+
+            case OpCode::LoopEnd:
+            case OpCode::SweepEnd: {
+                const int64_t done = ++context.loop_counters[instruction.slot];
+                if (instruction.count != 0 && done >= instruction.count) {
+                    context.pc++;
+                    break;
+                }
+                if (instruction.op == OpCode::SweepEnd) {
+                    SetParameterSlot(instruction.parameter,
+                                     FormatParameter(instruction.value + static_cast<double>(done) * instruction.step));
+                }
+                context.pc = instruction.target;
+                break;
+            }
+
+            case OpCode::Branch: {
+                const auto first = m_scenario.branches.begin() + instruction.slot;
+                const auto last = first + instruction.count;
+                const double pick = RollUnit() * (last - 1)->cumulative_weight;
+                auto arm = std::upper_bound(first, last, pick,
+                    [](double value, const BranchArm& candidate) { return value < candidate.cumulative_weight; });
+                context.pc = (arm != last ? arm : last - 1)->target;
+                break;
+            }
+
+            case OpCode::Jump:
+                context.pc = instruction.target;
+                break;
+
+            case OpCode::Acquire:
+            case OpCode::Replay:
+                break;  // Handled above
+        }
     }
 
     return std::nullopt;
 }
 
 DetectorState ScenarioEngine::GetCurrentState() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_context.current_state;
+    return m_state.load(std::memory_order_acquire);
 }
 
 std::optional<ErrorCode> ScenarioEngine::GetNextError() {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    UXDI_ALLOC_SCOPE(Scenario);
 
-    if (!m_running) {
+    // Called before every frame; only lock when an error step is due
+    if (!m_running || !m_error_due.load(std::memory_order_acquire)) {
         return std::nullopt;
     }
 
-    // Check current action for error injection
-    auto action = GetCurrentAction();
-    if (action && action->type == ActionType::InjectError) {
-        if (ShouldInjectError(action->probability)) {
-            auto error = stringToErrorCode(action->error);
-            if (error) {
-                m_context.current_action++;
-                return error;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending_error) {
+        auto error = m_pending_error;
+        m_pending_error.reset();
+        PublishStatus();
+        return error;
+    }
+
+    // An inject_error step reached before the next frame is rolled here
+    if (m_context.pc < m_scenario.program.size() && !m_context.waiting) {
+        const Instruction& instruction = m_scenario.program[m_context.pc];
+        if (instruction.op == OpCode::InjectError) {
+            m_context.pc++;
+            PublishStatus();
+            if (ShouldInjectError(instruction.value)) {
+                return instruction.error;
             }
         }
-        m_context.current_action++;
     }
 
     return std::nullopt;
 }
 
 bool ScenarioEngine::IsComplete() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_context.current_action >= m_scenario.actions.size();
+    return m_complete.load(std::memory_order_acquire);
 }
 
 const Scenario& ScenarioEngine::GetScenario() const {
@@ -146,125 +789,103 @@ const Scenario& ScenarioEngine::GetScenario() const {
 
 void ScenarioEngine::Reset() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_context.current_action = 0;
+    m_paced_action = kNoAction;
+    m_pending_error.reset();
+    m_context.pc = 0;
     m_context.frames_generated = 0;
+    m_context.trace_event = 0;
+    m_context.trace_started = false;
     m_context.current_state = DetectorState::IDLE;
     m_context.waiting = false;
-    m_context.parameters.clear();
+    m_context.parameters.assign(m_scenario.parameter_names.size(), std::string());
+    std::fill(m_context.loop_counters.begin(), m_context.loop_counters.end(), 0);
     m_context.last_action_time = std::chrono::steady_clock::now();
+    m_virtual_now_ns = 0;
+    SeedRandom();
+    ResetFaults();
+    PublishStatus();
 }
 
 void ScenarioEngine::SetFrameConfig(uint32_t width, uint32_t height, uint32_t bitDepth) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_generator_mutex);
     m_frame_width = width;
     m_frame_height = height;
     m_frame_bit_depth = bitDepth;
+    m_generator.SetFrameConfig(width, height, bitDepth);
+}
+
+void ScenarioEngine::SetExposure(double exposureTimeMs, double gain) {
+    std::lock_guard<std::mutex> lock(m_generator_mutex);
+    m_exposure_ms = exposureTimeMs;
+    m_gain = gain;
+    m_generator.SetExposure(exposureTimeMs, gain);
 }
 
 std::string ScenarioEngine::GetParameter(const std::string& name) const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_context.parameters.find(name);
-    return it != m_context.parameters.end() ? it->second : "";
+    const uint32_t slot = FindParameterSlot(name);
+    return slot < m_context.parameters.size() ? m_context.parameters[slot] : "";
 }
 
 void ScenarioEngine::SetParameter(const std::string& name, const std::string& value) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_context.parameters[name] = value;
+    uint32_t slot = FindParameterSlot(name);
+    if (slot == m_scenario.parameter_names.size()) {
+        m_scenario.parameter_names.push_back(name);
+    }
+    SetParameterSlot(slot, value);
 }
 
 // ============================================================================
 // Private Helper Methods
 // ============================================================================
 
-std::optional<ScenarioAction> ScenarioEngine::GetCurrentAction() const {
-    if (m_context.current_action < m_scenario.actions.size()) {
-        return m_scenario.actions[m_context.current_action];
-    }
-    return std::nullopt;
+uint32_t ScenarioEngine::FindParameterSlot(const std::string& name) const {
+    const auto& names = m_scenario.parameter_names;
+    return static_cast<uint32_t>(std::find(names.begin(), names.end(), name) - names.begin());
 }
 
-bool ScenarioEngine::ExecuteAction(const ScenarioAction& action) {
-    switch (action.type) {
-        case ActionType::Wait:
-            m_context.waiting = true;
-            m_context.wait_start = std::chrono::steady_clock::now();
-            m_context.wait_duration_ms = action.duration_ms;
-            return true;
+void ScenarioEngine::SetParameterSlot(uint32_t slot, std::string value) {
+    if (slot >= m_context.parameters.size()) {
+        m_context.parameters.resize(slot + 1);
+    }
 
-        case ActionType::SetState: {
-            auto state = stringToDetectorState(action.state);
-            if (state) {
-                m_context.current_state = *state;
-                return true;
-            }
-            return false;
+    // Exposure parameters also retune the generator, so a sweep over
+    // exposure_ms changes the rendered dose frame by frame
+    if (slot == Scenario::kExposureSlot || slot == Scenario::kGainSlot) {
+        char* end = nullptr;
+        const double number = std::strtod(value.c_str(), &end);
+        if (end != value.c_str() && number > 0.0) {
+            std::lock_guard<std::mutex> lock(m_generator_mutex);
+            (slot == Scenario::kExposureSlot ? m_exposure_ms : m_gain) = number;
+            m_generator.SetExposure(m_exposure_ms, m_gain);
         }
-
-        case ActionType::SetParameter:
-            m_context.parameters[action.parameter] = action.value;
-            return true;
-
-        case ActionType::Calibration:
-            // Calibration is a no-op in emulation, just advance state
-            m_context.current_state = DetectorState::READY;
-            return true;
-
-        case ActionType::Acquire:
-        case ActionType::InjectError:
-            // These are handled elsewhere
-            return true;
-
-        default:
-            return false;
     }
+    m_context.parameters[slot] = std::move(value);
 }
 
-FrameData ScenarioEngine::GenerateFrame() {
+FrameData ScenarioEngine::GenerateFrame(uint64_t frameNumber) {
+    UXDI_TRACE_SCOPE_ARG(Scenario, "scenario.GenerateFrame", frameNumber);
+    std::lock_guard<std::mutex> lock(m_generator_mutex);
+
     FrameData frame;
     frame.width = m_frame_width;
     frame.height = m_frame_height;
     frame.bitDepth = m_frame_bit_depth;
-    frame.frameNumber = static_cast<uint64_t>(m_context.frames_generated);
+    frame.frameNumber = frameNumber;
     frame.timestamp = std::chrono::duration<double>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
-    size_t pixel_count = static_cast<size_t>(frame.width) * frame.height;
-    size_t bytes_per_pixel = (frame.bitDepth + 7) / 8;
-    frame.dataLength = pixel_count * bytes_per_pixel;
-    frame.data = std::shared_ptr<uint8_t[]>(new uint8_t[frame.dataLength]);
-
-    // Generate gradient pattern for testing
-    if (bytes_per_pixel == 2) {
-        // 16-bit grayscale
-        uint16_t* pixels = reinterpret_cast<uint16_t*>(frame.data.get());
-        for (uint32_t y = 0; y < frame.height; ++y) {
-            for (uint32_t x = 0; x < frame.width; ++x) {
-                size_t idx = y * frame.width + x;
-                // Horizontal gradient with some vertical variation
-                uint16_t value = static_cast<uint16_t>(
-                    (x * 65535 / frame.width + y * 16384 / frame.height) % 65536);
-                pixels[idx] = value;
-            }
-        }
-    } else {
-        // 8-bit grayscale
-        uint8_t* pixels = frame.data.get();
-        for (uint32_t y = 0; y < frame.height; ++y) {
-            for (uint32_t x = 0; x < frame.width; ++x) {
-                size_t idx = y * frame.width + x;
-                uint8_t value = static_cast<uint8_t>(
-                    (x * 255 / frame.width + y * 64 / frame.height) % 256);
-                pixels[idx] = value;
-            }
-        }
-    }
+    frame.dataLength = m_generator.FrameBytes();
+    frame.data = m_frame_pool.Acquire(frame.dataLength);
+    m_generator.Render(frame.frameNumber, frame.data.get());
 
     return frame;
 }
 
-void ScenarioEngine::ProcessWaiting() {
+bool ScenarioEngine::ProcessWaiting() {
     if (!m_context.waiting) {
-        return;
+        return false;
     }
 
     auto now = std::chrono::steady_clock::now();
@@ -273,371 +894,126 @@ void ScenarioEngine::ProcessWaiting() {
 
     if (elapsed >= m_context.wait_duration_ms) {
         m_context.waiting = false;
-        m_context.current_action++;
     }
+    return m_context.waiting;
+}
+
+void ScenarioEngine::PublishStatus() {
+    const std::vector<Instruction>& program = m_scenario.program;
+    const bool at_end = m_context.pc >= program.size();
+    const bool error_step = !at_end && !m_context.waiting &&
+                            program[m_context.pc].op == OpCode::InjectError;
+
+    m_state.store(m_context.current_state, std::memory_order_release);
+    m_complete.store(at_end && !m_pending_error && m_replay_frames.empty(), std::memory_order_release);
+    m_error_due.store(m_pending_error.has_value() || error_step, std::memory_order_release);
 }
 
 bool ScenarioEngine::ShouldInjectError(double probability) const {
     if (probability <= 0.0) return false;
     if (probability >= 1.0) return true;
-    return m_dist(m_rng) < probability;
+    return RollUnit() < probability;
 }
 
-// ============================================================================
-// JSON Parsing - Minimal Parser for Scenario Format
-// ============================================================================
-
-bool ScenarioEngine::ParseScenario(const std::string& json) {
-    // Clear current scenario
-    m_scenario = Scenario();
-    m_context = ExecutionContext();
-
-    // Extract scenario name
-    auto name = ExtractString(json, "name");
-    if (name) {
-        m_scenario.name = *name;
-    } else {
-        m_scenario.name = "Unnamed Scenario";
-    }
-
-    // Extract description
-    auto desc = ExtractString(json, "description");
-    if (desc) {
-        m_scenario.description = *desc;
-    }
-
-    // Extract actions array
-    auto actions_json = ExtractArray(json, "actions");
-    if (actions_json.empty()) {
-        return true;  // Empty scenario is valid
-    }
-
-    // Parse each action
-    for (const auto& action_json : actions_json) {
-        ScenarioAction action;
-
-        // Extract action type
-        auto type_str = ExtractString(action_json, "type");
-        if (!type_str) {
-            continue;  // Skip invalid actions
-        }
-
-        auto type = stringToActionType(*type_str);
-        if (!type) {
-            continue;  // Skip unknown action types
-        }
-        action.type = *type;
-
-        // Extract action-specific fields
-        switch (action.type) {
-            case ActionType::Wait:
-                if (auto duration = ExtractInt(action_json, "duration_ms")) {
-                    action.duration_ms = *duration;
-                }
-                break;
-
-            case ActionType::SetState:
-                if (auto state = ExtractString(action_json, "state")) {
-                    action.state = *state;
-                }
-                break;
-
-            case ActionType::Acquire:
-                if (auto count = ExtractInt(action_json, "count")) {
-                    action.count = *count;
-                }
-                if (auto interval = ExtractInt(action_json, "interval_ms")) {
-                    action.interval_ms = *interval;
-                }
-                break;
-
-            case ActionType::InjectError:
-                if (auto error = ExtractString(action_json, "error")) {
-                    action.error = *error;
-                }
-                if (auto prob = ExtractDouble(action_json, "probability")) {
-                    action.probability = *prob;
-                }
-                break;
-
-            case ActionType::SetParameter:
-                if (auto param = ExtractString(action_json, "parameter")) {
-                    action.parameter = *param;
-                }
-                if (auto val = ExtractString(action_json, "value")) {
-                    action.value = *val;
-                }
-                break;
-
-            case ActionType::Calibration:
-                // Calibration has no additional parameters
-                break;
-        }
-
-        m_scenario.actions.push_back(action);
-    }
-
-    return true;
+double ScenarioEngine::RollUnit() const {
+    // 53 random bits from two draws, uniform in [0, 1)
+    const uint64_t high = m_rng() >> 5;
+    const uint64_t low = m_rng() >> 6;
+    return static_cast<double>((high << 26) | low) * 0x1.0p-53;
 }
 
-std::string ScenarioEngine::Trim(const std::string& str) const {
-    size_t start = 0;
-    while (start < str.length() && std::isspace(static_cast<unsigned char>(str[start]))) {
-        start++;
-    }
-
-    if (start == str.length()) {
-        return "";
-    }
-
-    size_t end = str.length() - 1;
-    while (end > start && std::isspace(static_cast<unsigned char>(str[end]))) {
-        end--;
-    }
-
-    return str.substr(start, end - start + 1);
-}
-
-std::optional<std::string> ScenarioEngine::ExtractString(
-    const std::string& json, const std::string& key) {
-
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-
-    if (key_pos == std::string::npos) {
-        return std::nullopt;
-    }
-
-    // Find colon after key
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) {
-        return std::nullopt;
-    }
-
-    // Find opening quote of value
-    size_t value_start = json.find('\"', colon_pos);
-    if (value_start == std::string::npos) {
-        return std::nullopt;
-    }
-    value_start++;  // Skip opening quote
-
-    // Find closing quote
-    size_t value_end = value_start;
-    bool escaped = false;
-    while (value_end < json.length()) {
-        if (escaped) {
-            escaped = false;
-            value_end++;
-            continue;
-        }
-        if (json[value_end] == '\\') {
-            escaped = true;
-            value_end++;
-            continue;
-        }
-        if (json[value_end] == '\"') {
-            break;
-        }
-        value_end++;
-    }
-
-    if (value_end >= json.length()) {
-        return std::nullopt;
-    }
-
-    std::string value = json.substr(value_start, value_end - value_start);
-    return UnescapeString(value);
+uint64_t ScenarioEngine::NowNs() const {
+    return m_virtual_clock.load(std::memory_order_relaxed) ? m_virtual_now_ns : MonotonicNowNs();
 }
 
-std::optional<int> ScenarioEngine::ExtractInt(
-    const std::string& json, const std::string& key) {
-
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-
-    if (key_pos == std::string::npos) {
-        return std::nullopt;
-    }
-
-    // Find colon after key
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) {
-        return std::nullopt;
-    }
-
-    // Skip whitespace after colon
-    size_t value_start = colon_pos + 1;
-    while (value_start < json.length() &&
-           std::isspace(static_cast<unsigned char>(json[value_start]))) {
-        value_start++;
-    }
-
-    // Parse integer
-    size_t value_end = value_start;
-    bool negative = false;
-    if (value_end < json.length() && json[value_end] == '-') {
-        negative = true;
-        value_end++;
-    }
-    while (value_end < json.length() &&
-           std::isdigit(static_cast<unsigned char>(json[value_end]))) {
-        value_end++;
-    }
-
-    if (value_end == value_start) {
-        return std::nullopt;
-    }
-
-    std::string value_str = json.substr(value_start, value_end - value_start);
-    try {
-        return std::stoi(value_str);
-    } catch (...) {
-        return std::nullopt;
+void ScenarioEngine::SeedRandom() {
+    // Unseeded scenarios keep rolling where the last run left off
+    if (m_scenario.seed != 0) {
+        std::seed_seq sequence{static_cast<uint32_t>(m_scenario.seed), static_cast<uint32_t>(m_scenario.seed >> 32)};
+        m_rng.seed(sequence);
     }
 }
 
-std::optional<double> ScenarioEngine::ExtractDouble(
-    const std::string& json, const std::string& key) {
-
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-
-    if (key_pos == std::string::npos) {
-        return std::nullopt;
-    }
+// ============================================================================
+// Scenario Parsing
+// ============================================================================
 
-    // Find colon after key
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) {
-        return std::nullopt;
+bool ScenarioEngine::ParseScenario(const std::string& json, const std::filesystem::path& base_dir) {
+    // Clear current scenario
+    m_scenario = Scenario();
+    m_context = ExecutionContext();
+    m_paced_action = kNoAction;
+    m_pending_error.reset();
+    m_parse_error.clear();
+    m_virtual_clock.store(false, std::memory_order_relaxed);
+    ResetFaults();
+
+    JsonDocument document;
+    if (!document.Parse(json)) {
+        m_parse_error = document.GetError().Format();
+        return false;
     }
-
-    // Skip whitespace after colon
-    size_t value_start = colon_pos + 1;
-    while (value_start < json.length() &&
-           std::isspace(static_cast<unsigned char>(json[value_start]))) {
-        value_start++;
+    const JsonValue root = document.Root();
+    if (!root.IsObject()) {
+        m_parse_error = "scenario must be a JSON object";
+        return false;
     }
 
-    // Parse double
-    size_t value_end = value_start;
-    bool negative = false;
-    if (value_end < json.length() && json[value_end] == '-') {
-        negative = true;
-        value_end++;
+    m_scenario.name = root["name"].AsString().value_or("Unnamed Scenario");
+    if (auto desc = root["description"].AsString()) {
+        m_scenario.description = *desc;
     }
-    while (value_end < json.length() &&
-           (std::isdigit(static_cast<unsigned char>(json[value_end])) ||
-            json[value_end] == '.')) {
-        value_end++;
+    if (auto seed = root["seed"].AsInt()) {
+        m_scenario.seed = static_cast<uint64_t>(std::max<int64_t>(*seed, 0));
     }
+    m_scenario.virtual_clock = root["clock"].AsString().value_or("") == "virtual";
 
-    if (value_end == value_start) {
-        return std::nullopt;
+    // Synthetic frame settings (all optional)
+    const JsonValue generator_json = root["generator"];
+    GeneratorConfig& generator = m_scenario.generator;
+    if (auto pattern = generator_json["pattern"].AsString()) {
+        generator.pattern = stringToFramePattern(*pattern).value_or(generator.pattern);
     }
-
-    std::string value_str = json.substr(value_start, value_end - value_start);
-    try {
-        return std::stod(value_str);
-    } catch (...) {
-        return std::nullopt;
+    if (auto variation = generator_json["variation"].AsString()) {
+        generator.variation = stringToFrameVariation(*variation).value_or(generator.variation);
     }
-}
-
-std::vector<std::string> ScenarioEngine::ExtractArray(
-    const std::string& json, const std::string& key) {
-
-    std::vector<std::string> result;
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-
-    if (key_pos == std::string::npos) {
-        return result;
+    if (auto noise = generator_json["noise"].AsString()) {
+        generator.noise = stringToFrameNoise(*noise).value_or(generator.noise);
+    } else if (generator.pattern == FramePattern::Phantom) {
+        generator.noise = FrameNoise::Poisson;  // Quantum noise unless asked otherwise
     }
-
-    // Find colon after key
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) {
-        return result;
+    if (auto level = generator_json["noise_level"].AsDouble()) {
+        generator.noise_level = *level;
     }
-
-    // Find opening bracket
-    size_t bracket_start = json.find('[', colon_pos);
-    if (bracket_start == std::string::npos) {
-        return result;
+    if (auto step = generator_json["step"].AsInt()) {
+        generator.step = static_cast<uint32_t>(std::clamp<int64_t>(*step, 0, UINT32_MAX));
     }
-
-    // Find matching closing bracket
-    int depth = 1;
-    size_t bracket_end = bracket_start + 1;
-    while (bracket_end < json.length() && depth > 0) {
-        if (json[bracket_end] == '[') depth++;
-        if (json[bracket_end] == ']') depth--;
-        bracket_end++;
+    if (auto seed = generator_json["seed"].AsInt()) {
+        generator.seed = static_cast<uint64_t>(std::max<int64_t>(*seed, 0));
+    } else {
+        generator.seed = m_scenario.seed;  // Noise follows the scenario seed
     }
-
-    if (depth != 0) {
-        return result;
+    {
+        std::lock_guard<std::mutex> lock(m_generator_mutex);
+        m_generator.Configure(generator);
     }
 
-    std::string array_content = json.substr(bracket_start + 1, bracket_end - bracket_start - 2);
-
-    // Extract objects from array
-    size_t pos = 0;
-    while (pos < array_content.length()) {
-        // Skip whitespace
-        while (pos < array_content.length() &&
-               std::isspace(static_cast<unsigned char>(array_content[pos]))) {
-            pos++;
-        }
-        if (pos >= array_content.length()) break;
-
-        // Find object start
-        if (array_content[pos] == '{') {
-            int obj_depth = 1;
-            size_t obj_start = pos;
-            size_t obj_end = pos + 1;
-
-            while (obj_end < array_content.length() && obj_depth > 0) {
-                if (array_content[obj_end] == '{') obj_depth++;
-                if (array_content[obj_end] == '}') obj_depth--;
-                obj_end++;
-            }
-
-            if (obj_depth == 0) {
-                result.push_back(array_content.substr(obj_start, obj_end - obj_start));
-                pos = obj_end;
-                continue;
-            }
-        }
-
-        pos++;
-    }
-
-    return result;
-}
-
-std::string ScenarioEngine::UnescapeString(const std::string& str) const {
-    std::string result;
-    result.reserve(str.length());
-
-    for (size_t i = 0; i < str.length(); ++i) {
-        if (str[i] == '\\' && i + 1 < str.length()) {
-            switch (str[i + 1]) {
-                case 'n': result += '\n'; break;
-                case 't': result += '\t'; break;
-                case 'r': result += '\r'; break;
-                case '\\': result += '\\'; break;
-                case '\"': result += '\"'; break;
-                default: result += str[i + 1]; break;
-            }
-            i++;
-        } else {
-            result += str[i];
-        }
+    // Actions; an absent or empty array is a valid, empty scenario
+    ScenarioCompiler compiler(m_scenario, base_dir);
+    compiler.CompileBlock(root["actions"]);
+    if (!compiler.GetError().empty()) {
+        m_parse_error = compiler.GetError();
+        m_scenario = Scenario();
+        return false;
     }
+    m_scenario.program.shrink_to_fit();
 
-    return result;
+    m_context.parameters.resize(m_scenario.parameter_names.size());
+    m_context.loop_counters.resize(m_scenario.loop_count);
+    m_virtual_clock.store(m_scenario.virtual_clock, std::memory_order_relaxed);
+    m_virtual_now_ns = 0;
+    SeedRandom();
+    return true;
 }
 
 } // namespace emul
@@ -4,9 +4,12 @@
 #include "uxdi/IDetectorListener.h"
 #include "uxdi/IDetectorSynchronous.h"
 #include "uxdi/Types.h"
+#include "uxdi/FrameBufferPool.h"
+#include "uxdi/FrameRateMeter.h"
 #include "varex_sdk.h"
 #include <memory>
 #include <mutex>
+#include <string>
 #include <atomic>
 
 namespace uxdi::adapters::varex {
@@ -22,7 +25,12 @@ class VarexDetector : public IDetector {
     friend class VarexDetectorSynchronous;
 
 public:
-    VarexDetector();
+    /**
+     * @brief Construct VarexDetector with SDK configuration
+     * @param config JSON configuration string passed to the SDK
+     *               Example: {"frame_rate": 200, "jitter": "normal", "jitter_ms": 1}
+     */
+    explicit VarexDetector(const std::string& config = "");
     virtual ~VarexDetector();
 
     // IDetector interface implementation
@@ -52,7 +60,12 @@ public:
     ErrorInfo getLastError() const override;
     void clearError() override;
 
+    DetectorStatistics getStatistics() const override;
+
 private:
+    // Configuration
+    std::string config_;
+
     // SDK handle
     VarexHandle sdkHandle_;
     std::mutex sdkMutex_;
@@ -80,6 +93,12 @@ private:
     // Synchronous interface
     std::shared_ptr<IDetectorSynchronous> syncInterface_;
 
+    // Delivered frame rate, throughput and listener callback time
+    FrameRateMeter frameRate_;
+
+    // Destination buffers for the mandatory copy of SDK frames
+    FrameBufferPool framePool_;
+
     // SDK callback bridges (static for C compatibility)
     static void imageCallbackBridge(const VarexImage* img, void* ctx);
     static void stateCallbackBridge(VarexState sdkState, void* ctx);
@@ -94,7 +113,7 @@ private:
     void setError(ErrorCode code, const std::string& message);
     void notifyStateChanged(DetectorState newState);
     void notifyError(const ErrorInfo& error);
-    void notifyImageReceived(const ImageData& image);
+    void notifyImageReceived(ImageData& image);  // Stamps image.latency.dispatchNs
     std::string stateToString(DetectorState state) const;
 
     // Error code mapping
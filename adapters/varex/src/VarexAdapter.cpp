@@ -1,4 +1,6 @@
 #include "VarexDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 
 using namespace uxdi::adapters::varex;
 
@@ -7,7 +9,9 @@ using namespace uxdi::adapters::varex;
 //=============================================================================
 
 // Export macros for adapter DLL
-#ifdef UXDI_VAREX_EXPORTS
+#if !defined(_WIN32)
+#define ADAPTER_API __attribute__((visibility("default")))
+#elif defined(UXDI_VAREX_EXPORTS)
 #define ADAPTER_API __declspec(dllexport)
 #else
 #define ADAPTER_API __declspec(dllimport)
@@ -19,16 +23,23 @@ extern "C" {
  * @brief Create a new VarexDetector instance
  *
  * This function is called by DetectorFactory to load the Varex adapter.
- * The config parameter is currently unused but reserved for future configuration.
+ * The config parameter is passed to the SDK, which reads mock frame
+ * timing options from it (see mock_frame_source.h).
+ *
+ * Config format examples:
+ * - {"frame_rate": 200}                       - 200 fps
+ * - {"jitter": "uniform", "jitter_ms": 2}     - +/- 2 ms per-frame jitter
+ * - {"burst": 8} or {"max_rate": true}        - Bursty or unthrottled delivery
+ * - "" or null                                - Native SDK rate
  *
  * @param config JSON configuration string (can be empty or null)
  * @return Pointer to IDetector interface, or nullptr on failure
  */
 ADAPTER_API uxdi::IDetector* CreateDetector(const char* config) {
-    (void)config;  // Config is reserved for future use
+    std::string configStr = config ? config : "";
 
     try {
-        auto* detector = new VarexDetector();
+        auto* detector = new VarexDetector(configStr);
 
         // Auto-initialize for convenience
         if (!detector->initialize()) {
@@ -64,4 +75,25 @@ ADAPTER_API void DestroyDetector(uxdi::IDetector* detector) {
     }
 }
 
+/**
+ * @brief Route this adapter's trace points to the host's recorder
+ *
+ * Called by DetectorFactory right after loading, since the adapter links its
+ * own copy of uxdi_core.
+ *
+ * @param recorder Host recorder, or nullptr to use the adapter's own
+ */
+ADAPTER_API void AttachTraceRecorder(uxdi::TraceRecorder* recorder) {
+    uxdi::TraceRecorder::Attach(recorder);
+}
+
+/**
+ * @brief Count this adapter's allocations in the host's tracker
+ *
+ * @param tracker Host tracker, or nullptr to use the adapter's own
+ */
+ADAPTER_API void AttachAllocationTracker(uxdi::AllocationTracker* tracker) {
+    uxdi::AllocationTracker::Attach(tracker);
+}
+
 } // extern "C"
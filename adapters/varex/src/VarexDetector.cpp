@@ -1,4 +1,6 @@
 #include "VarexDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 #include "varex_sdk.h"
 #include <cstring>
 #include <chrono>
@@ -11,8 +13,9 @@ using namespace uxdi::adapters::varex;
 // VarexDetector Implementation
 //=============================================================================
 
-VarexDetector::VarexDetector()
-    : sdkHandle_(nullptr)
+VarexDetector::VarexDetector(const std::string& config)
+    : config_(config)
+    , sdkHandle_(nullptr)
     , state_(DetectorState::IDLE)
     , initialized_(false)
     , sdkInitialized_(false)
@@ -70,8 +73,8 @@ bool VarexDetector::initialize() {
 
     state_ = DetectorState::INITIALIZING;
 
-    // Create SDK detector handle
-    VarexError err = Varex_CreateDetector("", &sdkHandle_);
+    // Create SDK detector handle with config
+    VarexError err = Varex_CreateDetector(config_.c_str(), &sdkHandle_);
     if (err != VAREX_OK || !sdkHandle_) {
         setError(mapVarexError(err), "Failed to create Varex detector");
         state_ = DetectorState::ERROR;
@@ -273,6 +276,8 @@ IDetectorListener* VarexDetector::getListener() const {
 }
 
 bool VarexDetector::startAcquisition() {
+    UXDI_TRACE_SCOPE(State, "varex.startAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -317,6 +322,8 @@ bool VarexDetector::startAcquisition() {
 }
 
 bool VarexDetector::stopAcquisition() {
+    UXDI_TRACE_SCOPE(State, "varex.stopAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -380,24 +387,34 @@ void VarexDetector::clearError() {
     lastError_.details.clear();
 }
 
+DetectorStatistics VarexDetector::getStatistics() const {
+    return frameRate_.GetStatistics();
+}
+
 //=============================================================================
 // Callback Bridges
 //=============================================================================
 
 void VarexDetector::imageCallbackBridge(const VarexImage* img, void* ctx) {
     if (!ctx || !img) return;
+    UXDI_TRACE_SCOPE_ARG(Callback, "varex.imageCallback", img->frameNumber);
+    UXDI_ALLOC_SCOPE(Adapter);
     auto* detector = static_cast<VarexDetector*>(ctx);
     detector->onImageReceived(img);
 }
 
 void VarexDetector::stateCallbackBridge(VarexState sdkState, void* ctx) {
     if (!ctx) return;
+    UXDI_TRACE_INSTANT(Callback, "varex.stateCallback", static_cast<uint64_t>(sdkState));
+    UXDI_ALLOC_SCOPE(Adapter);
     auto* detector = static_cast<VarexDetector*>(ctx);
     detector->onStateChanged(sdkState);
 }
 
 void VarexDetector::errorCallbackBridge(VarexError err, const char* msg, void* ctx) {
     if (!ctx) return;
+    UXDI_TRACE_INSTANT(Callback, "varex.errorCallback", static_cast<uint64_t>(err));
+    UXDI_ALLOC_SCOPE(Adapter);
     auto* detector = static_cast<VarexDetector*>(ctx);
     detector->onError(err, msg);
 }
@@ -409,10 +426,15 @@ void VarexDetector::errorCallbackBridge(VarexError err, const char* msg, void* c
 void VarexDetector::onImageReceived(const VarexImage* img) {
     if (!img) return;
 
+    // The SDK image carries no monotonic stamp, so delivery is stamped on callback entry
+    const uint64_t deliveredNs = MonotonicNowNs();
+
     // MANDATORY COPY: SDK owns the buffer, must copy immediately
     const size_t bufferBytes = img->dataLength;
-    auto buffer = std::shared_ptr<uint8_t[]>(new uint8_t[bufferBytes]);
+    UXDI_TRACE_BEGIN(Callback, "varex.copyFrame");
+    auto buffer = framePool_.Acquire(bufferBytes);
     std::memcpy(buffer.get(), img->data, bufferBytes);
+    UXDI_TRACE_END(Callback, "varex.copyFrame");
 
     // Create UXDI image structure
     ImageData image;
@@ -423,6 +445,8 @@ void VarexDetector::onImageReceived(const VarexImage* img) {
     image.timestamp = img->timestamp;
     image.data = buffer;
     image.dataLength = bufferBytes;
+    image.latency.sdkDeliveryNs = deliveredNs;
+    image.latency.adapterConvertedNs = MonotonicNowNs();
 
     notifyImageReceived(image);
 }
@@ -459,6 +483,8 @@ void VarexDetector::setError(ErrorCode code, const std::string& message) {
 }
 
 void VarexDetector::notifyStateChanged(DetectorState newState) {
+    UXDI_TRACE_INSTANT(State, "varex.stateChanged", static_cast<uint64_t>(newState));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -471,6 +497,8 @@ void VarexDetector::notifyStateChanged(DetectorState newState) {
 }
 
 void VarexDetector::notifyError(const ErrorInfo& error) {
+    UXDI_TRACE_INSTANT(State, "varex.error", static_cast<uint64_t>(error.code));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -482,15 +510,23 @@ void VarexDetector::notifyError(const ErrorInfo& error) {
     }
 }
 
-void VarexDetector::notifyImageReceived(const ImageData& image) {
+void VarexDetector::notifyImageReceived(ImageData& image) {
+    UXDI_TRACE_SCOPE_ARG(Dispatch, "varex.notifyImage", image.frameNumber);
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
         listener = listener_;
     }
 
+    const uint64_t dispatchNs = MonotonicNowNs();
+    frameRate_.RecordFrame(image.dataLength, dispatchNs);
+
     if (listener) {
+        image.latency.dispatchNs = dispatchNs;
+        UXDI_ALLOC_SCOPE(Listener);
         listener->onImageReceived(image);
+        frameRate_.RecordCallback(MonotonicNowNs() - dispatchNs);
     }
 }
 
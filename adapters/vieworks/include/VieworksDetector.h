@@ -4,9 +4,11 @@
 #include "uxdi/IDetectorListener.h"
 #include "uxdi/IDetectorSynchronous.h"
 #include "uxdi/Types.h"
+#include "uxdi/FrameRateMeter.h"
 #include "vieworks_sdk.h"
 #include <memory>
 #include <mutex>
+#include <string>
 #include <atomic>
 #include <thread>
 
@@ -23,7 +25,12 @@ class VieworksDetector : public IDetector {
     friend class VieworksDetectorSynchronous;
 
 public:
-    VieworksDetector();
+    /**
+     * @brief Construct VieworksDetector with SDK configuration
+     * @param config JSON configuration string passed to the SDK
+     *               Example: {"frame_rate": 200, "jitter": "normal", "jitter_ms": 1}
+     */
+    explicit VieworksDetector(const std::string& config = "");
     virtual ~VieworksDetector();
 
     // IDetector interface implementation
@@ -53,7 +60,12 @@ public:
     ErrorInfo getLastError() const override;
     void clearError() override;
 
+    DetectorStatistics getStatistics() const override;
+
 private:
+    // Configuration
+    std::string config_;
+
     // SDK handle
     VieworksHandle sdkHandle_;
     std::mutex sdkMutex_;
@@ -81,6 +93,9 @@ private:
     // Synchronous interface
     std::shared_ptr<IDetectorSynchronous> syncInterface_;
 
+    // Delivered frame rate, throughput and listener callback time
+    FrameRateMeter frameRate_;
+
     // Polling thread
     std::thread pollingThread_;
     std::atomic<bool> pollingActive_;
@@ -92,7 +107,7 @@ private:
     void setError(ErrorCode code, const std::string& message);
     void notifyStateChanged(DetectorState newState);
     void notifyError(const ErrorInfo& error);
-    void notifyImageReceived(const ImageData& image);
+    void notifyImageReceived(ImageData& image);  // Stamps image.latency.dispatchNs
     std::string stateToString(DetectorState state) const;
 
     // Error code mapping
@@ -1,4 +1,6 @@
 #include "VieworksDetector.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 #include "vieworks_sdk.h"
 #include <cstring>
 #include <chrono>
@@ -10,8 +12,9 @@ using namespace uxdi::adapters::vieworks;
 // VieworksDetector Implementation
 //=============================================================================
 
-VieworksDetector::VieworksDetector()
-    : sdkHandle_(nullptr)
+VieworksDetector::VieworksDetector(const std::string& config)
+    : config_(config)
+    , sdkHandle_(nullptr)
     , state_(DetectorState::IDLE)
     , initialized_(false)
     , sdkInitialized_(false)
@@ -78,8 +81,8 @@ bool VieworksDetector::initialize() {
 
     state_ = DetectorState::INITIALIZING;
 
-    // Create SDK detector handle
-    VieworksStatus status = Vieworks_CreateDetector("", &sdkHandle_);
+    // Create SDK detector handle with config
+    VieworksStatus status = Vieworks_CreateDetector(config_.c_str(), &sdkHandle_);
     if (status != VIEWORKS_OK || !sdkHandle_) {
         setError(mapVieworksError(status), "Failed to create Vieworks detector");
         state_ = DetectorState::ERROR;
@@ -265,6 +268,8 @@ IDetectorListener* VieworksDetector::getListener() const {
 }
 
 bool VieworksDetector::startAcquisition() {
+    UXDI_TRACE_SCOPE(State, "vieworks.startAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -315,6 +320,8 @@ bool VieworksDetector::startAcquisition() {
 }
 
 bool VieworksDetector::stopAcquisition() {
+    UXDI_TRACE_SCOPE(State, "vieworks.stopAcquisition");
+
     std::lock_guard<std::mutex> lock(stateMutex_);
 
     if (!initialized_) {
@@ -384,20 +391,40 @@ void VieworksDetector::clearError() {
     lastError_.details.clear();
 }
 
+DetectorStatistics VieworksDetector::getStatistics() const {
+    return frameRate_.GetStatistics();
+}
+
 //=============================================================================
 // Polling Thread
 //=============================================================================
 
 void VieworksDetector::pollingThreadFunc() {
+    UXDI_TRACE_THREAD_NAME("vieworks polling");
+    UXDI_ALLOC_SCOPE(Adapter);
+
     while (pollingActive_.load()) {
         int ready = 0;
-        VieworksStatus status = Vieworks_GetFrameReady(sdkHandle_, &ready);
+        VieworksStatus status;
+        {
+            UXDI_ALLOC_SCOPE(Sdk);
+            UXDI_TRACE_BEGIN(Acquisition, "vieworks.GetFrameReady");
+            status = Vieworks_GetFrameReady(sdkHandle_, &ready);
+            UXDI_TRACE_END(Acquisition, "vieworks.GetFrameReady");
+        }
 
         if (status == VIEWORKS_OK && ready) {
             VieworksFrame frame;
-            status = Vieworks_ReadFrame(sdkHandle_, &frame);
+            {
+                UXDI_ALLOC_SCOPE(Sdk);
+                UXDI_TRACE_BEGIN(Acquisition, "vieworks.ReadFrame");
+                status = Vieworks_ReadFrame(sdkHandle_, &frame);
+                UXDI_TRACE_END(Acquisition, "vieworks.ReadFrame");
+            }
 
             if (status == VIEWORKS_OK) {
+                const uint64_t deliveredNs = MonotonicNowNs();
+
                 // ZERO-COPY: SDK buffer is stable until next ReadFrame
                 // We can use the buffer directly without copying
                 ImageData image;
@@ -408,18 +435,18 @@ void VieworksDetector::pollingThreadFunc() {
                 image.timestamp = frame.timestamp;
                 image.dataLength = frame.dataLength;
 
-                // Create shared_ptr<uint8_t[]> with NOOP deleter (SDK owns the memory)
-                // Warning: This assumes the buffer is used before next ReadFrame
-                image.data = std::shared_ptr<uint8_t[]>(
-                    static_cast<uint8_t*>(frame.data),
-                    [](void*) { /* SDK owns memory, no deletion */ }
-                );
+                // Borrowed buffer (see ImageData): the SDK reuses it on the
+                // next ReadFrame, so listeners that keep the frame copy it
+                image.data = BorrowBuffer(frame.data);
+                image.latency.sdkDeliveryNs = deliveredNs;
+                image.latency.adapterConvertedNs = MonotonicNowNs();
 
                 notifyImageReceived(image);
+                continue;  // Drain queued frames before sleeping again
             }
         }
 
-        // Poll at ~100Hz (10ms interval)
+        // Poll at ~100Hz (10ms interval) while no frame is ready
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 }
@@ -436,6 +463,8 @@ void VieworksDetector::setError(ErrorCode code, const std::string& message) {
 }
 
 void VieworksDetector::notifyStateChanged(DetectorState newState) {
+    UXDI_TRACE_INSTANT(State, "vieworks.stateChanged", static_cast<uint64_t>(newState));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -448,6 +477,8 @@ void VieworksDetector::notifyStateChanged(DetectorState newState) {
 }
 
 void VieworksDetector::notifyError(const ErrorInfo& error) {
+    UXDI_TRACE_INSTANT(State, "vieworks.error", static_cast<uint64_t>(error.code));
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
@@ -459,15 +490,23 @@ void VieworksDetector::notifyError(const ErrorInfo& error) {
     }
 }
 
-void VieworksDetector::notifyImageReceived(const ImageData& image) {
+void VieworksDetector::notifyImageReceived(ImageData& image) {
+    UXDI_TRACE_SCOPE_ARG(Dispatch, "vieworks.notifyImage", image.frameNumber);
+
     IDetectorListener* listener = nullptr;
     {
         std::lock_guard<std::mutex> lock(listenerMutex_);
         listener = listener_;
     }
 
+    const uint64_t dispatchNs = MonotonicNowNs();
+    frameRate_.RecordFrame(image.dataLength, dispatchNs);
+
     if (listener) {
+        image.latency.dispatchNs = dispatchNs;
+        UXDI_ALLOC_SCOPE(Listener);
         listener->onImageReceived(image);
+        frameRate_.RecordCallback(MonotonicNowNs() - dispatchNs);
     }
 }
 
@@ -553,16 +592,17 @@ bool VieworksDetectorSynchronous::acquireFrame(ImageData& outImage, uint32_t tim
             if (Vieworks_GetFrameReady(detector_->sdkHandle_, &ready) == VIEWORKS_OK && ready) {
                 VieworksFrame frame;
                 if (Vieworks_ReadFrame(detector_->sdkHandle_, &frame) == VIEWORKS_OK) {
+                    outImage.latency = FrameTimestamps{};
+                    outImage.latency.sdkDeliveryNs = MonotonicNowNs();
                     outImage.width = frame.width;
                     outImage.height = frame.height;
                     outImage.bitDepth = frame.bitDepth;
                     outImage.frameNumber = frame.frameNumber;
                     outImage.timestamp = frame.timestamp;
                     outImage.dataLength = frame.dataLength;
-                    outImage.data = std::shared_ptr<uint8_t[]>(
-                        static_cast<uint8_t*>(frame.data),
-                        [](void*) { /* SDK owns memory */ }
-                    );
+                    outImage.data = BorrowBuffer(frame.data);  // SDK owns memory
+                    outImage.latency.adapterConvertedNs = MonotonicNowNs();
+                    detector_->frameRate_.RecordFrame(outImage.dataLength, outImage.latency.adapterConvertedNs);
                     return true;
                 }
             }
@@ -1,8 +1,24 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "uxdi/DetectorFactory.h"
 #include "uxdi/DetectorManager.h"
+#include "uxdi/FrameRecorder.h"
+#include "uxdi/FrameSequenceTracker.h"
 #include "uxdi/IDetector.h"
+#include "uxdi/IDetectorListener.h"
+#include "uxdi/MetricsRegistry.h"
+#include "uxdi/ProcessStats.h"
+#include "uxdi/TimingTrace.h"
+#include "uxdi/TraceRecorder.h"
 #include "uxdi/Types.h"
 
 #ifdef _WIN32
@@ -302,6 +318,572 @@ void SetAcquisitionParams(DetectorManager& manager, size_t detectorId) {
     }
 }
 
+// Recover a recording after a crash
+bool RecoverRecording(const std::string& path) {
+    PrintSection("Recovering Recording");
+    PrintInfo("Path: " + path);
+
+    RecoveryReport report;
+    if (!FrameRecorder::Recover(path, &report)) {
+        PrintError("Recording could not be recovered");
+        return false;
+    }
+
+    PrintSuccess("Recovered " + std::to_string(report.framesRecovered) + " frames");
+    std::cout << "  Journal: " << (report.journalFound ? "found" : "missing") << std::endl;
+    std::cout << "  From checkpoint: " << report.framesFromJournal << std::endl;
+    std::cout << "  Rescanned: " << report.framesRescanned
+              << " (" << report.bytesScanned << " bytes scanned)" << std::endl;
+    std::cout << "  Truncated: " << report.bytesTruncated << " bytes" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// Benchmark / Stress
+// ============================================================================
+
+// Counts frames and feeds the first listener's stream to a sequence tracker
+class LoadListener : public IDetectorListener {
+public:
+    explicit LoadListener(bool trackSequence) : m_trackSequence(trackSequence) {}
+
+    void onImageReceived(const ImageData& image) override {
+        const uint64_t nowNs = MonotonicNowNs();
+        if (m_trackSequence) {
+            m_sequence.Record(image.frameNumber, nowNs);
+        }
+        uint64_t expected = 0;
+        m_firstFrameNs.compare_exchange_strong(expected, nowNs, std::memory_order_relaxed);
+        m_lastFrameNs.store(nowNs, std::memory_order_relaxed);
+        m_bytes.fetch_add(image.dataLength, std::memory_order_relaxed);
+        m_frames.fetch_add(1, std::memory_order_release);
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override { m_errors.fetch_add(1, std::memory_order_relaxed); }
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+
+    uint64_t GetFrames() const { return m_frames.load(std::memory_order_acquire); }
+    uint64_t GetBytes() const { return m_bytes.load(std::memory_order_relaxed); }
+    uint64_t GetErrors() const { return m_errors.load(std::memory_order_relaxed); }
+    uint64_t GetFirstFrameNs() const { return m_firstFrameNs.load(std::memory_order_relaxed); }
+    uint64_t GetLastFrameNs() const { return m_lastFrameNs.load(std::memory_order_relaxed); }
+    FrameSequenceStats GetSequenceStats() const { return m_sequence.GetStats(); }
+
+private:
+    const bool m_trackSequence;
+    FrameSequenceTracker m_sequence;
+    std::atomic<uint64_t> m_frames{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_errors{0};
+    std::atomic<uint64_t> m_firstFrameNs{0};
+    std::atomic<uint64_t> m_lastFrameNs{0};
+};
+
+// Options shared by --bench and --soak
+struct LoadOptions {
+    std::vector<std::string> adapters;
+    uint64_t frames = 1000;       // --bench: frames to receive
+    double durationSec = 60.0;    // --soak: run time
+    double reportSec = 10.0;      // --soak: progress report interval
+    double timeoutSec = 0.0;      // --bench: 0 = derived from frames and rate
+    double rate = 0.0;            // Frames per second; 0 = adapter default
+    bool maxRate = false;
+    uint32_t listeners = 1;
+    std::string config;           // Replaces the generated adapter config
+    std::string jsonPath;
+    std::string timingTracePath;  // Record each detector's timing for replay
+    bool allowDrops = false;
+};
+
+// One detector under load and the listeners attached to it
+struct LoadTarget {
+    std::string adapter;
+    std::string config;
+    size_t detectorId = 0;
+    std::vector<std::unique_ptr<LoadListener>> listeners;
+    std::string timingTracePath;
+    std::unique_ptr<TimingTraceRecorder> timingTrace;
+    uint64_t startNs = 0;
+};
+
+// Parse "30", "30s", "5m" or "2h" into seconds; negative on error
+double ParseDuration(const std::string& text) {
+    try {
+        size_t used = 0;
+        const double value = std::stod(text, &used);
+        const std::string suffix = text.substr(used);
+        if (suffix.empty() || suffix == "s") {
+            return value;
+        }
+        if (suffix == "m") {
+            return value * 60.0;
+        }
+        if (suffix == "h") {
+            return value * 3600.0;
+        }
+    } catch (const std::exception&) {
+    }
+    return -1.0;
+}
+
+// Directory of the running executable, where the adapter libraries are built
+std::string ExecutableDirectory() {
+#ifdef _WIN32
+    char path[MAX_PATH] = {};
+    const DWORD length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+    std::string exePath(path, length);
+#else
+    char path[4096] = {};
+    const ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    std::string exePath(path, length > 0 ? static_cast<size_t>(length) : 0);
+#endif
+    const size_t slash = exePath.find_last_of("/\\");
+    return slash == std::string::npos ? std::string(".") : exePath.substr(0, slash);
+}
+
+// Short adapter names ("abyz", "emul", ...) resolve to the library next to the CLI
+std::string ResolveAdapterPath(const std::string& adapter) {
+    if (adapter.find_first_of("/\\.") != std::string::npos) {
+        return adapter;
+    }
+#ifdef _WIN32
+    return ExecutableDirectory() + "\\uxdi_" + adapter + ".dll";
+#else
+    return ExecutableDirectory() + "/libuxdi_" + adapter + ".so";
+#endif
+}
+
+// Short name of an adapter argument: "build/bin/libuxdi_varex.so" -> "varex"
+std::string AdapterKind(const std::string& adapter) {
+    const size_t slash = adapter.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? adapter : adapter.substr(slash + 1);
+    const size_t prefix = name.find("uxdi_");
+    if (prefix != std::string::npos) {
+        name = name.substr(prefix + 5);
+    }
+    return name.substr(0, name.find('.'));
+}
+
+// Adapter config that runs continuous acquisition at the requested rate
+std::string LoadConfig(const std::string& kind, const LoadOptions& options) {
+    if (!options.config.empty()) {
+        return options.config;
+    }
+    if (kind == "emul") {
+        const double intervalMs = (options.maxRate || options.rate <= 0.0) ? 0.0 : 1000.0 / options.rate;
+        return R"({"scenario": {"name": "load", "actions": [)"
+               R"({"type": "set_state", "state": "acquiring"},)"
+               R"({"type": "acquire", "count": 0, "interval_ms": )" + std::to_string(intervalMs) + "}]}}";
+    }
+    if (kind == "abyz" || kind == "varex" || kind == "vieworks") {
+        if (options.maxRate) {
+            return R"({"max_rate": true})";
+        }
+        if (options.rate > 0.0) {
+            return R"({"frame_rate": )" + std::to_string(options.rate) + "}";
+        }
+    }
+    return "";
+}
+
+// Parse the options following --bench/--soak, starting at argv[first]
+bool ParseLoadOptions(int argc, char* argv[], int first, LoadOptions& options) {
+    for (int i = first; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--allow-drops") {
+            options.allowDrops = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            PrintError("Missing value for " + arg);
+            return false;
+        }
+        const std::string value = argv[++i];
+        try {
+            if (arg == "--adapter") {
+                options.adapters.push_back(value);
+            } else if (arg == "--frames") {
+                options.frames = std::stoull(value);
+            } else if (arg == "--rate") {
+                options.maxRate = (value == "max");
+                options.rate = options.maxRate ? 0.0 : std::stod(value);
+            } else if (arg == "--listeners") {
+                options.listeners = static_cast<uint32_t>(std::max(1ul, std::stoul(value)));
+            } else if (arg == "--report") {
+                options.reportSec = ParseDuration(value);
+            } else if (arg == "--timeout") {
+                options.timeoutSec = ParseDuration(value);
+            } else if (arg == "--config") {
+                options.config = value;
+            } else if (arg == "--json") {
+                options.jsonPath = value;
+            } else if (arg == "--timing-trace") {
+                options.timingTracePath = value;
+            } else {
+                PrintError("Unknown option: " + arg);
+                return false;
+            }
+        } catch (const std::exception&) {
+            PrintError("Invalid value for " + arg + ": " + value);
+            return false;
+        }
+    }
+    if (options.reportSec <= 0.0 || options.timeoutSec < 0.0) {
+        PrintError("Invalid duration");
+        return false;
+    }
+    return true;
+}
+
+// Load the adapter, create and initialize a detector and attach the listeners
+bool StartLoadTarget(DetectorManager& manager, LoadTarget& target, const LoadOptions& options) {
+    target.config = LoadConfig(AdapterKind(target.adapter), options);
+
+    const size_t adapterId = LoadAdapter(ResolveAdapterPath(target.adapter));
+    if (adapterId == 0) {
+        return false;
+    }
+    target.detectorId = CreateDetector(manager, adapterId, target.config);
+    IDetector* detector = manager.GetDetector(target.detectorId);
+    if (!detector) {
+        return false;
+    }
+    if (!detector->isInitialized() && !detector->initialize()) {
+        PrintError("Failed to initialize " + target.adapter);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < options.listeners; ++i) {
+        target.listeners.push_back(std::make_unique<LoadListener>(i == 0));
+        ListenerOptions listenerOptions;
+        listenerOptions.name = "load-" + std::to_string(i);
+        manager.AddListener(target.detectorId, target.listeners.back().get(), listenerOptions);
+    }
+
+    if (!target.timingTracePath.empty()) {
+        target.timingTrace = std::make_unique<TimingTraceRecorder>();
+        if (!target.timingTrace->Open(target.timingTracePath)) {
+            PrintError(target.timingTrace->GetLastError().message);
+            return false;
+        }
+        ListenerOptions listenerOptions;
+        listenerOptions.name = "timing-trace";
+        manager.AddListener(target.detectorId, target.timingTrace.get(), listenerOptions);
+    }
+
+    target.startNs = MonotonicNowNs();
+    if (!detector->startAcquisition()) {
+        PrintError("Failed to start acquisition on " + target.adapter);
+        return false;
+    }
+    return true;
+}
+
+// Stop acquisition and release the detector before its listeners go away
+void StopLoadTargets(DetectorManager& manager, std::vector<LoadTarget>& targets) {
+    for (LoadTarget& target : targets) {
+        if (IDetector* detector = manager.GetDetector(target.detectorId)) {
+            detector->stopAcquisition();
+        }
+    }
+    for (LoadTarget& target : targets) {
+        if (target.detectorId != 0) {
+            manager.DestroyDetector(target.detectorId);
+        }
+    }
+    for (LoadTarget& target : targets) {
+        if (!target.timingTrace) {
+            continue;
+        }
+        if (target.timingTrace->Close()) {
+            PrintInfo("Timing trace: " + std::to_string(target.timingTrace->GetEventCount()) +
+                      " events written to " + target.timingTracePath);
+        } else {
+            PrintError(target.timingTrace->GetLastError().message);
+        }
+    }
+    DetectorFactory::UnloadAllAdapters();
+}
+
+uint64_t LoadErrors(const LoadTarget& target) {
+    return target.listeners.empty() ? 0 : target.listeners.front()->GetErrors();
+}
+
+// Frame rate between the first and the last received frame
+double LoadFps(const LoadListener& listener) {
+    const uint64_t frames = listener.GetFrames();
+    const uint64_t spanNs = listener.GetLastFrameNs() - listener.GetFirstFrameNs();
+    return (frames > 1 && spanNs > 0) ? (frames - 1) * 1e9 / spanNs : 0.0;
+}
+
+std::string FormatUs(uint64_t ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << ns / 1000.0 << " us";
+    return out.str();
+}
+
+// Human-readable results for one detector
+void PrintLoadTarget(DetectorManager& manager, const LoadTarget& target) {
+    const LoadListener& listener = *target.listeners.front();
+    const FrameSequenceStats sequence = listener.GetSequenceStats();
+    const LatencyStats latency = manager.GetLatencyStats(target.detectorId);
+    const double fps = LoadFps(listener);
+    const double spanSec = (listener.GetLastFrameNs() - listener.GetFirstFrameNs()) / 1e9;
+
+    std::cout << "  " << target.adapter << " (detector " << target.detectorId << ", "
+              << target.listeners.size() << " listeners)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "    Frames:      " << listener.GetFrames() << " at " << fps << " fps, "
+              << (spanSec > 0.0 ? listener.GetBytes() / spanSec / 1e6 : 0.0) << " MB/s" << std::endl;
+    std::cout << "    Continuity:  " << sequence.dropped << " dropped, " << sequence.duplicated
+              << " duplicated, " << sequence.outOfOrder << " out of order, "
+              << LoadErrors(target) << " errors" << std::endl;
+    std::cout << "    End-to-end:  p50 " << FormatUs(latency.endToEnd.p50Ns)
+              << ", p99 " << FormatUs(latency.endToEnd.p99Ns)
+              << ", max " << FormatUs(latency.endToEnd.maxNs) << std::endl;
+    std::cout << "    Callback:    p50 " << FormatUs(latency.listenerCallback.p50Ns)
+              << ", p99 " << FormatUs(latency.listenerCallback.p99Ns)
+              << ", max " << FormatUs(latency.listenerCallback.maxNs) << std::endl;
+    std::cout << "    Interval:    p50 " << FormatUs(sequence.interval.p50Ns)
+              << ", p99 " << FormatUs(sequence.interval.p99Ns)
+              << ", stddev " << FormatUs(static_cast<uint64_t>(sequence.intervalStdDevNs)) << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+std::string JsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string JsonLatency(const LatencySummary& summary) {
+    std::ostringstream out;
+    out << "{\"count\": " << summary.count << ", \"min\": " << summary.minNs
+        << ", \"p50\": " << summary.p50Ns << ", \"p99\": " << summary.p99Ns
+        << ", \"p999\": " << summary.p999Ns << ", \"max\": " << summary.maxNs << "}";
+    return out.str();
+}
+
+// Machine-readable results of a run; latencies are in nanoseconds
+bool WriteLoadJson(const std::string& path, const std::string& mode, DetectorManager& manager,
+                   const std::vector<LoadTarget>& targets, double wallSec,
+                   const ProcessStats& before, const ProcessStats& after, bool passed) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    const double cpuSec = (after.cpuTimeNs - before.cpuTimeNs) / 1e9;
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"mode\": \"" << mode << "\",\n";
+    out << "  \"passed\": " << (passed ? "true" : "false") << ",\n";
+    out << "  \"wall_s\": " << wallSec << ",\n";
+    out << "  \"cpu_s\": " << cpuSec << ",\n";
+    out << "  \"cpu_percent\": " << (wallSec > 0.0 ? 100.0 * cpuSec / wallSec : 0.0) << ",\n";
+    out << "  \"peak_rss_bytes\": " << after.peakResidentBytes << ",\n";
+    out << "  \"threads\": " << after.threadCount << ",\n";
+    out << "  \"detectors\": [";
+    for (size_t i = 0; i < targets.size(); ++i) {
+        const LoadTarget& target = targets[i];
+        const LoadListener& listener = *target.listeners.front();
+        const FrameSequenceStats sequence = listener.GetSequenceStats();
+        const LatencyStats latency = manager.GetLatencyStats(target.detectorId);
+        const double spanSec = (listener.GetLastFrameNs() - listener.GetFirstFrameNs()) / 1e9;
+
+        out << (i == 0 ? "\n" : ",\n") << "    {\n";
+        out << "      \"adapter\": \"" << JsonEscape(target.adapter) << "\",\n";
+        out << "      \"config\": \"" << JsonEscape(target.config) << "\",\n";
+        out << "      \"listeners\": " << target.listeners.size() << ",\n";
+        out << "      \"frames\": " << listener.GetFrames() << ",\n";
+        out << "      \"bytes\": " << listener.GetBytes() << ",\n";
+        out << "      \"fps\": " << LoadFps(listener) << ",\n";
+        out << "      \"mb_per_s\": " << (spanSec > 0.0 ? listener.GetBytes() / spanSec / 1e6 : 0.0) << ",\n";
+        out << "      \"first_frame_ms\": "
+            << (listener.GetFirstFrameNs() ? (listener.GetFirstFrameNs() - target.startNs) / 1e6 : 0.0) << ",\n";
+        out << "      \"dropped\": " << sequence.dropped << ",\n";
+        out << "      \"duplicated\": " << sequence.duplicated << ",\n";
+        out << "      \"out_of_order\": " << sequence.outOfOrder << ",\n";
+        out << "      \"errors\": " << LoadErrors(target) << ",\n";
+        out << "      \"latency_ns\": {\n";
+        out << "        \"end_to_end\": " << JsonLatency(latency.endToEnd) << ",\n";
+        out << "        \"sdk_to_adapter\": " << JsonLatency(latency.sdkToAdapter) << ",\n";
+        out << "        \"listener_callback\": " << JsonLatency(latency.listenerCallback) << ",\n";
+        out << "        \"frame_interval\": " << JsonLatency(sequence.interval) << "\n";
+        out << "      }\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Shared tail of --bench and --soak: resource usage, verdict and JSON
+int FinishLoadRun(const std::string& mode, DetectorManager& manager, std::vector<LoadTarget>& targets,
+                  const LoadOptions& options, double wallSec, const ProcessStats& before, bool completed) {
+    const ProcessStats after = SampleProcessStats();
+    const double cpuSec = (after.cpuTimeNs - before.cpuTimeNs) / 1e9;
+
+    bool passed = completed;
+    for (const LoadTarget& target : targets) {
+        const LoadListener& listener = *target.listeners.front();
+        const FrameSequenceStats sequence = listener.GetSequenceStats();
+        if (listener.GetFrames() == 0 || LoadErrors(target) != 0 ||
+            (!options.allowDrops && sequence.dropped != 0)) {
+            passed = false;
+        }
+    }
+
+    PrintSection("Results");
+    for (const LoadTarget& target : targets) {
+        PrintLoadTarget(manager, target);
+    }
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Process: " << wallSec << " s wall, " << cpuSec << " s CPU ("
+              << (wallSec > 0.0 ? 100.0 * cpuSec / wallSec : 0.0) << "% of one core), peak RSS "
+              << after.peakResidentBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+
+    if (!options.jsonPath.empty()) {
+        if (WriteLoadJson(options.jsonPath, mode, manager, targets, wallSec, before, after, passed)) {
+            PrintInfo("JSON report written to " + options.jsonPath);
+        } else {
+            PrintError("Failed to write JSON report to " + options.jsonPath);
+            passed = false;
+        }
+    }
+
+    StopLoadTargets(manager, targets);
+    if (passed) {
+        PrintSuccess(mode + " passed");
+    } else {
+        PrintError(mode + (completed ? " failed: frames dropped or errors reported" : " failed: timed out"));
+    }
+    return passed ? 0 : 1;
+}
+
+// --bench <adapter>: time the delivery of a fixed number of frames
+int RunBench(DetectorManager& manager, int argc, char* argv[]) {
+    LoadOptions options;
+    if (argc < 3 || !ParseLoadOptions(argc, argv, 3, options)) {
+        PrintError("Usage: --bench <adapter> [--frames N] [--rate R|max] [--listeners K] [--json <path>]");
+        return 1;
+    }
+    double timeoutSec = options.timeoutSec;
+    if (timeoutSec == 0.0) {
+        timeoutSec = 10.0 + (options.rate > 0.0 ? 2.0 * options.frames / options.rate : 60.0);
+    }
+
+    std::vector<LoadTarget> targets(1);
+    targets.front().adapter = argv[2];
+    targets.front().timingTracePath = options.timingTracePath;
+    PrintSection("Benchmark");
+    const ProcessStats before = SampleProcessStats();
+    const uint64_t startNs = MonotonicNowNs();
+    if (!StartLoadTarget(manager, targets.front(), options)) {
+        StopLoadTargets(manager, targets);
+        return 1;
+    }
+    PrintInfo("Waiting for " + std::to_string(options.frames) + " frames...");
+
+    const LoadListener& listener = *targets.front().listeners.front();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSec);
+    bool completed = true;
+    while (listener.GetFrames() < options.frames) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            completed = false;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (IDetector* detector = manager.GetDetector(targets.front().detectorId)) {
+        detector->stopAcquisition();
+    }
+
+    const double wallSec = (MonotonicNowNs() - startNs) / 1e9;
+    return FinishLoadRun("bench", manager, targets, options, wallSec, before, completed);
+}
+
+// --soak <duration>: run detectors side by side and report periodically
+int RunSoak(DetectorManager& manager, int argc, char* argv[]) {
+    LoadOptions options;
+    options.durationSec = argc >= 3 ? ParseDuration(argv[2]) : -1.0;
+    if (options.durationSec <= 0.0 || !ParseLoadOptions(argc, argv, 3, options)) {
+        PrintError("Usage: --soak <duration> [--adapter <name|path>]... [--rate R|max] [--listeners K] "
+                   "[--report <interval>] [--json <path>]");
+        return 1;
+    }
+    if (options.adapters.empty()) {
+        options.adapters = {"emul"};
+    }
+
+    std::vector<LoadTarget> targets(options.adapters.size());
+    PrintSection("Soak");
+    const ProcessStats before = SampleProcessStats();
+    const uint64_t startNs = MonotonicNowNs();
+    for (size_t i = 0; i < targets.size(); ++i) {
+        targets[i].adapter = options.adapters[i];
+        if (!options.timingTracePath.empty()) {
+            // One trace per detector when several run side by side
+            targets[i].timingTracePath = targets.size() == 1
+                ? options.timingTracePath : options.timingTracePath + "." + std::to_string(i);
+        }
+        if (!StartLoadTarget(manager, targets[i], options)) {
+            StopLoadTargets(manager, targets);
+            return 1;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::duration<double>(options.durationSec);
+    auto nextReport = start + std::chrono::duration<double>(options.reportSec);
+    std::vector<uint64_t> lastFrames(targets.size(), 0);
+    auto lastReport = start;
+    while (std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto now = std::chrono::steady_clock::now();
+        if (now < nextReport) {
+            continue;
+        }
+
+        const double intervalSec = std::chrono::duration<double>(now - lastReport).count();
+        const ProcessStats stats = SampleProcessStats();
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1)
+             << "t=" << std::chrono::duration<double>(now - start).count() << "s";
+        for (size_t i = 0; i < targets.size(); ++i) {
+            const LoadListener& listener = *targets[i].listeners.front();
+            const uint64_t frames = listener.GetFrames();
+            line << "  " << targets[i].adapter << ": " << (frames - lastFrames[i]) / intervalSec
+                 << " fps, " << listener.GetSequenceStats().dropped << " dropped";
+            lastFrames[i] = frames;
+        }
+        line << "  rss " << stats.residentBytes / (1024.0 * 1024.0) << " MB";
+        PrintInfo(line.str());
+        lastReport = now;
+        nextReport += std::chrono::duration<double>(options.reportSec);
+    }
+
+    for (LoadTarget& target : targets) {
+        if (IDetector* detector = manager.GetDetector(target.detectorId)) {
+            detector->stopAcquisition();
+        }
+    }
+    const double wallSec = (MonotonicNowNs() - startNs) / 1e9;
+    return FinishLoadRun("soak", manager, targets, options, wallSec, before, true);
+}
+
 // Print usage
 void PrintUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [command] [options]" << std::endl;
@@ -318,13 +900,34 @@ void PrintUsage(const char* programName) {
     std::cout << "  --info <detector_id>       Show detector information" << std::endl;
     std::cout << "  --params <detector_id>     Set acquisition parameters" << std::endl;
     std::cout << "  --detectors               List managed detectors" << std::endl;
+    std::cout << "  --recover <recording>     Repair a recording after a crash" << std::endl;
+    std::cout << "  --bench <adapter>         Measure throughput and latency over a fixed frame count" << std::endl;
+    std::cout << "  --soak <duration>         Run adapters continuously and report drops (e.g. 30s, 10m)" << std::endl;
     std::cout << "  --help                    Show this help message" << std::endl;
     std::cout << std::endl;
+    std::cout << "Global options:" << std::endl;
+    std::cout << "  --metrics-file <path>     Write Prometheus metrics to <path> on exit" << std::endl;
+    std::cout << "  --trace-file <path>       Record a Chrome trace to <path> (tracing builds)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Benchmark options (--bench, --soak):" << std::endl;
+    std::cout << "  --adapter <name|path>     Adapter to run; repeat for several (--soak, default emul)" << std::endl;
+    std::cout << "  --frames <N>              Frames to receive (--bench, default 1000)" << std::endl;
+    std::cout << "  --rate <fps|max>          Frame rate requested from the adapter" << std::endl;
+    std::cout << "  --listeners <K>           Listeners attached to each detector (default 1)" << std::endl;
+    std::cout << "  --config <json>           Adapter config instead of the generated one" << std::endl;
+    std::cout << "  --report <interval>       Progress report interval (--soak, default 10s)" << std::endl;
+    std::cout << "  --timeout <duration>      Give up waiting for frames (--bench)" << std::endl;
+    std::cout << "  --allow-drops             Do not fail the run on dropped frames" << std::endl;
+    std::cout << "  --json <path>             Write a machine-readable report" << std::endl;
+    std::cout << "  --timing-trace <path>     Record frame timing, states and errors for emulator replay" << std::endl;
+    std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  " << programName << " --list" << std::endl;
     std::cout << "  " << programName << " --load uxdi_dummy.dll" << std::endl;
     std::cout << "  " << programName << " --create 1" << std::endl;
     std::cout << "  " << programName << " --start 1" << std::endl;
+    std::cout << "  " << programName << " --bench abyz --frames 2000 --rate 200 --listeners 4 --json bench.json" << std::endl;
+    std::cout << "  " << programName << " --soak 10m --adapter emul --adapter varex --rate 60" << std::endl;
 }
 
 // Interactive demo mode
@@ -393,19 +996,8 @@ void RunInteractiveDemo() {
     std::cin.get();
 }
 
-int main(int argc, char* argv[]) {
-    // Set UTF-8 console for Windows
-#ifdef _WIN32
-    SetConsoleOutputCP(CP_UTF8);
-    SetConsoleCP(CP_UTF8);
-#endif
-
-    // No arguments - run interactive demo
-    if (argc == 1) {
-        RunInteractiveDemo();
-        return 0;
-    }
-
+// Dispatch a single command (argv[1]) and return the process exit code
+int RunCommand(int argc, char* argv[]) {
     // Parse command line arguments
     std::string command = argv[1];
     DetectorManager manager;
@@ -478,6 +1070,21 @@ int main(int argc, char* argv[]) {
         }
         SetAcquisitionParams(manager, std::stoul(argv[2], nullptr, 10));
     }
+    else if (command == "--recover") {
+        if (argc < 3) {
+            PrintError("Usage: --recover <recording>");
+            return 1;
+        }
+        if (!RecoverRecording(argv[2])) {
+            return 1;
+        }
+    }
+    else if (command == "--bench") {
+        return RunBench(manager, argc, argv);
+    }
+    else if (command == "--soak") {
+        return RunSoak(manager, argc, argv);
+    }
     else {
         PrintError("Unknown command: " + command);
         std::cout << "Use --help for usage information" << std::endl;
@@ -486,3 +1093,60 @@ int main(int argc, char* argv[]) {
 
     return 0;
 }
+
+int main(int argc, char* argv[]) {
+    // Set UTF-8 console for Windows
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+#endif
+
+    // Global options are stripped before command dispatch
+    std::string metricsFile;
+    std::string traceFile;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--metrics-file" || arg == "--trace-file") {
+            if (i + 1 >= argc) {
+                PrintError("Usage: " + arg + " <path>");
+                return 1;
+            }
+            (arg == "--metrics-file" ? metricsFile : traceFile) = argv[++i];
+            continue;
+        }
+        args.push_back(argv[i]);
+    }
+
+    if (!traceFile.empty()) {
+        TraceRecorder::Global().SetEnabled(true);
+    }
+
+    int exitCode = 0;
+    if (args.size() == 1) {
+        // No command - run interactive demo
+        RunInteractiveDemo();
+    } else {
+        exitCode = RunCommand(static_cast<int>(args.size()), args.data());
+    }
+
+    if (!traceFile.empty()) {
+        TraceRecorder::Global().SetEnabled(false);
+        if (TraceRecorder::Global().WriteChromeTrace(traceFile)) {
+            PrintInfo("Trace written to " + traceFile);
+        } else {
+            PrintError("Failed to write trace to " + traceFile);
+            exitCode = exitCode != 0 ? exitCode : 1;
+        }
+    }
+
+    if (!metricsFile.empty()) {
+        if (MetricsRegistry::Global().WritePrometheus(metricsFile)) {
+            PrintInfo("Metrics written to " + metricsFile);
+        } else {
+            PrintError("Failed to write metrics to " + metricsFile);
+            exitCode = exitCode != 0 ? exitCode : 1;
+        }
+    }
+    return exitCode;
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace uxdi {
+
+// Part of UXDI an allocation is attributed to
+enum class AllocationSubsystem : uint8_t {
+    Untagged,       // Outside any UXDI_ALLOC_SCOPE (application, SDK, runtime)
+    Manager,        // DetectorManager and DetectorFactory
+    Dispatch,       // FrameDispatcher bookkeeping
+    Listener,       // Listener callbacks
+    Adapter,        // Adapter acquisition threads and SDK callback bridges
+    Scenario,       // Emulator scenario engine
+    Recording,      // Recorders, spill store and retroactive buffer
+    Sdk,            // Vendor SDK calls made from adapter threads
+    Count
+};
+
+constexpr size_t kAllocationSubsystemCount = static_cast<size_t>(AllocationSubsystem::Count);
+
+/**
+ * @brief Allocation counts of one subsystem
+ */
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;             // Requested bytes, not including allocator overhead
+    uint64_t frees = 0;
+};
+
+/**
+ * @brief Allocation counts of every subsystem at one point in time
+ *
+ * Subtract two snapshots to get the allocations made in between.
+ */
+struct AllocationSnapshot {
+    std::array<AllocationCounts, kAllocationSubsystemCount> subsystems{};
+
+    const AllocationCounts& operator[](AllocationSubsystem subsystem) const {
+        return subsystems[static_cast<size_t>(subsystem)];
+    }
+
+    /**
+     * @brief Sum of UXDI's own subsystems (all but Untagged and Sdk)
+     */
+    AllocationCounts UxdiTotal() const;
+
+    AllocationSnapshot operator-(const AllocationSnapshot& earlier) const;
+
+    /**
+     * @brief One line per subsystem with a non-zero count
+     */
+    std::string Format() const;
+};
+
+/**
+ * @brief Attributes heap allocations to UXDI subsystems
+ *
+ * Code marks the subsystem it runs in with UXDI_ALLOC_SCOPE(); the tag is
+ * per thread and scopes nest. When built with UXDI_TRACK_ALLOCATIONS (CMake
+ * option of the same name), uxdi_core replaces the global operator new and
+ * delete and every allocation is counted against the calling thread's tag.
+ * Without the option the scopes compile to nothing and only explicit
+ * RecordAllocation() calls are counted.
+ *
+ * Adapter libraries link their own copy of uxdi_core. On Linux the host
+ * executable's operator new serves the whole process (so the host must be
+ * built with the option), and an adapter's scopes have to set the host's
+ * per-thread tag; DetectorFactory passes the host's tracker to the
+ * adapter's optional AttachAllocationTracker export for that. On Windows
+ * each module keeps its own operator new, which records into the attached
+ * host tracker as well.
+ */
+class UXDI_API AllocationTracker {
+public:
+    AllocationTracker();
+
+    // Non-copyable, non-movable
+    AllocationTracker(const AllocationTracker&) = delete;
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+    AllocationTracker(AllocationTracker&&) = delete;
+    AllocationTracker& operator=(AllocationTracker&&) = delete;
+
+    /**
+     * @brief Whether operator new is hooked in this build
+     */
+    static constexpr bool IsHooked() {
+#if defined(UXDI_TRACK_ALLOCATIONS)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief This module's own tracker
+     */
+    static AllocationTracker& Global();
+
+    /**
+     * @brief Tracker this module's scopes and allocations are counted in
+     *
+     * Global() unless another tracker was attached.
+     */
+    static AllocationTracker& Current() {
+        AllocationTracker* attached = s_attached.load(std::memory_order_acquire);
+        return attached ? *attached : Global();
+    }
+
+    /**
+     * @brief Count this module's scopes and allocations in another tracker
+     *
+     * @param tracker Tracker to use, or nullptr to go back to Global()
+     */
+    static void Attach(AllocationTracker* tracker);
+
+    /**
+     * @brief Subsystem the calling thread is tagged with
+     */
+    AllocationSubsystem GetThreadSubsystem() const;
+
+    /**
+     * @brief Tag the calling thread
+     *
+     * @return Previous tag, to be restored when the work is done
+     */
+    AllocationSubsystem SetThreadSubsystem(AllocationSubsystem subsystem);
+
+    /**
+     * @brief Count an allocation against the calling thread's subsystem
+     *
+     * Called by the operator new hooks; must not allocate.
+     */
+    void RecordAllocation(size_t bytes);
+
+    /**
+     * @brief Count a free against the calling thread's subsystem
+     */
+    void RecordFree();
+
+    AllocationSnapshot Snapshot() const;
+
+    /**
+     * @brief Zero all counters
+     */
+    void Reset();
+
+private:
+    // Returns the calling thread's tag in the module that created the tracker
+    using ThreadSlotFunc = AllocationSubsystem& (*)();
+
+    constexpr explicit AllocationTracker(ThreadSlotFunc threadSlot)
+        : m_threadSlot(threadSlot)
+    {
+    }
+
+    struct Counters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> frees{0};
+    };
+
+    Counters& CountersOfThread();
+
+    static std::atomic<AllocationTracker*> s_attached;
+
+    const ThreadSlotFunc m_threadSlot;
+    std::array<Counters, kAllocationSubsystemCount> m_counters{};
+};
+
+/**
+ * @brief RAII subsystem tag for the calling thread
+ */
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationSubsystem subsystem)
+        : m_tracker(AllocationTracker::Current())
+        , m_previous(m_tracker.SetThreadSubsystem(subsystem))
+    {
+    }
+
+    ~AllocationScope() {
+        m_tracker.SetThreadSubsystem(m_previous);
+    }
+
+    // Non-copyable, non-movable
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+    AllocationScope(AllocationScope&&) = delete;
+    AllocationScope& operator=(AllocationScope&&) = delete;
+
+private:
+    AllocationTracker& m_tracker;
+    AllocationSubsystem m_previous;
+};
+
+} // namespace uxdi
+
+// ============================================================================
+// Scope macro
+// ============================================================================
+
+#define UXDI_ALLOC_CONCAT_INNER(a, b) a##b
+#define UXDI_ALLOC_CONCAT(a, b) UXDI_ALLOC_CONCAT_INNER(a, b)
+
+#if defined(UXDI_TRACK_ALLOCATIONS)
+
+#define UXDI_ALLOC_SCOPE(subsystem) \
+    ::uxdi::AllocationScope UXDI_ALLOC_CONCAT(uxdiAllocScope, __LINE__)(::uxdi::AllocationSubsystem::subsystem)
+
+#else
+
+#define UXDI_ALLOC_SCOPE(subsystem) ((void)0)
+
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+#include <uxdi/Types.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace uxdi {
+
+/**
+ * @brief What a pacer does with frame slots it has already missed
+ */
+enum class PacingPolicy {
+    CatchUp,  // Deliver the missed frames back to back until on schedule again
+    Skip      // Drop the missed slots and continue on the original grid
+};
+
+/**
+ * @brief Pacing counters since the last Start()
+ */
+struct PacerStats {
+    uint64_t frames = 0;        // Deadlines handed out
+    uint64_t lateFrames = 0;    // Deadlines already past when handed out
+    uint64_t skippedSlots = 0;  // Slots dropped under PacingPolicy::Skip
+    uint64_t rebases = 0;       // Schedule restarts after a long stall
+};
+
+/**
+ * @brief Absolute-time frame schedule for generated frame streams
+ *
+ * Frame n is due at start + n * interval, so sleep overshoot and the time
+ * spent producing a frame never accumulate into drift. When the producer
+ * falls behind, the policy decides whether the missed frames are caught up
+ * or skipped; a stall longer than kRebaseNs restarts the schedule instead
+ * of bursting out the backlog.
+ *
+ * SleepUntil() waits for a deadline by sleeping until spinNs before it and
+ * spinning the rest of the way, which keeps wake-up jitter well below a
+ * millisecond at the cost of up to spinNs of CPU per frame.
+ *
+ * Not thread-safe; the owner serializes NextDeadline() calls.
+ */
+class UXDI_API DeadlinePacer {
+public:
+    static constexpr uint64_t kDefaultSpinNs = 1'000'000;
+    static constexpr uint64_t kRebaseNs = 1'000'000'000;
+
+    /**
+     * @param intervalNs Time between frames; 0 disables pacing
+     * @param policy What to do with missed frame slots
+     */
+    explicit DeadlinePacer(uint64_t intervalNs = 0, PacingPolicy policy = PacingPolicy::CatchUp);
+
+    /**
+     * @brief Change the interval and policy; takes effect at the next Start()
+     */
+    void Configure(uint64_t intervalNs, PacingPolicy policy);
+
+    /**
+     * @brief Restart the schedule: the next frame is due at nowNs
+     */
+    void Start(uint64_t nowNs = MonotonicNowNs());
+
+    /**
+     * @brief Deadline of the next frame; advances the schedule
+     *
+     * Returns nowNs when pacing is disabled.
+     */
+    uint64_t NextDeadline(uint64_t nowNs = MonotonicNowNs());
+
+    uint64_t GetIntervalNs() const { return m_intervalNs; }
+    PacingPolicy GetPolicy() const { return m_policy; }
+    PacerStats GetStats() const { return m_stats; }
+
+    /**
+     * @brief Wait until deadlineNs with a sleep followed by a short spin
+     *
+     * Sleeps in slices of at most 10 ms so a cleared running flag is seen
+     * promptly.
+     *
+     * @param deadlineNs Deadline from NextDeadline()
+     * @param running Flag cleared by the owner to abandon the wait
+     * @param spinNs How long before the deadline to stop sleeping
+     * @return false if running was cleared before the deadline
+     */
+    static bool SleepUntil(uint64_t deadlineNs, const std::atomic<bool>& running,
+                           uint64_t spinNs = kDefaultSpinNs);
+
+private:
+    uint64_t m_intervalNs;
+    PacingPolicy m_policy;
+    uint64_t m_startNs = 0;
+    uint64_t m_frameIndex = 0;
+    PacerStats m_stats;
+};
+
+} // namespace uxdi
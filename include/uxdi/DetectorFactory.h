@@ -16,11 +16,19 @@ namespace uxdi {
 
 // Forward declarations
 class IDetector;
+class TraceRecorder;
+class AllocationTracker;
 
 // Factory function pointers from adapter DLLs
 using CreateDetectorFunc = IDetector* (*)(const char* config);
 using DestroyDetectorFunc = void (*)(IDetector* detector);
 
+// Optional adapter export that routes the adapter's trace points to the host recorder
+using AttachTraceRecorderFunc = void (*)(TraceRecorder* recorder);
+
+// Optional adapter export that counts the adapter's allocations in the host tracker
+using AttachAllocationTrackerFunc = void (*)(AllocationTracker* tracker);
+
 // Custom deleter for IDetector that calls adapter's DestroyDetector
 struct DetectorFactoryDeleter {
     DestroyDetectorFunc destroyFunc = nullptr;
@@ -50,7 +58,10 @@ public:
      * @brief Load an adapter DLL from the specified path
      *
      * Loads a DLL and verifies it exports the required CreateDetector and
-     * DestroyDetector functions.
+     * DestroyDetector functions. If the DLL also exports AttachTraceRecorder,
+     * it is handed TraceRecorder::Current() so adapter trace points land in
+     * the host's timeline; likewise AllocationTracker::Current() is handed
+     * to an AttachAllocationTracker export.
      *
      * @param dllPath Wide-character path to the adapter DLL
      * @return Adapter ID for later reference in CreateDetector/UnloadAdapter
@@ -58,6 +69,18 @@ public:
      */
     static size_t LoadAdapter(const std::wstring& dllPath);
 
+    /**
+     * @brief Load an adapter library from a UTF-8 path
+     *
+     * Same as the wide-character overload. On Linux this is the native form
+     * and loads a shared object with dlopen().
+     *
+     * @param dllPath UTF-8 path to the adapter DLL or shared object
+     * @return Adapter ID for later reference in CreateDetector/UnloadAdapter
+     * @throws std::runtime_error on failure (library not found, missing exports, etc.)
+     */
+    static size_t LoadAdapter(const std::string& dllPath);
+
     /**
      * @brief Get information about all loaded adapters
      *
@@ -136,8 +159,14 @@ public:
 
 private:
     // Internal handle structure for loaded adapters
+#ifdef _WIN32
+    using ModuleHandle = HMODULE;
+#else
+    using ModuleHandle = void*;  // dlopen() handle
+#endif
+
     struct AdapterHandle {
-        HMODULE hModule;
+        ModuleHandle hModule;
         CreateDetectorFunc createFunc;
         DestroyDetectorFunc destroyFunc;
         DetectorAdapterInfo info;
@@ -5,6 +5,8 @@
 #include <uxdi/Types.h>
 #include <uxdi/uxdi_export.h>
 #include <uxdi/DetectorFactory.h>  // For DetectorFactoryDeleter
+#include <uxdi/FrameDispatcher.h>
+#include <uxdi/MetricsRegistry.h>
 
 #include <memory>
 #include <vector>
@@ -19,11 +21,20 @@ namespace uxdi {
  * DetectorManager provides a high-level API for managing multiple detector instances.
  * It handles detector creation, destruction, and maintains a registry of listeners
  * for each detector. All operations are thread-safe.
+ *
+ * Each detector's listener is a FrameDispatcher owned by the manager, which
+ * fans events out to the registered listeners and aggregates per-frame
+ * latency. Register listeners through AddListener() rather than calling
+ * setListener() on the detector directly.
+ *
+ * Detector lifecycle and every detector's frame, byte, latency, error and
+ * state counters are reported into a MetricsRegistry, labelled with the
+ * detector and adapter IDs.
  */
 class UXDI_API DetectorManager {
 public:
     // Constructor/Destructor
-    DetectorManager();
+    explicit DetectorManager(MetricsRegistry& metrics = MetricsRegistry::Global());
     ~DetectorManager();
 
     // Non-copyable, non-movable
@@ -44,6 +55,20 @@ public:
      */
     size_t CreateDetector(size_t adapterId, const std::string& config);
 
+    /**
+     * @brief Register an already created detector
+     *
+     * Takes the detector into the registry as if it had been created by
+     * CreateDetector. A deleter without a destroy function leaves the
+     * detector owned by the caller, which must keep it alive until it is
+     * destroyed here.
+     *
+     * @param detector Detector instance
+     * @param adapterId Adapter ID to associate with the detector
+     * @return Detector ID (0 if detector is null)
+     */
+    size_t RegisterDetector(std::unique_ptr<IDetector, DetectorFactoryDeleter> detector, size_t adapterId = 0);
+
     /**
      * @brief Destroy a detector instance
      *
@@ -74,14 +99,18 @@ public:
      *
      * @param detectorId ID returned from CreateDetector
      * @param listener Pointer to listener implementation
+     * @param options Callback budget and slow-consumer policy (see FrameDispatcher)
      * @return true if listener was added, false if detector not found or duplicate
      */
-    bool AddListener(size_t detectorId, IDetectorListener* listener);
+    bool AddListener(size_t detectorId, IDetectorListener* listener,
+                     const ListenerOptions& options = ListenerOptions{});
 
     /**
      * @brief Remove a specific listener
      *
      * Unregisters a previously added listener from receiving detector events.
+     * Returns once callbacks already running on other threads have finished;
+     * those callbacks may call back into the manager.
      *
      * @param detectorId ID returned from CreateDetector
      * @param listener Pointer to listener implementation
@@ -89,6 +118,18 @@ public:
      */
     bool RemoveListener(size_t detectorId, IDetectorListener* listener);
 
+    /**
+     * @brief Get delivery counters for a listener
+     *
+     * Reports budget overruns, whether the listener was moved to its own
+     * queue, and frames dropped from that queue.
+     *
+     * @param detectorId ID returned from CreateDetector
+     * @param listener Pointer to listener implementation
+     * @return Counters (empty if detector or listener not found)
+     */
+    ListenerStats GetListenerStats(size_t detectorId, IDetectorListener* listener) const;
+
     /**
      * @brief Remove all listeners for a detector
      *
@@ -120,6 +161,36 @@ public:
      */
     DetectorInfo GetInfo(size_t detectorId);
 
+    /**
+     * @brief Get a detector's delivered frame rate and throughput
+     *
+     * Reported by the adapter itself, so it reflects the frames the detector
+     * produces whether or not listeners are attached.
+     *
+     * @param detectorId ID returned from CreateDetector
+     * @return Statistics (empty if detector not found)
+     */
+    DetectorStatistics GetStatistics(size_t detectorId) const;
+
+    /**
+     * @brief Get frame latency percentiles for a detector
+     *
+     * Covers every frame delivered since creation or the last
+     * ResetLatencyStats(), broken down by pipeline stage.
+     *
+     * @param detectorId ID returned from CreateDetector
+     * @return Latency statistics (empty if detector not found)
+     */
+    LatencyStats GetLatencyStats(size_t detectorId) const;
+
+    /**
+     * @brief Discard a detector's latency samples
+     *
+     * @param detectorId ID returned from CreateDetector
+     * @return false if detector not found
+     */
+    bool ResetLatencyStats(size_t detectorId);
+
     /**
      * @brief Destroy all detector instances
      *
@@ -144,6 +215,16 @@ public:
      */
     std::vector<size_t> GetDetectorIds() const;
 
+    /**
+     * @brief Get all detector IDs into a caller-owned vector
+     *
+     * Replaces the vector's contents and reuses its capacity, so a poller
+     * that keeps the vector does not allocate on every call.
+     *
+     * @param ids Receives the detector IDs
+     */
+    void GetDetectorIds(std::vector<size_t>& ids) const;
+
     /**
      * @brief Check if a detector ID is valid
      *
@@ -157,13 +238,27 @@ private:
     struct DetectorEntry {
         size_t id;                           // Unique detector ID
         size_t adapterId;                    // Adapter ID used for creation
+        // Detector's listener; outlives the detector. Shared so listener
+        // removal can wait out running callbacks without holding m_mutex
+        std::shared_ptr<FrameDispatcher> dispatcher;
         std::unique_ptr<IDetector, DetectorFactoryDeleter> detector; // Detector instance (owning)
-        std::vector<IDetectorListener*> listeners; // Non-owning listener pointers
 
-        DetectorEntry(size_t id_, size_t adapterId_, std::unique_ptr<IDetector, DetectorFactoryDeleter> detector_)
-            : id(id_), adapterId(adapterId_), detector(std::move(detector_)) {}
+        DetectorEntry(size_t id_, size_t adapterId_, std::unique_ptr<IDetector, DetectorFactoryDeleter> detector_,
+                      MetricsRegistry& metrics);
+        ~DetectorEntry();
+        DetectorEntry(DetectorEntry&&) = default;
+        DetectorEntry& operator=(DetectorEntry&& other) noexcept;
+
+        // Detaches and destroys the detector, then its dispatcher
+        void Release();
     };
 
+    // Looks up a detector's dispatcher under m_mutex (nullptr if not found)
+    std::shared_ptr<FrameDispatcher> FindDispatcher(size_t detectorId) const;
+
+    // Adds a detector entry; caller holds m_mutex
+    size_t AddDetectorEntry(size_t adapterId, std::unique_ptr<IDetector, DetectorFactoryDeleter> detector);
+
     // Helper to find detector entry by ID
     std::vector<DetectorEntry>::iterator FindDetectorEntry(size_t detectorId);
     std::vector<DetectorEntry>::const_iterator FindDetectorEntry(size_t detectorId) const;
@@ -172,6 +267,12 @@ private:
     std::vector<DetectorEntry> m_detectors;
     mutable std::mutex m_mutex;
     size_t m_nextDetectorId;
+
+    MetricsRegistry& m_metrics;
+    MetricGauge& m_detectorsMetric;
+    MetricCounter& m_createdMetric;
+    MetricCounter& m_createFailuresMetric;
+    MetricCounter& m_destroyedMetric;
 };
 
 } // namespace uxdi
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief Recycles frame buffers handed out as ImageData::data
+ *
+ * Adapters that copy each SDK frame take the destination buffer from a pool
+ * instead of allocating it. A buffer goes back into circulation once every
+ * ImageData referring to it has been released, so listeners that keep a
+ * frame (recorders, retroactive buffers) keep it intact for as long as they
+ * hold it. In steady state Acquire() allocates nothing: the shared_ptr and
+ * its control block are created once per pool slot.
+ *
+ * When all slots are in use the pool grows up to maxBuffers; beyond that,
+ * Acquire() falls back to a one-off buffer that is not recycled.
+ */
+class UXDI_API FrameBufferPool {
+public:
+    static constexpr size_t kDefaultMaxBuffers = 8;
+
+    /**
+     * @param maxBuffers Number of buffers kept for reuse
+     */
+    explicit FrameBufferPool(size_t maxBuffers = kDefaultMaxBuffers);
+
+    // Non-copyable, non-movable
+    FrameBufferPool(const FrameBufferPool&) = delete;
+    FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+    FrameBufferPool(FrameBufferPool&&) = delete;
+    FrameBufferPool& operator=(FrameBufferPool&&) = delete;
+
+    /**
+     * @brief Get a buffer of at least the given size
+     *
+     * The contents are unspecified. Thread-safe.
+     */
+    std::shared_ptr<uint8_t[]> Acquire(size_t bytes);
+
+    /**
+     * @brief Number of buffers currently kept by the pool
+     */
+    size_t GetBufferCount() const;
+
+    /**
+     * @brief Number of Acquire() calls that had to allocate
+     */
+    uint64_t GetAllocationCount() const;
+
+    /**
+     * @brief Drop all pooled buffers (frames still held stay valid)
+     */
+    void Clear();
+
+private:
+    struct Slot {
+        std::shared_ptr<uint8_t[]> buffer;
+        size_t capacity = 0;
+    };
+
+    const size_t m_maxBuffers;
+    mutable std::mutex m_mutex;
+    std::vector<Slot> m_slots;
+    uint64_t m_allocations = 0;
+};
+
+} // namespace uxdi
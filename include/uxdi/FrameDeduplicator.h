@@ -0,0 +1,129 @@
+#pragma once
+
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief Options controlling static-frame detection
+ */
+struct DedupOptions {
+    double changeThreshold = 1.0;    // Max mean absolute difference (pixel units) for a static frame
+    uint32_t maxStaticRun = 0;       // Force a key frame after this many static frames (0 = never)
+};
+
+/**
+ * @brief Coarse frame signature: mean pixel value of each cell in an 8x8 grid
+ */
+struct FrameFingerprint {
+    static constexpr uint32_t kGridSize = 8;
+    std::array<uint32_t, kGridSize * kGridSize> cellMeans{};
+};
+
+/**
+ * @brief Result of analyzing one frame
+ */
+struct DedupResult {
+    bool isStatic = false;           // Frame matches the current key frame
+    uint64_t referenceFrame = 0;     // Key frame number to reference when static
+    double meanAbsDifference = 0.0;  // Difference from the key frame (pixel units)
+    FrameFingerprint fingerprint;    // Of the analyzed frame
+};
+
+/**
+ * @brief Static-frame detector for idle or dark periods
+ *
+ * Each frame is compared with the last key frame (the last frame that was
+ * not static). Comparing against the key frame rather than the previous
+ * frame keeps slow drift from accumulating unnoticed.
+ *
+ * The comparison is two-stage. A fingerprint of 8x8 cell means is computed
+ * first; if any cell moved by more than 64x the threshold the frame cannot
+ * be static and the full comparison is skipped. Otherwise the exact mean
+ * absolute difference is computed over every pixel. Both passes are plain
+ * contiguous loops that the compiler vectorizes.
+ *
+ * The key frame copy is reused between frames, so steady-state analysis
+ * does not allocate. Not thread-safe; callers serialize access.
+ */
+class UXDI_API FrameDeduplicator {
+public:
+    explicit FrameDeduplicator(const DedupOptions& options = DedupOptions{});
+
+    /**
+     * @brief Classify a frame and update the key frame when it changed
+     *
+     * Equivalent to Classify() followed by AdoptKeyFrame() for a frame that
+     * is not static.
+     *
+     * @param image Frame to analyze (8-bit or 16-bit pixels)
+     * @return Classification; frames of a new size are always key frames
+     */
+    DedupResult Analyze(const ImageData& image);
+
+    /**
+     * @brief Classify a frame without adopting it as the key frame
+     *
+     * For callers that must first store a changed frame before later static
+     * frames may refer to it.
+     *
+     * @param image Frame to analyze (8-bit or 16-bit pixels)
+     * @return Classification; frames of a new size are always key frames
+     */
+    DedupResult Classify(const ImageData& image);
+
+    /**
+     * @brief Make a frame that Classify() found changed the new key frame
+     *
+     * @param image The classified frame
+     * @param result Classify()'s result for it
+     */
+    void AdoptKeyFrame(const ImageData& image, const DedupResult& result);
+
+    /**
+     * @brief Forget the current key frame
+     */
+    void Reset();
+
+    /**
+     * @brief Get number of frames classified as static
+     */
+    uint64_t GetStaticFrameCount() const { return m_staticFrames; }
+
+    /**
+     * @brief Get number of frames classified as key frames
+     */
+    uint64_t GetKeyFrameCount() const { return m_keyFrames; }
+
+    /**
+     * @brief Compute the 8x8 cell-mean fingerprint of a frame
+     */
+    static FrameFingerprint ComputeFingerprint(const ImageData& image);
+
+    /**
+     * @brief Compute the mean absolute pixel difference of two frames
+     *
+     * @return Mean difference in pixel units, or a negative value if the
+     *         frames differ in size or format
+     */
+    static double ComputeMeanAbsDifference(const ImageData& a, const ImageData& b);
+
+private:
+    void StoreKeyFrame(const ImageData& image, const FrameFingerprint& fingerprint);
+
+    DedupOptions m_options;
+    ImageData m_keyFrame;                 // Metadata of the key frame (data unused)
+    std::vector<uint8_t> m_keyPixels;     // Reused copy of key frame pixels
+    FrameFingerprint m_keyFingerprint;
+    bool m_hasKeyFrame = false;
+    uint32_t m_staticRun = 0;
+    uint64_t m_staticFrames = 0;
+    uint64_t m_keyFrames = 0;
+};
+
+} // namespace uxdi
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <uxdi/IDetectorListener.h>
+#include <uxdi/LatencyHistogram.h>
+#include <uxdi/MetricsRegistry.h>
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief Latency percentiles for each stage of the frame pipeline
+ *
+ * Stages are measured from the ImageData::latency stamps written by the
+ * adapter and the dispatcher's own listener entry/exit stamps. Stages an
+ * adapter does not stamp stay empty.
+ */
+struct LatencyStats {
+    LatencySummary sdkToAdapter;        // SDK delivery -> adapter conversion done
+    LatencySummary adapterToDispatch;   // Conversion done -> handed to listener
+    LatencySummary dispatchToListener;  // Hand-off -> listener entry (per listener)
+    LatencySummary listenerCallback;    // Listener entry -> exit (per listener)
+    LatencySummary endToEnd;            // SDK delivery -> last listener exit
+};
+
+/**
+ * @brief Callback budget for one listener
+ *
+ * A listener that overruns its budget is reported; with demoteAfterOverruns
+ * set it is moved off the detector's thread onto a queue of its own, so a
+ * slow consumer stops holding back the other listeners.
+ */
+struct ListenerOptions {
+    std::string name;                  // Listener label on metrics ("unnamed" when empty)
+    uint64_t callbackBudgetNs = 0;     // Longest acceptable onImageReceived; 0 = no budget
+    uint32_t demoteAfterOverruns = 0;  // Overruns before moving to an async queue; 0 = never
+    size_t asyncQueueDepth = 4;        // Frames queued once demoted; the oldest is dropped when full
+};
+
+/**
+ * @brief Delivery counters for one listener
+ */
+struct ListenerStats {
+    uint64_t frames = 0;          // Frames handed to the listener or its queue
+    uint64_t overruns = 0;        // onImageReceived calls longer than the budget
+    uint64_t droppedFrames = 0;   // Frames dropped from a full async queue
+    uint64_t maxCallbackNs = 0;   // Longest onImageReceived call
+    bool demoted = false;         // Listener runs on its own queue
+};
+
+/**
+ * @brief Listener that fans detector events out to several listeners
+ *
+ * A detector accepts a single listener; DetectorManager installs one
+ * FrameDispatcher per detector and routes its listener registry through it.
+ * The listener list is copy-on-write, so dispatching a frame takes a short
+ * lock to grab the current list and never allocates. RemoveListener()
+ * waits for callbacks into the listener that are still running on other
+ * threads, so the listener may be destroyed as soon as it returns.
+ *
+ * Every frame's latency stamps are aggregated into per-stage histograms.
+ * With BindMetrics() the dispatcher also reports frames, bytes, end-to-end
+ * latency, errors by code and state transitions into a MetricsRegistry.
+ *
+ * Each listener's onImageReceived is timed against its ListenerOptions
+ * budget. A demoted listener receives frames from its own thread through a
+ * bounded queue; borrowed frame buffers (see ImageData) are copied into
+ * pooled buffers first. Its other callbacks
+ * stay on the detector's thread, so onAcquisitionStopped may arrive before
+ * its queued frames. Latency histograms cover synchronous deliveries only.
+ */
+class UXDI_API FrameDispatcher : public IDetectorListener {
+public:
+    FrameDispatcher();
+    ~FrameDispatcher() override;
+
+    // Non-copyable, non-movable
+    FrameDispatcher(const FrameDispatcher&) = delete;
+    FrameDispatcher& operator=(const FrameDispatcher&) = delete;
+    FrameDispatcher(FrameDispatcher&&) = delete;
+    FrameDispatcher& operator=(FrameDispatcher&&) = delete;
+
+    /**
+     * @brief Add a listener
+     *
+     * @param listener Listener to add (not owned)
+     * @param options Callback budget; the default has none
+     * @return false if listener is null or already registered
+     */
+    bool AddListener(IDetectorListener* listener, const ListenerOptions& options = ListenerOptions{});
+
+    /**
+     * @brief Remove a listener
+     *
+     * Waits for callbacks into the listener that are in progress on other
+     * threads; none start after this returns. A demoted listener's queue is
+     * discarded and its thread joined. A listener may remove itself from
+     * its own callback, which then finishes after this returns.
+     *
+     * @return false if listener was not registered
+     */
+    bool RemoveListener(IDetectorListener* listener);
+
+    /**
+     * @brief Remove all listeners
+     *
+     * @return Number of listeners removed
+     */
+    size_t RemoveAllListeners();
+
+    /**
+     * @brief Get number of registered listeners
+     */
+    size_t GetListenerCount() const;
+
+    /**
+     * @brief Get delivery counters for a listener
+     *
+     * @return Counters (empty if listener is not registered)
+     */
+    ListenerStats GetListenerStats(IDetectorListener* listener) const;
+
+    /**
+     * @brief Get latency percentiles for all stages
+     */
+    LatencyStats GetLatencyStats() const;
+
+    /**
+     * @brief Discard all latency samples
+     */
+    void ResetLatencyStats();
+
+    /**
+     * @brief Report this detector's events into a metrics registry
+     *
+     * Must be called before the dispatcher is installed as a listener.
+     *
+     * @param registry Registry to report into; must outlive the dispatcher
+     * @param labels Labels identifying the detector on every series
+     */
+    void BindMetrics(MetricsRegistry& registry, const MetricLabels& labels);
+
+    // IDetectorListener
+    void onImageReceived(const ImageData& image) override;
+    void onStateChanged(DetectorState newState) override;
+    void onError(const ErrorInfo& error) override;
+    void onAcquisitionStarted() override;
+    void onAcquisitionStopped() override;
+
+private:
+    struct ListenerEntry;
+    using ListenerList = std::vector<std::shared_ptr<ListenerEntry>>;
+
+    std::shared_ptr<const ListenerList> GetListeners() const;
+    void Demote(const std::shared_ptr<ListenerEntry>& entry);
+    void CountEvent(const char* name, const char* help, const char* labelName, const char* labelValue);
+
+    std::shared_ptr<const ListenerList> m_listeners;
+    mutable std::mutex m_mutex;
+
+    LatencyHistogram m_sdkToAdapter;
+    LatencyHistogram m_adapterToDispatch;
+    LatencyHistogram m_dispatchToListener;
+    LatencyHistogram m_listenerCallback;
+    LatencyHistogram m_endToEnd;
+
+    // Set once by BindMetrics(); null when metrics are not bound
+    MetricsRegistry* m_metrics = nullptr;
+    MetricLabels m_metricLabels;
+    MetricCounter* m_framesMetric = nullptr;
+    MetricCounter* m_bytesMetric = nullptr;
+    LatencyHistogram* m_latencyMetric = nullptr;
+    MetricGauge* m_stateMetric = nullptr;
+    MetricGauge* m_listenersMetric = nullptr;
+};
+
+} // namespace uxdi
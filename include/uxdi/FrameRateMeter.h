@@ -0,0 +1,85 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+#include <uxdi/LatencyHistogram.h>
+#include <uxdi/Types.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace uxdi {
+
+/**
+ * @brief Frame rate, throughput and callback time accounting for adapters
+ *
+ * Adapters call RecordFrame() for every frame they produce, whether or not a
+ * listener is attached, and RecordCallback() with the time their listener
+ * took. GetStatistics() can be called from any thread, so a supervisor can
+ * watch a detector's delivered rate without attaching a listener.
+ *
+ * The windowed figures come from a ring of time buckets, so they cover the
+ * trailing window to within one bucket. Recording is lock-free and never
+ * allocates. It expects one producer thread at a time; concurrent producers
+ * are safe, but a bucket may then lose a frame when it rolls over.
+ */
+class UXDI_API FrameRateMeter {
+public:
+    static constexpr size_t kBucketCount = 20;
+    static constexpr uint64_t kDefaultWindowNs = 2'000'000'000;
+
+    /**
+     * @param windowNs Length of the trailing window for windowFps/windowMBps
+     */
+    explicit FrameRateMeter(uint64_t windowNs = kDefaultWindowNs);
+
+    // Non-copyable, non-movable
+    FrameRateMeter(const FrameRateMeter&) = delete;
+    FrameRateMeter& operator=(const FrameRateMeter&) = delete;
+    FrameRateMeter(FrameRateMeter&&) = delete;
+    FrameRateMeter& operator=(FrameRateMeter&&) = delete;
+
+    /**
+     * @brief Count one produced frame
+     *
+     * @param bytes Pixel data size
+     * @param nowNs Production time from MonotonicNowNs()
+     */
+    void RecordFrame(size_t bytes, uint64_t nowNs = MonotonicNowNs());
+
+    /**
+     * @brief Record how long the listener callback for one frame took
+     */
+    void RecordCallback(uint64_t durationNs) { m_callback.Record(durationNs); }
+
+    /**
+     * @brief Compute statistics as of nowNs
+     */
+    DetectorStatistics GetStatistics(uint64_t nowNs = MonotonicNowNs()) const;
+
+    /**
+     * @brief Discard all recorded frames and callback times
+     *
+     * Not synchronized with RecordFrame(); call while no frames are produced.
+     */
+    void Reset();
+
+private:
+    struct Bucket {
+        std::atomic<uint64_t> epoch{0};    // Bucket index + 1 the counts belong to (0 = empty)
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    const uint64_t m_bucketNs;
+    std::array<Bucket, kBucketCount> m_buckets{};
+    std::atomic<uint64_t> m_frames{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_firstFrameNs{0};
+    std::atomic<uint64_t> m_lastFrameNs{0};
+    std::atomic<uint64_t> m_lastIntervalNs{0};
+    LatencyHistogram m_callback;
+};
+
+} // namespace uxdi
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <uxdi/FrameDeduplicator.h>
+#include <uxdi/IDetectorListener.h>
+#include <uxdi/RecordingFormat.h>
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace uxdi {
+
+/**
+ * @brief Options controlling recorder durability
+ */
+struct RecorderOptions {
+    uint32_t checkpointIntervalFrames = 64;    // Checkpoint after this many frames (0 = disabled)
+    uint32_t checkpointIntervalMs = 1000;      // Checkpoint after this much time (0 = disabled)
+    bool payloadChecksums = true;              // Store CRC-32 of each payload
+    size_t writeBufferBytes = 1024 * 1024;     // stdio buffer size for the container
+    bool deduplicate = false;                  // Record static frames as references
+    bool skipStaticFrames = false;             // Drop static frames instead (requires deduplicate)
+    DedupOptions dedup;                        // Static-frame detection settings
+};
+
+/**
+ * @brief Result of a recording recovery
+ */
+struct RecoveryReport {
+    uint64_t framesRecovered = 0;      // Total frames in the rebuilt index
+    uint64_t framesFromJournal = 0;    // Frames trusted from the last checkpoint
+    uint64_t framesRescanned = 0;      // Frames rebuilt by scanning the container tail
+    uint64_t bytesScanned = 0;         // Container bytes read during the tail scan
+    uint64_t bytesTruncated = 0;       // Torn bytes removed from the container
+    bool journalFound = false;         // Journal existed and had a valid header
+};
+
+/**
+ * @brief Crash-consistent frame recorder with a journaled index
+ *
+ * FrameRecorder appends frames to a container file and keeps an
+ * append-only journal (<path>.idx) of fixed-size index records. Every
+ * checkpoint interval both files are flushed and fsynced and a checkpoint
+ * record is appended, so a crash loses at most the frames written since
+ * the last checkpoint. Recover() rebuilds a valid recording from a torn
+ * file by scanning only the container bytes after the last checkpoint.
+ *
+ * A failed write leaves the files out of step with the recorder's offsets,
+ * so the first I/O error stops the recording: later writes and checkpoints
+ * are rejected and Close() only closes the files. Recover() then salvages
+ * everything up to the torn record.
+ *
+ * FrameRecorder implements IDetectorListener so it can be attached
+ * directly to a detector. All operations are thread-safe.
+ */
+class UXDI_API FrameRecorder : public IDetectorListener {
+public:
+    explicit FrameRecorder(const RecorderOptions& options = RecorderOptions{});
+    ~FrameRecorder() override;
+
+    // Non-copyable, non-movable
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+    FrameRecorder(FrameRecorder&&) = delete;
+    FrameRecorder& operator=(FrameRecorder&&) = delete;
+
+    /**
+     * @brief Create a new recording, truncating any existing files
+     *
+     * @param path Container file path (journal is written to path + ".idx")
+     * @return true on success, false on I/O error (see GetLastError)
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Append a frame to the recording
+     *
+     * Writes the frame record to the container and its index record to the
+     * journal, checkpointing when the configured interval elapses. With
+     * deduplication enabled, static frames are written as references to
+     * the last key frame (or skipped).
+     *
+     * @param image Frame to record
+     * @return true on success, false if not open, stopped by an earlier
+     *         write error, or on I/O error
+     */
+    bool WriteFrame(const ImageData& image);
+
+    /**
+     * @brief Append a payload-less record that refers to an earlier frame
+     *
+     * Used for static frames whose content matches referenceFrame.
+     *
+     * @param image Frame metadata (payload is ignored)
+     * @param referenceFrame Frame number whose payload this frame reuses
+     * @return true on success, false if not open, stopped by an earlier
+     *         write error, or on I/O error
+     */
+    bool WriteReference(const ImageData& image, uint64_t referenceFrame);
+
+    /**
+     * @brief Force a durable checkpoint now
+     *
+     * @return true on success, false if not open, stopped by an earlier
+     *         write error, or on I/O error
+     */
+    bool Checkpoint();
+
+    /**
+     * @brief Checkpoint and close the recording
+     *
+     * @return true on success (also true if already closed); false if the
+     *         recording was stopped by a write error
+     */
+    bool Close();
+
+    /**
+     * @brief Check whether a recording is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Get number of frames written to the current recording
+     */
+    uint64_t GetFrameCount() const;
+
+    /**
+     * @brief Get number of frames covered by the last checkpoint
+     */
+    uint64_t GetCheckpointedFrameCount() const;
+
+    /**
+     * @brief Get number of frames detected as static since Open
+     */
+    uint64_t GetStaticFrameCount() const;
+
+    /**
+     * @brief Get the last error
+     */
+    ErrorInfo GetLastError() const;
+
+    /**
+     * @brief Rebuild a valid recording after a crash
+     *
+     * Reads the journal up to its last valid checkpoint, then scans the
+     * container from that checkpoint's durable end, validating frame
+     * headers and payload checksums. The container is truncated at the
+     * last intact frame and the journal is rewritten to match, ending in
+     * a fresh checkpoint. Without a usable journal the whole container is
+     * scanned.
+     *
+     * @param path Container file path
+     * @param report Optional recovery statistics
+     * @return true if a valid recording was produced
+     */
+    static bool Recover(const std::string& path, RecoveryReport* report = nullptr);
+
+    // IDetectorListener implementation (records every received frame)
+    void onImageReceived(const ImageData& image) override;
+    void onStateChanged(DetectorState newState) override;
+    void onError(const ErrorInfo& error) override;
+    void onAcquisitionStarted() override;
+    void onAcquisitionStopped() override;
+
+private:
+    bool WriteRecord(const ImageData& image, uint32_t flags, uint64_t referenceFrame);
+    bool WriteCheckpointLocked();
+    bool CloseLocked();
+    bool CheckWritableLocked();
+    void SetError(ErrorCode code, const std::string& message);
+    void FailLocked(const std::string& message);
+
+    RecorderOptions m_options;
+    std::string m_path;
+    std::FILE* m_container = nullptr;
+    std::FILE* m_journal = nullptr;
+
+    uint64_t m_dataOffset = 0;           // Current end of the container
+    uint64_t m_frameCount = 0;           // Index records written
+    uint64_t m_checkpointedFrames = 0;   // Index records covered by last checkpoint
+    uint32_t m_framesSinceCheckpoint = 0;
+    uint64_t m_staticFrames = 0;
+    bool m_failed = false;               // A write failed; files no longer match the offsets
+    FrameDeduplicator m_dedup;
+    std::chrono::steady_clock::time_point m_lastCheckpoint;
+
+    ErrorInfo m_lastError;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace uxdi
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+#include <uxdi/LatencyHistogram.h>
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace uxdi {
+
+/**
+ * @brief Continuity and cadence statistics for one frame stream
+ */
+struct FrameSequenceStats {
+    uint64_t received = 0;          // Frames observed, duplicates included
+    uint64_t dropped = 0;           // Frame numbers skipped and not seen since
+    uint64_t duplicated = 0;        // Frame numbers delivered more than once
+    uint64_t outOfOrder = 0;        // Frames that arrived after a higher frame number
+    uint64_t firstFrameNumber = 0;
+    uint64_t highestFrameNumber = 0;
+    LatencySummary interval;        // Inter-arrival time
+    double intervalStdDevNs = 0.0;  // Inter-arrival jitter
+};
+
+/**
+ * @brief Checks frameNumber continuity of a frame stream
+ *
+ * Feed every delivered frame to Record(). A jump ahead counts the skipped
+ * numbers as dropped; a frame that later fills such a gap is reclassified
+ * as out of order. Numbers repeated within the last kReorderWindow frames
+ * count as duplicates; anything older is counted as out of order since it
+ * can no longer be told apart.
+ *
+ * Inter-arrival times are measured between consecutive Record() calls in
+ * arrival order. The stream may start at any frame number.
+ *
+ * Thread-safe; Record() does not allocate.
+ */
+class UXDI_API FrameSequenceTracker {
+public:
+    static constexpr size_t kReorderWindow = 1024;
+
+    FrameSequenceTracker() = default;
+
+    // Non-copyable, non-movable
+    FrameSequenceTracker(const FrameSequenceTracker&) = delete;
+    FrameSequenceTracker& operator=(const FrameSequenceTracker&) = delete;
+    FrameSequenceTracker(FrameSequenceTracker&&) = delete;
+    FrameSequenceTracker& operator=(FrameSequenceTracker&&) = delete;
+
+    /**
+     * @brief Record one delivered frame
+     *
+     * @param frameNumber ImageData::frameNumber of the frame
+     * @param arrivalNs Arrival time from MonotonicNowNs()
+     */
+    void Record(uint64_t frameNumber, uint64_t arrivalNs);
+
+    /**
+     * @brief Get counters and inter-arrival statistics so far
+     */
+    FrameSequenceStats GetStats() const;
+
+    /**
+     * @brief Forget all frames; the next one starts a new stream
+     */
+    void Reset();
+
+private:
+    mutable std::mutex m_mutex;
+    bool m_started = false;
+    FrameSequenceStats m_stats;
+    std::bitset<kReorderWindow> m_seen;  // Indexed by frameNumber % kReorderWindow
+
+    uint64_t m_lastArrivalNs = 0;
+    uint64_t m_intervalCount = 0;
+    double m_intervalMean = 0.0;
+    double m_intervalM2 = 0.0;           // Welford sum of squared deviations
+    LatencyHistogram m_intervals;
+};
+
+} // namespace uxdi
@@ -49,6 +49,10 @@ public:
     // Error handling
     virtual ErrorInfo getLastError() const = 0;
     virtual void clearError() = 0;
+
+    // Delivery statistics (frame rate, throughput, listener callback time).
+    // Adds a vtable slot: adapters must be rebuilt against this header.
+    virtual DetectorStatistics getStatistics() const { return DetectorStatistics{}; }
 };
 
 } // namespace uxdi
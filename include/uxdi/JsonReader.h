@@ -0,0 +1,245 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief Kind of a JSON value
+ */
+enum class JsonType : uint8_t {
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object
+};
+
+/**
+ * @brief Where and why a JSON document failed to parse
+ */
+struct UXDI_API JsonError {
+    size_t offset = 0;      // Byte offset of the offending character
+    size_t line = 0;        // 1-based
+    size_t column = 0;      // 1-based, in bytes
+    std::string message;
+
+    /**
+     * @brief "line 3, column 14: expected ',' or '}'"
+     */
+    std::string Format() const;
+};
+
+class JsonDocument;
+
+/**
+ * @brief Read-only handle to one value of a JsonDocument
+ *
+ * Two words, cheap to copy, valid while the document and its source text
+ * live. Looking up a missing key or reading the wrong type yields an
+ * invalid value or nullopt rather than an error, so optional settings read
+ * as root["generator"]["seed"].AsInt() without checks at each level.
+ */
+class UXDI_API JsonValue {
+public:
+    class Iterator;
+
+    JsonValue() = default;
+
+    bool IsValid() const { return m_document != nullptr; }
+    explicit operator bool() const { return IsValid(); }
+
+    /**
+     * @brief Type of the value; Null for an invalid value
+     */
+    JsonType GetType() const;
+    bool IsObject() const { return GetType() == JsonType::Object; }
+    bool IsArray() const { return GetType() == JsonType::Array; }
+    bool IsString() const { return GetType() == JsonType::String; }
+    bool IsNumber() const { return GetType() == JsonType::Number; }
+
+    /**
+     * @brief String contents with escapes decoded; nullopt unless a string
+     */
+    std::optional<std::string> AsString() const;
+
+    /**
+     * @brief Number value; nullopt unless a number
+     */
+    std::optional<double> AsDouble() const;
+
+    /**
+     * @brief Integer value; nullopt unless an integral number within int64_t
+     */
+    std::optional<int64_t> AsInt() const;
+
+    /**
+     * @brief Boolean value; nullopt unless true or false
+     */
+    std::optional<bool> AsBool() const;
+
+    /**
+     * @brief Source text of the value; strings without quotes, escapes left in
+     */
+    std::string_view Raw() const;
+
+    /**
+     * @brief Key of this value when it is an object member (escapes left in)
+     */
+    std::string_view Key() const;
+
+    /**
+     * @brief Number of array elements or object members; 0 for scalars
+     */
+    size_t Size() const;
+
+    /**
+     * @brief First member named key; invalid if absent or not an object
+     *
+     * Linear in the number of members of this object only.
+     */
+    JsonValue Find(std::string_view key) const;
+    JsonValue operator[](std::string_view key) const { return Find(key); }
+
+    /**
+     * @brief Elements of an array or members of an object, in document order
+     */
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    friend class JsonDocument;
+
+    JsonValue(const JsonDocument* document, uint32_t index)
+        : m_document(document)
+        , m_index(index)
+    {
+    }
+
+    const JsonDocument* m_document = nullptr;
+    uint32_t m_index = 0;
+};
+
+/**
+ * @brief Forward iterator over the children of an array or object
+ */
+class UXDI_API JsonValue::Iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = JsonValue;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const JsonValue*;
+    using reference = JsonValue;
+
+    Iterator() = default;
+
+    JsonValue operator*() const { return JsonValue(m_document, m_index); }
+    Iterator& operator++();
+    Iterator operator++(int) {
+        Iterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const Iterator& other) const { return m_remaining == other.m_remaining; }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+private:
+    friend class JsonValue;
+
+    Iterator(const JsonDocument* document, uint32_t index, size_t remaining)
+        : m_document(document)
+        , m_index(index)
+        , m_remaining(remaining)
+    {
+    }
+
+    const JsonDocument* m_document = nullptr;
+    uint32_t m_index = 0;
+    size_t m_remaining = 0;
+};
+
+/**
+ * @brief Single-pass JSON reader over a string_view
+ *
+ * Parse() validates the text in one recursive-descent pass (RFC 8259, no
+ * extensions) and records every value as a fixed-size node in one vector,
+ * in document order. Nodes refer back into the source text, so nothing is
+ * copied or decoded until a value is read, and each node knows where its
+ * subtree ends, so walking an object's members skips nested values in
+ * constant time. Parsing a document is linear in its size and allocates
+ * only the node vector.
+ *
+ * The source text must outlive the document and every JsonValue taken from
+ * it. Not thread-safe to Parse() while values are read; reading alone is.
+ */
+class UXDI_API JsonDocument {
+public:
+    /// Nesting deeper than this is rejected rather than risking the stack
+    static constexpr size_t kMaxDepth = 256;
+
+    JsonDocument() = default;
+
+    // Non-copyable, non-movable: values point at the document
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+    JsonDocument(JsonDocument&&) = delete;
+    JsonDocument& operator=(JsonDocument&&) = delete;
+
+    /**
+     * @brief Parse text, replacing any previous document
+     * @return false on malformed input; GetError() says where and why
+     */
+    bool Parse(std::string_view text);
+
+    /**
+     * @brief Top-level value; invalid until a successful Parse()
+     */
+    JsonValue Root() const;
+
+    const JsonError& GetError() const { return m_error; }
+
+    /**
+     * @brief Number of values in the document
+     */
+    size_t GetValueCount() const { return m_nodes.size(); }
+
+private:
+    friend class JsonValue;
+    friend class JsonValue::Iterator;
+    friend class JsonParser;
+
+    struct Node {
+        uint32_t begin = 0;         // Value text; inside the quotes for strings
+        uint32_t length = 0;
+        uint32_t keyBegin = 0;      // Member key text, inside the quotes
+        uint32_t keyLength = 0;
+        uint32_t count = 0;         // Children of an array or object
+        uint32_t end = 0;           // Index one past this node's subtree
+        JsonType type = JsonType::Null;
+        bool escaped = false;       // String value contains escapes
+        bool keyEscaped = false;    // Member key contains escapes
+    };
+
+    std::string_view m_text;
+    std::vector<Node> m_nodes;
+    JsonError m_error;
+};
+
+/**
+ * @brief Decode the escapes of a JSON string body (text between the quotes)
+ *
+ * \uXXXX escapes, including surrogate pairs, are written as UTF-8.
+ */
+UXDI_API std::string UnescapeJsonString(std::string_view body);
+
+} // namespace uxdi
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace uxdi {
+
+/**
+ * @brief Percentile summary of a latency histogram (all values in nanoseconds)
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t minNs = 0;
+    uint64_t maxNs = 0;
+    double meanNs = 0.0;
+    uint64_t p50Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t p999Ns = 0;
+};
+
+/**
+ * @brief Fixed-size log-linear latency histogram (HDR-style)
+ *
+ * Values below 128 ns are counted exactly; larger values fall into buckets
+ * that keep the top 7 significant bits, so any reported percentile is
+ * within 1/64 (~1.6%) of the true value. Values above ~18 minutes are
+ * clamped into the last bucket.
+ *
+ * Record() is lock-free and never allocates, so it is safe on acquisition
+ * threads. Readers may run concurrently with writers and see a summary
+ * that is consistent to within the samples recorded meanwhile.
+ */
+class UXDI_API LatencyHistogram {
+public:
+    static constexpr uint32_t kSubBucketBits = 7;
+    static constexpr uint64_t kMaxTrackableNs = (uint64_t{1} << 40) - 1;
+
+    LatencyHistogram() = default;
+
+    // Non-copyable, non-movable
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    LatencyHistogram(LatencyHistogram&&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+
+    /**
+     * @brief Record one sample
+     *
+     * @param valueNs Latency in nanoseconds
+     */
+    void Record(uint64_t valueNs);
+
+    /**
+     * @brief Get number of recorded samples
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * @brief Get smallest recorded sample (0 if empty)
+     */
+    uint64_t GetMin() const;
+
+    /**
+     * @brief Get largest recorded sample (0 if empty)
+     */
+    uint64_t GetMax() const;
+
+    /**
+     * @brief Get arithmetic mean of recorded samples (0 if empty)
+     */
+    double GetMean() const;
+
+    /**
+     * @brief Get the value at a percentile
+     *
+     * @param percentile Percentile in [0, 100]
+     * @return Upper bound of the bucket holding the percentile (0 if empty)
+     */
+    uint64_t GetPercentile(double percentile) const;
+
+    /**
+     * @brief Get count, min, max, mean, p50, p99 and p99.9 in one pass
+     */
+    LatencySummary Summarize() const;
+
+    /**
+     * @brief Discard all samples
+     */
+    void Reset();
+
+private:
+    static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;     // 128
+    static constexpr size_t kSubBucketHalf = kSubBucketCount / 2;              // 64
+    static constexpr size_t kBucketCount = kSubBucketCount + (40 - kSubBucketBits) * kSubBucketHalf;
+
+    static size_t BucketIndex(uint64_t valueNs);
+    static uint64_t BucketUpperBound(size_t index);
+
+    std::array<std::atomic<uint64_t>, kBucketCount> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_min{UINT64_MAX};
+    std::atomic<uint64_t> m_max{0};
+};
+
+} // namespace uxdi
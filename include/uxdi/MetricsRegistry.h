@@ -0,0 +1,200 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+#include <uxdi/LatencyHistogram.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uxdi {
+
+// Label name/value pairs attached to one metric series
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+enum class MetricType {
+    Counter,
+    Gauge,
+    Summary   // LatencyHistogram, exported in seconds
+};
+
+/**
+ * @brief Monotonic counter sharded across threads
+ *
+ * Each thread increments its own cache-line-sized shard, so concurrent
+ * writers never contend; GetValue() sums the shards.
+ */
+class UXDI_API MetricCounter {
+public:
+    static constexpr size_t kShardCount = 16;
+
+    MetricCounter() = default;
+
+    // Non-copyable, non-movable
+    MetricCounter(const MetricCounter&) = delete;
+    MetricCounter& operator=(const MetricCounter&) = delete;
+    MetricCounter(MetricCounter&&) = delete;
+    MetricCounter& operator=(MetricCounter&&) = delete;
+
+    void Increment(uint64_t amount = 1) {
+        m_shards[ThisThreadShard()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    uint64_t GetValue() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    static size_t ThisThreadShard() {
+        static std::atomic<size_t> nextShard{0};
+        thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return shard;
+    }
+
+    std::array<Shard, kShardCount> m_shards{};
+};
+
+/**
+ * @brief Value that can go up and down (queue depth, detector count, ...)
+ */
+class UXDI_API MetricGauge {
+public:
+    MetricGauge() = default;
+
+    // Non-copyable, non-movable
+    MetricGauge(const MetricGauge&) = delete;
+    MetricGauge& operator=(const MetricGauge&) = delete;
+    MetricGauge(MetricGauge&&) = delete;
+    MetricGauge& operator=(MetricGauge&&) = delete;
+
+    void Set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    void Add(int64_t delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    int64_t GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * @brief Point-in-time value of one metric series
+ */
+struct MetricSample {
+    std::string name;
+    std::string help;
+    MetricType type = MetricType::Counter;
+    MetricLabels labels;
+    double value = 0.0;        // Counter and gauge value
+    LatencySummary summary;    // Summary metrics (nanoseconds)
+};
+
+/**
+ * @brief Registry of named counters, gauges and latency summaries
+ *
+ * Series are identified by name plus labels and live as long as the
+ * registry; the Get* methods return the existing series when called again,
+ * so hot paths look a series up once and keep the reference. Recording is
+ * lock-free; only registration and snapshots take the registry lock.
+ *
+ * Global() is the process-wide registry that DetectorManager reports into.
+ * Adapter DLLs link their own copy of uxdi_core, so per-detector metrics are
+ * collected on the host side by the FrameDispatcher rather than inside the
+ * adapters.
+ */
+class UXDI_API MetricsRegistry {
+public:
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    // Non-copyable, non-movable
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    MetricsRegistry(MetricsRegistry&&) = delete;
+    MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+    /**
+     * @brief Process-wide registry
+     */
+    static MetricsRegistry& Global();
+
+    /**
+     * @brief Get or create a counter series
+     *
+     * @param name Metric name ([a-zA-Z_:][a-zA-Z0-9_:]*), conventionally ending in _total
+     * @param help One-line description (taken from the first registration)
+     * @param labels Series labels
+     * @throws std::invalid_argument if the name is invalid or registered with another type
+     */
+    MetricCounter& GetCounter(const std::string& name, const std::string& help,
+                              const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a gauge series
+     *
+     * @throws std::invalid_argument if the name is invalid or registered with another type
+     */
+    MetricGauge& GetGauge(const std::string& name, const std::string& help,
+                          const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a latency series, recorded in nanoseconds
+     *
+     * Exported as a Prometheus summary in seconds (p50, p99, p99.9), so the
+     * name should end in _seconds.
+     *
+     * @throws std::invalid_argument if the name is invalid or registered with another type
+     */
+    LatencyHistogram& GetHistogram(const std::string& name, const std::string& help,
+                                   const MetricLabels& labels = {});
+
+    /**
+     * @brief Read every series, ordered by name and labels
+     */
+    std::vector<MetricSample> Snapshot() const;
+
+    /**
+     * @brief Render all series in Prometheus text exposition format (0.0.4)
+     */
+    std::string FormatPrometheus() const;
+
+    /**
+     * @brief Write FormatPrometheus() to a file
+     *
+     * Writes to a temporary file and renames it over the target, so a
+     * scraper (e.g. the node_exporter textfile collector) never sees a
+     * partial file.
+     *
+     * @return false if the file could not be written
+     */
+    bool WritePrometheus(const std::string& path) const;
+
+private:
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<LatencyHistogram> histogram;
+    };
+
+    struct Family {
+        std::string help;
+        MetricType type = MetricType::Counter;
+        std::map<std::string, Series> series;  // Keyed by rendered labels
+    };
+
+    Series& GetSeries(const std::string& name, const std::string& help,
+                      MetricType type, const MetricLabels& labels);
+
+    std::map<std::string, Family> m_families;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace uxdi
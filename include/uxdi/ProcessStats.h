@@ -0,0 +1,30 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <cstdint>
+
+namespace uxdi {
+
+/**
+ * @brief Resource usage of the current process at one point in time
+ *
+ * Fields the platform cannot report are left at 0.
+ */
+struct ProcessStats {
+    uint64_t residentBytes = 0;      // Resident set / working set
+    uint64_t peakResidentBytes = 0;  // High-water mark of residentBytes
+    uint32_t threadCount = 0;
+    uint64_t cpuTimeNs = 0;          // User + system CPU time consumed so far
+};
+
+/**
+ * @brief Sample resident memory, thread count and CPU time of the current process
+ *
+ * Reads /proc/self/status and getrusage() on Linux and uses the
+ * process/toolhelp APIs on Windows. CPU time is cumulative; divide the
+ * difference of two samples by the wall time between them for utilization. Cheap enough to poll once a second over a long run.
+ */
+UXDI_API ProcessStats SampleProcessStats();
+
+} // namespace uxdi
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace uxdi {
+namespace recording {
+
+/**
+ * On-disk layout of a UXDI frame recording
+ *
+ * A recording consists of two files:
+ * - Container (<path>):      ContainerHeader followed by frame records
+ *                            (FrameRecordHeader + payload bytes)
+ * - Journal   (<path>.idx):  JournalHeader followed by fixed-size
+ *                            JournalRecord entries (append-only)
+ *
+ * Every frame appends one INDEX record to the journal. Periodically the
+ * recorder fsyncs both files and appends a CHECKPOINT record whose
+ * dataEnd marks the durable end of the container. Recovery trusts every
+ * index record before the last valid checkpoint and only rescans the
+ * container tail after checkpoint.dataEnd.
+ *
+ * All integers are little-endian; structures are packed to fixed sizes.
+ */
+
+constexpr uint32_t kContainerMagic  = 0x52445855;  // "UXDR"
+constexpr uint32_t kJournalMagic    = 0x4A445855;  // "UXDJ"
+constexpr uint32_t kFrameMagic      = 0x46445855;  // "UXDF"
+constexpr uint32_t kFormatVersion   = 1;
+
+// Journal record types
+constexpr uint32_t kRecordIndex      = 1;
+constexpr uint32_t kRecordCheckpoint = 2;
+
+// Frame record flags
+constexpr uint32_t kFrameFlagNone      = 0;
+constexpr uint32_t kFrameFlagReference = 1u << 0;  // No payload; refers to an earlier frame
+constexpr uint32_t kFrameFlagPayloadCrc = 1u << 1;  // payloadCrc is valid
+
+#pragma pack(push, 1)
+
+/**
+ * @brief Header at the start of the container file
+ */
+struct ContainerHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t createdAtNs;   // Wall-clock creation time (ns since epoch)
+    uint64_t reserved[2];
+};
+
+/**
+ * @brief Header preceding each frame payload in the container
+ *
+ * headerCrc covers all preceding fields; payloadCrc covers the payload
+ * bytes and is only valid when kFrameFlagPayloadCrc is set.
+ */
+struct FrameRecordHeader {
+    uint32_t magic;
+    uint32_t flags;
+    uint64_t frameNumber;
+    double   timestamp;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bitDepth;
+    uint32_t payloadCrc;
+    uint64_t dataLength;
+    uint64_t referenceFrame;  // Valid when kFrameFlagReference is set
+    uint32_t reserved;
+    uint32_t headerCrc;
+};
+
+/**
+ * @brief Header at the start of the journal file
+ */
+struct JournalHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Fixed-size journal record
+ *
+ * INDEX:      frameNumber/timestamp/offset/length/flags describe one frame
+ *             record in the container (offset points at its header).
+ * CHECKPOINT: frameNumber holds the number of INDEX records before it,
+ *             offset holds the durable end of the container.
+ */
+struct JournalRecord {
+    uint32_t type;
+    uint32_t flags;
+    uint64_t frameNumber;
+    double   timestamp;
+    uint64_t offset;
+    uint64_t length;
+    uint32_t reserved;
+    uint32_t crc;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(ContainerHeader) == 32, "ContainerHeader layout changed");
+static_assert(sizeof(FrameRecordHeader) == 64, "FrameRecordHeader layout changed");
+static_assert(sizeof(JournalHeader) == 16, "JournalHeader layout changed");
+static_assert(sizeof(JournalRecord) == 48, "JournalRecord layout changed");
+
+/**
+ * @brief Compute CRC-32 (IEEE 802.3) of a byte range
+ *
+ * @param data Pointer to bytes
+ * @param length Number of bytes
+ * @param seed Previous CRC value for incremental computation
+ * @return CRC-32 checksum
+ */
+UXDI_API uint32_t ComputeCrc32(const void* data, size_t length, uint32_t seed = 0);
+
+/**
+ * @brief Check a journal record's CRC and type
+ */
+UXDI_API bool IsValidJournalRecord(const JournalRecord& record);
+
+/**
+ * @brief Check a frame record header's magic and CRC
+ */
+UXDI_API bool IsValidFrameHeader(const FrameRecordHeader& header);
+
+// Journal file path is the container path with this suffix appended
+constexpr const char* kJournalSuffix = ".idx";
+
+} // namespace recording
+} // namespace uxdi
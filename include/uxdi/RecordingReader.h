@@ -0,0 +1,235 @@
+#pragma once
+
+#include <uxdi/RecordingFormat.h>
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief One frame in a recording's index
+ */
+struct RecordingIndexEntry {
+    uint64_t frameNumber = 0;
+    double timestamp = 0.0;
+    uint64_t offset = 0;        // Frame record header offset in the container
+    uint64_t length = 0;        // Payload bytes (0 for references)
+    uint32_t flags = 0;         // recording::kFrameFlag* bits
+};
+
+/**
+ * @brief Options for reading recordings
+ */
+struct RecordingReaderOptions {
+    bool verifyPayloadChecksums = false;   // Check payload CRC on every read
+};
+
+/**
+ * @brief Payload cache reused across reads of consecutive static frames
+ */
+struct RecordingPayloadCache {
+    size_t payloadIndex = static_cast<size_t>(-1);
+    std::shared_ptr<uint8_t[]> data;
+};
+
+class RecordingReader;
+
+/**
+ * @brief Iterator that reads upcoming frames on a background thread
+ *
+ * The readahead thread keeps up to `depth` frames decoded ahead of the
+ * consumer using its own file handle, so stepping through a recording
+ * only blocks when the disk cannot keep up. The reader must outlive the
+ * iterator, and cannot be closed or reopened while iterators exist.
+ */
+class UXDI_API PrefetchingFrameIterator {
+public:
+    PrefetchingFrameIterator(const RecordingReader& reader, std::vector<size_t> indices, size_t depth);
+    ~PrefetchingFrameIterator();
+
+    // Non-copyable, non-movable
+    PrefetchingFrameIterator(const PrefetchingFrameIterator&) = delete;
+    PrefetchingFrameIterator& operator=(const PrefetchingFrameIterator&) = delete;
+    PrefetchingFrameIterator(PrefetchingFrameIterator&&) = delete;
+    PrefetchingFrameIterator& operator=(PrefetchingFrameIterator&&) = delete;
+
+    /**
+     * @brief Get the next frame, waiting for the readahead thread if needed
+     *
+     * @param outImage Receives the frame
+     * @return false at the end of the sequence or on a read error
+     */
+    bool Next(ImageData& outImage);
+
+    /**
+     * @brief Get number of frames not yet returned by Next()
+     */
+    size_t GetRemaining() const;
+
+private:
+    struct Prefetched {
+        ImageData image;
+        bool ok = false;
+    };
+
+    void ReadaheadLoop();
+
+    const RecordingReader& m_reader;
+    std::vector<size_t> m_indices;
+    size_t m_depth;
+    size_t m_consumed = 0;
+    size_t m_produced = 0;
+    std::deque<Prefetched> m_ready;
+    bool m_stop = false;
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+/**
+ * @brief Random-access reader for recordings written by FrameRecorder
+ *
+ * Open() loads the journal index, then scans frame headers in the container
+ * past the last indexed frame, so recordings that are still being written
+ * or have no usable journal remain readable. Timestamp lookups
+ * are binary searches over a time-ordered view of the index, and range
+ * queries support a stride for "every Nth frame" scans. Static frames
+ * recorded as references resolve to their key frame's pixels.
+ *
+ * All operations are thread-safe. Lookups and iterators share the index;
+ * Open() and Close() replace it and wait for them. Iterators use their own
+ * file handles.
+ */
+class UXDI_API RecordingReader {
+public:
+    explicit RecordingReader(const RecordingReaderOptions& options = RecordingReaderOptions{});
+    ~RecordingReader();
+
+    // Non-copyable, non-movable
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+    RecordingReader(RecordingReader&&) = delete;
+    RecordingReader& operator=(RecordingReader&&) = delete;
+
+    /**
+     * @brief Open a recording and load its index
+     *
+     * @param path Container file path
+     * @return true on success; false on I/O error, for a foreign file, or
+     *         while iterators exist
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Close the recording
+     *
+     * @return true on success (also true if already closed); false while
+     *         iterators exist
+     */
+    bool Close();
+
+    /**
+     * @brief Check whether a recording is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Get number of frames in the index
+     */
+    size_t GetFrameCount() const;
+
+    /**
+     * @brief Get an index entry
+     *
+     * @param index Frame position in recording order
+     * @param outEntry Receives the entry
+     * @return false if index is out of range
+     */
+    bool GetEntry(size_t index, RecordingIndexEntry& outEntry) const;
+
+    /**
+     * @brief Find the first frame at or after a timestamp
+     *
+     * @param timestamp Time in seconds (same clock as ImageData::timestamp)
+     * @return Frame index, or GetFrameCount() if every frame is earlier
+     */
+    size_t FindByTimestamp(double timestamp) const;
+
+    /**
+     * @brief Get frames with t0 <= timestamp < t1 in time order
+     *
+     * @param t0 Range start (inclusive)
+     * @param t1 Range end (exclusive)
+     * @param stride Return every Nth matching frame (0 is treated as 1)
+     * @return Frame indices
+     */
+    std::vector<size_t> QueryTimeRange(double t0, double t1, size_t stride = 1) const;
+
+    /**
+     * @brief Get frames first <= index < last in recording order
+     *
+     * @param first Range start (inclusive)
+     * @param last Range end (exclusive, clamped to the frame count)
+     * @param stride Return every Nth frame (0 is treated as 1)
+     * @return Frame indices
+     */
+    std::vector<size_t> QueryIndexRange(size_t first, size_t last, size_t stride = 1) const;
+
+    /**
+     * @brief Read a frame's metadata and pixels
+     *
+     * @param index Frame position in recording order
+     * @param outImage Receives the frame
+     * @return false if out of range, on I/O error or checksum mismatch
+     */
+    bool ReadFrame(size_t index, ImageData& outImage) const;
+
+    /**
+     * @brief Create an iterator that prefetches the given frames
+     *
+     * @param indices Frames to visit, e.g. from QueryTimeRange()
+     * @param depth Number of frames to read ahead
+     */
+    std::unique_ptr<PrefetchingFrameIterator> Iterate(std::vector<size_t> indices, size_t depth = 8) const;
+
+private:
+    friend class PrefetchingFrameIterator;
+
+    bool LoadJournal(uint64_t containerSize);
+    void ScanContainer(uint64_t start, uint64_t containerSize);
+    void BuildLookups();
+    void CloseLocked();
+    size_t ResolveReference(uint64_t referenceFrame, size_t index) const;
+    bool ReadFrameFrom(std::ifstream& file, size_t index, ImageData& outImage,
+                       RecordingPayloadCache* cache) const;
+
+    RecordingReaderOptions m_options;
+
+    // Index; Open() and Close() write it under an exclusive lock
+    std::string m_path;
+    std::vector<RecordingIndexEntry> m_entries;
+    std::vector<size_t> m_timeOrder;   // Empty when timestamps are already non-decreasing
+    std::unordered_map<uint64_t, std::vector<size_t>> m_keyFrames;  // frameNumber -> key frame indices
+    mutable std::shared_mutex m_indexMutex;
+
+    // ReadFrame() state; taken before m_indexMutex
+    mutable std::ifstream m_file;
+    mutable RecordingPayloadCache m_cache;
+    mutable size_t m_iterators = 0;    // Live PrefetchingFrameIterators
+    mutable std::mutex m_mutex;
+};
+
+} // namespace uxdi
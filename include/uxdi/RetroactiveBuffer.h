@@ -0,0 +1,143 @@
+#pragma once
+
+#include <uxdi/IDetectorListener.h>
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace uxdi {
+
+class FrameRecorder;
+
+/**
+ * @brief Options controlling the pre-trigger ring
+ */
+struct RetroactiveBufferOptions {
+    size_t maxBytes = 256ull * 1024 * 1024;   // Pixel memory budget for the ring
+    uint32_t maxFrames = 0;                   // Ring length limit (0 = limited by maxBytes)
+    double maxAgeSeconds = 0.0;               // Only commit frames this recent (0 = all)
+};
+
+/**
+ * @brief Pre-trigger frame ring ("record the last N seconds")
+ *
+ * RetroactiveBuffer is a listener that keeps the most recent frames in a
+ * ring of preallocated slots. Incoming frames are copied into the oldest
+ * slot, so steady-state operation performs no allocation. The ring is
+ * sized from the byte budget when the first frame (or a frame of a new
+ * size) arrives.
+ *
+ * Trigger() commits the buffered frames followed by the next M frames to
+ * a FrameRecorder. Disk writes run on an internal writer thread so the
+ * detector callback only ever performs a memcpy. If the writer falls so
+ * far behind that an uncommitted slot is overwritten, the lost frames
+ * are counted in GetDroppedFrameCount().
+ */
+class UXDI_API RetroactiveBuffer : public IDetectorListener {
+public:
+    explicit RetroactiveBuffer(const RetroactiveBufferOptions& options = RetroactiveBufferOptions{});
+    ~RetroactiveBuffer() override;
+
+    // Non-copyable, non-movable
+    RetroactiveBuffer(const RetroactiveBuffer&) = delete;
+    RetroactiveBuffer& operator=(const RetroactiveBuffer&) = delete;
+    RetroactiveBuffer(RetroactiveBuffer&&) = delete;
+    RetroactiveBuffer& operator=(RetroactiveBuffer&&) = delete;
+
+    /**
+     * @brief Commit the ring plus the next frames to a recorder
+     *
+     * Frames already committed by an earlier trigger are not written twice.
+     * The recorder must stay open until the capture completes.
+     *
+     * @param recorder Open recorder to write to
+     * @param postTriggerFrames Number of frames to capture after the trigger
+     * @return true if the capture was started, false if the recorder is not
+     *         open or a capture is already in progress
+     */
+    bool Trigger(FrameRecorder& recorder, uint32_t postTriggerFrames);
+
+    /**
+     * @brief Stop the current capture after the frame being written
+     */
+    void Cancel();
+
+    /**
+     * @brief Check whether a triggered capture is still being written
+     */
+    bool IsCapturing() const;
+
+    /**
+     * @brief Wait until the current capture has been written
+     *
+     * @param timeoutMs Maximum time to wait
+     * @return true if no capture is in progress on return
+     */
+    bool WaitForCapture(uint32_t timeoutMs) const;
+
+    /**
+     * @brief Discard all buffered frames (slots are kept)
+     */
+    void Clear();
+
+    /**
+     * @brief Get number of frames currently held in the ring
+     */
+    size_t GetBufferedFrameCount() const;
+
+    /**
+     * @brief Get ring capacity in frames for the current frame size
+     */
+    size_t GetCapacityFrames() const;
+
+    /**
+     * @brief Get pixel memory held by the ring in bytes
+     */
+    size_t GetBufferedBytes() const;
+
+    /**
+     * @brief Get number of frames lost to overrun or an exhausted budget
+     */
+    uint64_t GetDroppedFrameCount() const;
+
+    // IDetectorListener implementation
+    void onImageReceived(const ImageData& image) override;
+    void onStateChanged(DetectorState newState) override;
+    void onError(const ErrorInfo& error) override;
+    void onAcquisitionStarted() override;
+    void onAcquisitionStopped() override;
+
+private:
+    struct Slot {
+        ImageData image;      // Metadata plus pooled pixel buffer
+        uint64_t sequence = 0;
+    };
+
+    void ResizeLocked(size_t frameBytes);
+    uint64_t OldestSequenceLocked() const;
+    bool HasPendingLocked() const;
+    void WriterLoop();
+
+    RetroactiveBufferOptions m_options;
+    std::vector<Slot> m_slots;
+    size_t m_frameBytes = 0;
+
+    uint64_t m_nextSequence = 1;      // Sequence assigned to the next frame
+    uint64_t m_ringStart = 1;         // First sequence stored since the last reset
+    uint64_t m_committedSequence = 0; // Last sequence written to the recorder
+    uint64_t m_commitLimit = 0;       // Write frames up to this sequence
+    uint64_t m_droppedFrames = 0;
+    FrameRecorder* m_recorder = nullptr;
+
+    bool m_stopWriter = false;
+    std::thread m_writer;
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_cv;
+};
+
+} // namespace uxdi
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <uxdi/IDetectorSynchronous.h>
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace uxdi {
+
+class SpillableFrameStore;
+
+/**
+ * @brief Options controlling memory use of a spillable store
+ */
+struct SpillOptions {
+    size_t hotBytes = 512ull * 1024 * 1024;         // Newest frames kept in RAM
+    size_t maxPendingBytes = 256ull * 1024 * 1024;  // Spill backlog before Append blocks
+    std::string scratchDirectory;                   // Empty = system temp directory
+};
+
+/**
+ * @brief Handle to a frame in a SpillableFrameStore
+ *
+ * Handles are cheap to copy. Load() returns the frame whether it is still
+ * in memory or has been spilled, paging it back in from the scratch file
+ * when needed. A handle must not outlive its store.
+ */
+class UXDI_API FrameHandle {
+public:
+    FrameHandle() = default;
+
+    /**
+     * @brief Check whether the handle refers to a frame
+     */
+    bool IsValid() const { return m_store != nullptr; }
+
+    /**
+     * @brief Get the frame's position in the store
+     */
+    size_t GetIndex() const { return m_index; }
+
+    /**
+     * @brief Check whether the frame's pixels are in memory
+     */
+    bool IsResident() const;
+
+    /**
+     * @brief Get the frame, paging it in from disk if necessary
+     *
+     * @param outImage Receives the frame
+     * @return true on success, false if invalid or on I/O error
+     */
+    bool Load(ImageData& outImage) const;
+
+private:
+    friend class SpillableFrameStore;
+    FrameHandle(const SpillableFrameStore* store, size_t index)
+        : m_store(store), m_index(index) {}
+
+    const SpillableFrameStore* m_store = nullptr;
+    size_t m_index = 0;
+};
+
+/**
+ * @brief Frame store that spills older frames to a scratch file
+ *
+ * The newest frames (up to hotBytes) stay in memory. Older frames are
+ * queued to a writer thread which appends them to a scratch file and then
+ * releases their pixel memory, so long bursts are bounded by disk space
+ * rather than RAM. Append() only blocks when the spill backlog exceeds
+ * maxPendingBytes, so sustained throughput is limited by the disk. If the
+ * scratch file cannot be created or written, frames that no longer fit in
+ * the hot window are rejected.
+ *
+ * Appended frames share their pixel buffer with the caller; the buffer
+ * must not be modified afterwards. Borrowed buffers (see ImageData) are
+ * copied instead. The
+ * scratch file is deleted when the store is destroyed. All operations are
+ * thread-safe.
+ */
+class UXDI_API SpillableFrameStore {
+public:
+    explicit SpillableFrameStore(const SpillOptions& options = SpillOptions{});
+    ~SpillableFrameStore();
+
+    // Non-copyable, non-movable
+    SpillableFrameStore(const SpillableFrameStore&) = delete;
+    SpillableFrameStore& operator=(const SpillableFrameStore&) = delete;
+    SpillableFrameStore(SpillableFrameStore&&) = delete;
+    SpillableFrameStore& operator=(SpillableFrameStore&&) = delete;
+
+    /**
+     * @brief Add a frame to the store
+     *
+     * @param image Frame to store (owned buffers are shared, not copied)
+     * @return Handle to the stored frame, or an invalid handle if spilling
+     *         failed and the hot window is full (see GetLastError)
+     */
+    FrameHandle Append(const ImageData& image);
+
+    /**
+     * @brief Get a handle to a stored frame
+     *
+     * @param index Frame position (0 = first appended)
+     * @return Handle, or an invalid handle if index is out of range
+     */
+    FrameHandle GetHandle(size_t index) const;
+
+    /**
+     * @brief Get a stored frame, paging it in if necessary
+     *
+     * @param index Frame position
+     * @param outImage Receives the frame
+     * @return true on success, false if out of range or on I/O error
+     */
+    bool Load(size_t index, ImageData& outImage) const;
+
+    /**
+     * @brief Wait until all queued spills have been written
+     */
+    void Flush();
+
+    /**
+     * @brief Get number of stored frames
+     */
+    size_t GetFrameCount() const;
+
+    /**
+     * @brief Get number of frames whose pixels live only on disk
+     */
+    size_t GetSpilledFrameCount() const;
+
+    /**
+     * @brief Get pixel bytes currently held in memory
+     */
+    size_t GetResidentBytes() const;
+
+    /**
+     * @brief Get the scratch file path (empty until the first spill)
+     */
+    std::string GetScratchPath() const;
+
+    /**
+     * @brief Get the last error
+     */
+    ErrorInfo GetLastError() const;
+
+private:
+    friend class FrameHandle;
+
+    enum class EntryState {
+        Resident,   // Pixels only in memory
+        Queued,     // Queued for the writer, still in memory
+        Spilled     // Pixels only in the scratch file
+    };
+
+    struct Entry {
+        ImageData image;                       // data is null once spilled
+        EntryState state = EntryState::Resident;
+        uint64_t offset = 0;                   // Scratch file offset when spilled
+        mutable std::weak_ptr<uint8_t[]> pagedIn;  // Last paged-in copy
+    };
+
+    bool IsResident(size_t index) const;
+    bool OpenScratchLocked();
+    void WriterLoop();
+    void SetErrorLocked(ErrorCode code, const std::string& message) const;
+
+    SpillOptions m_options;
+    std::vector<Entry> m_entries;
+    std::deque<size_t> m_queue;
+    size_t m_nextToSpill = 0;
+    size_t m_hotBytes = 0;
+    size_t m_pendingBytes = 0;
+    size_t m_spilledFrames = 0;
+    bool m_writeFailed = false;
+
+    std::string m_scratchPath;
+    std::FILE* m_scratch = nullptr;
+    uint64_t m_scratchEnd = 0;
+    mutable std::FILE* m_reader = nullptr;
+    mutable std::mutex m_readMutex;
+
+    mutable ErrorInfo m_lastError;
+    bool m_stopWriter = false;
+    std::thread m_writer;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+/**
+ * @brief Acquire a burst of frames directly into a spillable store
+ *
+ * Equivalent to IDetectorSynchronous::acquireFrames() but the frames go to
+ * the store instead of a std::vector, so bursts larger than RAM succeed.
+ *
+ * @param detector Synchronous acquisition interface
+ * @param frameCount Number of frames to acquire
+ * @param store Destination store
+ * @param timeoutMs Timeout for the whole burst
+ * @return true if all frames were acquired and stored
+ */
+UXDI_API bool AcquireFramesToStore(IDetectorSynchronous& detector, uint32_t frameCount,
+                                   SpillableFrameStore& store, uint32_t timeoutMs = 30000);
+
+} // namespace uxdi
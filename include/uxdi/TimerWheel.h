@@ -0,0 +1,75 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief Hashed timing wheel of (key, deadline) entries
+ *
+ * Time is cut into ticks of tickNs; an entry lives in slot
+ * (deadline / tickNs) % slotCount, so scheduling is O(1) and popping the
+ * entries that fell due costs one slot per elapsed tick, however many
+ * entries are waiting further out. Entries more than one revolution ahead
+ * share a slot with nearer ones and are left in place until their own
+ * revolution comes round.
+ *
+ * Keys are opaque; the wheel does not deduplicate or cancel them, so an
+ * owner that reschedules or removes work tags its keys and drops stale
+ * ones when they pop. Not thread-safe; the owner serializes all calls.
+ */
+class UXDI_API TimerWheel {
+public:
+    static constexpr uint64_t kDefaultTickNs = 1'000'000;
+    static constexpr size_t kDefaultSlotCount = 1024;
+
+    /**
+     * @param tickNs Resolution of the wheel; entries pop at most one tick late
+     * @param slotCount Slots per revolution (tickNs * slotCount = horizon)
+     */
+    explicit TimerWheel(uint64_t tickNs = kDefaultTickNs, size_t slotCount = kDefaultSlotCount);
+
+    /**
+     * @brief Add an entry; a deadline already past pops at the next PopDue()
+     */
+    void Schedule(uint64_t key, uint64_t deadlineNs);
+
+    /**
+     * @brief Move the keys of every entry due at or before nowNs into out
+     *
+     * Keys are appended in no particular order.
+     * @return Number of keys appended
+     */
+    size_t PopDue(uint64_t nowNs, std::vector<uint64_t>& out);
+
+    /**
+     * @brief Earliest deadline within one revolution, or the end of the
+     *        revolution when only farther entries remain; nullopt when empty
+     *
+     * A wake-up time for the thread driving the wheel; never later than the
+     * earliest entry.
+     */
+    std::optional<uint64_t> NextDeadline() const;
+
+    size_t Size() const { return m_size; }
+    bool Empty() const { return m_size == 0; }
+    uint64_t GetTickNs() const { return m_tickNs; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint64_t deadlineNs;
+    };
+
+    uint64_t m_tickNs;
+    std::vector<std::vector<Entry>> m_slots;
+    uint64_t m_currentTick = 0;     // Earliest tick that may still hold due entries
+    size_t m_size = 0;
+};
+
+} // namespace uxdi
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <uxdi/IDetectorListener.h>
+#include <uxdi/Types.h>
+#include <uxdi/uxdi_export.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uxdi {
+
+/**
+ * @brief Kind of a timing trace event
+ */
+enum class TimingEventType : uint8_t {
+    AcquisitionStarted = 1,
+    Frame = 2,
+    StateChanged = 3,
+    Error = 4,
+    AcquisitionStopped = 5
+};
+
+/**
+ * @brief One event of a timing trace
+ */
+struct TimingEvent {
+    TimingEventType type = TimingEventType::Frame;
+    uint64_t offsetNs = 0;      // Since the first event of the trace
+    uint64_t frameNumber = 0;   // Frame events
+    uint32_t code = 0;          // DetectorState (StateChanged) or ErrorCode (Error)
+};
+
+/**
+ * @brief Records when frames, state changes and errors arrive
+ *
+ * A timing trace keeps no pixels: it captures the inter-frame timing, frame
+ * numbers, state transitions and error codes of a session so the emulator's
+ * ScenarioEngine can replay the session's timing without the hardware or
+ * the vendor SDK (a "replay" action).
+ *
+ * Frames are timed by ImageData::latency.sdkDeliveryNs when the adapter
+ * stamps it, so listener dispatch delays do not leak into the trace, and by
+ * their arrival otherwise. Other events are timed on arrival.
+ *
+ * File layout: a 16-byte header ("UXDT", version, 8 reserved bytes)
+ * followed by one variable-length record per event:
+ *
+ *   type (1 byte), nanoseconds since the previous event (LEB128), then
+ *   Frame:        frame number minus (previous frame number + 1), zigzag LEB128
+ *   StateChanged: state (LEB128)
+ *   Error:        error code (LEB128)
+ *
+ * A frame of a steady stream costs five or six bytes. The file is appended
+ * as events arrive; a record torn by a crash is dropped when the trace is
+ * read.
+ *
+ * Thread-safe. Non-copyable, non-movable.
+ */
+class UXDI_API TimingTraceRecorder : public IDetectorListener {
+public:
+    TimingTraceRecorder();
+    ~TimingTraceRecorder() override;
+
+    // Non-copyable, non-movable
+    TimingTraceRecorder(const TimingTraceRecorder&) = delete;
+    TimingTraceRecorder& operator=(const TimingTraceRecorder&) = delete;
+    TimingTraceRecorder(TimingTraceRecorder&&) = delete;
+    TimingTraceRecorder& operator=(TimingTraceRecorder&&) = delete;
+
+    /**
+     * @brief Create a new trace, truncating any existing file
+     *
+     * @param path Trace file path
+     * @return true on success, false on I/O error (see GetLastError)
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Append an event
+     *
+     * @param type Event kind
+     * @param timeNs When it happened (MonotonicNowNs() clock); earlier
+     *               than the previous event counts as simultaneous
+     * @param value Frame number, DetectorState or ErrorCode, by type
+     * @return true on success, false if not open or on I/O error
+     */
+    bool WriteEvent(TimingEventType type, uint64_t timeNs, uint64_t value = 0);
+
+    /**
+     * @brief Flush and close the trace
+     *
+     * @return true on success (also true if already closed)
+     */
+    bool Close();
+
+    bool IsOpen() const;
+    uint64_t GetEventCount() const;
+
+    /**
+     * @brief Get the last error
+     */
+    ErrorInfo GetLastError() const;
+
+    /**
+     * @brief Read a trace written by TimingTraceRecorder
+     *
+     * @param path Trace file path
+     * @param events Replaced by the trace's events
+     * @param error Set to the reason when reading fails
+     * @return true if the file is a timing trace
+     */
+    static bool Read(const std::string& path, std::vector<TimingEvent>& events, std::string* error = nullptr);
+
+    // IDetectorListener implementation (records every callback)
+    void onImageReceived(const ImageData& image) override;
+    void onStateChanged(DetectorState newState) override;
+    void onError(const ErrorInfo& error) override;
+    void onAcquisitionStarted() override;
+    void onAcquisitionStopped() override;
+
+private:
+    bool CloseLocked();
+    void SetError(ErrorCode code, const std::string& message);
+
+    std::FILE* m_file = nullptr;
+    uint64_t m_lastNs = 0;              // Time of the previous event
+    uint64_t m_nextFrameNumber = 0;     // Previous frame number + 1
+    uint64_t m_eventCount = 0;
+
+    ErrorInfo m_lastError;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace uxdi
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <uxdi/uxdi_export.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uxdi {
+
+// Subsystem a trace event belongs to (exported as the Chrome trace "cat")
+enum class TraceCategory : uint8_t {
+    Acquisition,    // Adapter acquisition and polling threads
+    Callback,       // SDK callback bridges
+    State,          // Detector state machine
+    Dispatch,       // Listener dispatch
+    Scenario,       // Emulator scenario engine
+    Host            // Application code
+};
+
+/**
+ * @brief One recorded trace event (64 bytes, one cache line)
+ *
+ * The name is copied rather than referenced so a trace can still be
+ * exported after the adapter that recorded it has been unloaded.
+ */
+struct TraceEvent {
+    static constexpr size_t kMaxNameLength = 45;
+
+    uint64_t timestampNs = 0;       // MonotonicNowNs()
+    uint64_t arg = 0;               // Frame number, state, ... (exported as args.value)
+    TraceCategory category = TraceCategory::Host;
+    char phase = 'i';               // 'B' begin, 'E' end, 'i' instant
+    char name[kMaxNameLength + 1] = {};
+};
+
+/**
+ * @brief Flight recorder for thread activity timelines
+ *
+ * Each thread writes into its own fixed-size ring buffer, so recording is
+ * lock-free and never allocates after the thread's first event; when a
+ * buffer is full the oldest events are overwritten. The recorder starts
+ * disabled and the trace points only cost a relaxed load until SetEnabled().
+ *
+ * Trace points are written with the UXDI_TRACE_* macros below, which compile
+ * to nothing unless UXDI_ENABLE_TRACING is defined (CMake option of the same
+ * name).
+ *
+ * Adapter DLLs link their own copy of uxdi_core and so have their own
+ * Global() recorder. DetectorFactory passes the host's recorder to the
+ * adapter's optional AttachTraceRecorder export, which calls Attach() so that
+ * every module records into one timeline.
+ */
+class UXDI_API TraceRecorder {
+public:
+    static constexpr size_t kDefaultEventsPerThread = 8192;
+    static constexpr size_t kDefaultMaxThreads = 64;
+
+    /**
+     * @param eventsPerThread Ring buffer capacity of each thread
+     * @param maxThreads Buffers kept before those of exited threads are reused
+     */
+    explicit TraceRecorder(size_t eventsPerThread = kDefaultEventsPerThread,
+                           size_t maxThreads = kDefaultMaxThreads);
+    ~TraceRecorder();
+
+    // Non-copyable, non-movable
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+    TraceRecorder(TraceRecorder&&) = delete;
+    TraceRecorder& operator=(TraceRecorder&&) = delete;
+
+    /**
+     * @brief This module's own recorder
+     */
+    static TraceRecorder& Global();
+
+    /**
+     * @brief Recorder the trace points of this module write to
+     *
+     * Global() unless another recorder was attached.
+     */
+    static TraceRecorder& Current() {
+        TraceRecorder* attached = s_attached.load(std::memory_order_acquire);
+        return attached ? *attached : Global();
+    }
+
+    /**
+     * @brief Redirect this module's trace points to another recorder
+     *
+     * @param recorder Recorder to use, or nullptr to go back to Global()
+     */
+    static void Attach(TraceRecorder* recorder);
+
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record an event on the calling thread (no-op while disabled)
+     *
+     * @param phase 'B', 'E' or 'i'
+     * @param name Event name, truncated to TraceEvent::kMaxNameLength
+     */
+    void Record(TraceCategory category, char phase, const char* name, uint64_t arg = 0);
+
+    /**
+     * @brief Name the calling thread in exported traces
+     */
+    void SetThreadName(const char* name);
+
+    /**
+     * @brief Discard all recorded events (buffers stay allocated)
+     */
+    void Clear();
+
+    /**
+     * @brief Number of thread buffers allocated so far
+     */
+    size_t GetThreadCount() const;
+
+    /**
+     * @brief Events of one thread, oldest first
+     */
+    struct ThreadTrace {
+        uint32_t threadId = 0;          // Recorder-assigned, stable per buffer
+        std::string threadName;
+        uint64_t overwritten = 0;       // Events lost to ring buffer wrap
+        std::vector<TraceEvent> events;
+    };
+
+    /**
+     * @brief Copy out every thread's events
+     *
+     * May run while threads are recording; events overwritten during the
+     * copy are dropped.
+     */
+    std::vector<ThreadTrace> Collect() const;
+
+    /**
+     * @brief Render Collect() as Chrome trace event JSON
+     *
+     * Loads in chrome://tracing and ui.perfetto.dev. Timestamps are in
+     * microseconds on the MonotonicNowNs() clock.
+     */
+    std::string FormatChromeTrace() const;
+
+    /**
+     * @brief Write FormatChromeTrace() to a file
+     *
+     * @return false if the file could not be written
+     */
+    bool WriteChromeTrace(const std::string& path) const;
+
+private:
+    friend struct TraceThreadSlot;
+    struct ThreadBuffer;
+    struct Shared;
+
+    ThreadBuffer* AcquireBuffer();
+
+    static std::atomic<TraceRecorder*> s_attached;
+
+    const uint64_t m_id;
+    const size_t m_eventsPerThread;
+    const size_t m_maxThreads;
+    std::atomic<bool> m_enabled{false};
+    std::shared_ptr<Shared> m_shared;
+};
+
+/**
+ * @brief RAII begin/end span on the current recorder
+ */
+class TraceScope {
+public:
+    TraceScope(TraceCategory category, const char* name, uint64_t arg = 0)
+        : m_recorder(TraceRecorder::Current())
+        , m_category(category)
+        , m_name(name)
+        , m_active(m_recorder.IsEnabled())
+    {
+        if (m_active) {
+            m_recorder.Record(m_category, 'B', m_name, arg);
+        }
+    }
+
+    ~TraceScope() {
+        if (m_active) {
+            m_recorder.Record(m_category, 'E', m_name);
+        }
+    }
+
+    // Non-copyable, non-movable
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+private:
+    TraceRecorder& m_recorder;
+    TraceCategory m_category;
+    const char* m_name;
+    bool m_active;
+};
+
+} // namespace uxdi
+
+// ============================================================================
+// Trace point macros
+// ============================================================================
+
+#define UXDI_TRACE_CONCAT_INNER(a, b) a##b
+#define UXDI_TRACE_CONCAT(a, b) UXDI_TRACE_CONCAT_INNER(a, b)
+
+#if defined(UXDI_ENABLE_TRACING)
+
+#define UXDI_TRACE_RECORD(category, phase, name, arg)                                   \
+    do {                                                                                \
+        ::uxdi::TraceRecorder& uxdiTraceRecorder = ::uxdi::TraceRecorder::Current();    \
+        if (uxdiTraceRecorder.IsEnabled()) {                                            \
+            uxdiTraceRecorder.Record(::uxdi::TraceCategory::category, phase, name, arg); \
+        }                                                                               \
+    } while (0)
+
+// Span covering the rest of the enclosing scope
+#define UXDI_TRACE_SCOPE(category, name) \
+    ::uxdi::TraceScope UXDI_TRACE_CONCAT(uxdiTraceScope, __LINE__)(::uxdi::TraceCategory::category, name)
+#define UXDI_TRACE_SCOPE_ARG(category, name, arg) \
+    ::uxdi::TraceScope UXDI_TRACE_CONCAT(uxdiTraceScope, __LINE__)(::uxdi::TraceCategory::category, name, arg)
+
+// Explicit span ends, for spans that do not match a C++ scope
+#define UXDI_TRACE_BEGIN(category, name) UXDI_TRACE_RECORD(category, 'B', name, 0)
+#define UXDI_TRACE_END(category, name) UXDI_TRACE_RECORD(category, 'E', name, 0)
+
+#define UXDI_TRACE_INSTANT(category, name, arg) UXDI_TRACE_RECORD(category, 'i', name, arg)
+
+#define UXDI_TRACE_THREAD_NAME(name) ::uxdi::TraceRecorder::Current().SetThreadName(name)
+
+#else
+
+#define UXDI_TRACE_SCOPE(category, name) ((void)0)
+#define UXDI_TRACE_SCOPE_ARG(category, name, arg) ((void)0)
+#define UXDI_TRACE_BEGIN(category, name) ((void)0)
+#define UXDI_TRACE_END(category, name) ((void)0)
+#define UXDI_TRACE_INSTANT(category, name, arg) ((void)0)
+#define UXDI_TRACE_THREAD_NAME(name) ((void)0)
+
+#endif
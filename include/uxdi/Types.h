@@ -1,6 +1,7 @@
 #pragma once
 
 #include "uxdi_export.h"
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <memory>
@@ -45,15 +46,62 @@ struct AcquisitionParams {
     uint32_t binning{};     // Binning factor (1, 2, 4, etc.)
 };
 
+// Monotonic clock used for latency stamps (steady_clock, nanoseconds)
+inline uint64_t MonotonicNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Per-frame latency stamps from MonotonicNowNs() (0 = not stamped)
+struct FrameTimestamps {
+    uint64_t sdkDeliveryNs{};       // Frame delivered by the vendor SDK / generator
+    uint64_t adapterConvertedNs{};  // Adapter finished converting to ImageData
+    uint64_t dispatchNs{};          // Adapter handed the frame to its listener
+};
+
 // Image data structure (zero-copy via shared_ptr)
+//
+// The buffer is either owned, keeping the pixels alive for as long as any
+// copy of the ImageData holds it, or borrowed: memory the adapter or its SDK
+// reuses for the next frame, wrapped with BorrowBuffer(). A borrowed buffer
+// is only valid during the callback that delivers it; code that keeps the
+// frame longer copies it first (see IsBorrowedBuffer()). Adapters must not
+// wrap SDK memory with a no-op deleter, which passes it off as owned.
 struct ImageData {
     uint32_t width{};
     uint32_t height{};
     uint32_t bitDepth{};
     uint64_t frameNumber{};
     double timestamp{};  // Unix timestamp in seconds
-    std::shared_ptr<uint8_t[]> data{};  // Zero-copy image buffer
+    std::shared_ptr<uint8_t[]> data{};  // Zero-copy image buffer, owned or borrowed
     size_t dataLength{};                // Buffer size in bytes
+    FrameTimestamps latency{};          // Monotonic pipeline stamps
+};
+
+// Wraps memory the caller keeps owning as a borrowed ImageData buffer. The
+// empty owner allocates no control block and marks the buffer as borrowed.
+inline std::shared_ptr<uint8_t[]> BorrowBuffer(void* memory) {
+    return std::shared_ptr<uint8_t[]>(std::shared_ptr<void>(), static_cast<uint8_t*>(memory));
+}
+
+// True if the frame's buffer is borrowed and must be copied to outlive the callback
+inline bool IsBorrowedBuffer(const ImageData& image) {
+    return image.data && image.data.use_count() == 0;
+}
+
+// Delivery rate statistics tracked inside the adapter (see FrameRateMeter)
+struct DetectorStatistics {
+    uint64_t framesDelivered{};     // Frames produced since creation
+    uint64_t bytesDelivered{};      // Pixel bytes produced since creation
+    double instantFps{};            // From the last inter-frame interval
+    double windowFps{};             // Over the trailing window (windowSec)
+    double windowMBps{};            // Pixel data rate over the window (1 MB = 1e6 bytes)
+    double windowSec{};             // Time span the window figures cover
+    double lastFrameAgeSec{};       // Time since the last frame (0 if none yet)
+    uint64_t callbackCount{};       // Listener callbacks timed
+    uint64_t callbackMeanNs{};      // Listener callback execution time
+    uint64_t callbackP99Ns{};
+    uint64_t callbackMaxNs{};
 };
 
 // Error codes
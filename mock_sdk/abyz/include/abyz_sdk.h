@@ -164,6 +164,8 @@ ABYZ_API enum AbyzError Abyz_Shutdown(void);
  *
  * @param config Configuration string (JSON format with "vendor" field)
  *               Example: {"vendor": "rayence"} or {"vendor": "samsung"}
+ *               The mock also reads frame timing keys: "frame_rate",
+ *               "jitter", "jitter_ms", "burst", "max_rate" (default ~40 fps)
  * @param outHandle Output pointer to receive the detector handle
  * @return ABYZ_OK on success, error code otherwise
  */
@@ -1,4 +1,5 @@
 #include "abyz_sdk.h"
+#include "mock_frame_source.h"
 #include <cstring>
 #include <chrono>
 #include <thread>
@@ -7,6 +8,7 @@
 #include <mutex>
 #include <string>
 #include <algorithm>
+#include <cmath>
 
 //=============================================================================
 // ABYZ Mock SDK Implementation
@@ -37,13 +39,17 @@ struct MockDetector {
     // Frame generation thread
     std::atomic<bool> threadActive{false};
     std::thread frameThread;
+
+    // Frame timing and precomputed content (owned by SDK, must be copied by adapter)
+    mock_sdk::FrameTimingConfig timing;
+    mock_sdk::PatternBank frames;
 };
 
 static std::vector<MockDetector*> g_detectors;
 static std::mutex g_detectorsMutex;
 
-// Frame data buffer (owned by SDK, must be copied by adapter)
-static std::vector<uint16_t> g_frameBuffer;
+// Native frame interval is ~25ms (~40 fps)
+constexpr double kNativeFrameRate = 40.0;
 
 //=============================================================================
 // Internal Helper Functions
@@ -101,36 +107,7 @@ AbyzDetectorInfo createMockDetectorInfo(AbyzVendor vendor) {
 }
 
 AbyzVendor parseVendorFromConfig(const char* config) {
-    if (!config) {
-        return ABYZ_VENDOR_RAYENCE; // Default vendor
-    }
-
-    std::string configStr(config);
-    std::transform(configStr.begin(), configStr.end(), configStr.begin(), ::tolower);
-
-    // Simple JSON parsing for "vendor" field
-    size_t vendorPos = configStr.find("\"vendor\"");
-    if (vendorPos == std::string::npos) {
-        return ABYZ_VENDOR_RAYENCE; // Default vendor
-    }
-
-    size_t colonPos = configStr.find(':', vendorPos);
-    if (colonPos == std::string::npos) {
-        return ABYZ_VENDOR_RAYENCE;
-    }
-
-    size_t valueStart = configStr.find('"', colonPos);
-    if (valueStart == std::string::npos) {
-        return ABYZ_VENDOR_RAYENCE;
-    }
-    valueStart++; // Skip opening quote
-
-    size_t valueEnd = configStr.find('"', valueStart);
-    if (valueEnd == std::string::npos) {
-        return ABYZ_VENDOR_RAYENCE;
-    }
-
-    std::string vendorValue = configStr.substr(valueStart, valueEnd - valueStart);
+    const std::string vendorValue = mock_sdk::SdkConfig(config).string("vendor");
 
     if (vendorValue == "rayence") {
         return ABYZ_VENDOR_RAYENCE;
@@ -143,76 +120,65 @@ AbyzVendor parseVendorFromConfig(const char* config) {
     return ABYZ_VENDOR_RAYENCE; // Default vendor
 }
 
-void frameGenerationThread(MockDetector* detector) {
-    while (detector->threadActive.load() && detector->acquiring) {
-        // Simulate ~25ms frame interval (~40 fps)
-        std::this_thread::sleep_for(std::chrono::milliseconds(25));
-
-        if (!detector->threadActive.load() || !detector->acquiring) {
-            break;
+uint16_t vendorPatternValue(AbyzVendor vendor, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    switch (vendor) {
+        case ABYZ_VENDOR_RAYENCE:
+            // Diagonal gradient pattern
+            return static_cast<uint16_t>((static_cast<uint64_t>(x + y) * 65535) / (width + height));
+
+        case ABYZ_VENDOR_SAMSUNG: {
+            // Radial gradient pattern
+            float cx = width / 2.0f;
+            float cy = height / 2.0f;
+            float dist = std::sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy));
+            float maxDist = std::sqrt(cx * cx + cy * cy);
+            return static_cast<uint16_t>((dist / maxDist) * 65535);
         }
 
-        // Prepare frame data (SDK-owned buffer)
-        const size_t pixelCount = detector->params.width * detector->params.height;
-        if (g_frameBuffer.size() < pixelCount) {
-            g_frameBuffer.resize(pixelCount);
+        case ABYZ_VENDOR_DRTECH: {
+            // Horizontal stripes pattern
+            uint32_t stripeWidth = 32;
+            uint32_t stripe = (y / stripeWidth) % 2;
+            return stripe ? 50000 : 15000;
         }
 
-        // Generate vendor-specific mock frame patterns
-        for (uint32_t y = 0; y < detector->params.height; ++y) {
-            for (uint32_t x = 0; x < detector->params.width; ++x) {
-                size_t idx = y * detector->params.width + x;
-                uint16_t value = 0;
-
-                switch (detector->vendor) {
-                    case ABYZ_VENDOR_RAYENCE:
-                        // Diagonal gradient pattern
-                        value = static_cast<uint16_t>(((x + y) * 65535) / (detector->params.width + detector->params.height));
-                        break;
-
-                    case ABYZ_VENDOR_SAMSUNG:
-                        // Radial gradient pattern
-                        {
-                            float cx = detector->params.width / 2.0f;
-                            float cy = detector->params.height / 2.0f;
-                            float dist = std::sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy));
-                            float maxDist = std::sqrt(cx * cx + cy * cy);
-                            value = static_cast<uint16_t>((dist / maxDist) * 65535);
-                        }
-                        break;
-
-                    case ABYZ_VENDOR_DRTECH:
-                        // Horizontal stripes pattern
-                        {
-                            uint32_t stripeWidth = 32;
-                            uint32_t stripe = (y / stripeWidth) % 2;
-                            value = stripe ? 50000 : 15000;
-                        }
-                        break;
-
-                    default:
-                        value = 32768; // Middle gray
-                        break;
-                }
-
-                // Add frame counter variation
-                value = static_cast<uint16_t>((value + detector->frameCounter * 50) % 65536);
-                g_frameBuffer[idx] = value;
-            }
+        default:
+            return 32768; // Middle gray
+    }
+}
+
+void frameGenerationThread(MockDetector* detector) {
+    const uint32_t width = detector->params.width;
+    const uint32_t height = detector->params.height;
+    const AbyzVendor vendor = detector->vendor;
+
+    // Vendor patterns are evaluated once per resolution, not per frame
+    detector->frames.prepare(width, height, detector->timing.patternFrames, 50,
+        [vendor, width, height](uint32_t x, uint32_t y) {
+            return vendorPatternValue(vendor, x, y, width, height);
+        });
+
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    mock_sdk::FramePacer pacer(detector->timing);
+    pacer.start();
+
+    while (detector->acquiring && pacer.waitForNextFrame(detector->threadActive)) {
+        if (!detector->acquiring) {
+            break;
         }
 
         // Create image structure (SDK-owned memory)
         AbyzImage image{};
-        image.data = g_frameBuffer.data();
-        image.width = detector->params.width;
-        image.height = detector->params.height;
+        image.data = detector->frames.frame(detector->frameCounter);
+        image.width = width;
+        image.height = height;
         image.bitDepth = 16;
         image.frameNumber = ++detector->frameCounter;
         image.timestamp = std::chrono::duration<double>(
             std::chrono::system_clock::now().time_since_epoch()
         ).count();
         image.dataLength = static_cast<uint32_t>(pixelCount * sizeof(uint16_t));
-        image.vendor = detector->vendor;
+        image.vendor = vendor;
 
         // Deliver image through callback (MUST copy immediately!)
         if (detector->imageCallback) {
@@ -299,6 +265,7 @@ ABYZ_API AbyzError Abyz_CreateDetector(const char* config, AbyzHandle* outHandle
     auto* detector = new MockDetector();
     detector->vendor = vendor;
     detector->info = createMockDetectorInfo(vendor);
+    detector->timing = mock_sdk::parseFrameTimingConfig(config, kNativeFrameRate);
 
     {
         std::lock_guard<std::mutex> lock(g_detectorsMutex);
@@ -0,0 +1,86 @@
+#pragma once
+
+// Config string handling shared by the mock vendor SDKs
+//
+// *_CreateDetector takes a JSON object whose keys and string values are
+// case-insensitive. The string is lowercased and parsed once; lookups are
+// on the top-level members. A missing, malformed or non-object config reads
+// as empty, so every key keeps its default, like a real SDK ignoring an
+// unusable config file.
+
+#include "uxdi/JsonReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+#include <string>
+
+namespace mock_sdk {
+
+/**
+ * @brief Parsed SDK config string
+ */
+class SdkConfig {
+public:
+    explicit SdkConfig(const char* config) {
+        if (!config) {
+            return;
+        }
+        text_ = config;
+        std::transform(text_.begin(), text_.end(), text_.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (document_.Parse(text_) && document_.Root().IsObject()) {
+            root_ = document_.Root();
+        }
+    }
+
+    SdkConfig(const SdkConfig&) = delete;
+    SdkConfig& operator=(const SdkConfig&) = delete;
+
+    /**
+     * @brief String value of key; empty when absent or not a string
+     */
+    std::string string(const char* key) const {
+        return root_[key].AsString().value_or(std::string{});
+    }
+
+    /**
+     * @brief Numeric value of key; numbers written as strings are accepted
+     */
+    std::optional<double> number(const char* key) const {
+        const uxdi::JsonValue value = root_[key];
+        if (auto number = value.AsDouble()) {
+            return number;
+        }
+        if (auto text = value.AsString()) {
+            char* end = nullptr;
+            const double number = std::strtod(text->c_str(), &end);
+            if (end != text->c_str()) {
+                return number;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief true for true, a nonzero number, or "true"/"1"
+     */
+    bool flag(const char* key) const {
+        const uxdi::JsonValue value = root_[key];
+        if (auto boolean = value.AsBool()) {
+            return *boolean;
+        }
+        if (auto text = value.AsString()) {
+            return *text == "true" || *text == "1";
+        }
+        return number(key).value_or(0.0) != 0.0;
+    }
+
+private:
+    std::string text_;
+    uxdi::JsonDocument document_;
+    uxdi::JsonValue root_;
+};
+
+} // namespace mock_sdk
@@ -0,0 +1,270 @@
+#pragma once
+
+// Frame timing and content shared by the mock vendor SDKs
+//
+// Each mock SDK reads its timing options from the config string passed to
+// *_CreateDetector, paces frames against an absolute schedule, and serves
+// frame content from patterns computed once per resolution. Nothing here is
+// part of a vendor API; real SDKs pace frames in hardware.
+//
+// Config keys (all optional, case-insensitive; see mock_config.h):
+//   "frame_rate": 120        frames per second (default: the SDK's native rate)
+//   "jitter": "uniform"      "none", "uniform" (+/- jitter_ms) or "normal" (sigma = jitter_ms)
+//   "jitter_ms": 2.5         jitter amplitude in milliseconds
+//   "burst": 8               frames delivered back to back per burst; bursts
+//                            are spaced so the average rate stays frame_rate
+//   "max_rate": true         deliver frames as fast as the consumer accepts them
+//   "pattern_frames": 4      distinct precomputed frames to cycle through
+//   "seed": 42               jitter random seed (0 = nondeterministic)
+
+#include "mock_config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mock_sdk {
+
+//=============================================================================
+// Timing Configuration
+//=============================================================================
+
+enum class JitterMode {
+    None,
+    Uniform,
+    Normal
+};
+
+struct FrameTimingConfig {
+    double frameRate = 30.0;
+    JitterMode jitter = JitterMode::None;
+    double jitterMs = 0.0;
+    uint32_t burstSize = 1;
+    bool maxRate = false;
+    uint32_t patternFrames = 4;
+    uint64_t seed = 0;
+};
+
+/**
+ * @brief Parse timing options from an SDK config string
+ *
+ * Unknown keys are ignored and malformed values keep their defaults, like the
+ * rest of the mock config handling.
+ *
+ * @param config Config string passed to *_CreateDetector (may be null)
+ * @param nativeFrameRate Rate used when "frame_rate" is not given
+ */
+inline FrameTimingConfig parseFrameTimingConfig(const char* config, double nativeFrameRate) {
+    FrameTimingConfig timing;
+    timing.frameRate = nativeFrameRate;
+    const SdkConfig sdkConfig(config);
+
+    if (auto rate = sdkConfig.number("frame_rate"); rate && *rate > 0.0) {
+        timing.frameRate = *rate;
+    }
+
+    const std::string jitter = sdkConfig.string("jitter");
+    if (jitter == "uniform") {
+        timing.jitter = JitterMode::Uniform;
+    } else if (jitter == "normal") {
+        timing.jitter = JitterMode::Normal;
+    }
+
+    if (auto jitterMs = sdkConfig.number("jitter_ms")) {
+        timing.jitterMs = std::max(0.0, *jitterMs);
+    }
+    if (auto burst = sdkConfig.number("burst")) {
+        timing.burstSize = static_cast<uint32_t>(std::max(1.0, *burst));
+    }
+    timing.maxRate = sdkConfig.flag("max_rate");
+    if (auto patternFrames = sdkConfig.number("pattern_frames")) {
+        timing.patternFrames = static_cast<uint32_t>(std::max(1.0, *patternFrames));
+    }
+    if (auto seed = sdkConfig.number("seed"); seed && *seed > 0.0) {
+        timing.seed = static_cast<uint64_t>(*seed);
+    }
+
+    return timing;
+}
+
+//=============================================================================
+// Frame Pacer
+//=============================================================================
+
+/**
+ * @brief Paces frames against an absolute schedule
+ *
+ * Frame n is due at start + (n / burst + 1) * burst * interval, so sleep
+ * overshoot and delivery time never accumulate into drift. Jitter offsets
+ * each deadline independently and never reorders frames. When delivery
+ * falls more than a second behind (a stalled consumer), the schedule is
+ * rebased instead of bursting out the backlog.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FramePacer(const FrameTimingConfig& config)
+        : config_(config)
+        , interval_(std::chrono::duration_cast<Clock::duration>(
+              std::chrono::duration<double>(1.0 / std::max(config.frameRate, 1e-3))))
+        , rng_(config.seed ? config.seed : std::random_device{}())
+    {
+    }
+
+    /**
+     * @brief Restart the schedule from the given time
+     */
+    void start(Clock::time_point now = Clock::now()) {
+        start_ = now;
+        lastDeadline_ = now;
+        frameIndex_ = 0;
+    }
+
+    /**
+     * @brief Compute the deadline of the next frame and advance the schedule
+     */
+    Clock::time_point nextDeadline() {
+        const uint64_t burst = config_.burstSize;
+        const uint64_t period = frameIndex_ / burst + 1;
+        ++frameIndex_;
+
+        Clock::time_point deadline = start_ + interval_ * static_cast<int64_t>(period * burst);
+        if (config_.jitter != JitterMode::None && config_.jitterMs > 0.0) {
+            deadline += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(sampleJitterMs()));
+        }
+        deadline = std::max(deadline, lastDeadline_);
+        lastDeadline_ = deadline;
+        return deadline;
+    }
+
+    /**
+     * @brief Wait for the next frame's deadline
+     *
+     * Sleeps in short slices so a stop request is noticed promptly.
+     *
+     * @param running Flag cleared by the SDK to stop acquisition
+     * @return false if running was cleared while waiting
+     */
+    bool waitForNextFrame(const std::atomic<bool>& running) {
+        if (config_.maxRate) {
+            return running.load();
+        }
+
+        Clock::time_point deadline = nextDeadline();
+        Clock::time_point now = Clock::now();
+        if (now - deadline > std::chrono::seconds(1)) {
+            start(now);
+            deadline = nextDeadline();
+        }
+
+        constexpr auto kSlice = std::chrono::milliseconds(10);
+        while (running.load()) {
+            now = Clock::now();
+            if (now >= deadline) {
+                return true;
+            }
+            std::this_thread::sleep_until(std::min(deadline, now + kSlice));
+        }
+        return false;
+    }
+
+private:
+    double sampleJitterMs() {
+        if (config_.jitter == JitterMode::Uniform) {
+            return std::uniform_real_distribution<double>(-config_.jitterMs, config_.jitterMs)(rng_);
+        }
+        return std::normal_distribution<double>(0.0, config_.jitterMs)(rng_);
+    }
+
+    FrameTimingConfig config_;
+    Clock::duration interval_;
+    Clock::time_point start_{};
+    Clock::time_point lastDeadline_{};
+    uint64_t frameIndex_ = 0;
+    std::mt19937_64 rng_;
+};
+
+//=============================================================================
+// Precomputed Frame Content
+//=============================================================================
+
+/**
+ * @brief Frame content computed once per resolution
+ *
+ * Holds a fixed number of distinct 16-bit frames; frame n is served from
+ * slot n % count. The base pattern is evaluated once per pixel and each
+ * slot adds its own brightness offset, so per-frame cost is a pointer
+ * lookup. Slots are immutable between prepare() calls, so a pointer handed
+ * out stays valid until the resolution changes.
+ */
+class PatternBank {
+public:
+    /// Upper bound on precomputed content; fewer slots are kept for large frames
+    static constexpr size_t kMaxBytes = 64u * 1024u * 1024u;
+
+    /**
+     * @brief Compute the frames for a resolution if not already prepared
+     *
+     * @param width Frame width in pixels
+     * @param height Frame height in pixels
+     * @param slotCount Requested number of distinct frames
+     * @param offsetStep Brightness offset added per slot (wraps at 16 bits)
+     * @param basePattern Callable (x, y) -> uint16_t giving the base pattern
+     */
+    template <typename Pattern>
+    void prepare(uint32_t width, uint32_t height, uint32_t slotCount, uint32_t offsetStep,
+                 Pattern&& basePattern) {
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        const size_t frameBytes = std::max<size_t>(pixelCount * sizeof(uint16_t), 1);
+        const size_t slots = std::clamp<size_t>(kMaxBytes / frameBytes, 1, std::max<uint32_t>(slotCount, 1));
+        if (width == width_ && height == height_ && slots == slots_) {
+            return;
+        }
+
+        pixels_.resize(pixelCount * slots);
+        for (uint32_t y = 0; y < height; ++y) {
+            uint16_t* row = pixels_.data() + static_cast<size_t>(y) * width;
+            for (uint32_t x = 0; x < width; ++x) {
+                row[x] = static_cast<uint16_t>(basePattern(x, y));
+            }
+        }
+        for (size_t slot = 1; slot < slots; ++slot) {
+            const uint16_t offset = static_cast<uint16_t>(slot * offsetStep);
+            const uint16_t* base = pixels_.data();
+            uint16_t* out = pixels_.data() + slot * pixelCount;
+            for (size_t i = 0; i < pixelCount; ++i) {
+                out[i] = static_cast<uint16_t>(base[i] + offset);
+            }
+        }
+
+        width_ = width;
+        height_ = height;
+        slots_ = slots;
+    }
+
+    /**
+     * @brief Content for a frame number
+     */
+    uint16_t* frame(uint64_t frameNumber) {
+        const size_t pixelCount = static_cast<size_t>(width_) * height_;
+        return pixels_.data() + (frameNumber % slots_) * pixelCount;
+    }
+
+    size_t slotCount() const { return slots_; }
+
+private:
+    std::vector<uint16_t> pixels_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    size_t slots_ = 0;
+};
+
+} // namespace mock_sdk
@@ -151,6 +151,8 @@ VAREX_API VarexError Varex_Shutdown();
  * @brief Create a new detector handle
  *
  * @param config Configuration string (can be null or empty for default)
+ *               The mock reads frame timing keys: "frame_rate", "jitter",
+ *               "jitter_ms", "burst", "max_rate" (default ~33 fps)
  * @param outHandle Output pointer to receive the detector handle
  * @return VAREX_OK on success, error code otherwise
  */
@@ -1,10 +1,12 @@
 #include "varex_sdk.h"
+#include "mock_frame_source.h"
 #include <cstring>
 #include <chrono>
 #include <thread>
 #include <vector>
 #include <atomic>
 #include <mutex>
+#include <algorithm>
 
 //=============================================================================
 // Varex Mock SDK Implementation
@@ -34,13 +36,17 @@ struct MockDetector {
     // Frame generation thread
     std::atomic<bool> threadActive{false};
     std::thread frameThread;
+
+    // Frame timing and precomputed content (owned by SDK, must be copied by adapter)
+    mock_sdk::FrameTimingConfig timing;
+    mock_sdk::PatternBank frames;
 };
 
 static std::vector<MockDetector*> g_detectors;
 static std::mutex g_detectorsMutex;
 
-// Frame data buffer (owned by SDK, must be copied by adapter)
-static std::vector<uint16_t> g_frameBuffer;
+// Native frame interval is ~30ms (~33 fps)
+constexpr double kNativeFrameRate = 1000.0 / 30.0;
 
 //=============================================================================
 // Internal Helper Functions
@@ -59,39 +65,29 @@ VarexDetectorInfo createMockDetectorInfo() {
 }
 
 void frameGenerationThread(MockDetector* detector) {
-    while (detector->threadActive.load() && detector->acquiring) {
-        // Simulate ~30ms frame interval (~33 fps)
-        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const uint32_t width = detector->params.width;
+    const uint32_t height = detector->params.height;
 
-        if (!detector->threadActive.load() || !detector->acquiring) {
-            break;
-        }
+    // Gradient pattern for visualization, evaluated once per resolution
+    detector->frames.prepare(width, height, detector->timing.patternFrames, 100,
+        [width, height](uint32_t x, uint32_t y) {
+            return (x * 65535 / width + y * 65535 / height) / 2;
+        });
 
-        // Prepare frame data (SDK-owned buffer)
-        const size_t pixelCount = detector->params.width * detector->params.height;
-        if (g_frameBuffer.size() < pixelCount) {
-            g_frameBuffer.resize(pixelCount);
-        }
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    mock_sdk::FramePacer pacer(detector->timing);
+    pacer.start();
 
-        // Generate mock frame data (gradient pattern for visualization)
-        for (uint32_t y = 0; y < detector->params.height; ++y) {
-            for (uint32_t x = 0; x < detector->params.width; ++x) {
-                size_t idx = y * detector->params.width + x;
-                // Create gradient pattern with some variation
-                uint16_t value = static_cast<uint16_t>(
-                    (x * 65535 / detector->params.width + y * 65535 / detector->params.height) / 2
-                );
-                // Add frame counter variation
-                value = static_cast<uint16_t>((value + detector->frameCounter * 100) % 65536);
-                g_frameBuffer[idx] = value;
-            }
+    while (detector->acquiring && pacer.waitForNextFrame(detector->threadActive)) {
+        if (!detector->acquiring) {
+            break;
         }
 
         // Create image structure (SDK-owned memory)
         VarexImage image{};
-        image.data = g_frameBuffer.data();
-        image.width = detector->params.width;
-        image.height = detector->params.height;
+        image.data = detector->frames.frame(detector->frameCounter);
+        image.width = width;
+        image.height = height;
         image.bitDepth = 16;
         image.frameNumber = ++detector->frameCounter;
         image.timestamp = std::chrono::duration<double>(
@@ -170,8 +166,6 @@ VAREX_API VarexError Varex_Shutdown() {
 }
 
 VAREX_API VarexError Varex_CreateDetector(const char* config, VarexHandle* outHandle) {
-    (void)config; // Config not used in mock
-
     if (!g_sdkInitialized.load()) {
         return VAREX_ERR_NOT_INITIALIZED;
     }
@@ -182,6 +176,7 @@ VAREX_API VarexError Varex_CreateDetector(const char* config, VarexHandle* outHa
 
     auto* detector = new MockDetector();
     detector->info = createMockDetectorInfo();
+    detector->timing = mock_sdk::parseFrameTimingConfig(config, kNativeFrameRate);
 
     {
         std::lock_guard<std::mutex> lock(g_detectorsMutex);
@@ -118,6 +118,8 @@ VIEWORKS_API VieworksStatus Vieworks_Shutdown();
  * @brief Create a new detector handle
  *
  * @param config Configuration string (can be null or empty for default)
+ *               The mock reads frame timing keys: "frame_rate", "jitter",
+ *               "jitter_ms", "burst", "max_rate" (default ~50 fps)
  * @param outHandle Output pointer to receive the detector handle
  * @return VIEWORKS_OK on success, error code otherwise
  */
@@ -205,6 +207,9 @@ VIEWORKS_API VieworksStatus Vieworks_StopAcquisition(VieworksHandle handle);
 /**
  * @brief Check if a frame is ready to read
  *
+ * The detector buffers up to 16 unread frames; when the host falls further
+ * behind, the oldest unread frame is overwritten.
+ *
  * @param handle Detector handle
  * @param outReady Output pointer to receive frame ready status
  * @return VIEWORKS_OK on success, error code otherwise
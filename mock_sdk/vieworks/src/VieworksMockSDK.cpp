@@ -1,10 +1,13 @@
 #include "vieworks_sdk.h"
+#include "mock_frame_source.h"
+#include <array>
 #include <cstring>
 #include <chrono>
 #include <thread>
 #include <vector>
 #include <atomic>
 #include <mutex>
+#include <algorithm>
 
 //=============================================================================
 // Vieworks Mock SDK Implementation
@@ -16,19 +19,34 @@ namespace {
 static std::atomic<bool> g_sdkInitialized{false};
 static std::mutex g_sdkMutex;
 
+// Frames the detector buffers before the oldest unread frame is overwritten
+constexpr size_t kFrameQueueDepth = 16;
+
+// Native frame interval is ~20ms (~50 fps)
+constexpr double kNativeFrameRate = 50.0;
+
 // Mock detector data
 struct MockDetector {
     bool initialized = false;
-    VieworksState state = VIEWORKS_STATE_STANDBY;
+    std::atomic<VieworksState> state{VIEWORKS_STATE_STANDBY};
     VieworksAcqParams params{2048, 2048, 0, 0, 100.0f, 1.0f, 1};
     VieworksDetectorInfo info{};
     uint64_t frameCounter = 0;
-    bool acquiring = false;
-    bool frameReady = false;
+    std::atomic<bool> acquiring{false};
+
+    // Frames produced but not yet read, oldest first
+    std::mutex frameMutex;
+    std::array<VieworksFrame, kFrameQueueDepth> frameQueue{};
+    size_t queueHead = 0;
+    size_t queueCount = 0;
 
-    // Frame data buffer (stable until next ReadFrame)
-    std::vector<uint16_t> frameBuffer;
-    VieworksFrame currentFrame{};
+    // Frame generation thread
+    std::atomic<bool> threadActive{false};
+    std::thread frameThread;
+
+    // Frame timing and precomputed content (stable until StopAcquisition)
+    mock_sdk::FrameTimingConfig timing;
+    mock_sdk::PatternBank frames;
 };
 
 static std::vector<MockDetector*> g_detectors;
@@ -50,49 +68,82 @@ VieworksDetectorInfo createMockDetectorInfo() {
     return info;
 }
 
-void generateMockFrame(MockDetector* detector) {
-    const size_t pixelCount = detector->params.width * detector->params.height;
+uint16_t checkerboardValue(uint32_t x, uint32_t y) {
+    // Create checkerboard pattern
+    uint32_t tileSize = 64;
+    bool white = ((x / tileSize) + (y / tileSize)) % 2 == 0;
+    uint16_t baseValue = white ? 50000 : 10000;
+
+    // Add gradient within each tile
+    uint32_t tileX = x % tileSize;
+    uint32_t tileY = y % tileSize;
+    uint16_t variation = static_cast<uint16_t>(
+        (tileX * 20000 / tileSize) + (tileY * 20000 / tileSize)
+    );
+
+    return static_cast<uint16_t>(baseValue + variation);
+}
+
+void queueFrame(MockDetector* detector, const VieworksFrame& frame) {
+    std::lock_guard<std::mutex> lock(detector->frameMutex);
 
-    // Allocate buffer if needed
-    if (detector->frameBuffer.size() < pixelCount) {
-        detector->frameBuffer.resize(pixelCount);
+    // A full queue overwrites the oldest frame, like a detector whose
+    // host stopped reading; the gap shows up in the frame numbers
+    if (detector->queueCount == kFrameQueueDepth) {
+        detector->queueHead = (detector->queueHead + 1) % kFrameQueueDepth;
+        --detector->queueCount;
     }
+    detector->frameQueue[(detector->queueHead + detector->queueCount) % kFrameQueueDepth] = frame;
+    ++detector->queueCount;
+    detector->state = VIEWORKS_STATE_READY;
+}
 
-    // Generate mock frame data (checkerboard pattern)
-    for (uint32_t y = 0; y < detector->params.height; ++y) {
-        for (uint32_t x = 0; x < detector->params.width; ++x) {
-            size_t idx = y * detector->params.width + x;
-            // Create checkerboard pattern
-            uint32_t tileSize = 64;
-            bool white = ((x / tileSize) + (y / tileSize)) % 2 == 0;
-            uint16_t baseValue = white ? 50000 : 10000;
+void frameGenerationThread(MockDetector* detector) {
+    const uint32_t width = detector->params.width;
+    const uint32_t height = detector->params.height;
 
-            // Add gradient within each tile
-            uint32_t tileX = x % tileSize;
-            uint32_t tileY = y % tileSize;
-            uint16_t variation = static_cast<uint16_t>(
-                (tileX * 20000 / tileSize) + (tileY * 20000 / tileSize)
-            );
+    // Checkerboard is evaluated once per resolution, not per frame
+    detector->frames.prepare(width, height, detector->timing.patternFrames, 500, checkerboardValue);
 
-            // Add frame counter variation
-            uint16_t frameOffset = static_cast<uint16_t>((detector->frameCounter * 500) % 10000);
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    mock_sdk::FramePacer pacer(detector->timing);
+    pacer.start();
 
-            detector->frameBuffer[idx] = baseValue + variation + frameOffset;
-        }
+    while (pacer.waitForNextFrame(detector->threadActive)) {
+        VieworksFrame frame{};
+        frame.data = detector->frames.frame(detector->frameCounter);
+        frame.width = width;
+        frame.height = height;
+        frame.bitDepth = 16;
+        frame.frameNumber = ++detector->frameCounter;
+        frame.timestamp = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        frame.dataLength = static_cast<uint32_t>(pixelCount * sizeof(uint16_t));
+
+        queueFrame(detector, frame);
     }
+}
+
+void startFrameThread(MockDetector* detector) {
+    if (detector->threadActive.load()) {
+        return; // Already running
+    }
+
+    detector->threadActive = true;
+    detector->frameThread = std::thread(frameGenerationThread, detector);
+}
+
+void stopFrameThread(MockDetector* detector) {
+    detector->threadActive = false;
 
-    // Update frame structure
-    detector->currentFrame.data = detector->frameBuffer.data();
-    detector->currentFrame.width = detector->params.width;
-    detector->currentFrame.height = detector->params.height;
-    detector->currentFrame.bitDepth = 16;
-    detector->currentFrame.frameNumber = ++detector->frameCounter;
-    detector->currentFrame.timestamp = std::chrono::duration<double>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
-    detector->currentFrame.dataLength = static_cast<uint32_t>(pixelCount * sizeof(uint16_t));
+    if (detector->frameThread.joinable()) {
+        detector->frameThread.join();
+    }
 
-    detector->frameReady = true;
+    std::lock_guard<std::mutex> lock(detector->frameMutex);
+    detector->queueHead = 0;
+    detector->queueCount = 0;
 }
 
 } // anonymous namespace
@@ -124,6 +175,7 @@ VIEWORKS_API VieworksStatus Vieworks_Shutdown() {
     // Cleanup all detectors
     std::lock_guard<std::mutex> detectorsLock(g_detectorsMutex);
     for (auto* detector : g_detectors) {
+        stopFrameThread(detector);
         delete detector;
     }
     g_detectors.clear();
@@ -133,8 +185,6 @@ VIEWORKS_API VieworksStatus Vieworks_Shutdown() {
 }
 
 VIEWORKS_API VieworksStatus Vieworks_CreateDetector(const char* config, VieworksHandle* outHandle) {
-    (void)config; // Config not used in mock
-
     if (!g_sdkInitialized.load()) {
         return VIEWORKS_ERR_NOT_INITIALIZED;
     }
@@ -145,6 +195,7 @@ VIEWORKS_API VieworksStatus Vieworks_CreateDetector(const char* config, Vieworks
 
     auto* detector = new MockDetector();
     detector->info = createMockDetectorInfo();
+    detector->timing = mock_sdk::parseFrameTimingConfig(config, kNativeFrameRate);
 
     {
         std::lock_guard<std::mutex> lock(g_detectorsMutex);
@@ -332,19 +383,10 @@ VIEWORKS_API VieworksStatus Vieworks_StartAcquisition(VieworksHandle handle) {
     }
 
     detector->acquiring = true;
-    detector->frameReady = false;
     detector->state = VIEWORKS_STATE_EXPOSING;
 
-    // Simulate initial frame becoming available after exposure time
-    std::thread([detector]() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(
-            static_cast<int>(detector->params.exposureTimeMs)
-        ));
-        if (detector->acquiring) {
-            generateMockFrame(detector);
-            detector->state = VIEWORKS_STATE_READY;
-        }
-    }).detach();
+    // Frames become available as the generation thread produces them
+    startFrameThread(detector);
 
     return VIEWORKS_OK;
 }
@@ -365,7 +407,7 @@ VIEWORKS_API VieworksStatus Vieworks_StopAcquisition(VieworksHandle handle) {
     }
 
     detector->acquiring = false;
-    detector->frameReady = false;
+    stopFrameThread(detector);
     detector->state = VIEWORKS_STATE_READY;
 
     return VIEWORKS_OK;
@@ -382,17 +424,8 @@ VIEWORKS_API VieworksStatus Vieworks_GetFrameReady(VieworksHandle handle, int* o
 
     auto* detector = static_cast<MockDetector*>(handle);
 
-    *outReady = detector->frameReady ? 1 : 0;
-
-    // Auto-generate next frame if acquiring and no frame ready
-    if (detector->acquiring && !detector->frameReady && detector->state == VIEWORKS_STATE_READY) {
-        std::thread([detector]() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(20)); // ~50fps
-            if (detector->acquiring) {
-                generateMockFrame(detector);
-            }
-        }).detach();
-    }
+    std::lock_guard<std::mutex> lock(detector->frameMutex);
+    *outReady = detector->queueCount > 0 ? 1 : 0;
 
     return VIEWORKS_OK;
 }
@@ -408,14 +441,14 @@ VIEWORKS_API VieworksStatus Vieworks_ReadFrame(VieworksHandle handle, VieworksFr
 
     auto* detector = static_cast<MockDetector*>(handle);
 
-    if (!detector->frameReady) {
+    std::lock_guard<std::mutex> lock(detector->frameMutex);
+    if (detector->queueCount == 0) {
         return VIEWORKS_ERR_STATE_ERROR;
     }
 
-    detector->state = VIEWORKS_STATE_READING;
-    *outFrame = detector->currentFrame;
-    detector->frameReady = false;
-    detector->state = VIEWORKS_STATE_READY;
+    *outFrame = detector->frameQueue[detector->queueHead];
+    detector->queueHead = (detector->queueHead + 1) % kFrameQueueDepth;
+    --detector->queueCount;
 
     return VIEWORKS_OK;
 }
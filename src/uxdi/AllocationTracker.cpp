@@ -0,0 +1,252 @@
+#include "uxdi/AllocationTracker.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace uxdi {
+
+// ============================================================================
+// Internal state
+// ============================================================================
+
+namespace {
+
+// Trivially constructible, so reading it from operator new never allocates
+thread_local AllocationSubsystem t_subsystem = AllocationSubsystem::Untagged;
+
+AllocationSubsystem& ThreadSubsystemSlot() {
+    return t_subsystem;
+}
+
+const char* SubsystemName(AllocationSubsystem subsystem) {
+    switch (subsystem) {
+        case AllocationSubsystem::Untagged:  return "untagged";
+        case AllocationSubsystem::Manager:   return "manager";
+        case AllocationSubsystem::Dispatch:  return "dispatch";
+        case AllocationSubsystem::Listener:  return "listener";
+        case AllocationSubsystem::Adapter:   return "adapter";
+        case AllocationSubsystem::Scenario:  return "scenario";
+        case AllocationSubsystem::Recording: return "recording";
+        case AllocationSubsystem::Sdk:       return "sdk";
+        case AllocationSubsystem::Count:     break;
+    }
+    return "untagged";
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// AllocationSnapshot Implementation
+// ============================================================================
+
+AllocationCounts AllocationSnapshot::UxdiTotal() const {
+    AllocationCounts total;
+    for (size_t i = 0; i < kAllocationSubsystemCount; ++i) {
+        const auto subsystem = static_cast<AllocationSubsystem>(i);
+        if (subsystem == AllocationSubsystem::Untagged || subsystem == AllocationSubsystem::Sdk) {
+            continue;
+        }
+        total.allocations += subsystems[i].allocations;
+        total.bytes += subsystems[i].bytes;
+        total.frees += subsystems[i].frees;
+    }
+    return total;
+}
+
+AllocationSnapshot AllocationSnapshot::operator-(const AllocationSnapshot& earlier) const {
+    AllocationSnapshot delta;
+    for (size_t i = 0; i < kAllocationSubsystemCount; ++i) {
+        delta.subsystems[i].allocations = subsystems[i].allocations - earlier.subsystems[i].allocations;
+        delta.subsystems[i].bytes = subsystems[i].bytes - earlier.subsystems[i].bytes;
+        delta.subsystems[i].frees = subsystems[i].frees - earlier.subsystems[i].frees;
+    }
+    return delta;
+}
+
+std::string AllocationSnapshot::Format() const {
+    std::string out;
+    for (size_t i = 0; i < kAllocationSubsystemCount; ++i) {
+        const AllocationCounts& counts = subsystems[i];
+        if (counts.allocations == 0 && counts.frees == 0) {
+            continue;
+        }
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-10s %10llu allocations %14llu bytes %10llu frees\n",
+                      SubsystemName(static_cast<AllocationSubsystem>(i)),
+                      static_cast<unsigned long long>(counts.allocations),
+                      static_cast<unsigned long long>(counts.bytes),
+                      static_cast<unsigned long long>(counts.frees));
+        out += line;
+    }
+    return out;
+}
+
+// ============================================================================
+// AllocationTracker Implementation
+// ============================================================================
+
+std::atomic<AllocationTracker*> AllocationTracker::s_attached{nullptr};
+
+AllocationTracker::AllocationTracker()
+    : m_threadSlot(&ThreadSubsystemSlot)
+{
+}
+
+AllocationTracker& AllocationTracker::Global() {
+    // Constant-initialized: usable from operator new before static
+    // constructors run and after static destructors
+    static constinit AllocationTracker tracker(&ThreadSubsystemSlot);
+    return tracker;
+}
+
+void AllocationTracker::Attach(AllocationTracker* tracker) {
+    s_attached.store(tracker, std::memory_order_release);
+}
+
+AllocationSubsystem AllocationTracker::GetThreadSubsystem() const {
+    return m_threadSlot();
+}
+
+AllocationSubsystem AllocationTracker::SetThreadSubsystem(AllocationSubsystem subsystem) {
+    AllocationSubsystem& slot = m_threadSlot();
+    const AllocationSubsystem previous = slot;
+    slot = subsystem;
+    return previous;
+}
+
+AllocationTracker::Counters& AllocationTracker::CountersOfThread() {
+    const size_t index = static_cast<size_t>(m_threadSlot());
+    return m_counters[index < kAllocationSubsystemCount ? index : 0];
+}
+
+void AllocationTracker::RecordAllocation(size_t bytes) {
+    Counters& counters = CountersOfThread();
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::RecordFree() {
+    CountersOfThread().frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationSnapshot AllocationTracker::Snapshot() const {
+    AllocationSnapshot snapshot;
+    for (size_t i = 0; i < kAllocationSubsystemCount; ++i) {
+        snapshot.subsystems[i].allocations = m_counters[i].allocations.load(std::memory_order_relaxed);
+        snapshot.subsystems[i].bytes = m_counters[i].bytes.load(std::memory_order_relaxed);
+        snapshot.subsystems[i].frees = m_counters[i].frees.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void AllocationTracker::Reset() {
+    for (Counters& counters : m_counters) {
+        counters.allocations.store(0, std::memory_order_relaxed);
+        counters.bytes.store(0, std::memory_order_relaxed);
+        counters.frees.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace uxdi
+
+// ============================================================================
+// Global operator new/delete replacements
+// ============================================================================
+
+#if defined(UXDI_TRACK_ALLOCATIONS)
+
+namespace {
+
+void* Allocate(std::size_t size) {
+    for (;;) {
+        if (void* p = std::malloc(size ? size : 1)) {
+            uxdi::AllocationTracker::Current().RecordAllocation(size);
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* AllocateAligned(std::size_t size, std::align_val_t alignment) {
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    for (;;) {
+#ifdef _WIN32
+        void* p = _aligned_malloc(size ? size : 1, align);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, align, size ? size : 1) != 0) {
+            p = nullptr;
+        }
+#endif
+        if (p) {
+            uxdi::AllocationTracker::Current().RecordAllocation(size);
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void Free(void* p) noexcept {
+    if (p) {
+        uxdi::AllocationTracker::Current().RecordFree();
+        std::free(p);
+    }
+}
+
+void FreeAligned(void* p) noexcept {
+    if (p) {
+        uxdi::AllocationTracker::Current().RecordFree();
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return AllocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return AllocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { Free(p); }
+void operator delete[](void* p) noexcept { Free(p); }
+void operator delete(void* p, std::size_t) noexcept { Free(p); }
+void operator delete[](void* p, std::size_t) noexcept { Free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { Free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { Free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+
+#endif // UXDI_TRACK_ALLOCATIONS
@@ -0,0 +1,77 @@
+#include "uxdi/DeadlinePacer.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace uxdi {
+
+// ============================================================================
+// DeadlinePacer Implementation
+// ============================================================================
+
+DeadlinePacer::DeadlinePacer(uint64_t intervalNs, PacingPolicy policy)
+    : m_intervalNs(intervalNs)
+    , m_policy(policy)
+{
+}
+
+void DeadlinePacer::Configure(uint64_t intervalNs, PacingPolicy policy) {
+    m_intervalNs = intervalNs;
+    m_policy = policy;
+}
+
+void DeadlinePacer::Start(uint64_t nowNs) {
+    m_startNs = nowNs;
+    m_frameIndex = 0;
+    m_stats = PacerStats{};
+}
+
+uint64_t DeadlinePacer::NextDeadline(uint64_t nowNs) {
+    m_stats.frames++;
+    if (m_intervalNs == 0) {
+        return nowNs;
+    }
+
+    uint64_t deadline = m_startNs + m_frameIndex * m_intervalNs;
+    if (nowNs > deadline + m_intervalNs) {
+        const uint64_t behindNs = nowNs - deadline;
+        if (m_policy == PacingPolicy::Skip) {
+            // Land on the most recent slot; the ones before it are dropped
+            const uint64_t missed = behindNs / m_intervalNs;
+            m_frameIndex += missed;
+            m_stats.skippedSlots += missed;
+            deadline += missed * m_intervalNs;
+        } else if (behindNs > kRebaseNs) {
+            m_startNs = nowNs;
+            m_frameIndex = 0;
+            m_stats.rebases++;
+            deadline = nowNs;
+        }
+    }
+
+    if (deadline < nowNs) {
+        m_stats.lateFrames++;
+    }
+    m_frameIndex++;
+    return deadline;
+}
+
+bool DeadlinePacer::SleepUntil(uint64_t deadlineNs, const std::atomic<bool>& running, uint64_t spinNs) {
+    constexpr uint64_t kMaxSleepNs = 10'000'000;
+
+    while (running.load(std::memory_order_relaxed)) {
+        const uint64_t nowNs = MonotonicNowNs();
+        if (nowNs >= deadlineNs) {
+            return true;
+        }
+        const uint64_t remainingNs = deadlineNs - nowNs;
+        if (remainingNs > spinNs) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(remainingNs - spinNs, kMaxSleepNs)));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    return false;
+}
+
+} // namespace uxdi
@@ -1,10 +1,57 @@
 #include "uxdi/DetectorFactory.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
 #include <stdexcept>
 #include <system_error>
 #include <vector>
 
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
 namespace uxdi {
 
+namespace {
+
+// Thin wrappers over LoadLibrary/dlopen so the factory logic stays shared
+
+#ifdef _WIN32
+HMODULE OpenModule(const std::wstring& path) {
+    return LoadLibraryW(path.c_str());
+}
+
+void* FindSymbol(HMODULE module, const char* name) {
+    return reinterpret_cast<void*>(GetProcAddress(module, name));
+}
+
+void CloseModule(HMODULE module) {
+    CloseModule(module);
+}
+
+std::string LastModuleError() {
+    return "Error code: " + std::to_string(GetLastError());
+}
+#else
+void* OpenModule(const std::wstring& path) {
+    return dlopen(DetectorFactory::ToUtf8String(path).c_str(), RTLD_NOW | RTLD_LOCAL);
+}
+
+void* FindSymbol(void* module, const char* name) {
+    return dlsym(module, name);
+}
+
+void CloseModule(void* module) {
+    dlclose(module);
+}
+
+std::string LastModuleError() {
+    const char* error = dlerror();
+    return error ? error : "unknown error";
+}
+#endif
+
+} // anonymous namespace
+
 // Static member initialization
 std::vector<DetectorFactory::AdapterHandle> DetectorFactory::s_loadedAdapters;
 std::mutex DetectorFactory::s_mutex;
@@ -21,21 +68,20 @@ size_t DetectorFactory::LoadAdapter(const std::wstring& dllPath) {
     std::lock_guard<std::mutex> lock(s_mutex);
 
     // Load the DLL
-    HMODULE hModule = LoadLibraryW(dllPath.c_str());
+    ModuleHandle hModule = OpenModule(dllPath);
     if (!hModule) {
-        DWORD error = GetLastError();
         throw std::runtime_error(
             "Failed to load DLL: " + ToUtf8String(dllPath) +
-            " (Error code: " + std::to_string(error) + ")"
+            " (" + LastModuleError() + ")"
         );
     }
 
     // Get CreateDetector function
     auto createFunc = reinterpret_cast<CreateDetectorFunc>(
-        GetProcAddress(hModule, "CreateDetector")
+        FindSymbol(hModule, "CreateDetector")
     );
     if (!createFunc) {
-        FreeLibrary(hModule);
+        CloseModule(hModule);
         throw std::runtime_error(
             "DLL does not export CreateDetector: " + ToUtf8String(dllPath)
         );
@@ -43,15 +89,29 @@ size_t DetectorFactory::LoadAdapter(const std::wstring& dllPath) {
 
     // Get DestroyDetector function
     auto destroyFunc = reinterpret_cast<DestroyDetectorFunc>(
-        GetProcAddress(hModule, "DestroyDetector")
+        FindSymbol(hModule, "DestroyDetector")
     );
     if (!destroyFunc) {
-        FreeLibrary(hModule);
+        CloseModule(hModule);
         throw std::runtime_error(
             "DLL does not export DestroyDetector: " + ToUtf8String(dllPath)
         );
     }
 
+    // Share the host's trace timeline with the adapter's copy of uxdi_core
+    auto attachTraceFunc = reinterpret_cast<AttachTraceRecorderFunc>(
+        FindSymbol(hModule, "AttachTraceRecorder")
+    );
+    if (attachTraceFunc) {
+        attachTraceFunc(&TraceRecorder::Current());
+    }
+    auto attachAllocationFunc = reinterpret_cast<AttachAllocationTrackerFunc>(
+        FindSymbol(hModule, "AttachAllocationTracker")
+    );
+    if (attachAllocationFunc) {
+        attachAllocationFunc(&AllocationTracker::Current());
+    }
+
     // Try to query adapter info by creating a temporary detector
     // (Note: This assumes adapters can be created with empty config to query info)
     DetectorAdapterInfo info;
@@ -86,6 +146,10 @@ size_t DetectorFactory::LoadAdapter(const std::wstring& dllPath) {
     return adapterId;
 }
 
+size_t DetectorFactory::LoadAdapter(const std::string& dllPath) {
+    return LoadAdapter(ToWideString(dllPath));
+}
+
 std::vector<DetectorAdapterInfo> DetectorFactory::GetLoadedAdapters() {
     std::lock_guard<std::mutex> lock(s_mutex);
 
@@ -168,7 +232,7 @@ void DetectorFactory::UnloadAdapter(size_t adapterId) {
     for (auto it = s_loadedAdapters.begin(); it != s_loadedAdapters.end(); ++it) {
         size_t currentId = (it - s_loadedAdapters.begin()) + 1;
         if (currentId == adapterId) {
-            FreeLibrary(it->hModule);
+            CloseModule(it->hModule);
             s_loadedAdapters.erase(it);
             return;
         }
@@ -183,12 +247,13 @@ void DetectorFactory::UnloadAllAdapters() {
     std::lock_guard<std::mutex> lock(s_mutex);
 
     for (auto& handle : s_loadedAdapters) {
-        FreeLibrary(handle.hModule);
+        CloseModule(handle.hModule);
     }
 
     s_loadedAdapters.clear();
 }
 
+#ifdef _WIN32
 std::wstring DetectorFactory::ToWideString(const std::string& utf8) {
     if (utf8.empty()) {
         return std::wstring();
@@ -262,5 +327,77 @@ std::string DetectorFactory::ToUtf8String(const std::wstring& wide) {
 
     return result;
 }
+#else
+std::wstring DetectorFactory::ToWideString(const std::string& utf8) {
+    // wchar_t holds a full code point outside Windows
+    std::wstring result;
+    result.reserve(utf8.size());
+
+    for (size_t i = 0; i < utf8.size();) {
+        const auto lead = static_cast<unsigned char>(utf8[i]);
+        size_t length = 0;
+        char32_t codePoint = 0;
+        if (lead < 0x80) {
+            length = 1;
+            codePoint = lead;
+        } else if ((lead & 0xE0) == 0xC0) {
+            length = 2;
+            codePoint = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3;
+            codePoint = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 4;
+            codePoint = lead & 0x07;
+        } else {
+            throw std::runtime_error("Failed to convert UTF-8 to wide string");
+        }
+
+        if (i + length > utf8.size()) {
+            throw std::runtime_error("Failed to convert UTF-8 to wide string");
+        }
+        for (size_t k = 1; k < length; ++k) {
+            const auto next = static_cast<unsigned char>(utf8[i + k]);
+            if ((next & 0xC0) != 0x80) {
+                throw std::runtime_error("Failed to convert UTF-8 to wide string");
+            }
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+
+        result.push_back(static_cast<wchar_t>(codePoint));
+        i += length;
+    }
+
+    return result;
+}
+
+std::string DetectorFactory::ToUtf8String(const std::wstring& wide) {
+    std::string result;
+    result.reserve(wide.size());
+
+    for (wchar_t ch : wide) {
+        const auto codePoint = static_cast<char32_t>(ch);
+        if (codePoint < 0x80) {
+            result.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x110000) {
+            result.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            throw std::runtime_error("Failed to convert wide string to UTF-8");
+        }
+    }
+
+    return result;
+}
+#endif
 
 } // namespace uxdi
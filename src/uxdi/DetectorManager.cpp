@@ -1,12 +1,54 @@
 #include "uxdi/DetectorManager.h"
+#include "uxdi/AllocationTracker.h"
 #include "uxdi/DetectorFactory.h"
 #include <algorithm>
 #include <stdexcept>
 
 namespace uxdi {
 
-DetectorManager::DetectorManager()
+DetectorManager::DetectorEntry::DetectorEntry(size_t id_, size_t adapterId_,
+                                              std::unique_ptr<IDetector, DetectorFactoryDeleter> detector_,
+                                              MetricsRegistry& metrics)
+    : id(id_)
+    , adapterId(adapterId_)
+    , dispatcher(std::make_shared<FrameDispatcher>())
+    , detector(std::move(detector_))
+{
+    dispatcher->BindMetrics(metrics, {{"detector", std::to_string(id)}, {"adapter", std::to_string(adapterId)}});
+    detector->setListener(dispatcher.get());
+}
+
+DetectorManager::DetectorEntry::~DetectorEntry() {
+    Release();
+}
+
+DetectorManager::DetectorEntry& DetectorManager::DetectorEntry::operator=(DetectorEntry&& other) noexcept {
+    if (this != &other) {
+        Release();
+        id = other.id;
+        adapterId = other.adapterId;
+        detector = std::move(other.detector);
+        dispatcher = std::move(other.dispatcher);
+    }
+    return *this;
+}
+
+void DetectorManager::DetectorEntry::Release() {
+    // Detach first; matters for detectors the manager does not own
+    if (detector && dispatcher && detector->getListener() == dispatcher.get()) {
+        detector->setListener(nullptr);
+    }
+    detector.reset();
+    dispatcher.reset();
+}
+
+DetectorManager::DetectorManager(MetricsRegistry& metrics)
     : m_nextDetectorId(1)
+    , m_metrics(metrics)
+    , m_detectorsMetric(metrics.GetGauge("uxdi_detectors", "Detectors currently managed"))
+    , m_createdMetric(metrics.GetCounter("uxdi_detectors_created_total", "Detectors created or registered"))
+    , m_createFailuresMetric(metrics.GetCounter("uxdi_detector_create_failures_total", "Failed detector creations"))
+    , m_destroyedMetric(metrics.GetCounter("uxdi_detectors_destroyed_total", "Detectors destroyed"))
 {
 }
 
@@ -16,6 +58,7 @@ DetectorManager::~DetectorManager() {
 }
 
 size_t DetectorManager::CreateDetector(size_t adapterId, const std::string& config) {
+    UXDI_ALLOC_SCOPE(Manager);
     std::lock_guard<std::mutex> lock(m_mutex);
 
     try {
@@ -23,30 +66,51 @@ size_t DetectorManager::CreateDetector(size_t adapterId, const std::string& conf
         auto detector = DetectorFactory::CreateDetector(adapterId, config);
 
         if (!detector) {
+            m_createFailuresMetric.Increment();
             return 0; // Failed to create detector
         }
 
-        // Assign a unique detector ID
-        size_t detectorId = m_nextDetectorId++;
-
-        // Add detector entry to registry
-        m_detectors.emplace_back(detectorId, adapterId, std::move(detector));
-
-        return detectorId;
+        return AddDetectorEntry(adapterId, std::move(detector));
     }
     catch (const std::exception&) {
         // DetectorFactory::CreateDetector throws on invalid adapterId or creation failure
+        m_createFailuresMetric.Increment();
         return 0;
     }
 }
 
+size_t DetectorManager::RegisterDetector(std::unique_ptr<IDetector, DetectorFactoryDeleter> detector, size_t adapterId) {
+    UXDI_ALLOC_SCOPE(Manager);
+    if (!detector) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return AddDetectorEntry(adapterId, std::move(detector));
+}
+
+size_t DetectorManager::AddDetectorEntry(size_t adapterId, std::unique_ptr<IDetector, DetectorFactoryDeleter> detector) {
+    // Assign a unique detector ID
+    size_t detectorId = m_nextDetectorId++;
+
+    // Add detector entry to registry
+    m_detectors.emplace_back(detectorId, adapterId, std::move(detector), m_metrics);
+    m_createdMetric.Increment();
+    m_detectorsMetric.Add(1);
+
+    return detectorId;
+}
+
 void DetectorManager::DestroyDetector(size_t detectorId) {
+    UXDI_ALLOC_SCOPE(Manager);
     std::lock_guard<std::mutex> lock(m_mutex);
 
     auto it = FindDetectorEntry(detectorId);
     if (it != m_detectors.end()) {
         // Remove from vector (unique_ptr auto-deletes the detector)
         m_detectors.erase(it);
+        m_destroyedMetric.Increment();
+        m_detectorsMetric.Add(-1);
     }
     // If detectorId not found, silently ignore (idempotent operation)
 }
@@ -61,7 +125,9 @@ IDetector* DetectorManager::GetDetector(size_t detectorId) {
     return nullptr;
 }
 
-bool DetectorManager::AddListener(size_t detectorId, IDetectorListener* listener) {
+bool DetectorManager::AddListener(size_t detectorId, IDetectorListener* listener,
+                                  const ListenerOptions& options) {
+    UXDI_ALLOC_SCOPE(Manager);
     if (!listener) {
         return false;
     }
@@ -73,51 +139,44 @@ bool DetectorManager::AddListener(size_t detectorId, IDetectorListener* listener
         return false; // Detector not found
     }
 
-    // Check for duplicate listener
-    auto& listeners = it->listeners;
-    if (std::find(listeners.begin(), listeners.end(), listener) != listeners.end()) {
-        return false; // Already registered
-    }
-
-    // Add listener to the list
-    listeners.push_back(listener);
-    return true;
+    // Dispatcher rejects duplicates
+    return it->dispatcher->AddListener(listener, options);
 }
 
 bool DetectorManager::RemoveListener(size_t detectorId, IDetectorListener* listener) {
+    UXDI_ALLOC_SCOPE(Manager);
     if (!listener) {
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    auto it = FindDetectorEntry(detectorId);
-    if (it == m_detectors.end()) {
+    // The dispatcher waits for the listener's running callbacks, which may
+    // call back into the manager, so it is not asked under m_mutex
+    std::shared_ptr<FrameDispatcher> dispatcher = FindDispatcher(detectorId);
+    if (!dispatcher) {
         return false; // Detector not found
     }
 
-    auto& listeners = it->listeners;
-    auto listenerIt = std::find(listeners.begin(), listeners.end(), listener);
-
-    if (listenerIt != listeners.end()) {
-        listeners.erase(listenerIt);
-        return true;
-    }
-
-    return false; // Listener not found
+    return dispatcher->RemoveListener(listener);
 }
 
-size_t DetectorManager::RemoveAllListeners(size_t detectorId) {
+ListenerStats DetectorManager::GetListenerStats(size_t detectorId, IDetectorListener* listener) const {
     std::lock_guard<std::mutex> lock(m_mutex);
 
     auto it = FindDetectorEntry(detectorId);
-    if (it == m_detectors.end()) {
+    if (it != m_detectors.end()) {
+        return it->dispatcher->GetListenerStats(listener);
+    }
+    return ListenerStats{};
+}
+
+size_t DetectorManager::RemoveAllListeners(size_t detectorId) {
+    // Not under m_mutex, as in RemoveListener()
+    std::shared_ptr<FrameDispatcher> dispatcher = FindDispatcher(detectorId);
+    if (!dispatcher) {
         return 0; // Detector not found
     }
 
-    size_t count = it->listeners.size();
-    it->listeners.clear();
-    return count;
+    return dispatcher->RemoveAllListeners();
 }
 
 DetectorState DetectorManager::GetState(size_t detectorId) {
@@ -131,6 +190,7 @@ DetectorState DetectorManager::GetState(size_t detectorId) {
 }
 
 DetectorInfo DetectorManager::GetInfo(size_t detectorId) {
+    UXDI_ALLOC_SCOPE(Manager);
     std::lock_guard<std::mutex> lock(m_mutex);
 
     auto it = FindDetectorEntry(detectorId);
@@ -140,10 +200,43 @@ DetectorInfo DetectorManager::GetInfo(size_t detectorId) {
     return DetectorInfo{}; // Return empty info if not found
 }
 
+DetectorStatistics DetectorManager::GetStatistics(size_t detectorId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = FindDetectorEntry(detectorId);
+    if (it != m_detectors.end() && it->detector) {
+        return it->detector->getStatistics();
+    }
+    return DetectorStatistics{};
+}
+
+LatencyStats DetectorManager::GetLatencyStats(size_t detectorId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = FindDetectorEntry(detectorId);
+    if (it != m_detectors.end()) {
+        return it->dispatcher->GetLatencyStats();
+    }
+    return LatencyStats{};
+}
+
+bool DetectorManager::ResetLatencyStats(size_t detectorId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = FindDetectorEntry(detectorId);
+    if (it == m_detectors.end()) {
+        return false;
+    }
+    it->dispatcher->ResetLatencyStats();
+    return true;
+}
+
 void DetectorManager::DestroyAllDetectors() {
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Clear all detectors (unique_ptrs auto-delete)
+    m_destroyedMetric.Increment(m_detectors.size());
+    m_detectorsMetric.Add(-static_cast<int64_t>(m_detectors.size()));
     m_detectors.clear();
 }
 
@@ -153,16 +246,21 @@ size_t DetectorManager::GetDetectorCount() const {
 }
 
 std::vector<size_t> DetectorManager::GetDetectorIds() const {
+    std::vector<size_t> ids;
+    GetDetectorIds(ids);
+    return ids;
+}
+
+void DetectorManager::GetDetectorIds(std::vector<size_t>& ids) const {
+    UXDI_ALLOC_SCOPE(Manager);
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    std::vector<size_t> ids;
+    ids.clear();
     ids.reserve(m_detectors.size());
 
     for (const auto& entry : m_detectors) {
         ids.push_back(entry.id);
     }
-
-    return ids;
 }
 
 bool DetectorManager::IsValidDetector(size_t detectorId) const {
@@ -186,4 +284,11 @@ DetectorManager::FindDetectorEntry(size_t detectorId) const {
         });
 }
 
+std::shared_ptr<FrameDispatcher> DetectorManager::FindDispatcher(size_t detectorId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = FindDetectorEntry(detectorId);
+    return it != m_detectors.end() ? it->dispatcher : nullptr;
+}
+
 } // namespace uxdi
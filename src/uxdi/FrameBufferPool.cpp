@@ -0,0 +1,63 @@
+#include "uxdi/FrameBufferPool.h"
+#include <algorithm>
+#include <atomic>
+
+namespace uxdi {
+
+// ============================================================================
+// FrameBufferPool Implementation
+// ============================================================================
+
+FrameBufferPool::FrameBufferPool(size_t maxBuffers)
+    : m_maxBuffers(std::max<size_t>(maxBuffers, 1))
+{
+    m_slots.reserve(m_maxBuffers);
+}
+
+std::shared_ptr<uint8_t[]> FrameBufferPool::Acquire(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // A slot is free when the pool holds the only reference; a smaller free
+    // slot is kept as a fallback for a resolution change
+    Slot* undersized = nullptr;
+    for (Slot& slot : m_slots) {
+        if (slot.buffer.use_count() != 1) {
+            continue;
+        }
+        if (slot.capacity >= bytes) {
+            // Pairs with the release in the last holder's shared_ptr destructor
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return slot.buffer;
+        }
+        if (!undersized) {
+            undersized = &slot;
+        }
+    }
+
+    ++m_allocations;
+    std::shared_ptr<uint8_t[]> buffer(new uint8_t[bytes]);
+    if (undersized) {
+        undersized->buffer = buffer;
+        undersized->capacity = bytes;
+    } else if (m_slots.size() < m_maxBuffers) {
+        m_slots.push_back(Slot{buffer, bytes});
+    }
+    return buffer;
+}
+
+size_t FrameBufferPool::GetBufferCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots.size();
+}
+
+uint64_t FrameBufferPool::GetAllocationCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_allocations;
+}
+
+void FrameBufferPool::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots.clear();
+}
+
+} // namespace uxdi
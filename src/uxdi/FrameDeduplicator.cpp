@@ -0,0 +1,230 @@
+#include "uxdi/FrameDeduplicator.h"
+#include <algorithm>
+#include <cstring>
+
+namespace uxdi {
+
+namespace {
+
+constexpr uint32_t kGrid = FrameFingerprint::kGridSize;
+
+// ============================================================================
+// Pixel kernels
+// ============================================================================
+//
+// The inner loops are branch-free over contiguous memory with narrow
+// accumulators, which MSVC (/O2) and GCC/Clang (-O3, the CMake Release
+// default) turn into SIMD code.
+// Accumulators are flushed into 64-bit totals in chunks small enough that
+// 16-bit pixels cannot overflow them.
+
+constexpr size_t kChunkPixels = 16384;
+
+template <typename T>
+uint64_t SumAbsDiff(const T* a, const T* b, size_t count) {
+    uint64_t total = 0;
+    for (size_t start = 0; start < count; start += kChunkPixels) {
+        const size_t end = std::min(count, start + kChunkPixels);
+        uint32_t acc = 0;
+        for (size_t i = start; i < end; ++i) {
+            const int32_t d = static_cast<int32_t>(a[i]) - static_cast<int32_t>(b[i]);
+            acc += static_cast<uint32_t>(d < 0 ? -d : d);
+        }
+        total += acc;
+    }
+    return total;
+}
+
+template <typename T>
+uint64_t SumRange(const T* pixels, size_t count) {
+    uint64_t total = 0;
+    for (size_t start = 0; start < count; start += kChunkPixels) {
+        const size_t end = std::min(count, start + kChunkPixels);
+        uint32_t acc = 0;
+        for (size_t i = start; i < end; ++i) {
+            acc += pixels[i];
+        }
+        total += acc;
+    }
+    return total;
+}
+
+uint32_t CellStart(uint32_t cell, uint32_t extent) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(cell) * extent / kGrid);
+}
+
+uint64_t CellPixels(uint32_t cx, uint32_t cy, uint32_t width, uint32_t height) {
+    const uint64_t w = CellStart(cx + 1, width) - CellStart(cx, width);
+    const uint64_t h = CellStart(cy + 1, height) - CellStart(cy, height);
+    return w * h;
+}
+
+template <typename T>
+void AccumulateCells(const T* pixels, uint32_t width, uint32_t height, FrameFingerprint& out) {
+    std::array<uint64_t, kGrid * kGrid> sums{};
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint32_t cy = static_cast<uint32_t>(static_cast<uint64_t>(y) * kGrid / height);
+        const T* row = pixels + static_cast<size_t>(y) * width;
+        for (uint32_t cx = 0; cx < kGrid; ++cx) {
+            const uint32_t x0 = CellStart(cx, width);
+            const uint32_t x1 = CellStart(cx + 1, width);
+            sums[cy * kGrid + cx] += SumRange(row + x0, x1 - x0);
+        }
+    }
+    for (uint32_t cy = 0; cy < kGrid; ++cy) {
+        for (uint32_t cx = 0; cx < kGrid; ++cx) {
+            const uint64_t count = CellPixels(cx, cy, width, height);
+            out.cellMeans[cy * kGrid + cx] =
+                count > 0 ? static_cast<uint32_t>(sums[cy * kGrid + cx] / count) : 0;
+        }
+    }
+}
+
+size_t BytesPerPixel(const ImageData& image) {
+    return image.bitDepth > 8 ? 2 : 1;
+}
+
+size_t PixelCount(const ImageData& image) {
+    return static_cast<size_t>(image.width) * image.height;
+}
+
+bool HasPixels(const ImageData& image) {
+    return image.data && image.width > 0 && image.height > 0 &&
+           image.dataLength >= PixelCount(image) * BytesPerPixel(image);
+}
+
+bool SameFormat(const ImageData& a, const ImageData& b) {
+    return a.width == b.width && a.height == b.height && BytesPerPixel(a) == BytesPerPixel(b);
+}
+
+uint64_t SumAbsDiff(const uint8_t* a, const uint8_t* b, size_t pixels, size_t bytesPerPixel) {
+    if (bytesPerPixel == 2) {
+        return SumAbsDiff(reinterpret_cast<const uint16_t*>(a),
+                          reinterpret_cast<const uint16_t*>(b), pixels);
+    }
+    return SumAbsDiff(a, b, pixels);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// FrameDeduplicator Implementation
+// ============================================================================
+
+FrameDeduplicator::FrameDeduplicator(const DedupOptions& options)
+    : m_options(options)
+{
+}
+
+DedupResult FrameDeduplicator::Analyze(const ImageData& image) {
+    const DedupResult result = Classify(image);
+    if (!result.isStatic) {
+        AdoptKeyFrame(image, result);
+    }
+    return result;
+}
+
+DedupResult FrameDeduplicator::Classify(const ImageData& image) {
+    DedupResult result;
+    if (!HasPixels(image)) {
+        return result;
+    }
+
+    result.fingerprint = ComputeFingerprint(image);
+    const FrameFingerprint& fingerprint = result.fingerprint;
+    const bool runAllowed = m_options.maxStaticRun == 0 || m_staticRun < m_options.maxStaticRun;
+
+    if (m_hasKeyFrame && runAllowed && SameFormat(image, m_keyFrame)) {
+        const size_t pixels = PixelCount(image);
+
+        // Stage 1: a cell whose mean moved by d contributes at least
+        // (d - 1) * cellPixels to the total difference (means are floored)
+        bool possible = true;
+        for (uint32_t cy = 0; cy < kGrid && possible; ++cy) {
+            for (uint32_t cx = 0; cx < kGrid; ++cx) {
+                const uint32_t a = fingerprint.cellMeans[cy * kGrid + cx];
+                const uint32_t b = m_keyFingerprint.cellMeans[cy * kGrid + cx];
+                const uint32_t delta = a > b ? a - b : b - a;
+                if (delta > 1) {
+                    const double bound = static_cast<double>(delta - 1) *
+                        static_cast<double>(CellPixels(cx, cy, image.width, image.height)) /
+                        static_cast<double>(pixels);
+                    if (bound > m_options.changeThreshold) {
+                        result.meanAbsDifference = bound;
+                        possible = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Stage 2: exact mean absolute difference
+        if (possible) {
+            const uint64_t sum = SumAbsDiff(image.data.get(), m_keyPixels.data(),
+                                            pixels, BytesPerPixel(image));
+            result.meanAbsDifference = static_cast<double>(sum) / static_cast<double>(pixels);
+            if (result.meanAbsDifference <= m_options.changeThreshold) {
+                result.isStatic = true;
+                result.referenceFrame = m_keyFrame.frameNumber;
+                ++m_staticRun;
+                ++m_staticFrames;
+                return result;
+            }
+        }
+    }
+
+    return result;
+}
+
+void FrameDeduplicator::AdoptKeyFrame(const ImageData& image, const DedupResult& result) {
+    if (!HasPixels(image)) {
+        ++m_keyFrames;
+        return;
+    }
+    StoreKeyFrame(image, result.fingerprint);
+}
+
+void FrameDeduplicator::Reset() {
+    m_hasKeyFrame = false;
+    m_staticRun = 0;
+}
+
+FrameFingerprint FrameDeduplicator::ComputeFingerprint(const ImageData& image) {
+    FrameFingerprint fingerprint;
+    if (!HasPixels(image)) {
+        return fingerprint;
+    }
+
+    if (BytesPerPixel(image) == 2) {
+        AccumulateCells(reinterpret_cast<const uint16_t*>(image.data.get()),
+                        image.width, image.height, fingerprint);
+    } else {
+        AccumulateCells(image.data.get(), image.width, image.height, fingerprint);
+    }
+    return fingerprint;
+}
+
+double FrameDeduplicator::ComputeMeanAbsDifference(const ImageData& a, const ImageData& b) {
+    if (!HasPixels(a) || !HasPixels(b) || !SameFormat(a, b)) {
+        return -1.0;
+    }
+    const size_t pixels = PixelCount(a);
+    const uint64_t sum = SumAbsDiff(a.data.get(), b.data.get(), pixels, BytesPerPixel(a));
+    return static_cast<double>(sum) / static_cast<double>(pixels);
+}
+
+void FrameDeduplicator::StoreKeyFrame(const ImageData& image, const FrameFingerprint& fingerprint) {
+    const size_t bytes = PixelCount(image) * BytesPerPixel(image);
+    m_keyPixels.resize(bytes);  // Keeps capacity across key frames of the same size
+    std::memcpy(m_keyPixels.data(), image.data.get(), bytes);
+
+    // Keep metadata only; holding the caller's buffer would defeat pooling
+    m_keyFrame = image;
+    m_keyFrame.data.reset();
+    m_keyFingerprint = fingerprint;
+    m_hasKeyFrame = true;
+    m_staticRun = 0;
+    ++m_keyFrames;
+}
+
+} // namespace uxdi
@@ -0,0 +1,510 @@
+#include "uxdi/FrameDispatcher.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/FrameBufferPool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+namespace uxdi {
+
+namespace {
+
+void RecordInterval(LatencyHistogram& histogram, uint64_t startNs, uint64_t endNs) {
+    if (startNs != 0 && endNs >= startNs) {
+        histogram.Record(endNs - startNs);
+    }
+}
+
+const char* StateName(DetectorState state) {
+    switch (state) {
+        case DetectorState::UNKNOWN:      return "UNKNOWN";
+        case DetectorState::IDLE:         return "IDLE";
+        case DetectorState::INITIALIZING: return "INITIALIZING";
+        case DetectorState::READY:        return "READY";
+        case DetectorState::ACQUIRING:    return "ACQUIRING";
+        case DetectorState::STOPPING:     return "STOPPING";
+        case DetectorState::ERROR:        return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+const char* ErrorCodeName(ErrorCode code) {
+    switch (code) {
+        case ErrorCode::SUCCESS:             return "SUCCESS";
+        case ErrorCode::UNKNOWN_ERROR:       return "UNKNOWN_ERROR";
+        case ErrorCode::NOT_INITIALIZED:     return "NOT_INITIALIZED";
+        case ErrorCode::ALREADY_INITIALIZED: return "ALREADY_INITIALIZED";
+        case ErrorCode::INVALID_PARAMETER:   return "INVALID_PARAMETER";
+        case ErrorCode::TIMEOUT:             return "TIMEOUT";
+        case ErrorCode::HARDWARE_ERROR:      return "HARDWARE_ERROR";
+        case ErrorCode::COMMUNICATION_ERROR: return "COMMUNICATION_ERROR";
+        case ErrorCode::NOT_SUPPORTED:       return "NOT_SUPPORTED";
+        case ErrorCode::STATE_ERROR:         return "STATE_ERROR";
+        case ErrorCode::OUT_OF_MEMORY:       return "OUT_OF_MEMORY";
+    }
+    return "UNKNOWN_ERROR";
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Listener entries
+// ============================================================================
+
+/**
+ * @brief A registered listener with its budget, counters and async queue
+ *
+ * The queue and worker thread exist only once the listener is demoted. The
+ * worker holds a reference to the entry, so Retire() must be called before
+ * the dispatcher lets go of it.
+ *
+ * Synchronous callbacks go through Invoke(), which counts them in flight.
+ * The dispatcher unlinks an entry before retiring it, but a dispatch that
+ * grabbed the old list may still reach it: either Invoke() sees the entry
+ * retired and skips the call, or Retire() sees the call and waits for it.
+ */
+struct FrameDispatcher::ListenerEntry {
+    IDetectorListener* const listener;
+    const ListenerOptions options;
+
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint64_t> droppedFrames{0};
+    std::atomic<uint64_t> maxCallbackNs{0};
+    std::atomic<bool> demoted{false};
+
+    // Synchronous callbacks in progress; Retire() waits for them to finish
+    std::atomic<uint32_t> inFlight{0};
+    std::atomic<bool> retired{false};
+    static inline thread_local const ListenerEntry* current = nullptr;  // Entry this thread is calling
+
+    // Null when metrics are not bound
+    MetricCounter* overrunsMetric = nullptr;
+    MetricCounter* droppedMetric = nullptr;
+    MetricCounter* demotionsMetric = nullptr;
+
+    // Async delivery; ring of queued frames guarded by queueMutex
+    std::mutex queueMutex;
+    std::condition_variable queueCv;
+    std::vector<ImageData> queue;
+    size_t queueHead = 0;
+    size_t queueCount = 0;
+    bool stopping = false;
+    FrameBufferPool copyPool;
+    std::thread worker;
+
+    ListenerEntry(IDetectorListener* listener_, const ListenerOptions& options_)
+        : listener(listener_)
+        , options(options_)
+        , copyPool(std::max<size_t>(options_.asyncQueueDepth, 1) + 2)
+    {
+    }
+
+    ~ListenerEntry() {
+        Stop();
+    }
+
+    /**
+     * @brief Call the listener on this thread unless it has been retired
+     * @return true if the listener was called
+     */
+    template <typename Callback>
+    bool Invoke(Callback&& callback) {
+        // Sequentially consistent with Retire(): one of the two sees the other
+        inFlight.fetch_add(1);
+        if (!retired.load()) {
+            const ListenerEntry* const outer = current;
+            current = this;
+            callback(listener);
+            current = outer;
+            Leave();
+            return true;
+        }
+        Leave();
+        return false;
+    }
+
+    /**
+     * @brief Stop calling the listener and wait for calls in progress
+     *
+     * A listener retiring itself from its own callback waits only for the
+     * calls on other threads.
+     */
+    void Retire() {
+        retired.store(true);
+        const uint32_t own = current == this ? 1 : 0;
+        for (uint32_t calls = inFlight.load(); calls > own; calls = inFlight.load()) {
+            inFlight.wait(calls);
+        }
+        Stop();
+    }
+
+    void Leave() {
+        inFlight.fetch_sub(1);
+        if (retired.load()) {
+            inFlight.notify_all();
+        }
+    }
+
+    /**
+     * @brief Account one onImageReceived call
+     * @return true if the call overran the budget
+     */
+    bool RecordCallback(uint64_t durationNs) {
+        uint64_t previousMax = maxCallbackNs.load(std::memory_order_relaxed);
+        while (durationNs > previousMax &&
+               !maxCallbackNs.compare_exchange_weak(previousMax, durationNs, std::memory_order_relaxed)) {
+        }
+
+        if (options.callbackBudgetNs == 0 || durationNs <= options.callbackBudgetNs) {
+            return false;
+        }
+        overruns.fetch_add(1, std::memory_order_relaxed);
+        if (overrunsMetric) {
+            overrunsMetric->Increment();
+        }
+        return true;
+    }
+
+    bool ShouldDemote() const {
+        return options.demoteAfterOverruns != 0 &&
+               overruns.load(std::memory_order_relaxed) >= options.demoteAfterOverruns;
+    }
+
+    void Enqueue(const ImageData& image) {
+        ImageData queued = image;
+        if (IsBorrowedBuffer(image)) {
+            queued.data = copyPool.Acquire(image.dataLength);
+            std::memcpy(queued.data.get(), image.data.get(), image.dataLength);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (stopping) {
+                return;
+            }
+            if (queueCount == queue.size()) {
+                queue[queueHead] = ImageData{};
+                queueHead = (queueHead + 1) % queue.size();
+                --queueCount;
+                droppedFrames.fetch_add(1, std::memory_order_relaxed);
+                if (droppedMetric) {
+                    droppedMetric->Increment();
+                }
+            }
+            queue[(queueHead + queueCount) % queue.size()] = std::move(queued);
+            ++queueCount;
+        }
+        queueCv.notify_one();
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+            for (ImageData& image : queue) {
+                image = ImageData{};
+            }
+            queueCount = 0;
+        }
+        queueCv.notify_all();
+
+        if (worker.joinable()) {
+            // A listener removing itself from its own queue thread
+            if (worker.get_id() == std::this_thread::get_id()) {
+                worker.detach();
+            } else {
+                worker.join();
+            }
+        }
+    }
+
+    static void WorkerLoop(std::shared_ptr<ListenerEntry> entry) {
+        UXDI_TRACE_THREAD_NAME("uxdi listener queue");
+        UXDI_ALLOC_SCOPE(Listener);
+
+        ImageData image;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(entry->queueMutex);
+                entry->queueCv.wait(lock, [&entry] { return entry->stopping || entry->queueCount > 0; });
+                if (entry->stopping) {
+                    break;
+                }
+                image = std::move(entry->queue[entry->queueHead]);
+                entry->queueHead = (entry->queueHead + 1) % entry->queue.size();
+                --entry->queueCount;
+            }
+
+            UXDI_TRACE_SCOPE_ARG(Dispatch, "listener.queued.onImageReceived", image.frameNumber);
+            const uint64_t entryNs = MonotonicNowNs();
+            entry->listener->onImageReceived(image);
+            entry->RecordCallback(MonotonicNowNs() - entryNs);
+
+            // Hand the buffer back before waiting for the next frame
+            image = ImageData{};
+        }
+    }
+};
+
+// ============================================================================
+// FrameDispatcher Implementation
+// ============================================================================
+
+FrameDispatcher::FrameDispatcher()
+    : m_listeners(std::make_shared<const ListenerList>())
+{
+}
+
+FrameDispatcher::~FrameDispatcher() {
+    for (const std::shared_ptr<ListenerEntry>& entry : *GetListeners()) {
+        entry->Retire();
+    }
+}
+
+bool FrameDispatcher::AddListener(IDetectorListener* listener, const ListenerOptions& options) {
+    if (!listener) {
+        return false;
+    }
+
+    auto entry = std::make_shared<ListenerEntry>(listener, options);
+    if (m_metrics) {
+        MetricLabels labels = m_metricLabels;
+        labels.emplace_back("listener", options.name.empty() ? "unnamed" : options.name);
+        entry->overrunsMetric = &m_metrics->GetCounter(
+            "uxdi_listener_overruns_total", "Listener callbacks longer than their budget", labels);
+        entry->droppedMetric = &m_metrics->GetCounter(
+            "uxdi_listener_dropped_frames_total", "Frames dropped from a demoted listener's queue", labels);
+        entry->demotionsMetric = &m_metrics->GetCounter(
+            "uxdi_listener_demotions_total", "Listeners moved to an async queue", labels);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto matches = [listener](const std::shared_ptr<ListenerEntry>& e) { return e->listener == listener; };
+    if (std::find_if(m_listeners->begin(), m_listeners->end(), matches) != m_listeners->end()) {
+        return false;
+    }
+
+    auto updated = std::make_shared<ListenerList>(*m_listeners);
+    updated->push_back(std::move(entry));
+    m_listeners = std::move(updated);
+    if (m_listenersMetric) {
+        m_listenersMetric->Set(static_cast<int64_t>(m_listeners->size()));
+    }
+    return true;
+}
+
+bool FrameDispatcher::RemoveListener(IDetectorListener* listener) {
+    std::shared_ptr<ListenerEntry> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_listeners->begin(), m_listeners->end(),
+                               [listener](const std::shared_ptr<ListenerEntry>& e) { return e->listener == listener; });
+        if (!listener || it == m_listeners->end()) {
+            return false;
+        }
+
+        removed = *it;
+        auto updated = std::make_shared<ListenerList>(*m_listeners);
+        updated->erase(updated->begin() + (it - m_listeners->begin()));
+        m_listeners = std::move(updated);
+        if (m_listenersMetric) {
+            m_listenersMetric->Set(static_cast<int64_t>(m_listeners->size()));
+        }
+    }
+
+    // Outside the lock: waits for callbacks in progress
+    removed->Retire();
+    return true;
+}
+
+size_t FrameDispatcher::RemoveAllListeners() {
+    std::shared_ptr<const ListenerList> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        removed = m_listeners;
+        if (!removed->empty()) {
+            m_listeners = std::make_shared<const ListenerList>();
+        }
+        if (m_listenersMetric) {
+            m_listenersMetric->Set(0);
+        }
+    }
+
+    for (const std::shared_ptr<ListenerEntry>& entry : *removed) {
+        entry->Retire();
+    }
+    return removed->size();
+}
+
+size_t FrameDispatcher::GetListenerCount() const {
+    return GetListeners()->size();
+}
+
+ListenerStats FrameDispatcher::GetListenerStats(IDetectorListener* listener) const {
+    ListenerStats stats;
+    for (const std::shared_ptr<ListenerEntry>& entry : *GetListeners()) {
+        if (entry->listener == listener) {
+            stats.frames = entry->frames.load(std::memory_order_relaxed);
+            stats.overruns = entry->overruns.load(std::memory_order_relaxed);
+            stats.droppedFrames = entry->droppedFrames.load(std::memory_order_relaxed);
+            stats.maxCallbackNs = entry->maxCallbackNs.load(std::memory_order_relaxed);
+            stats.demoted = entry->demoted.load(std::memory_order_acquire);
+            break;
+        }
+    }
+    return stats;
+}
+
+void FrameDispatcher::Demote(const std::shared_ptr<ListenerEntry>& entry) {
+    {
+        std::lock_guard<std::mutex> lock(entry->queueMutex);
+        if (entry->stopping || entry->demoted.load(std::memory_order_relaxed)) {
+            return;
+        }
+        entry->queue.resize(std::max<size_t>(entry->options.asyncQueueDepth, 1));
+        entry->worker = std::thread(&ListenerEntry::WorkerLoop, entry);
+        entry->demoted.store(true, std::memory_order_release);
+    }
+
+    UXDI_TRACE_INSTANT(Dispatch, "listener.demoted", entry->overruns.load(std::memory_order_relaxed));
+    if (entry->demotionsMetric) {
+        entry->demotionsMetric->Increment();
+    }
+}
+
+LatencyStats FrameDispatcher::GetLatencyStats() const {
+    LatencyStats stats;
+    stats.sdkToAdapter = m_sdkToAdapter.Summarize();
+    stats.adapterToDispatch = m_adapterToDispatch.Summarize();
+    stats.dispatchToListener = m_dispatchToListener.Summarize();
+    stats.listenerCallback = m_listenerCallback.Summarize();
+    stats.endToEnd = m_endToEnd.Summarize();
+    return stats;
+}
+
+void FrameDispatcher::ResetLatencyStats() {
+    m_sdkToAdapter.Reset();
+    m_adapterToDispatch.Reset();
+    m_dispatchToListener.Reset();
+    m_listenerCallback.Reset();
+    m_endToEnd.Reset();
+}
+
+void FrameDispatcher::BindMetrics(MetricsRegistry& registry, const MetricLabels& labels) {
+    m_metrics = &registry;
+    m_metricLabels = labels;
+    m_framesMetric = &registry.GetCounter(
+        "uxdi_frames_delivered_total", "Frames delivered to listeners", labels);
+    m_bytesMetric = &registry.GetCounter(
+        "uxdi_frame_bytes_total", "Pixel bytes delivered to listeners", labels);
+    m_latencyMetric = &registry.GetHistogram(
+        "uxdi_frame_latency_seconds", "SDK delivery to last listener return", labels);
+    m_stateMetric = &registry.GetGauge(
+        "uxdi_detector_state", "Current DetectorState as its enum value", labels);
+    m_listenersMetric = &registry.GetGauge(
+        "uxdi_listeners", "Registered listeners", labels);
+    m_listenersMetric->Set(static_cast<int64_t>(GetListenerCount()));
+}
+
+void FrameDispatcher::CountEvent(const char* name, const char* help,
+                                 const char* labelName, const char* labelValue) {
+    // Errors and state changes are rare enough for a registry lookup
+    MetricLabels labels = m_metricLabels;
+    labels.emplace_back(labelName, labelValue);
+    m_metrics->GetCounter(name, help, labels).Increment();
+}
+
+// ============================================================================
+// IDetectorListener
+// ============================================================================
+
+void FrameDispatcher::onImageReceived(const ImageData& image) {
+    UXDI_ALLOC_SCOPE(Dispatch);
+    const FrameTimestamps& stamps = image.latency;
+    RecordInterval(m_sdkToAdapter, stamps.sdkDeliveryNs, stamps.adapterConvertedNs);
+    RecordInterval(m_adapterToDispatch, stamps.adapterConvertedNs, stamps.dispatchNs);
+
+    const std::shared_ptr<const ListenerList> listeners = GetListeners();
+    uint64_t exitNs = MonotonicNowNs();
+    for (const std::shared_ptr<ListenerEntry>& entry : *listeners) {
+        entry->frames.fetch_add(1, std::memory_order_relaxed);
+        if (entry->demoted.load(std::memory_order_acquire)) {
+            entry->Enqueue(image);
+            continue;
+        }
+
+        UXDI_TRACE_SCOPE_ARG(Dispatch, "listener.onImageReceived", image.frameNumber);
+        const uint64_t entryNs = MonotonicNowNs();
+        bool called = false;
+        {
+            UXDI_ALLOC_SCOPE(Listener);
+            called = entry->Invoke([&image](IDetectorListener* listener) { listener->onImageReceived(image); });
+        }
+        if (!called) {
+            continue;
+        }
+        exitNs = MonotonicNowNs();
+
+        RecordInterval(m_dispatchToListener, stamps.dispatchNs, entryNs);
+        m_listenerCallback.Record(exitNs - entryNs);
+        if (entry->RecordCallback(exitNs - entryNs) && entry->ShouldDemote()) {
+            Demote(entry);
+        }
+    }
+
+    RecordInterval(m_endToEnd, stamps.sdkDeliveryNs, exitNs);
+
+    if (m_framesMetric) {
+        m_framesMetric->Increment();
+        m_bytesMetric->Increment(image.dataLength);
+        RecordInterval(*m_latencyMetric, stamps.sdkDeliveryNs, exitNs);
+    }
+}
+
+void FrameDispatcher::onStateChanged(DetectorState newState) {
+    UXDI_TRACE_SCOPE_ARG(Dispatch, "listener.onStateChanged", static_cast<uint64_t>(newState));
+
+    if (m_metrics) {
+        m_stateMetric->Set(static_cast<int64_t>(newState));
+        CountEvent("uxdi_state_transitions_total", "State changes by new state", "state", StateName(newState));
+    }
+
+    for (const std::shared_ptr<ListenerEntry>& entry : *GetListeners()) {
+        entry->Invoke([newState](IDetectorListener* listener) { listener->onStateChanged(newState); });
+    }
+}
+
+void FrameDispatcher::onError(const ErrorInfo& error) {
+    UXDI_TRACE_SCOPE_ARG(Dispatch, "listener.onError", static_cast<uint64_t>(error.code));
+
+    if (m_metrics) {
+        CountEvent("uxdi_detector_errors_total", "Detector errors by ErrorCode", "code", ErrorCodeName(error.code));
+    }
+
+    for (const std::shared_ptr<ListenerEntry>& entry : *GetListeners()) {
+        entry->Invoke([&error](IDetectorListener* listener) { listener->onError(error); });
+    }
+}
+
+void FrameDispatcher::onAcquisitionStarted() {
+    for (const std::shared_ptr<ListenerEntry>& entry : *GetListeners()) {
+        entry->Invoke([](IDetectorListener* listener) { listener->onAcquisitionStarted(); });
+    }
+}
+
+void FrameDispatcher::onAcquisitionStopped() {
+    for (const std::shared_ptr<ListenerEntry>& entry : *GetListeners()) {
+        entry->Invoke([](IDetectorListener* listener) { listener->onAcquisitionStopped(); });
+    }
+}
+
+std::shared_ptr<const FrameDispatcher::ListenerList> FrameDispatcher::GetListeners() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_listeners;
+}
+
+} // namespace uxdi
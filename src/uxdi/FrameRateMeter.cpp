@@ -0,0 +1,105 @@
+#include "uxdi/FrameRateMeter.h"
+#include <algorithm>
+
+namespace uxdi {
+
+// ============================================================================
+// FrameRateMeter Implementation
+// ============================================================================
+
+FrameRateMeter::FrameRateMeter(uint64_t windowNs)
+    : m_bucketNs(std::max<uint64_t>(windowNs / kBucketCount, 1))
+{
+}
+
+void FrameRateMeter::RecordFrame(size_t bytes, uint64_t nowNs) {
+    const uint64_t index = nowNs / m_bucketNs;
+    Bucket& bucket = m_buckets[index % kBucketCount];
+    if (bucket.epoch.load(std::memory_order_acquire) != index + 1) {
+        bucket.frames.store(0, std::memory_order_relaxed);
+        bucket.bytes.store(0, std::memory_order_relaxed);
+        bucket.epoch.store(index + 1, std::memory_order_release);
+    }
+    bucket.frames.fetch_add(1, std::memory_order_relaxed);
+    bucket.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    const uint64_t previousNs = m_lastFrameNs.exchange(nowNs, std::memory_order_relaxed);
+    if (previousNs == 0) {
+        m_firstFrameNs.store(nowNs, std::memory_order_relaxed);
+    } else if (nowNs > previousNs) {
+        m_lastIntervalNs.store(nowNs - previousNs, std::memory_order_relaxed);
+    }
+}
+
+DetectorStatistics FrameRateMeter::GetStatistics(uint64_t nowNs) const {
+    DetectorStatistics stats;
+    stats.framesDelivered = m_frames.load(std::memory_order_relaxed);
+    stats.bytesDelivered = m_bytes.load(std::memory_order_relaxed);
+
+    const uint64_t firstNs = m_firstFrameNs.load(std::memory_order_relaxed);
+    const uint64_t lastNs = m_lastFrameNs.load(std::memory_order_relaxed);
+    if (lastNs != 0 && nowNs >= lastNs) {
+        stats.lastFrameAgeSec = static_cast<double>(nowNs - lastNs) / 1e9;
+
+        // A stall shows up immediately: the open interval counts once it
+        // is longer than the last completed one
+        const uint64_t intervalNs = std::max(m_lastIntervalNs.load(std::memory_order_relaxed), nowNs - lastNs);
+        if (intervalNs > 0 && stats.framesDelivered > 1) {
+            stats.instantFps = 1e9 / static_cast<double>(intervalNs);
+        }
+    }
+
+    // Sum the buckets that fall inside the trailing window
+    const uint64_t currentIndex = nowNs / m_bucketNs;
+    const uint64_t oldestIndex = currentIndex + 1 >= kBucketCount ? currentIndex + 1 - kBucketCount : 0;
+    uint64_t windowFrames = 0;
+    uint64_t windowBytes = 0;
+    for (const Bucket& bucket : m_buckets) {
+        const uint64_t epoch = bucket.epoch.load(std::memory_order_acquire);
+        if (epoch == 0 || epoch - 1 < oldestIndex || epoch - 1 > currentIndex) {
+            continue;
+        }
+        windowFrames += bucket.frames.load(std::memory_order_relaxed);
+        windowBytes += bucket.bytes.load(std::memory_order_relaxed);
+    }
+
+    // Before a full window has passed, measure from the first frame and
+    // count intervals rather than frames
+    uint64_t windowStartNs = oldestIndex * m_bucketNs;
+    if (firstNs != 0 && firstNs >= windowStartNs) {
+        windowStartNs = firstNs;
+        windowFrames = windowFrames > 0 ? windowFrames - 1 : 0;
+    }
+    if (nowNs > windowStartNs) {
+        const double windowSec = static_cast<double>(nowNs - windowStartNs) / 1e9;
+        stats.windowSec = windowSec;
+        stats.windowFps = static_cast<double>(windowFrames) / windowSec;
+        stats.windowMBps = static_cast<double>(windowBytes) / 1e6 / windowSec;
+    }
+
+    const LatencySummary callback = m_callback.Summarize();
+    stats.callbackCount = callback.count;
+    stats.callbackMeanNs = static_cast<uint64_t>(callback.meanNs);
+    stats.callbackP99Ns = callback.p99Ns;
+    stats.callbackMaxNs = callback.maxNs;
+    return stats;
+}
+
+void FrameRateMeter::Reset() {
+    for (Bucket& bucket : m_buckets) {
+        bucket.epoch.store(0, std::memory_order_relaxed);
+        bucket.frames.store(0, std::memory_order_relaxed);
+        bucket.bytes.store(0, std::memory_order_relaxed);
+    }
+    m_frames.store(0, std::memory_order_relaxed);
+    m_bytes.store(0, std::memory_order_relaxed);
+    m_firstFrameNs.store(0, std::memory_order_relaxed);
+    m_lastFrameNs.store(0, std::memory_order_relaxed);
+    m_lastIntervalNs.store(0, std::memory_order_relaxed);
+    m_callback.Reset();
+}
+
+} // namespace uxdi
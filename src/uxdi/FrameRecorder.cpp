@@ -0,0 +1,587 @@
+#include "uxdi/FrameRecorder.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/MetricsRegistry.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace uxdi {
+
+using namespace recording;
+
+namespace {
+
+// Shared by all recorders
+MetricCounter& RecordedFramesMetric() {
+    static MetricCounter& counter = MetricsRegistry::Global().GetCounter(
+        "uxdi_recorder_frames_total", "Frame records written to recordings");
+    return counter;
+}
+
+MetricCounter& RecordedBytesMetric() {
+    static MetricCounter& counter = MetricsRegistry::Global().GetCounter(
+        "uxdi_recorder_bytes_total", "Bytes written to recording containers");
+    return counter;
+}
+
+// ============================================================================
+// CRC-32 (slicing-by-8)
+// ============================================================================
+
+struct Crc32Tables {
+    uint32_t table[8][256];
+};
+
+const Crc32Tables& GetCrc32Tables() {
+    static const Crc32Tables tables = [] {
+        Crc32Tables t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+            }
+            t.table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) {
+                uint32_t prev = t.table[k - 1][i];
+                t.table[k][i] = (prev >> 8) ^ t.table[0][prev & 0xFF];
+            }
+        }
+        return t;
+    }();
+    return tables;
+}
+
+// ============================================================================
+// File helpers
+// ============================================================================
+
+// Flush stdio buffers and force data to stable storage
+bool SyncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+JournalRecord MakeIndexRecord(const FrameRecordHeader& header, uint64_t offset) {
+    JournalRecord record{};
+    record.type = kRecordIndex;
+    record.flags = header.flags;
+    record.frameNumber = header.frameNumber;
+    record.timestamp = header.timestamp;
+    record.offset = offset;
+    record.length = header.dataLength;
+    record.crc = ComputeCrc32(&record, offsetof(JournalRecord, crc));
+    return record;
+}
+
+JournalRecord MakeCheckpointRecord(uint64_t indexCount, uint64_t dataEnd) {
+    JournalRecord record{};
+    record.type = kRecordCheckpoint;
+    record.frameNumber = indexCount;
+    record.offset = dataEnd;
+    record.crc = ComputeCrc32(&record, offsetof(JournalRecord, crc));
+    return record;
+}
+
+} // anonymous namespace
+
+uint32_t recording::ComputeCrc32(const void* data, size_t length, uint32_t seed) {
+    const auto& t = GetCrc32Tables().table;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = ~seed;
+
+    while (length >= 8) {
+        uint32_t lo = 0;
+        uint32_t hi = 0;
+        std::memcpy(&lo, bytes, 4);
+        std::memcpy(&hi, bytes + 4, 4);
+        lo ^= crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^
+              t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^
+              t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        bytes += 8;
+        length -= 8;
+    }
+
+    while (length--) {
+        crc = t[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+bool recording::IsValidJournalRecord(const JournalRecord& record) {
+    return record.crc == ComputeCrc32(&record, offsetof(JournalRecord, crc)) &&
+           (record.type == kRecordIndex || record.type == kRecordCheckpoint);
+}
+
+bool recording::IsValidFrameHeader(const FrameRecordHeader& header) {
+    return header.magic == kFrameMagic &&
+           header.headerCrc == ComputeCrc32(&header, offsetof(FrameRecordHeader, headerCrc));
+}
+
+// ============================================================================
+// FrameRecorder Implementation
+// ============================================================================
+
+FrameRecorder::FrameRecorder(const RecorderOptions& options)
+    : m_options(options)
+    , m_dedup(options.dedup)
+{
+    m_lastError.code = ErrorCode::SUCCESS;
+    m_lastError.message = "No error";
+}
+
+FrameRecorder::~FrameRecorder() {
+    Close();
+}
+
+bool FrameRecorder::Open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_container) {
+        SetError(ErrorCode::STATE_ERROR, "Recording is already open");
+        return false;
+    }
+
+    const std::string journalPath = path + kJournalSuffix;
+    m_container = std::fopen(path.c_str(), "wb");
+    m_journal = std::fopen(journalPath.c_str(), "wb");
+    if (!m_container || !m_journal) {
+        CloseLocked();
+        SetError(ErrorCode::HARDWARE_ERROR, "Failed to create recording: " + path);
+        return false;
+    }
+
+    if (m_options.writeBufferBytes > 0) {
+        std::setvbuf(m_container, nullptr, _IOFBF, m_options.writeBufferBytes);
+    }
+
+    ContainerHeader containerHeader{};
+    containerHeader.magic = kContainerMagic;
+    containerHeader.version = kFormatVersion;
+    containerHeader.createdAtNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    JournalHeader journalHeader{};
+    journalHeader.magic = kJournalMagic;
+    journalHeader.version = kFormatVersion;
+    journalHeader.recordSize = sizeof(JournalRecord);
+
+    if (std::fwrite(&containerHeader, sizeof(containerHeader), 1, m_container) != 1 ||
+        std::fwrite(&journalHeader, sizeof(journalHeader), 1, m_journal) != 1) {
+        CloseLocked();
+        SetError(ErrorCode::HARDWARE_ERROR, "Failed to write recording headers: " + path);
+        return false;
+    }
+
+    m_path = path;
+    m_dataOffset = sizeof(ContainerHeader);
+    m_frameCount = 0;
+    m_checkpointedFrames = 0;
+    m_framesSinceCheckpoint = 0;
+    m_staticFrames = 0;
+    m_failed = false;
+    m_dedup.Reset();
+    m_lastCheckpoint = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool FrameRecorder::WriteFrame(const ImageData& image) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_container && !m_failed && m_options.deduplicate) {
+        const DedupResult dedup = m_dedup.Classify(image);
+        if (dedup.isStatic) {
+            m_staticFrames++;
+            if (m_options.skipStaticFrames) {
+                return true;
+            }
+            return WriteRecord(image, kFrameFlagReference, dedup.referenceFrame);
+        }
+
+        // Later static frames may only refer to a key frame that was written
+        if (!WriteRecord(image, kFrameFlagNone, 0)) {
+            return false;
+        }
+        m_dedup.AdoptKeyFrame(image, dedup);
+        return true;
+    }
+
+    return WriteRecord(image, kFrameFlagNone, 0);
+}
+
+bool FrameRecorder::WriteReference(const ImageData& image, uint64_t referenceFrame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return WriteRecord(image, kFrameFlagReference, referenceFrame);
+}
+
+bool FrameRecorder::Checkpoint() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!CheckWritableLocked()) {
+        return false;
+    }
+    return WriteCheckpointLocked();
+}
+
+bool FrameRecorder::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_container) {
+        return true;
+    }
+
+    // A checkpoint would cover bytes that never made it to disk
+    if (m_failed) {
+        CloseLocked();
+        return false;
+    }
+
+    bool ok = WriteCheckpointLocked();
+    return CloseLocked() && ok;
+}
+
+bool FrameRecorder::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_container != nullptr;
+}
+
+uint64_t FrameRecorder::GetFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frameCount;
+}
+
+uint64_t FrameRecorder::GetCheckpointedFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_checkpointedFrames;
+}
+
+uint64_t FrameRecorder::GetStaticFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_staticFrames;
+}
+
+ErrorInfo FrameRecorder::GetLastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+// ============================================================================
+// IDetectorListener Implementation
+// ============================================================================
+
+void FrameRecorder::onImageReceived(const ImageData& image) {
+    WriteFrame(image);
+}
+
+void FrameRecorder::onStateChanged(DetectorState) {
+}
+
+void FrameRecorder::onError(const ErrorInfo&) {
+}
+
+void FrameRecorder::onAcquisitionStarted() {
+}
+
+void FrameRecorder::onAcquisitionStopped() {
+    // Make everything recorded so far durable at the end of a sweep
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_container && !m_failed && m_framesSinceCheckpoint > 0) {
+        WriteCheckpointLocked();
+    }
+}
+
+// ============================================================================
+// Recovery
+// ============================================================================
+
+bool FrameRecorder::Recover(const std::string& path, RecoveryReport* report) {
+    namespace fs = std::filesystem;
+
+    RecoveryReport result;
+    std::error_code ec;
+    const uint64_t containerSize = fs::file_size(path, ec);
+    if (ec || containerSize < sizeof(ContainerHeader)) {
+        return false;
+    }
+
+    std::ifstream container(path, std::ios::binary);
+    ContainerHeader containerHeader{};
+    if (!container.read(reinterpret_cast<char*>(&containerHeader), sizeof(containerHeader)) ||
+        containerHeader.magic != kContainerMagic ||
+        containerHeader.version != kFormatVersion) {
+        return false;
+    }
+
+    // Walk the journal to its last valid checkpoint
+    const std::string journalPath = path + kJournalSuffix;
+    uint64_t scanStart = sizeof(ContainerHeader);
+    uint64_t journalKeep = 0;      // Journal bytes that remain valid
+    uint64_t journalSize = 0;
+    {
+        std::ifstream journal(journalPath, std::ios::binary);
+        JournalHeader journalHeader{};
+        if (journal.read(reinterpret_cast<char*>(&journalHeader), sizeof(journalHeader)) &&
+            journalHeader.magic == kJournalMagic &&
+            journalHeader.version == kFormatVersion &&
+            journalHeader.recordSize == sizeof(JournalRecord)) {
+            result.journalFound = true;
+            journalKeep = sizeof(JournalHeader);
+            journalSize = fs::file_size(journalPath, ec);
+
+            uint64_t indexCount = 0;
+            uint64_t position = sizeof(JournalHeader);
+            JournalRecord record{};
+            while (journal.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+                position += sizeof(record);
+                if (!IsValidJournalRecord(record)) {
+                    break;
+                }
+                if (record.type == kRecordIndex) {
+                    indexCount++;
+                    continue;
+                }
+                // Checkpoint must agree with what precedes it and with the container
+                if (record.frameNumber != indexCount || record.offset > containerSize ||
+                    record.offset < sizeof(ContainerHeader)) {
+                    break;
+                }
+                result.framesFromJournal = indexCount;
+                scanStart = record.offset;
+                journalKeep = position;
+            }
+        }
+    }
+
+    // Scan the container tail for intact frame records
+    std::vector<JournalRecord> rebuilt;
+    std::vector<uint8_t> chunk(1024 * 1024);
+    uint64_t position = scanStart;
+    container.clear();
+    container.seekg(static_cast<std::streamoff>(position));
+
+    while (position + sizeof(FrameRecordHeader) <= containerSize) {
+        FrameRecordHeader header{};
+        if (!container.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            !IsValidFrameHeader(header)) {
+            break;
+        }
+
+        const uint64_t recordEnd = position + sizeof(header) + header.dataLength;
+        if (recordEnd > containerSize) {
+            break;  // Torn payload
+        }
+
+        if (header.flags & kFrameFlagPayloadCrc) {
+            uint32_t crc = 0;
+            uint64_t remaining = header.dataLength;
+            bool readOk = true;
+            while (remaining > 0) {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(remaining, chunk.size()));
+                if (!container.read(reinterpret_cast<char*>(chunk.data()), count)) {
+                    readOk = false;
+                    break;
+                }
+                crc = ComputeCrc32(chunk.data(), count, crc);
+                remaining -= count;
+            }
+            if (!readOk || crc != header.payloadCrc) {
+                break;
+            }
+        } else {
+            container.seekg(static_cast<std::streamoff>(recordEnd));
+        }
+
+        rebuilt.push_back(MakeIndexRecord(header, position));
+        result.bytesScanned += recordEnd - position;
+        position = recordEnd;
+    }
+    container.close();
+
+    result.framesRescanned = rebuilt.size();
+    result.framesRecovered = result.framesFromJournal + result.framesRescanned;
+    result.bytesTruncated = containerSize - position;
+
+    // Nothing torn and journal already ends at a checkpoint: recording is intact
+    const bool intact = rebuilt.empty() && result.bytesTruncated == 0 &&
+                        journalKeep > 0 && journalKeep == journalSize;
+
+    if (!intact) {
+        if (result.bytesTruncated > 0) {
+            fs::resize_file(path, position, ec);
+            if (ec) {
+                return false;
+            }
+        }
+
+        std::FILE* journal = nullptr;
+        if (journalKeep > 0) {
+            fs::resize_file(journalPath, journalKeep, ec);
+            if (ec) {
+                return false;
+            }
+            journal = std::fopen(journalPath.c_str(), "ab");
+        } else {
+            journal = std::fopen(journalPath.c_str(), "wb");
+            if (journal) {
+                JournalHeader journalHeader{};
+                journalHeader.magic = kJournalMagic;
+                journalHeader.version = kFormatVersion;
+                journalHeader.recordSize = sizeof(JournalRecord);
+                std::fwrite(&journalHeader, sizeof(journalHeader), 1, journal);
+            }
+        }
+        if (!journal) {
+            return false;
+        }
+
+        bool ok = true;
+        if (!rebuilt.empty()) {
+            ok = std::fwrite(rebuilt.data(), sizeof(JournalRecord), rebuilt.size(), journal) == rebuilt.size();
+        }
+        const JournalRecord checkpoint = MakeCheckpointRecord(result.framesRecovered, position);
+        ok = ok && std::fwrite(&checkpoint, sizeof(checkpoint), 1, journal) == 1;
+        ok = SyncFile(journal) && ok;
+        ok = (std::fclose(journal) == 0) && ok;
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (report) {
+        *report = result;
+    }
+    return true;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool FrameRecorder::WriteRecord(const ImageData& image, uint32_t flags, uint64_t referenceFrame) {
+    UXDI_ALLOC_SCOPE(Recording);
+    if (!CheckWritableLocked()) {
+        return false;
+    }
+
+    const bool isReference = (flags & kFrameFlagReference) != 0;
+    const uint8_t* payload = isReference ? nullptr : image.data.get();
+    const uint64_t payloadLength = (payload != nullptr) ? image.dataLength : 0;
+
+    FrameRecordHeader header{};
+    header.magic = kFrameMagic;
+    header.flags = flags;
+    header.frameNumber = image.frameNumber;
+    header.timestamp = image.timestamp;
+    header.width = image.width;
+    header.height = image.height;
+    header.bitDepth = image.bitDepth;
+    header.dataLength = payloadLength;
+    header.referenceFrame = referenceFrame;
+    if (m_options.payloadChecksums && payloadLength > 0) {
+        header.flags |= kFrameFlagPayloadCrc;
+        header.payloadCrc = ComputeCrc32(payload, static_cast<size_t>(payloadLength));
+    }
+    header.headerCrc = ComputeCrc32(&header, offsetof(FrameRecordHeader, headerCrc));
+
+    const JournalRecord record = MakeIndexRecord(header, m_dataOffset);
+
+    if (std::fwrite(&header, sizeof(header), 1, m_container) != 1 ||
+        (payloadLength > 0 &&
+         std::fwrite(payload, 1, static_cast<size_t>(payloadLength), m_container) != payloadLength) ||
+        std::fwrite(&record, sizeof(record), 1, m_journal) != 1) {
+        FailLocked("Failed to write frame to recording");
+        return false;
+    }
+
+    m_dataOffset += sizeof(header) + payloadLength;
+    m_frameCount++;
+    RecordedFramesMetric().Increment();
+    RecordedBytesMetric().Increment(sizeof(header) + payloadLength);
+    m_framesSinceCheckpoint++;
+
+    bool due = m_options.checkpointIntervalFrames > 0 &&
+               m_framesSinceCheckpoint >= m_options.checkpointIntervalFrames;
+    if (!due && m_options.checkpointIntervalMs > 0) {
+        due = std::chrono::steady_clock::now() - m_lastCheckpoint >=
+              std::chrono::milliseconds(m_options.checkpointIntervalMs);
+    }
+
+    return due ? WriteCheckpointLocked() : true;
+}
+
+bool FrameRecorder::WriteCheckpointLocked() {
+    // Container data must be durable before the checkpoint that covers it
+    if (!SyncFile(m_container)) {
+        FailLocked("Failed to sync recording container");
+        return false;
+    }
+
+    const JournalRecord checkpoint = MakeCheckpointRecord(m_frameCount, m_dataOffset);
+    if (std::fwrite(&checkpoint, sizeof(checkpoint), 1, m_journal) != 1 || !SyncFile(m_journal)) {
+        FailLocked("Failed to write recording checkpoint");
+        return false;
+    }
+
+    m_checkpointedFrames = m_frameCount;
+    m_framesSinceCheckpoint = 0;
+    m_lastCheckpoint = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool FrameRecorder::CloseLocked() {
+    bool ok = true;
+    if (m_container) {
+        ok = (std::fclose(m_container) == 0) && ok;
+        m_container = nullptr;
+    }
+    if (m_journal) {
+        ok = (std::fclose(m_journal) == 0) && ok;
+        m_journal = nullptr;
+    }
+    return ok;
+}
+
+bool FrameRecorder::CheckWritableLocked() {
+    if (!m_container) {
+        SetError(ErrorCode::STATE_ERROR, "Recording is not open");
+        return false;
+    }
+    if (m_failed) {
+        SetError(ErrorCode::STATE_ERROR, "Recording stopped after a write error: " + m_path);
+        return false;
+    }
+    return true;
+}
+
+void FrameRecorder::SetError(ErrorCode code, const std::string& message) {
+    m_lastError.code = code;
+    m_lastError.message = message;
+    m_lastError.details.clear();
+}
+
+void FrameRecorder::FailLocked(const std::string& message) {
+    // Part of the record may already be on disk; index records written from
+    // here on would point past it
+    m_failed = true;
+    SetError(ErrorCode::HARDWARE_ERROR, message);
+}
+
+} // namespace uxdi
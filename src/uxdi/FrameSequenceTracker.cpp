@@ -0,0 +1,95 @@
+#include "uxdi/FrameSequenceTracker.h"
+#include <cmath>
+
+namespace uxdi {
+
+// ============================================================================
+// FrameSequenceTracker Implementation
+// ============================================================================
+
+void FrameSequenceTracker::Record(uint64_t frameNumber, uint64_t arrivalNs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stats.received++;
+
+    if (m_started) {
+        const uint64_t intervalNs = arrivalNs > m_lastArrivalNs ? arrivalNs - m_lastArrivalNs : 0;
+        m_intervals.Record(intervalNs);
+
+        m_intervalCount++;
+        const double delta = static_cast<double>(intervalNs) - m_intervalMean;
+        m_intervalMean += delta / static_cast<double>(m_intervalCount);
+        m_intervalM2 += delta * (static_cast<double>(intervalNs) - m_intervalMean);
+    }
+    m_lastArrivalNs = arrivalNs;
+
+    const size_t slot = frameNumber % kReorderWindow;
+
+    if (!m_started) {
+        m_started = true;
+        m_stats.firstFrameNumber = frameNumber;
+        m_stats.highestFrameNumber = frameNumber;
+        m_seen.set(slot);
+        return;
+    }
+
+    const uint64_t highest = m_stats.highestFrameNumber;
+
+    if (frameNumber > highest) {
+        const uint64_t gap = frameNumber - highest - 1;
+        m_stats.dropped += gap;
+
+        // Slots between the old and new highest now belong to unseen frames
+        if (gap + 1 >= kReorderWindow) {
+            m_seen.reset();
+        } else {
+            for (uint64_t n = highest + 1; n < frameNumber; ++n) {
+                m_seen.reset(n % kReorderWindow);
+            }
+        }
+        m_seen.set(slot);
+        m_stats.highestFrameNumber = frameNumber;
+        return;
+    }
+
+    if (highest - frameNumber >= kReorderWindow || frameNumber < m_stats.firstFrameNumber) {
+        m_stats.outOfOrder++;
+        return;
+    }
+
+    if (m_seen.test(slot)) {
+        m_stats.duplicated++;
+        return;
+    }
+
+    // Late arrival of a frame previously counted as dropped
+    m_seen.set(slot);
+    m_stats.outOfOrder++;
+    m_stats.dropped--;
+}
+
+FrameSequenceStats FrameSequenceTracker::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FrameSequenceStats stats = m_stats;
+    stats.interval = m_intervals.Summarize();
+    if (m_intervalCount > 1) {
+        stats.intervalStdDevNs = std::sqrt(m_intervalM2 / static_cast<double>(m_intervalCount - 1));
+    }
+    return stats;
+}
+
+void FrameSequenceTracker::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_started = false;
+    m_stats = FrameSequenceStats{};
+    m_seen.reset();
+    m_lastArrivalNs = 0;
+    m_intervalCount = 0;
+    m_intervalMean = 0.0;
+    m_intervalM2 = 0.0;
+    m_intervals.Reset();
+}
+
+} // namespace uxdi
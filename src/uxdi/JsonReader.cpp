@@ -0,0 +1,525 @@
+#include "uxdi/JsonReader.h"
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace uxdi {
+
+// ============================================================================
+// JsonParser
+// ============================================================================
+
+/**
+ * @brief Recursive-descent pass that fills a JsonDocument's node vector
+ */
+class JsonParser {
+public:
+    JsonParser(std::string_view text, std::vector<JsonDocument::Node>& nodes, JsonError& error)
+        : m_text(text)
+        , m_nodes(nodes)
+        , m_error(error)
+    {
+    }
+
+    bool Parse() {
+        SkipWhitespace();
+        if (!ParseValue(0, 0, 0, false)) {
+            return false;
+        }
+        SkipWhitespace();
+        if (m_pos != m_text.size()) {
+            return Fail("unexpected text after the document");
+        }
+        return true;
+    }
+
+private:
+    using Node = JsonDocument::Node;
+
+    bool Fail(const char* message) {
+        m_error.offset = m_pos;
+        m_error.message = message;
+        return false;
+    }
+
+    void SkipWhitespace() {
+        while (m_pos < m_text.size()) {
+            const char c = m_text[m_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            ++m_pos;
+        }
+    }
+
+    bool Consume(char expected) {
+        if (m_pos < m_text.size() && m_text[m_pos] == expected) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConsumeLiteral(std::string_view literal) {
+        if (m_text.substr(m_pos, literal.size()) != literal) {
+            return Fail("invalid literal");
+        }
+        m_pos += literal.size();
+        return true;
+    }
+
+    // Scans a string starting at the opening quote; leaves m_pos after the
+    // closing quote and reports the body span
+    bool ScanString(uint32_t& begin, uint32_t& length, bool& escaped) {
+        ++m_pos;  // Opening quote
+        begin = static_cast<uint32_t>(m_pos);
+        escaped = false;
+        while (m_pos < m_text.size()) {
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') {
+                length = static_cast<uint32_t>(m_pos - begin);
+                ++m_pos;
+                return true;
+            }
+            if (c < 0x20) {
+                return Fail("control character in string");
+            }
+            if (c == '\\') {
+                escaped = true;
+                ++m_pos;
+                if (m_pos >= m_text.size()) {
+                    break;
+                }
+                switch (m_text[m_pos]) {
+                    case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                        break;
+                    case 'u':
+                        for (int i = 1; i <= 4; ++i) {
+                            if (m_pos + i >= m_text.size() ||
+                                !std::isxdigit(static_cast<unsigned char>(m_text[m_pos + i]))) {
+                                m_pos += i;
+                                return Fail("invalid \\u escape");
+                            }
+                        }
+                        m_pos += 4;
+                        break;
+                    default:
+                        return Fail("invalid escape");
+                }
+            }
+            ++m_pos;
+        }
+        return Fail("unterminated string");
+    }
+
+    bool ScanDigits() {
+        const size_t start = m_pos;
+        while (m_pos < m_text.size() && m_text[m_pos] >= '0' && m_text[m_pos] <= '9') {
+            ++m_pos;
+        }
+        return m_pos > start;
+    }
+
+    bool ScanNumber() {
+        Consume('-');
+        if (Consume('0')) {
+            // No leading zeros
+        } else if (!ScanDigits()) {
+            return Fail("invalid number");
+        }
+        if (Consume('.') && !ScanDigits()) {
+            return Fail("expected digits after '.'");
+        }
+        if (Consume('e') || Consume('E')) {
+            if (!Consume('+')) {
+                Consume('-');
+            }
+            if (!ScanDigits()) {
+                return Fail("expected exponent digits");
+            }
+        }
+        return true;
+    }
+
+    bool ParseValue(size_t depth, uint32_t keyBegin, uint32_t keyLength, bool keyEscaped) {
+        if (m_pos >= m_text.size()) {
+            return Fail("unexpected end of input");
+        }
+
+        const auto index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+        m_nodes[index].begin = static_cast<uint32_t>(m_pos);
+        m_nodes[index].keyBegin = keyBegin;
+        m_nodes[index].keyLength = keyLength;
+        m_nodes[index].keyEscaped = keyEscaped;
+
+        JsonType type = JsonType::Null;
+        uint32_t count = 0;
+        switch (m_text[m_pos]) {
+            case '{':
+                type = JsonType::Object;
+                if (!ParseObject(depth + 1, count)) {
+                    return false;
+                }
+                break;
+            case '[':
+                type = JsonType::Array;
+                if (!ParseArray(depth + 1, count)) {
+                    return false;
+                }
+                break;
+            case '"': {
+                type = JsonType::String;
+                uint32_t begin = 0;
+                uint32_t length = 0;
+                bool escaped = false;
+                if (!ScanString(begin, length, escaped)) {
+                    return false;
+                }
+                m_nodes[index].begin = begin;
+                m_nodes[index].length = length;
+                m_nodes[index].escaped = escaped;
+                break;
+            }
+            case 't':
+                type = JsonType::Bool;
+                if (!ConsumeLiteral("true")) {
+                    return false;
+                }
+                break;
+            case 'f':
+                type = JsonType::Bool;
+                if (!ConsumeLiteral("false")) {
+                    return false;
+                }
+                break;
+            case 'n':
+                if (!ConsumeLiteral("null")) {
+                    return false;
+                }
+                break;
+            default:
+                if (m_text[m_pos] != '-' && (m_text[m_pos] < '0' || m_text[m_pos] > '9')) {
+                    return Fail("expected a value");
+                }
+                type = JsonType::Number;
+                if (!ScanNumber()) {
+                    return false;
+                }
+                break;
+        }
+
+        // Children may have grown the vector; index, not a reference
+        Node& node = m_nodes[index];
+        node.type = type;
+        node.count = count;
+        node.end = static_cast<uint32_t>(m_nodes.size());
+        if (type != JsonType::String) {
+            node.length = static_cast<uint32_t>(m_pos - node.begin);
+        }
+        return true;
+    }
+
+    bool ParseObject(size_t depth, uint32_t& count) {
+        if (depth > JsonDocument::kMaxDepth) {
+            return Fail("nesting too deep");
+        }
+        ++m_pos;  // '{'
+        SkipWhitespace();
+        if (Consume('}')) {
+            return true;
+        }
+        for (;;) {
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+                return Fail("expected a member name");
+            }
+            uint32_t keyBegin = 0;
+            uint32_t keyLength = 0;
+            bool keyEscaped = false;
+            if (!ScanString(keyBegin, keyLength, keyEscaped)) {
+                return false;
+            }
+            SkipWhitespace();
+            if (!Consume(':')) {
+                return Fail("expected ':'");
+            }
+            SkipWhitespace();
+            if (!ParseValue(depth, keyBegin, keyLength, keyEscaped)) {
+                return false;
+            }
+            ++count;
+            SkipWhitespace();
+            if (Consume('}')) {
+                return true;
+            }
+            if (!Consume(',')) {
+                return Fail("expected ',' or '}'");
+            }
+            SkipWhitespace();
+        }
+    }
+
+    bool ParseArray(size_t depth, uint32_t& count) {
+        if (depth > JsonDocument::kMaxDepth) {
+            return Fail("nesting too deep");
+        }
+        ++m_pos;  // '['
+        SkipWhitespace();
+        if (Consume(']')) {
+            return true;
+        }
+        for (;;) {
+            if (!ParseValue(depth, 0, 0, false)) {
+                return false;
+            }
+            ++count;
+            SkipWhitespace();
+            if (Consume(']')) {
+                return true;
+            }
+            if (!Consume(',')) {
+                return Fail("expected ',' or ']'");
+            }
+            SkipWhitespace();
+        }
+    }
+
+    std::string_view m_text;
+    std::vector<JsonDocument::Node>& m_nodes;
+    JsonError& m_error;
+    size_t m_pos = 0;
+};
+
+// ============================================================================
+// JsonError Implementation
+// ============================================================================
+
+std::string JsonError::Format() const {
+    char prefix[64];
+    std::snprintf(prefix, sizeof(prefix), "line %zu, column %zu: ", line, column);
+    return prefix + message;
+}
+
+// ============================================================================
+// JsonDocument Implementation
+// ============================================================================
+
+bool JsonDocument::Parse(std::string_view text) {
+    m_text = text;
+    m_nodes.clear();
+    m_error = JsonError{};
+
+    if (text.size() >= std::numeric_limits<uint32_t>::max()) {
+        m_error.message = "document too large";
+        return false;
+    }
+
+    // Scenario-style documents hold about one value per 16 bytes
+    m_nodes.reserve(text.size() / 16 + 1);
+    JsonParser parser(text, m_nodes, m_error);
+    if (parser.Parse()) {
+        return true;
+    }
+
+    m_nodes.clear();
+    m_error.line = 1;
+    m_error.column = 1;
+    for (size_t i = 0; i < m_error.offset && i < text.size(); ++i) {
+        if (text[i] == '\n') {
+            ++m_error.line;
+            m_error.column = 1;
+        } else {
+            ++m_error.column;
+        }
+    }
+    return false;
+}
+
+JsonValue JsonDocument::Root() const {
+    return m_nodes.empty() ? JsonValue() : JsonValue(this, 0);
+}
+
+// ============================================================================
+// JsonValue Implementation
+// ============================================================================
+
+JsonType JsonValue::GetType() const {
+    return m_document ? m_document->m_nodes[m_index].type : JsonType::Null;
+}
+
+std::optional<std::string> JsonValue::AsString() const {
+    if (GetType() != JsonType::String) {
+        return std::nullopt;
+    }
+    const JsonDocument::Node& node = m_document->m_nodes[m_index];
+    const std::string_view body = m_document->m_text.substr(node.begin, node.length);
+    return node.escaped ? UnescapeJsonString(body) : std::string(body);
+}
+
+std::optional<double> JsonValue::AsDouble() const {
+    if (GetType() != JsonType::Number) {
+        return std::nullopt;
+    }
+    const std::string_view raw = Raw();
+    double value = 0.0;
+    const auto result = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+    if (result.ec == std::errc::result_out_of_range) {
+        return raw.front() == '-' ? -HUGE_VAL : HUGE_VAL;
+    }
+    return value;
+}
+
+std::optional<int64_t> JsonValue::AsInt() const {
+    if (GetType() != JsonType::Number) {
+        return std::nullopt;
+    }
+    const std::string_view raw = Raw();
+    int64_t value = 0;
+    const auto result = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+    if (result.ec == std::errc() && result.ptr == raw.data() + raw.size()) {
+        return value;
+    }
+
+    // Fractions and exponents are fine as long as the value is integral
+    const std::optional<double> real = AsDouble();
+    if (real && std::trunc(*real) == *real && *real >= -9.2233720368547758e18 && *real < 9.2233720368547758e18) {
+        return static_cast<int64_t>(*real);
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> JsonValue::AsBool() const {
+    if (GetType() != JsonType::Bool) {
+        return std::nullopt;
+    }
+    return Raw() == "true";
+}
+
+std::string_view JsonValue::Raw() const {
+    if (!m_document) {
+        return {};
+    }
+    const JsonDocument::Node& node = m_document->m_nodes[m_index];
+    return m_document->m_text.substr(node.begin, node.length);
+}
+
+std::string_view JsonValue::Key() const {
+    if (!m_document) {
+        return {};
+    }
+    const JsonDocument::Node& node = m_document->m_nodes[m_index];
+    return m_document->m_text.substr(node.keyBegin, node.keyLength);
+}
+
+size_t JsonValue::Size() const {
+    const JsonType type = GetType();
+    if (type != JsonType::Array && type != JsonType::Object) {
+        return 0;
+    }
+    return m_document->m_nodes[m_index].count;
+}
+
+JsonValue JsonValue::Find(std::string_view key) const {
+    if (GetType() != JsonType::Object) {
+        return {};
+    }
+    for (const JsonValue member : *this) {
+        const JsonDocument::Node& node = m_document->m_nodes[member.m_index];
+        const std::string_view raw = member.Key();
+        if (node.keyEscaped ? UnescapeJsonString(raw) == key : raw == key) {
+            return member;
+        }
+    }
+    return {};
+}
+
+JsonValue::Iterator JsonValue::begin() const {
+    return Iterator(m_document, m_index + 1, Size());
+}
+
+JsonValue::Iterator JsonValue::end() const {
+    return Iterator(m_document, 0, 0);
+}
+
+JsonValue::Iterator& JsonValue::Iterator::operator++() {
+    m_index = m_document->m_nodes[m_index].end;
+    --m_remaining;
+    return *this;
+}
+
+// ============================================================================
+// String decoding
+// ============================================================================
+
+namespace {
+
+uint32_t ParseHex4(std::string_view digits) {
+    uint32_t value = 0;
+    std::from_chars(digits.data(), digits.data() + 4, value, 16);
+    return value;
+}
+
+void AppendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+} // anonymous namespace
+
+std::string UnescapeJsonString(std::string_view body) {
+    std::string result;
+    result.reserve(body.size());
+
+    for (size_t i = 0; i < body.size(); ++i) {
+        if (body[i] != '\\' || i + 1 >= body.size()) {
+            result += body[i];
+            continue;
+        }
+        const char escape = body[++i];
+        switch (escape) {
+            case 'b': result += '\b'; break;
+            case 'f': result += '\f'; break;
+            case 'n': result += '\n'; break;
+            case 'r': result += '\r'; break;
+            case 't': result += '\t'; break;
+            case 'u': {
+                if (i + 4 >= body.size()) {
+                    return result;
+                }
+                uint32_t codePoint = ParseHex4(body.substr(i + 1, 4));
+                i += 4;
+                // A high surrogate followed by \uDC00-\uDFFF is one code point
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 6 < body.size() &&
+                    body[i + 1] == '\\' && body[i + 2] == 'u') {
+                    const uint32_t low = ParseHex4(body.substr(i + 3, 4));
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                AppendUtf8(result, codePoint);
+                break;
+            }
+            default: result += escape; break;  // '"', '\\' and '/'
+        }
+    }
+
+    return result;
+}
+
+} // namespace uxdi
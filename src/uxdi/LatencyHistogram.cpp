@@ -0,0 +1,142 @@
+#include "uxdi/LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace uxdi {
+
+namespace {
+
+uint64_t TargetRank(double percentile, uint64_t total) {
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total)));
+    return std::clamp<uint64_t>(rank, 1, total);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// LatencyHistogram Implementation
+// ============================================================================
+
+void LatencyHistogram::Record(uint64_t valueNs) {
+    m_buckets[BucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(valueNs, std::memory_order_relaxed);
+
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (valueNs < current &&
+           !m_min.compare_exchange_weak(current, valueNs, std::memory_order_relaxed)) {
+    }
+    current = m_max.load(std::memory_order_relaxed);
+    while (valueNs > current &&
+           !m_max.compare_exchange_weak(current, valueNs, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::GetCount() const {
+    return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetMin() const {
+    const uint64_t value = m_min.load(std::memory_order_relaxed);
+    return value == UINT64_MAX ? 0 : value;
+}
+
+uint64_t LatencyHistogram::GetMax() const {
+    return m_max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::GetMean() const {
+    const uint64_t count = GetCount();
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(count);
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const {
+    std::array<uint64_t, kBucketCount> snapshot;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const uint64_t target = TargetRank(percentile, total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += snapshot[i];
+        if (seen >= target) {
+            return std::min(BucketUpperBound(i), GetMax());
+        }
+    }
+    return GetMax();
+}
+
+LatencySummary LatencyHistogram::Summarize() const {
+    LatencySummary summary;
+    std::array<uint64_t, kBucketCount> snapshot;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return summary;
+    }
+
+    summary.count = total;
+    summary.minNs = GetMin();
+    summary.maxNs = GetMax();
+    summary.meanNs = GetMean();
+
+    const uint64_t targets[3] = {TargetRank(50.0, total), TargetRank(99.0, total), TargetRank(99.9, total)};
+    uint64_t* outputs[3] = {&summary.p50Ns, &summary.p99Ns, &summary.p999Ns};
+    size_t next = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount && next < 3; ++i) {
+        seen += snapshot[i];
+        while (next < 3 && seen >= targets[next]) {
+            *outputs[next++] = std::min(BucketUpperBound(i), summary.maxNs);
+        }
+    }
+    return summary;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(UINT64_MAX, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t valueNs) {
+    valueNs = std::min(valueNs, kMaxTrackableNs);
+    if (valueNs < kSubBucketCount) {
+        return static_cast<size_t>(valueNs);
+    }
+    // Keep the top kSubBucketBits significant bits
+    const uint32_t msb = static_cast<uint32_t>(std::bit_width(valueNs)) - 1;
+    const uint32_t shift = msb - (kSubBucketBits - 1);
+    const uint64_t sub = valueNs >> shift;
+    return kSubBucketCount + (msb - kSubBucketBits) * kSubBucketHalf + static_cast<size_t>(sub - kSubBucketHalf);
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    const size_t group = (index - kSubBucketCount) / kSubBucketHalf;
+    const uint64_t sub = (index - kSubBucketCount) % kSubBucketHalf + kSubBucketHalf;
+    const uint32_t shift = static_cast<uint32_t>(group) + 1;
+    return ((sub + 1) << shift) - 1;
+}
+
+} // namespace uxdi
@@ -0,0 +1,240 @@
+#include "uxdi/MetricsRegistry.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace uxdi {
+
+namespace {
+
+bool IsValidName(const std::string& name, bool allowColon) {
+    if (name.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        const bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+                           (allowColon && c == ':');
+        const bool digit = c >= '0' && c <= '9';
+        if (!alpha && !(digit && i > 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string EscapeLabelValue(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '"':  escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default:   escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+// Renders `name="value",...` without braces; also serves as the series key
+std::string RenderLabels(const MetricLabels& labels) {
+    std::string text;
+    for (const auto& [name, value] : labels) {
+        if (!text.empty()) {
+            text += ',';
+        }
+        text += name + "=\"" + EscapeLabelValue(value) + "\"";
+    }
+    return text;
+}
+
+std::string WithBraces(const std::string& labels, const std::string& extra = "") {
+    if (labels.empty() && extra.empty()) {
+        return "";
+    }
+    if (labels.empty()) {
+        return "{" + extra + "}";
+    }
+    if (extra.empty()) {
+        return "{" + labels + "}";
+    }
+    return "{" + labels + "," + extra + "}";
+}
+
+std::string FormatValue(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+const char* TypeName(MetricType type) {
+    switch (type) {
+        case MetricType::Counter: return "counter";
+        case MetricType::Gauge:   return "gauge";
+        case MetricType::Summary: return "summary";
+    }
+    return "untyped";
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// MetricCounter Implementation
+// ============================================================================
+
+uint64_t MetricCounter::GetValue() const {
+    uint64_t total = 0;
+    for (const auto& shard : m_shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// ============================================================================
+// MetricsRegistry Implementation
+// ============================================================================
+
+MetricsRegistry::MetricsRegistry() = default;
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry& MetricsRegistry::Global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricCounter& MetricsRegistry::GetCounter(const std::string& name, const std::string& help,
+                                           const MetricLabels& labels) {
+    return *GetSeries(name, help, MetricType::Counter, labels).counter;
+}
+
+MetricGauge& MetricsRegistry::GetGauge(const std::string& name, const std::string& help,
+                                       const MetricLabels& labels) {
+    return *GetSeries(name, help, MetricType::Gauge, labels).gauge;
+}
+
+LatencyHistogram& MetricsRegistry::GetHistogram(const std::string& name, const std::string& help,
+                                                const MetricLabels& labels) {
+    return *GetSeries(name, help, MetricType::Summary, labels).histogram;
+}
+
+MetricsRegistry::Series& MetricsRegistry::GetSeries(const std::string& name, const std::string& help,
+                                                    MetricType type, const MetricLabels& labels) {
+    if (!IsValidName(name, true)) {
+        throw std::invalid_argument("Invalid metric name: " + name);
+    }
+    for (const auto& label : labels) {
+        if (!IsValidName(label.first, false) || label.first == "quantile") {
+            throw std::invalid_argument("Invalid label name for " + name + ": " + label.first);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto [familyIt, inserted] = m_families.try_emplace(name);
+    Family& family = familyIt->second;
+    if (inserted) {
+        family.help = help;
+        family.type = type;
+    } else if (family.type != type) {
+        throw std::invalid_argument("Metric " + name + " already registered as " + TypeName(family.type));
+    }
+
+    auto [seriesIt, created] = family.series.try_emplace(RenderLabels(labels));
+    Series& series = seriesIt->second;
+    if (created) {
+        series.labels = labels;
+        switch (type) {
+            case MetricType::Counter: series.counter = std::make_unique<MetricCounter>(); break;
+            case MetricType::Gauge:   series.gauge = std::make_unique<MetricGauge>(); break;
+            case MetricType::Summary: series.histogram = std::make_unique<LatencyHistogram>(); break;
+        }
+    }
+    return series;
+}
+
+std::vector<MetricSample> MetricsRegistry::Snapshot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<MetricSample> samples;
+    for (const auto& [name, family] : m_families) {
+        for (const auto& [key, series] : family.series) {
+            MetricSample sample;
+            sample.name = name;
+            sample.help = family.help;
+            sample.type = family.type;
+            sample.labels = series.labels;
+            switch (family.type) {
+                case MetricType::Counter:
+                    sample.value = static_cast<double>(series.counter->GetValue());
+                    break;
+                case MetricType::Gauge:
+                    sample.value = static_cast<double>(series.gauge->GetValue());
+                    break;
+                case MetricType::Summary:
+                    sample.summary = series.histogram->Summarize();
+                    sample.value = static_cast<double>(sample.summary.count);
+                    break;
+            }
+            samples.push_back(std::move(sample));
+        }
+    }
+    return samples;
+}
+
+std::string MetricsRegistry::FormatPrometheus() const {
+    const std::vector<MetricSample> samples = Snapshot();
+
+    std::ostringstream out;
+    const std::string* currentFamily = nullptr;
+    for (const auto& sample : samples) {
+        if (!currentFamily || *currentFamily != sample.name) {
+            out << "# HELP " << sample.name << ' ' << sample.help << '\n';
+            out << "# TYPE " << sample.name << ' ' << TypeName(sample.type) << '\n';
+            currentFamily = &sample.name;
+        }
+
+        const std::string labels = RenderLabels(sample.labels);
+        if (sample.type != MetricType::Summary) {
+            out << sample.name << WithBraces(labels) << ' ' << FormatValue(sample.value) << '\n';
+            continue;
+        }
+
+        const LatencySummary& summary = sample.summary;
+        const std::pair<const char*, uint64_t> quantiles[] = {
+            {"0.5", summary.p50Ns}, {"0.99", summary.p99Ns}, {"0.999", summary.p999Ns}};
+        for (const auto& [quantile, valueNs] : quantiles) {
+            out << sample.name << WithBraces(labels, std::string("quantile=\"") + quantile + "\"")
+                << ' ' << FormatValue(static_cast<double>(valueNs) / 1e9) << '\n';
+        }
+        out << sample.name << "_sum" << WithBraces(labels) << ' '
+            << FormatValue(summary.meanNs * static_cast<double>(summary.count) / 1e9) << '\n';
+        out << sample.name << "_count" << WithBraces(labels) << ' ' << summary.count << '\n';
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::WritePrometheus(const std::string& path) const {
+    const std::string text = FormatPrometheus();
+    const std::string tempPath = path + ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace uxdi
@@ -0,0 +1,95 @@
+#include "uxdi/ProcessStats.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+
+namespace uxdi {
+
+#if defined(_WIN32)
+
+ProcessStats SampleProcessStats() {
+    ProcessStats stats;
+
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        stats.residentBytes = counters.WorkingSetSize;
+        stats.peakResidentBytes = counters.PeakWorkingSetSize;
+    }
+
+    FILETIME creation{}, exit{}, kernel{}, user{};
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        // FILETIME counts 100 ns ticks
+        const auto ticks = [](const FILETIME& time) {
+            return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+        stats.cpuTimeNs = (ticks(kernel) + ticks(user)) * 100;
+    }
+
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot != INVALID_HANDLE_VALUE) {
+        const DWORD processId = GetCurrentProcessId();
+        THREADENTRY32 entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL ok = Thread32First(snapshot, &entry); ok; ok = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID == processId) {
+                stats.threadCount++;
+            }
+        }
+        CloseHandle(snapshot);
+    }
+
+    return stats;
+}
+
+#elif defined(__linux__)
+
+ProcessStats SampleProcessStats() {
+    ProcessStats stats;
+
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        uint64_t value = 0;
+        fields >> key >> value;
+
+        // Memory lines are reported in kB
+        if (key == "VmRSS:") {
+            stats.residentBytes = value * 1024;
+        } else if (key == "VmHWM:") {
+            stats.peakResidentBytes = value * 1024;
+        } else if (key == "Threads:") {
+            stats.threadCount = static_cast<uint32_t>(value);
+        }
+    }
+
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        const auto toNs = [](const timeval& time) {
+            return static_cast<uint64_t>(time.tv_sec) * 1000000000ull +
+                   static_cast<uint64_t>(time.tv_usec) * 1000ull;
+        };
+        stats.cpuTimeNs = toNs(usage.ru_utime) + toNs(usage.ru_stime);
+    }
+
+    return stats;
+}
+
+#else
+
+ProcessStats SampleProcessStats() {
+    return ProcessStats{};
+}
+
+#endif
+
+} // namespace uxdi
@@ -0,0 +1,456 @@
+#include "uxdi/RecordingReader.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace uxdi {
+
+using namespace recording;
+
+namespace {
+
+constexpr size_t kNoFrame = static_cast<size_t>(-1);
+
+template <typename T>
+bool ReadStruct(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool SeekTo(std::ifstream& file, uint64_t offset) {
+    file.clear();
+    return static_cast<bool>(file.seekg(static_cast<std::streamoff>(offset)));
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// PrefetchingFrameIterator Implementation
+// ============================================================================
+
+PrefetchingFrameIterator::PrefetchingFrameIterator(const RecordingReader& reader,
+                                                   std::vector<size_t> indices, size_t depth)
+    : m_reader(reader)
+    , m_indices(std::move(indices))
+    , m_depth(std::max<size_t>(depth, 1))
+{
+    {
+        std::lock_guard<std::mutex> readerLock(m_reader.m_mutex);
+        ++m_reader.m_iterators;
+    }
+    m_thread = std::thread(&PrefetchingFrameIterator::ReadaheadLoop, this);
+}
+
+PrefetchingFrameIterator::~PrefetchingFrameIterator() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    std::lock_guard<std::mutex> readerLock(m_reader.m_mutex);
+    --m_reader.m_iterators;
+}
+
+bool PrefetchingFrameIterator::Next(ImageData& outImage) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return !m_ready.empty() || m_consumed >= m_indices.size(); });
+    if (m_ready.empty()) {
+        return false;
+    }
+
+    Prefetched next = std::move(m_ready.front());
+    m_ready.pop_front();
+    if (!next.ok) {
+        m_consumed = m_indices.size();  // A read error ends the sequence
+        m_ready.clear();
+    } else {
+        ++m_consumed;
+    }
+    lock.unlock();
+    m_cv.notify_all();
+
+    if (!next.ok) {
+        return false;
+    }
+    outImage = std::move(next.image);
+    return true;
+}
+
+size_t PrefetchingFrameIterator::GetRemaining() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_indices.size() - m_consumed;
+}
+
+void PrefetchingFrameIterator::ReadaheadLoop() {
+    std::ifstream file;
+    {
+        std::shared_lock<std::shared_mutex> indexLock(m_reader.m_indexMutex);
+        file.open(m_reader.m_path, std::ios::binary);
+    }
+    RecordingPayloadCache cache;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] {
+            return m_stop || (m_produced < m_indices.size() && m_ready.size() < m_depth);
+        });
+        if (m_stop) {
+            break;
+        }
+
+        const size_t index = m_indices[m_produced];
+        lock.unlock();
+        Prefetched frame;
+        {
+            std::shared_lock<std::shared_mutex> indexLock(m_reader.m_indexMutex);
+            frame.ok = file.is_open() && m_reader.ReadFrameFrom(file, index, frame.image, &cache);
+        }
+        lock.lock();
+
+        m_ready.push_back(std::move(frame));
+        m_produced = m_ready.back().ok ? m_produced + 1 : m_indices.size();
+        m_cv.notify_all();
+    }
+}
+
+// ============================================================================
+// RecordingReader Implementation
+// ============================================================================
+
+RecordingReader::RecordingReader(const RecordingReaderOptions& options)
+    : m_options(options)
+{
+}
+
+RecordingReader::~RecordingReader() {
+    Close();
+}
+
+bool RecordingReader::Open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_iterators > 0) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> indexLock(m_indexMutex);
+    CloseLocked();
+
+    std::error_code ec;
+    const uint64_t containerSize = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+
+    m_file.open(path, std::ios::binary);
+    ContainerHeader header{};
+    if (!m_file.is_open() || !ReadStruct(m_file, header) ||
+        header.magic != kContainerMagic || header.version != kFormatVersion) {
+        m_file.close();
+        return false;
+    }
+
+    m_path = path;
+    LoadJournal(containerSize);
+
+    // Pick up frames the journal does not (yet) describe
+    uint64_t scanStart = sizeof(ContainerHeader);
+    if (!m_entries.empty()) {
+        scanStart = m_entries.back().offset + sizeof(FrameRecordHeader) + m_entries.back().length;
+    }
+    ScanContainer(scanStart, containerSize);
+
+    BuildLookups();
+    return true;
+}
+
+bool RecordingReader::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_iterators > 0) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> indexLock(m_indexMutex);
+    CloseLocked();
+    return true;
+}
+
+bool RecordingReader::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_file.is_open();
+}
+
+size_t RecordingReader::GetFrameCount() const {
+    std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+    return m_entries.size();
+}
+
+bool RecordingReader::GetEntry(size_t index, RecordingIndexEntry& outEntry) const {
+    std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+    if (index >= m_entries.size()) {
+        return false;
+    }
+    outEntry = m_entries[index];
+    return true;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+size_t RecordingReader::FindByTimestamp(double timestamp) const {
+    std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+    const size_t count = m_entries.size();
+    auto timeAt = [this](size_t position) {
+        return m_timeOrder.empty() ? m_entries[position].timestamp
+                                   : m_entries[m_timeOrder[position]].timestamp;
+    };
+
+    // Binary search over the time-ordered view
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (timeAt(mid) < timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == count || m_timeOrder.empty()) {
+        return lo;
+    }
+    return m_timeOrder[lo];
+}
+
+std::vector<size_t> RecordingReader::QueryTimeRange(double t0, double t1, size_t stride) const {
+    std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+    std::vector<size_t> result;
+    if (t1 <= t0 || m_entries.empty()) {
+        return result;
+    }
+    stride = std::max<size_t>(stride, 1);
+
+    // Positions in the time-ordered view
+    auto lowerBound = [this](double t) {
+        if (m_timeOrder.empty()) {
+            return static_cast<size_t>(std::lower_bound(
+                m_entries.begin(), m_entries.end(), t,
+                [](const RecordingIndexEntry& e, double value) { return e.timestamp < value; }) -
+                m_entries.begin());
+        }
+        return static_cast<size_t>(std::lower_bound(
+            m_timeOrder.begin(), m_timeOrder.end(), t,
+            [this](size_t index, double value) { return m_entries[index].timestamp < value; }) -
+            m_timeOrder.begin());
+    };
+
+    const size_t first = lowerBound(t0);
+    const size_t last = lowerBound(t1);
+    result.reserve((last - first + stride - 1) / stride);
+    for (size_t position = first; position < last; position += stride) {
+        result.push_back(m_timeOrder.empty() ? position : m_timeOrder[position]);
+    }
+    return result;
+}
+
+std::vector<size_t> RecordingReader::QueryIndexRange(size_t first, size_t last, size_t stride) const {
+    std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+    std::vector<size_t> result;
+    last = std::min(last, m_entries.size());
+    if (first >= last) {
+        return result;
+    }
+    stride = std::max<size_t>(stride, 1);
+
+    result.reserve((last - first + stride - 1) / stride);
+    for (size_t index = first; index < last; index += stride) {
+        result.push_back(index);
+    }
+    return result;
+}
+
+// ============================================================================
+// Frame access
+// ============================================================================
+
+bool RecordingReader::ReadFrame(size_t index, ImageData& outImage) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+    return m_file.is_open() && ReadFrameFrom(m_file, index, outImage, &m_cache);
+}
+
+std::unique_ptr<PrefetchingFrameIterator> RecordingReader::Iterate(std::vector<size_t> indices,
+                                                                   size_t depth) const {
+    return std::make_unique<PrefetchingFrameIterator>(*this, std::move(indices), depth);
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool RecordingReader::LoadJournal(uint64_t containerSize) {
+    std::ifstream journal(m_path + kJournalSuffix, std::ios::binary);
+    JournalHeader header{};
+    if (!journal.is_open() || !ReadStruct(journal, header) ||
+        header.magic != kJournalMagic || header.version != kFormatVersion ||
+        header.recordSize != sizeof(JournalRecord)) {
+        return false;
+    }
+
+    // Trust index records up to the first damaged or out-of-bounds one
+    JournalRecord record{};
+    uint64_t expectedOffset = sizeof(ContainerHeader);
+    while (ReadStruct(journal, record) && IsValidJournalRecord(record)) {
+        if (record.type != kRecordIndex) {
+            continue;
+        }
+        if (record.offset != expectedOffset ||
+            record.offset + sizeof(FrameRecordHeader) + record.length > containerSize) {
+            break;
+        }
+
+        RecordingIndexEntry entry;
+        entry.frameNumber = record.frameNumber;
+        entry.timestamp = record.timestamp;
+        entry.offset = record.offset;
+        entry.length = record.length;
+        entry.flags = record.flags;
+        m_entries.push_back(entry);
+        expectedOffset = record.offset + sizeof(FrameRecordHeader) + record.length;
+    }
+    return true;
+}
+
+void RecordingReader::ScanContainer(uint64_t start, uint64_t containerSize) {
+    uint64_t offset = start;
+    FrameRecordHeader header{};
+    while (offset + sizeof(FrameRecordHeader) <= containerSize &&
+           SeekTo(m_file, offset) && ReadStruct(m_file, header) && IsValidFrameHeader(header)) {
+        const uint64_t end = offset + sizeof(FrameRecordHeader) + header.dataLength;
+        if (end > containerSize) {
+            break;
+        }
+
+        RecordingIndexEntry entry;
+        entry.frameNumber = header.frameNumber;
+        entry.timestamp = header.timestamp;
+        entry.offset = offset;
+        entry.length = header.dataLength;
+        entry.flags = header.flags;
+        m_entries.push_back(entry);
+        offset = end;
+    }
+}
+
+void RecordingReader::BuildLookups() {
+    bool sorted = true;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (i > 0 && m_entries[i].timestamp < m_entries[i - 1].timestamp) {
+            sorted = false;
+        }
+        if ((m_entries[i].flags & kFrameFlagReference) == 0) {
+            m_keyFrames[m_entries[i].frameNumber].push_back(i);
+        }
+    }
+
+    if (!sorted) {
+        m_timeOrder.resize(m_entries.size());
+        for (size_t i = 0; i < m_timeOrder.size(); ++i) {
+            m_timeOrder[i] = i;
+        }
+        std::stable_sort(m_timeOrder.begin(), m_timeOrder.end(), [this](size_t a, size_t b) {
+            return m_entries[a].timestamp < m_entries[b].timestamp;
+        });
+    }
+}
+
+void RecordingReader::CloseLocked() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_path.clear();
+    m_entries.clear();
+    m_timeOrder.clear();
+    m_keyFrames.clear();
+    m_cache = RecordingPayloadCache{};
+}
+
+size_t RecordingReader::ResolveReference(uint64_t referenceFrame, size_t index) const {
+    // A reference points at the latest key frame with that number before it
+    auto it = m_keyFrames.find(referenceFrame);
+    if (it == m_keyFrames.end()) {
+        return kNoFrame;
+    }
+    const std::vector<size_t>& candidates = it->second;
+    auto pos = std::lower_bound(candidates.begin(), candidates.end(), index);
+    if (pos == candidates.begin()) {
+        return kNoFrame;
+    }
+    return *(pos - 1);
+}
+
+bool RecordingReader::ReadFrameFrom(std::ifstream& file, size_t index, ImageData& outImage,
+                                    RecordingPayloadCache* cache) const {
+    if (index >= m_entries.size()) {
+        return false;
+    }
+
+    FrameRecordHeader header{};
+    if (!SeekTo(file, m_entries[index].offset) || !ReadStruct(file, header) ||
+        !IsValidFrameHeader(header)) {
+        return false;
+    }
+
+    ImageData image;
+    image.width = header.width;
+    image.height = header.height;
+    image.bitDepth = header.bitDepth;
+    image.frameNumber = header.frameNumber;
+    image.timestamp = header.timestamp;
+
+    // Static frames take their pixels from the key frame
+    size_t payloadIndex = index;
+    FrameRecordHeader payloadHeader = header;
+    if (header.flags & kFrameFlagReference) {
+        payloadIndex = ResolveReference(header.referenceFrame, index);
+        if (payloadIndex == kNoFrame) {
+            return false;
+        }
+    }
+    image.dataLength = static_cast<size_t>(m_entries[payloadIndex].length);
+
+    if (cache && cache->payloadIndex == payloadIndex && cache->data) {
+        image.data = cache->data;
+        outImage = std::move(image);
+        return true;
+    }
+
+    if (payloadIndex != index) {
+        if (!SeekTo(file, m_entries[payloadIndex].offset) || !ReadStruct(file, payloadHeader) ||
+            !IsValidFrameHeader(payloadHeader)) {
+            return false;
+        }
+    }
+
+    std::shared_ptr<uint8_t[]> payload(new uint8_t[image.dataLength]);
+    if (image.dataLength > 0 &&
+        !file.read(reinterpret_cast<char*>(payload.get()), static_cast<std::streamsize>(image.dataLength))) {
+        return false;
+    }
+
+    if (m_options.verifyPayloadChecksums && (payloadHeader.flags & kFrameFlagPayloadCrc) &&
+        ComputeCrc32(payload.get(), image.dataLength) != payloadHeader.payloadCrc) {
+        return false;
+    }
+
+    if (cache) {
+        cache->payloadIndex = payloadIndex;
+        cache->data = payload;
+    }
+    image.data = std::move(payload);
+    outImage = std::move(image);
+    return true;
+}
+
+} // namespace uxdi
@@ -0,0 +1,242 @@
+#include "uxdi/RetroactiveBuffer.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/FrameRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace uxdi {
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+RetroactiveBuffer::RetroactiveBuffer(const RetroactiveBufferOptions& options)
+    : m_options(options) {
+    // Started here so the mutex and condition variable already exist
+    m_writer = std::thread(&RetroactiveBuffer::WriterLoop, this);
+}
+
+RetroactiveBuffer::~RetroactiveBuffer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopWriter = true;
+    }
+    m_cv.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+// ============================================================================
+// Trigger control
+// ============================================================================
+
+bool RetroactiveBuffer::Trigger(FrameRecorder& recorder, uint32_t postTriggerFrames) {
+    if (!recorder.IsOpen()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_commitLimit > m_committedSequence) {
+            return false;  // Capture already in progress
+        }
+
+        m_recorder = &recorder;
+
+        // Start from the oldest buffered frame, never rewriting frames an
+        // earlier trigger already committed
+        m_committedSequence = std::max(m_committedSequence, OldestSequenceLocked() - 1);
+
+        // Skip frames older than the age window, measured from the newest frame
+        if (m_options.maxAgeSeconds > 0.0 && !m_slots.empty() &&
+            m_nextSequence - 1 > m_committedSequence) {
+            const size_t capacity = m_slots.size();
+            const double newest = m_slots[(m_nextSequence - 1) % capacity].image.timestamp;
+            while (m_committedSequence + 1 < m_nextSequence) {
+                const Slot& slot = m_slots[(m_committedSequence + 1) % capacity];
+                if (newest - slot.image.timestamp <= m_options.maxAgeSeconds) {
+                    break;
+                }
+                ++m_committedSequence;
+            }
+        }
+
+        m_commitLimit = m_nextSequence - 1 + postTriggerFrames;
+    }
+    m_cv.notify_all();
+    return true;
+}
+
+void RetroactiveBuffer::Cancel() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_commitLimit = m_committedSequence;
+    }
+    m_cv.notify_all();
+}
+
+bool RetroactiveBuffer::IsCapturing() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_commitLimit > m_committedSequence;
+}
+
+bool RetroactiveBuffer::WaitForCapture(uint32_t timeoutMs) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                         [this] { return m_commitLimit <= m_committedSequence; });
+}
+
+void RetroactiveBuffer::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ringStart = m_nextSequence;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+size_t RetroactiveBuffer::GetBufferedFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_nextSequence - OldestSequenceLocked());
+}
+
+size_t RetroactiveBuffer::GetCapacityFrames() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots.size();
+}
+
+size_t RetroactiveBuffer::GetBufferedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots.size() * m_frameBytes;
+}
+
+uint64_t RetroactiveBuffer::GetDroppedFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_droppedFrames;
+}
+
+// ============================================================================
+// IDetectorListener implementation
+// ============================================================================
+
+void RetroactiveBuffer::onImageReceived(const ImageData& image) {
+    UXDI_ALLOC_SCOPE(Recording);
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (image.dataLength != m_frameBytes || m_slots.empty()) {
+            ResizeLocked(image.dataLength);
+        }
+        if (m_slots.empty()) {
+            ++m_droppedFrames;  // Frame does not fit the byte budget
+            return;
+        }
+
+        const uint64_t sequence = m_nextSequence;
+        Slot& slot = m_slots[sequence % m_slots.size()];
+
+        // The writer may still hold this buffer; only then is a new one needed
+        std::shared_ptr<uint8_t[]> buffer = std::move(slot.image.data);
+        if (!buffer || buffer.use_count() > 1) {
+            buffer = std::shared_ptr<uint8_t[]>(new uint8_t[m_frameBytes]);
+        }
+        if (image.data && image.dataLength > 0) {
+            std::memcpy(buffer.get(), image.data.get(), image.dataLength);
+        }
+
+        slot.image = image;
+        slot.image.data = std::move(buffer);
+        slot.sequence = sequence;
+        ++m_nextSequence;
+
+        notify = HasPendingLocked();
+    }
+    if (notify) {
+        m_cv.notify_all();
+    }
+}
+
+void RetroactiveBuffer::onStateChanged(DetectorState) {
+}
+
+void RetroactiveBuffer::onError(const ErrorInfo&) {
+}
+
+void RetroactiveBuffer::onAcquisitionStarted() {
+}
+
+void RetroactiveBuffer::onAcquisitionStopped() {
+}
+
+// ============================================================================
+// Internal helpers
+// ============================================================================
+
+void RetroactiveBuffer::ResizeLocked(size_t frameBytes) {
+    size_t capacity = frameBytes > 0 ? m_options.maxBytes / frameBytes : 0;
+    if (m_options.maxFrames > 0) {
+        capacity = std::min<size_t>(capacity, m_options.maxFrames);
+    }
+
+    // Existing frames have a different size and are discarded; a pending
+    // capture counts them as dropped when the writer next runs
+    m_slots.clear();
+    m_slots.resize(capacity);
+    for (Slot& slot : m_slots) {
+        slot.image.data = std::shared_ptr<uint8_t[]>(new uint8_t[frameBytes]);
+    }
+    m_frameBytes = frameBytes;
+    m_ringStart = m_nextSequence;
+}
+
+uint64_t RetroactiveBuffer::OldestSequenceLocked() const {
+    const uint64_t filled = std::min<uint64_t>(m_nextSequence - m_ringStart, m_slots.size());
+    return m_nextSequence - filled;
+}
+
+bool RetroactiveBuffer::HasPendingLocked() const {
+    return m_committedSequence < std::min(m_nextSequence - 1, m_commitLimit);
+}
+
+void RetroactiveBuffer::WriterLoop() {
+    UXDI_ALLOC_SCOPE(Recording);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stopWriter || HasPendingLocked(); });
+        if (m_stopWriter) {
+            break;
+        }
+
+        // Frames overwritten before they could be written are lost
+        const uint64_t oldest = OldestSequenceLocked();
+        if (m_committedSequence + 1 < oldest) {
+            const uint64_t skipTo = std::min(oldest - 1, m_commitLimit);
+            m_droppedFrames += skipTo - m_committedSequence;
+            m_committedSequence = skipTo;
+            if (!HasPendingLocked()) {
+                m_cv.notify_all();
+                continue;
+            }
+        }
+
+        const uint64_t sequence = m_committedSequence + 1;
+        ImageData image = m_slots[sequence % m_slots.size()].image;  // Pins the buffer
+        FrameRecorder* recorder = m_recorder;
+
+        lock.unlock();
+        const bool written = recorder->WriteFrame(image);
+        image.data.reset();
+        lock.lock();
+
+        if (!written) {
+            ++m_droppedFrames;
+        }
+        m_committedSequence = std::max(m_committedSequence, sequence);
+        m_cv.notify_all();
+    }
+}
+
+} // namespace uxdi
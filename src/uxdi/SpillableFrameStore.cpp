@@ -0,0 +1,341 @@
+#include "uxdi/SpillableFrameStore.h"
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/MetricsRegistry.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace uxdi {
+
+namespace {
+
+// 64-bit seek; plain fseek takes a 32-bit long on Windows
+bool SeekTo(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+// Shared by all stores
+MetricGauge& SpillQueueMetric() {
+    static MetricGauge& gauge = MetricsRegistry::Global().GetGauge(
+        "uxdi_spill_queue_frames", "Frames queued for the spill writer");
+    return gauge;
+}
+
+MetricCounter& SpilledBytesMetric() {
+    static MetricCounter& counter = MetricsRegistry::Global().GetCounter(
+        "uxdi_spill_bytes_total", "Frame bytes written to spill scratch files");
+    return counter;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// FrameHandle
+// ============================================================================
+
+bool FrameHandle::IsResident() const {
+    return m_store != nullptr && m_store->IsResident(m_index);
+}
+
+bool FrameHandle::Load(ImageData& outImage) const {
+    return m_store != nullptr && m_store->Load(m_index, outImage);
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+SpillableFrameStore::SpillableFrameStore(const SpillOptions& options)
+    : m_options(options) {
+    m_lastError.code = ErrorCode::SUCCESS;
+    m_writer = std::thread(&SpillableFrameStore::WriterLoop, this);
+}
+
+SpillableFrameStore::~SpillableFrameStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopWriter = true;
+    }
+    m_cv.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    SpillQueueMetric().Add(-static_cast<int64_t>(m_queue.size()));
+
+    if (m_reader) {
+        std::fclose(m_reader);
+    }
+    if (m_scratch) {
+        std::fclose(m_scratch);
+    }
+    if (!m_scratchPath.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(m_scratchPath, ec);
+    }
+}
+
+// ============================================================================
+// Frame access
+// ============================================================================
+
+FrameHandle SpillableFrameStore::Append(const ImageData& image) {
+    UXDI_ALLOC_SCOPE(Recording);
+
+    Entry entry;
+    entry.image = image;
+    if (IsBorrowedBuffer(image)) {
+        entry.image.data = std::shared_ptr<uint8_t[]>(new uint8_t[image.dataLength]);
+        std::memcpy(entry.image.data.get(), image.data.get(), image.dataLength);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Without a working scratch file RAM is all that is left; refuse frames
+    // beyond the hot window rather than grow without bound
+    if (m_writeFailed && m_hotBytes + image.dataLength > m_options.hotBytes) {
+        SetErrorLocked(ErrorCode::OUT_OF_MEMORY, "Spilling failed and the hot window is full");
+        return FrameHandle();
+    }
+
+    const size_t index = m_entries.size();
+    m_entries.push_back(std::move(entry));
+    m_hotBytes += image.dataLength;
+
+    // Queue the oldest resident frames until the hot window fits again;
+    // the newest frame always stays in memory
+    bool queued = false;
+    while (!m_writeFailed && m_hotBytes > m_options.hotBytes && m_nextToSpill < index) {
+        if (!m_scratch && !OpenScratchLocked()) {
+            m_writeFailed = true;
+            break;
+        }
+        Entry& victim = m_entries[m_nextToSpill];
+        victim.state = EntryState::Queued;
+        m_hotBytes -= victim.image.dataLength;
+        m_pendingBytes += victim.image.dataLength;
+        m_queue.push_back(m_nextToSpill);
+        SpillQueueMetric().Add(1);
+        ++m_nextToSpill;
+        queued = true;
+    }
+    if (queued) {
+        m_cv.notify_all();
+    }
+    if (m_writeFailed && m_hotBytes > m_options.hotBytes) {
+        // The scratch file could not be created; nothing was queued
+        m_hotBytes -= image.dataLength;
+        m_entries.pop_back();
+        return FrameHandle();
+    }
+
+    // Back-pressure: never let the unwritten backlog grow without bound
+    m_cv.wait(lock, [this] {
+        return m_pendingBytes <= m_options.maxPendingBytes || m_writeFailed || m_stopWriter;
+    });
+
+    return FrameHandle(this, index);
+}
+
+FrameHandle SpillableFrameStore::GetHandle(size_t index) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index >= m_entries.size()) {
+        return FrameHandle();
+    }
+    return FrameHandle(this, index);
+}
+
+bool SpillableFrameStore::Load(size_t index, ImageData& outImage) const {
+    ImageData image;
+    uint64_t offset = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (index >= m_entries.size()) {
+            return false;
+        }
+        const Entry& entry = m_entries[index];
+        image = entry.image;
+        if (image.data || image.dataLength == 0) {
+            outImage = std::move(image);
+            return true;
+        }
+        if (auto cached = entry.pagedIn.lock()) {
+            image.data = std::move(cached);
+            outImage = std::move(image);
+            return true;
+        }
+        offset = entry.offset;
+    }
+
+    // Page in from the scratch file outside the store lock
+    std::shared_ptr<uint8_t[]> buffer(new uint8_t[image.dataLength]);
+    bool ok = false;
+    {
+        std::lock_guard<std::mutex> readLock(m_readMutex);
+        if (!m_reader) {
+            m_reader = std::fopen(m_scratchPath.c_str(), "rb");
+        }
+        ok = m_reader && SeekTo(m_reader, offset) &&
+             std::fread(buffer.get(), 1, image.dataLength, m_reader) == image.dataLength;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!ok) {
+        SetErrorLocked(ErrorCode::HARDWARE_ERROR,
+                       "Failed to page in frame " + std::to_string(index) + " from " + m_scratchPath);
+        return false;
+    }
+    m_entries[index].pagedIn = buffer;
+    image.data = std::move(buffer);
+    outImage = std::move(image);
+    return true;
+}
+
+void SpillableFrameStore::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_pendingBytes == 0 || m_writeFailed || m_stopWriter; });
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+size_t SpillableFrameStore::GetFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t SpillableFrameStore::GetSpilledFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_spilledFrames;
+}
+
+size_t SpillableFrameStore::GetResidentBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hotBytes + m_pendingBytes;
+}
+
+std::string SpillableFrameStore::GetScratchPath() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_scratchPath;
+}
+
+ErrorInfo SpillableFrameStore::GetLastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+// ============================================================================
+// Internal helpers
+// ============================================================================
+
+bool SpillableFrameStore::IsResident(size_t index) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return index < m_entries.size() && m_entries[index].state != EntryState::Spilled;
+}
+
+bool SpillableFrameStore::OpenScratchLocked() {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::path directory = m_options.scratchDirectory.empty()
+        ? fs::temp_directory_path(ec)
+        : fs::path(m_options.scratchDirectory);
+
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const std::string name = "uxdi_spill_" + std::to_string(stamp) + "_" +
+        std::to_string(reinterpret_cast<uintptr_t>(this)) + ".tmp";
+    const std::string path = (directory / name).string();
+
+    m_scratch = std::fopen(path.c_str(), "wb");
+    if (!m_scratch) {
+        SetErrorLocked(ErrorCode::HARDWARE_ERROR, "Failed to create scratch file: " + path);
+        return false;
+    }
+    m_scratchPath = path;
+    return true;
+}
+
+void SpillableFrameStore::WriterLoop() {
+    UXDI_ALLOC_SCOPE(Recording);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stopWriter || !m_queue.empty(); });
+        if (m_stopWriter) {
+            break;
+        }
+
+        const size_t index = m_queue.front();
+        m_queue.pop_front();
+        SpillQueueMetric().Add(-1);
+        ImageData image = m_entries[index].image;  // Keeps the buffer alive while writing
+        const uint64_t offset = m_scratchEnd;
+        std::FILE* scratch = m_scratch;
+
+        lock.unlock();
+        const bool ok = image.dataLength == 0 ||
+            (std::fwrite(image.data.get(), 1, image.dataLength, scratch) == image.dataLength &&
+             std::fflush(scratch) == 0);
+        image.data.reset();
+        lock.lock();
+
+        Entry& entry = m_entries[index];
+        if (ok) {
+            entry.offset = offset;
+            entry.image.data.reset();
+            entry.state = EntryState::Spilled;
+            m_scratchEnd += image.dataLength;
+            ++m_spilledFrames;
+            SpilledBytesMetric().Increment(image.dataLength);
+        } else {
+            // Keep the frame in memory and stop spilling further frames
+            entry.state = EntryState::Resident;
+            m_hotBytes += image.dataLength;
+            m_writeFailed = true;
+            SetErrorLocked(ErrorCode::HARDWARE_ERROR, "Failed to write scratch file: " + m_scratchPath);
+        }
+        m_pendingBytes -= image.dataLength;
+        m_cv.notify_all();
+    }
+}
+
+void SpillableFrameStore::SetErrorLocked(ErrorCode code, const std::string& message) const {
+    m_lastError.code = code;
+    m_lastError.message = message;
+    m_lastError.details.clear();
+}
+
+// ============================================================================
+// Synchronous acquisition helper
+// ============================================================================
+
+bool AcquireFramesToStore(IDetectorSynchronous& detector, uint32_t frameCount,
+                          SpillableFrameStore& store, uint32_t timeoutMs) {
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto timeout = std::chrono::milliseconds(timeoutMs);
+
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        const auto elapsed = std::chrono::steady_clock::now() - startTime;
+        if (elapsed >= timeout) {
+            return false;
+        }
+
+        const uint32_t remainingTimeout = timeoutMs - static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+        ImageData frame;
+        if (!detector.acquireFrame(frame, remainingTimeout)) {
+            return false;
+        }
+        if (!store.Append(frame).IsValid()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace uxdi
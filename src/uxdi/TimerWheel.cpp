@@ -0,0 +1,73 @@
+#include "uxdi/TimerWheel.h"
+#include <algorithm>
+
+namespace uxdi {
+
+// ============================================================================
+// TimerWheel Implementation
+// ============================================================================
+
+TimerWheel::TimerWheel(uint64_t tickNs, size_t slotCount)
+    : m_tickNs(std::max<uint64_t>(tickNs, 1))
+    , m_slots(std::max<size_t>(slotCount, 1))
+{
+}
+
+void TimerWheel::Schedule(uint64_t key, uint64_t deadlineNs) {
+    // Past deadlines go in the current slot so the next pop finds them
+    const uint64_t tick = std::max(deadlineNs / m_tickNs, m_currentTick);
+    m_slots[tick % m_slots.size()].push_back(Entry{key, deadlineNs});
+    m_size++;
+}
+
+size_t TimerWheel::PopDue(uint64_t nowNs, std::vector<uint64_t>& out) {
+    const uint64_t nowTick = nowNs / m_tickNs;
+    if (m_size == 0 || nowTick < m_currentTick) {
+        m_currentTick = std::max(m_currentTick, nowTick);
+        return 0;
+    }
+
+    // Visit each elapsed tick's slot once; a gap of a revolution or more
+    // visits every slot once
+    const uint64_t ticks = std::min<uint64_t>(nowTick - m_currentTick + 1, m_slots.size());
+    size_t popped = 0;
+    for (uint64_t i = 0; i < ticks && m_size > 0; ++i) {
+        std::vector<Entry>& slot = m_slots[(m_currentTick + i) % m_slots.size()];
+        auto keep = std::partition(slot.begin(), slot.end(),
+                                   [nowNs](const Entry& entry) { return entry.deadlineNs > nowNs; });
+        for (auto it = keep; it != slot.end(); ++it) {
+            out.push_back(it->key);
+        }
+        const size_t count = static_cast<size_t>(slot.end() - keep);
+        slot.erase(keep, slot.end());
+        popped += count;
+        m_size -= count;
+    }
+
+    // The current tick may still hold entries due later within it
+    m_currentTick = nowTick;
+    return popped;
+}
+
+std::optional<uint64_t> TimerWheel::NextDeadline() const {
+    if (m_size == 0) {
+        return std::nullopt;
+    }
+
+    const uint64_t revolutionEnd = m_currentTick + m_slots.size();
+    for (uint64_t tick = m_currentTick; tick < revolutionEnd; ++tick) {
+        const std::vector<Entry>& slot = m_slots[tick % m_slots.size()];
+        std::optional<uint64_t> earliest;
+        for (const Entry& entry : slot) {
+            if (entry.deadlineNs / m_tickNs <= tick) {
+                earliest = std::min(earliest.value_or(entry.deadlineNs), entry.deadlineNs);
+            }
+        }
+        if (earliest) {
+            return earliest;
+        }
+    }
+    return revolutionEnd * m_tickNs;
+}
+
+} // namespace uxdi
@@ -0,0 +1,269 @@
+#include "uxdi/TimingTrace.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace uxdi {
+
+namespace {
+
+constexpr uint32_t kTraceMagic = 0x54445855;  // "UXDT"
+constexpr uint32_t kTraceVersion = 1;
+constexpr size_t kHeaderBytes = 16;
+
+// Largest record: type byte and two 64-bit varints
+constexpr size_t kMaxRecordBytes = 1 + 2 * 10;
+
+size_t PutVarint(uint8_t* out, uint64_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = static_cast<uint8_t>(value);
+    return length;
+}
+
+bool GetVarint(const uint8_t*& cursor, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && cursor < end; shift += 7) {
+        const uint8_t byte = *cursor++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// TimingTraceRecorder Implementation
+// ============================================================================
+
+TimingTraceRecorder::TimingTraceRecorder() {
+    m_lastError.code = ErrorCode::SUCCESS;
+    m_lastError.message = "No error";
+}
+
+TimingTraceRecorder::~TimingTraceRecorder() {
+    Close();
+}
+
+bool TimingTraceRecorder::Open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_file) {
+        SetError(ErrorCode::STATE_ERROR, "Timing trace is already open");
+        return false;
+    }
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        SetError(ErrorCode::HARDWARE_ERROR, "Failed to create timing trace: " + path);
+        return false;
+    }
+
+    uint8_t header[kHeaderBytes] = {};
+    std::memcpy(header, &kTraceMagic, sizeof(kTraceMagic));
+    std::memcpy(header + 4, &kTraceVersion, sizeof(kTraceVersion));
+    if (std::fwrite(header, sizeof(header), 1, m_file) != 1) {
+        CloseLocked();
+        SetError(ErrorCode::HARDWARE_ERROR, "Failed to write timing trace header: " + path);
+        return false;
+    }
+
+    m_lastNs = 0;
+    m_nextFrameNumber = 0;
+    m_eventCount = 0;
+    return true;
+}
+
+bool TimingTraceRecorder::WriteEvent(TimingEventType type, uint64_t timeNs, uint64_t value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file) {
+        SetError(ErrorCode::STATE_ERROR, "Timing trace is not open");
+        return false;
+    }
+
+    // The first event starts the clock; callbacks racing on other threads
+    // may arrive stamped slightly out of order
+    if (m_eventCount == 0) {
+        m_lastNs = timeNs;
+    }
+    const uint64_t deltaNs = timeNs > m_lastNs ? timeNs - m_lastNs : 0;
+    m_lastNs = std::max(m_lastNs, timeNs);
+
+    uint8_t record[kMaxRecordBytes];
+    size_t length = 0;
+    record[length++] = static_cast<uint8_t>(type);
+    length += PutVarint(record + length, deltaNs);
+    switch (type) {
+        case TimingEventType::Frame:
+            // A steady stream encodes as zero
+            length += PutVarint(record + length, ZigZag(static_cast<int64_t>(value - m_nextFrameNumber)));
+            m_nextFrameNumber = value + 1;
+            break;
+        case TimingEventType::StateChanged:
+        case TimingEventType::Error:
+            length += PutVarint(record + length, value);
+            break;
+        case TimingEventType::AcquisitionStarted:
+        case TimingEventType::AcquisitionStopped:
+            break;
+    }
+
+    if (std::fwrite(record, 1, length, m_file) != length) {
+        SetError(ErrorCode::HARDWARE_ERROR, "Failed to write timing trace event");
+        return false;
+    }
+    m_eventCount++;
+    return true;
+}
+
+bool TimingTraceRecorder::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return CloseLocked();
+}
+
+bool TimingTraceRecorder::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_file != nullptr;
+}
+
+uint64_t TimingTraceRecorder::GetEventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_eventCount;
+}
+
+ErrorInfo TimingTraceRecorder::GetLastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+bool TimingTraceRecorder::Read(const std::string& path, std::vector<TimingEvent>& events, std::string* error) {
+    const auto fail = [error](std::string message) {
+        if (error) {
+            *error = std::move(message);
+        }
+        return false;
+    };
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return fail("cannot open " + path);
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (bytes.size() >= kHeaderBytes) {
+        std::memcpy(&magic, bytes.data(), sizeof(magic));
+        std::memcpy(&version, bytes.data() + 4, sizeof(version));
+    }
+    if (magic != kTraceMagic) {
+        return fail(path + " is not a timing trace");
+    }
+    if (version != kTraceVersion) {
+        return fail(path + " has unsupported timing trace version " + std::to_string(version));
+    }
+
+    events.clear();
+    const uint8_t* cursor = bytes.data() + kHeaderBytes;
+    const uint8_t* const end = bytes.data() + bytes.size();
+    uint64_t offsetNs = 0;
+    uint64_t nextFrameNumber = 0;
+    while (cursor < end) {
+        TimingEvent event;
+        event.type = static_cast<TimingEventType>(*cursor++);
+
+        uint64_t deltaNs = 0;
+        uint64_t value = 0;
+        bool complete = GetVarint(cursor, end, deltaNs);
+        switch (event.type) {
+            case TimingEventType::Frame:
+            case TimingEventType::StateChanged:
+            case TimingEventType::Error:
+                complete = complete && GetVarint(cursor, end, value);
+                break;
+            case TimingEventType::AcquisitionStarted:
+            case TimingEventType::AcquisitionStopped:
+                break;
+            default:
+                return fail(path + ": unknown event type " + std::to_string(static_cast<int>(event.type)));
+        }
+        if (!complete) {
+            break;  // Torn last record
+        }
+
+        offsetNs += deltaNs;
+        event.offsetNs = offsetNs;
+        if (event.type == TimingEventType::Frame) {
+            event.frameNumber = nextFrameNumber + static_cast<uint64_t>(UnZigZag(value));
+            nextFrameNumber = event.frameNumber + 1;
+        } else {
+            event.code = static_cast<uint32_t>(value);
+        }
+        events.push_back(event);
+    }
+    return true;
+}
+
+// ============================================================================
+// IDetectorListener Implementation
+// ============================================================================
+
+void TimingTraceRecorder::onImageReceived(const ImageData& image) {
+    const uint64_t timeNs = image.latency.sdkDeliveryNs != 0 ? image.latency.sdkDeliveryNs : MonotonicNowNs();
+    WriteEvent(TimingEventType::Frame, timeNs, image.frameNumber);
+}
+
+void TimingTraceRecorder::onStateChanged(DetectorState newState) {
+    WriteEvent(TimingEventType::StateChanged, MonotonicNowNs(), static_cast<uint64_t>(newState));
+}
+
+void TimingTraceRecorder::onError(const ErrorInfo& error) {
+    WriteEvent(TimingEventType::Error, MonotonicNowNs(), static_cast<uint64_t>(error.code));
+}
+
+void TimingTraceRecorder::onAcquisitionStarted() {
+    WriteEvent(TimingEventType::AcquisitionStarted, MonotonicNowNs());
+}
+
+void TimingTraceRecorder::onAcquisitionStopped() {
+    WriteEvent(TimingEventType::AcquisitionStopped, MonotonicNowNs());
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool TimingTraceRecorder::CloseLocked() {
+    if (!m_file) {
+        return true;
+    }
+    const bool ok = std::fclose(m_file) == 0;
+    m_file = nullptr;
+    if (!ok) {
+        SetError(ErrorCode::HARDWARE_ERROR, "Failed to close timing trace");
+    }
+    return ok;
+}
+
+void TimingTraceRecorder::SetError(ErrorCode code, const std::string& message) {
+    m_lastError.code = code;
+    m_lastError.message = message;
+    m_lastError.details.clear();
+}
+
+} // namespace uxdi
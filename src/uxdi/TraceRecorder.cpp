@@ -0,0 +1,312 @@
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/Types.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace uxdi {
+
+// ============================================================================
+// Internal state
+// ============================================================================
+
+struct TraceRecorder::ThreadBuffer {
+    explicit ThreadBuffer(size_t capacity)
+        : events(new TraceEvent[capacity])
+        , capacity(capacity)
+    {
+    }
+
+    std::unique_ptr<TraceEvent[]> events;
+    const size_t capacity;
+    std::atomic<uint64_t> head{0};  // Events ever written; only the owning thread stores
+
+    // Guarded by Shared::mutex
+    uint64_t tail = 0;              // Events before this index were cleared
+    uint32_t threadId = 0;
+    std::string threadName;
+    bool retired = false;
+};
+
+struct TraceRecorder::Shared {
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    uint32_t nextThreadId = 1;
+};
+
+// Per-thread cache of the buffer owned in the most recently used recorder.
+// The weak reference lets the thread retire its buffer on exit without
+// keeping a destroyed recorder's state alive.
+struct TraceThreadSlot {
+    const TraceRecorder* recorder = nullptr;
+    uint64_t recorderId = 0;
+    TraceRecorder::ThreadBuffer* buffer = nullptr;
+    std::weak_ptr<TraceRecorder::Shared> shared;
+    std::string pendingName;
+
+    void Release() {
+        if (auto state = shared.lock()) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            buffer->retired = true;
+        }
+        recorder = nullptr;
+        recorderId = 0;
+        buffer = nullptr;
+        shared.reset();
+    }
+
+    ~TraceThreadSlot() {
+        Release();
+    }
+};
+
+namespace {
+
+thread_local TraceThreadSlot t_slot;
+
+std::atomic<uint64_t> g_nextRecorderId{1};
+
+const char* CategoryName(TraceCategory category) {
+    switch (category) {
+        case TraceCategory::Acquisition: return "acquisition";
+        case TraceCategory::Callback:    return "callback";
+        case TraceCategory::State:       return "state";
+        case TraceCategory::Dispatch:    return "dispatch";
+        case TraceCategory::Scenario:    return "scenario";
+        case TraceCategory::Host:        return "host";
+    }
+    return "host";
+}
+
+void AppendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(c);
+                }
+                break;
+        }
+    }
+    out += '"';
+}
+
+// Chrome trace timestamps are microseconds; keep nanosecond precision
+void AppendMicroseconds(std::string& out, uint64_t ns) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03u",
+                  static_cast<unsigned long long>(ns / 1000), static_cast<unsigned>(ns % 1000));
+    out += buffer;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// TraceRecorder Implementation
+// ============================================================================
+
+std::atomic<TraceRecorder*> TraceRecorder::s_attached{nullptr};
+
+TraceRecorder::TraceRecorder(size_t eventsPerThread, size_t maxThreads)
+    : m_id(g_nextRecorderId.fetch_add(1, std::memory_order_relaxed))
+    , m_eventsPerThread(std::max<size_t>(eventsPerThread, 1))
+    , m_maxThreads(std::max<size_t>(maxThreads, 1))
+    , m_shared(std::make_shared<Shared>())
+{
+}
+
+TraceRecorder::~TraceRecorder() {
+    if (t_slot.recorder == this && t_slot.recorderId == m_id) {
+        t_slot.Release();
+    }
+}
+
+TraceRecorder& TraceRecorder::Global() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+void TraceRecorder::Attach(TraceRecorder* recorder) {
+    s_attached.store(recorder, std::memory_order_release);
+}
+
+void TraceRecorder::Record(TraceCategory category, char phase, const char* name, uint64_t arg) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    ThreadBuffer* buffer = (t_slot.recorder == this && t_slot.recorderId == m_id)
+        ? t_slot.buffer
+        : AcquireBuffer();
+
+    const uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[index % buffer->capacity];
+    event.timestampNs = MonotonicNowNs();
+    event.arg = arg;
+    event.category = category;
+    event.phase = phase;
+
+    size_t length = 0;
+    if (name) {
+        while (length < TraceEvent::kMaxNameLength && name[length] != '\0') {
+            event.name[length] = name[length];
+            ++length;
+        }
+    }
+    event.name[length] = '\0';
+
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::SetThreadName(const char* name) {
+    t_slot.pendingName = name ? name : "";
+    if (t_slot.recorder == this && t_slot.recorderId == m_id) {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        t_slot.buffer->threadName = t_slot.pendingName;
+    }
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::AcquireBuffer() {
+    t_slot.Release();
+
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+
+    // Keep the events of exited threads until the thread limit is reached
+    ThreadBuffer* buffer = nullptr;
+    if (m_shared->buffers.size() >= m_maxThreads) {
+        for (auto& candidate : m_shared->buffers) {
+            if (candidate->retired) {
+                buffer = candidate.get();
+                buffer->head.store(0, std::memory_order_relaxed);
+                buffer->tail = 0;
+                break;
+            }
+        }
+    }
+    if (!buffer) {
+        m_shared->buffers.push_back(std::make_unique<ThreadBuffer>(m_eventsPerThread));
+        buffer = m_shared->buffers.back().get();
+    }
+
+    buffer->threadId = m_shared->nextThreadId++;
+    buffer->threadName = t_slot.pendingName;
+    buffer->retired = false;
+
+    t_slot.recorder = this;
+    t_slot.recorderId = m_id;
+    t_slot.buffer = buffer;
+    t_slot.shared = m_shared;
+    return buffer;
+}
+
+void TraceRecorder::Clear() {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    for (auto& buffer : m_shared->buffers) {
+        buffer->tail = buffer->head.load(std::memory_order_acquire);
+    }
+}
+
+size_t TraceRecorder::GetThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    return m_shared->buffers.size();
+}
+
+std::vector<TraceRecorder::ThreadTrace> TraceRecorder::Collect() const {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+
+    std::vector<ThreadTrace> traces;
+    traces.reserve(m_shared->buffers.size());
+    for (const auto& buffer : m_shared->buffers) {
+        const uint64_t capacity = buffer->capacity;
+        const uint64_t end = buffer->head.load(std::memory_order_acquire);
+        const uint64_t oldestAvailable = end > capacity ? end - capacity : 0;
+        const uint64_t begin = std::max(buffer->tail, oldestAvailable);
+
+        ThreadTrace trace;
+        trace.threadId = buffer->threadId;
+        trace.threadName = buffer->threadName;
+        trace.events.reserve(static_cast<size_t>(end - begin));
+        for (uint64_t i = begin; i < end; ++i) {
+            trace.events.push_back(buffer->events[i % capacity]);
+        }
+
+        // The owning thread keeps writing while we copy; drop any slot it
+        // may have reused before we read it
+        const uint64_t after = buffer->head.load(std::memory_order_acquire);
+        const uint64_t firstIntact = after > capacity ? after - capacity : 0;
+        uint64_t firstKept = begin;
+        if (firstIntact > begin) {
+            const uint64_t torn = std::min<uint64_t>(firstIntact - begin, trace.events.size());
+            trace.events.erase(trace.events.begin(), trace.events.begin() + static_cast<ptrdiff_t>(torn));
+            firstKept = begin + torn;
+        }
+        trace.overwritten = firstKept - buffer->tail;
+
+        if (!trace.events.empty() || !trace.threadName.empty()) {
+            traces.push_back(std::move(trace));
+        }
+    }
+    return traces;
+}
+
+std::string TraceRecorder::FormatChromeTrace() const {
+    const std::vector<ThreadTrace> traces = Collect();
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        out += first ? "\n" : ",\n";
+        first = false;
+    };
+
+    for (const auto& trace : traces) {
+        const std::string tid = std::to_string(trace.threadId);
+        if (!trace.threadName.empty()) {
+            separator();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+            AppendJsonString(out, trace.threadName.c_str());
+            out += "}}";
+        }
+
+        for (const auto& event : trace.events) {
+            separator();
+            out += "{\"name\":";
+            AppendJsonString(out, event.name);
+            out += ",\"cat\":\"";
+            out += CategoryName(event.category);
+            out += "\",\"ph\":\"";
+            out += event.phase;
+            out += "\",\"ts\":";
+            AppendMicroseconds(out, event.timestampNs);
+            out += ",\"pid\":1,\"tid\":" + tid;
+            if (event.phase == 'i') {
+                out += ",\"s\":\"t\"";
+            }
+            if (event.phase != 'E') {
+                out += ",\"args\":{\"value\":" + std::to_string(event.arg) + "}";
+            }
+            out += '}';
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool TraceRecorder::WriteChromeTrace(const std::string& path) const {
+    const std::string text = FormatChromeTrace();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    return file && file.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+} // namespace uxdi
@@ -0,0 +1,142 @@
+// Steady-state acquisition must not allocate.
+//
+// Each detector runs through DetectorManager with a listener that keeps the
+// latest frame, the way a live display does. After a warm-up the test counts
+// allocations made inside UXDI's subsystems while more frames arrive; any
+// allocation there fails the test with a per-subsystem breakdown. Allocations
+// inside mock SDK calls (Sdk) and by the test itself (Untagged) are not checked.
+
+#include <gtest/gtest.h>
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/DetectorManager.h"
+#include "uxdi/IDetectorListener.h"
+#include "ABYZDetector.h"
+#include "EmulDetector.h"
+#include "VarexDetector.h"
+#include "VieworksDetector.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace uxdi;
+
+namespace {
+
+constexpr uint64_t kWarmupFrames = 5;
+constexpr uint64_t kMeasuredFrames = 20;
+constexpr auto kFrameTimeout = std::chrono::seconds(60);
+
+class LatestFrameListener : public IDetectorListener {
+public:
+    std::atomic<uint64_t> frames{0};
+
+    void onImageReceived(const ImageData& image) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_latest = image;
+        }
+        frames.fetch_add(1, std::memory_order_release);
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override {}
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_latest = ImageData{};
+    }
+
+private:
+    std::mutex m_mutex;
+    ImageData m_latest;
+};
+
+void DestroyTestDetector(IDetector* detector) {
+    if (detector->isInitialized()) {
+        detector->shutdown();
+    }
+    delete detector;
+}
+
+std::unique_ptr<IDetector, DetectorFactoryDeleter> CreateTestDetector(const std::string& kind) {
+    IDetector* detector = nullptr;
+    if (kind == "emul") {
+        detector = new adapters::emul::EmulDetector(
+            R"({"scenario": {"name": "allocations", "actions": [)"
+            R"({"type": "set_state", "state": "acquiring"},)"
+            R"({"type": "acquire", "count": 0, "interval_ms": 5}]}})");
+    } else if (kind == "abyz") {
+        detector = new adapters::abyz::ABYZDetector();
+    } else if (kind == "varex") {
+        detector = new adapters::varex::VarexDetector();
+    } else if (kind == "vieworks") {
+        detector = new adapters::vieworks::VieworksDetector();
+    }
+
+    std::unique_ptr<IDetector, DetectorFactoryDeleter> owned(detector, DetectorFactoryDeleter{DestroyTestDetector, 0});
+    if (!owned || !owned->initialize()) {
+        return nullptr;
+    }
+    if (kind == "emul") {
+        AcquisitionParams params = owned->getAcquisitionParams();
+        params.width = 256;
+        params.height = 256;
+        if (!owned->setAcquisitionParams(params)) {
+            return nullptr;
+        }
+    }
+    return owned;
+}
+
+bool WaitForFrames(const LatestFrameListener& listener, uint64_t target) {
+    const auto deadline = std::chrono::steady_clock::now() + kFrameTimeout;
+    while (listener.frames.load(std::memory_order_acquire) < target) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class SteadyStateAllocations : public ::testing::TestWithParam<const char*> {};
+
+} // anonymous namespace
+
+TEST_P(SteadyStateAllocations, FramePathDoesNotAllocate) {
+    ASSERT_TRUE(AllocationTracker::IsHooked());
+
+    LatestFrameListener listener;
+    DetectorManager manager;
+    auto detector = CreateTestDetector(GetParam());
+    ASSERT_NE(detector, nullptr);
+    const size_t id = manager.RegisterDetector(std::move(detector));
+    ASSERT_TRUE(manager.AddListener(id, &listener));
+    ASSERT_TRUE(manager.GetDetector(id)->startAcquisition());
+
+    // Pools, metric shards and thread-locals fill up during the warm-up
+    ASSERT_TRUE(WaitForFrames(listener, kWarmupFrames));
+    const uint64_t firstFrame = listener.frames.load();
+    const AllocationSnapshot before = AllocationTracker::Current().Snapshot();
+
+    ASSERT_TRUE(WaitForFrames(listener, firstFrame + kMeasuredFrames));
+    const AllocationSnapshot delta = AllocationTracker::Current().Snapshot() - before;
+    const uint64_t frames = listener.frames.load() - firstFrame;
+
+    manager.GetDetector(id)->stopAcquisition();
+    listener.Release();
+
+    EXPECT_EQ(delta.UxdiTotal().allocations, 0u)
+        << frames << " frames, allocations by subsystem:\n" << delta.Format();
+}
+
+INSTANTIATE_TEST_SUITE_P(Adapters, SteadyStateAllocations,
+                         ::testing::Values("emul", "abyz", "varex", "vieworks"),
+                         [](const ::testing::TestParamInfo<const char*>& info) {
+                             return std::string(info.param);
+                         });
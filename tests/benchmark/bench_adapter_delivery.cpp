@@ -0,0 +1,61 @@
+#include "bench_common.h"
+#include "instant_sdk.h"
+#include "ABYZDetector.h"
+#include "VarexDetector.h"
+#include <vector>
+
+using namespace uxdi;
+using namespace uxdi::bench;
+
+// Callback-to-listener path of the callback-driven adapters: copy the
+// SDK-owned buffer, build ImageData and notify the listener. Frames come
+// from the instant SDK, so the time is adapter work only.
+
+template <typename SdkImage, typename Deliver>
+static void RunCopyAndNotify(benchmark::State& state, IDetector& detector, Deliver deliver) {
+    const auto side = static_cast<uint32_t>(state.range(0));
+    const auto bits = static_cast<uint32_t>(state.range(1));
+    const size_t bytes = FrameBytes(side, bits);
+
+    if (!detector.initialize()) {
+        state.SkipWithError("Failed to initialize detector");
+        return;
+    }
+    CountingListener listener;
+    detector.setListener(&listener);
+
+    std::vector<uint8_t> sdkBuffer(bytes, 0x5A);
+    SdkImage image{};
+    image.data = sdkBuffer.data();
+    image.width = side;
+    image.height = side;
+    image.bitDepth = bits;
+    image.dataLength = static_cast<uint32_t>(bytes);
+
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        ++image.frameNumber;
+        deliver(image);
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    detector.setListener(nullptr);
+    detector.shutdown();
+    if (listener.frames.load() != static_cast<uint64_t>(state.iterations())) {
+        state.SkipWithError("Listener missed frames");
+        return;
+    }
+    SetFrameCounters(state, state.iterations(), bytes, elapsedNs);
+}
+
+static void BM_AbyzCopyAndNotify(benchmark::State& state) {
+    adapters::abyz::ABYZDetector detector(R"({"vendor": "rayence"})");
+    RunCopyAndNotify<AbyzImage>(state, detector, DeliverAbyzFrame);
+}
+BENCHMARK(BM_AbyzCopyAndNotify)->Apply(FrameSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_VarexCopyAndNotify(benchmark::State& state) {
+    adapters::varex::VarexDetector detector;
+    RunCopyAndNotify<VarexImage>(state, detector, DeliverVarexFrame);
+}
+BENCHMARK(BM_VarexCopyAndNotify)->Apply(FrameSizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include "uxdi/IDetector.h"
+#include "uxdi/IDetectorListener.h"
+#include <atomic>
+#include <cstdint>
+
+// Windows macro workaround - ERROR conflicts with DetectorState::ERROR
+#ifdef ERROR
+#undef ERROR
+#endif
+
+namespace uxdi::bench {
+
+// Square frame sides and bit depths swept by the frame-size benchmarks
+inline void FrameSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"side", "bits"});
+    for (int64_t side : {512, 1024, 2048, 4096}) {
+        for (int64_t bits : {8, 16}) {
+            b->Args({side, bits});
+        }
+    }
+}
+
+inline size_t FrameBytes(int64_t side, int64_t bits) {
+    return static_cast<size_t>(side) * static_cast<size_t>(side) * (bits > 8 ? 2 : 1);
+}
+
+/**
+ * @brief Report frames/s, ns/frame and bytes/s for `frames` processed frames
+ *
+ * ns_per_frame is a plain value, so the console and JSON show the same
+ * number: the wall-clock time of the timed loop (elapsedNs, measured with
+ * MonotonicNowNs()) per frame.
+ */
+inline void SetFrameCounters(benchmark::State& state, int64_t frames, size_t frameBytes, uint64_t elapsedNs) {
+    state.SetItemsProcessed(frames);
+    state.SetBytesProcessed(frames * static_cast<int64_t>(frameBytes));
+    state.counters["frames_per_second"] = benchmark::Counter(
+        static_cast<double>(frames), benchmark::Counter::kIsRate);
+    state.counters["ns_per_frame"] = frames > 0 ? static_cast<double>(elapsedNs) / static_cast<double>(frames) : 0.0;
+}
+
+/**
+ * @brief Listener that only counts frames
+ */
+class CountingListener : public IDetectorListener {
+public:
+    std::atomic<uint64_t> frames{0};
+
+    void onImageReceived(const ImageData& image) override {
+        benchmark::DoNotOptimize(image.data.get());
+        frames.fetch_add(1, std::memory_order_relaxed);
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override {}
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+};
+
+/**
+ * @brief Inert detector for exercising DetectorManager
+ */
+class NullDetector : public IDetector {
+public:
+    bool initialize() override { return true; }
+    bool shutdown() override { return true; }
+    bool isInitialized() const override { return true; }
+    DetectorInfo getDetectorInfo() const override { return DetectorInfo{}; }
+    std::string getVendorName() const override { return "Null"; }
+    std::string getModelName() const override { return "Null"; }
+    DetectorState getState() const override { return DetectorState::READY; }
+    std::string getStateString() const override { return "READY"; }
+    bool setAcquisitionParams(const AcquisitionParams&) override { return true; }
+    AcquisitionParams getAcquisitionParams() const override { return AcquisitionParams{}; }
+    void setListener(IDetectorListener* listener) override { listener_ = listener; }
+    IDetectorListener* getListener() const override { return listener_; }
+    bool startAcquisition() override { return true; }
+    bool stopAcquisition() override { return true; }
+    bool isAcquiring() const override { return false; }
+    std::shared_ptr<IDetectorSynchronous> getSynchronousInterface() override { return nullptr; }
+    ErrorInfo getLastError() const override { return ErrorInfo{}; }
+    void clearError() override {}
+
+private:
+    IDetectorListener* listener_ = nullptr;
+};
+
+} // namespace uxdi::bench
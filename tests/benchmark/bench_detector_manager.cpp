@@ -0,0 +1,78 @@
+#include "bench_common.h"
+#include "uxdi/DetectorManager.h"
+#include "uxdi/FrameDispatcher.h"
+#include <memory>
+#include <vector>
+
+using namespace uxdi;
+using namespace uxdi::bench;
+
+// Lookups and dispatch do not touch pixels, so these sweep thread and
+// listener counts rather than frame sizes.
+
+namespace {
+
+constexpr size_t kManagedDetectors = 16;
+
+struct SharedManager {
+    std::vector<std::unique_ptr<NullDetector>> detectors;
+    DetectorManager manager;  // Declared last: destroyed before the detectors it borrows
+    std::vector<size_t> ids;
+
+    SharedManager() {
+        for (size_t i = 0; i < kManagedDetectors; ++i) {
+            detectors.push_back(std::make_unique<NullDetector>());
+            ids.push_back(manager.RegisterDetector(
+                std::unique_ptr<IDetector, DetectorFactoryDeleter>(detectors.back().get(), DetectorFactoryDeleter{})));
+        }
+    }
+};
+
+SharedManager& GetSharedManager() {
+    static SharedManager shared;
+    return shared;
+}
+
+} // anonymous namespace
+
+static void BM_DetectorManagerLookup(benchmark::State& state) {
+    SharedManager& shared = GetSharedManager();
+    size_t next = static_cast<size_t>(state.thread_index());
+
+    for (auto _ : state) {
+        const size_t id = shared.ids[next++ % kManagedDetectors];
+        benchmark::DoNotOptimize(shared.manager.GetDetector(id));
+        benchmark::DoNotOptimize(shared.manager.GetState(id));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DetectorManagerLookup)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ListenerDispatch(benchmark::State& state) {
+    const auto listenerCount = static_cast<size_t>(state.range(0));
+    FrameDispatcher dispatcher;
+    std::vector<CountingListener> listeners(listenerCount);
+    for (auto& listener : listeners) {
+        dispatcher.AddListener(&listener);
+    }
+
+    ImageData image;
+    image.width = 1024;
+    image.height = 1024;
+    image.bitDepth = 16;
+    image.dataLength = FrameBytes(1024, 16);
+    image.data = std::shared_ptr<uint8_t[]>(new uint8_t[image.dataLength]);
+
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        const uint64_t now = MonotonicNowNs();
+        image.latency.sdkDeliveryNs = now;
+        image.latency.adapterConvertedNs = now;
+        image.latency.dispatchNs = now;
+        dispatcher.onImageReceived(image);
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    SetFrameCounters(state, state.iterations(), image.dataLength, elapsedNs);
+}
+BENCHMARK(BM_ListenerDispatch)->ArgName("listeners")->RangeMultiplier(2)->Range(1, 8);
@@ -0,0 +1,194 @@
+#include "bench_common.h"
+#include "ScenarioEngine.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace uxdi;
+using namespace uxdi::bench;
+using uxdi::adapters::emul::ScenarioEngine;
+
+// Endless acquire action: every GetNextFrame() call generates a frame
+static const char* kEndlessAcquire =
+    R"({"name": "bench", "actions": [{"type": "acquire", "count": 0}]})";
+
+static void BM_ScenarioEngineGenerateFrame(benchmark::State& state) {
+    const auto side = static_cast<uint32_t>(state.range(0));
+    const auto bits = static_cast<uint32_t>(state.range(1));
+
+    ScenarioEngine engine;
+    if (!engine.LoadScenario(kEndlessAcquire)) {
+        state.SkipWithError("Failed to load scenario");
+        return;
+    }
+    engine.SetFrameConfig(side, side, bits);
+    engine.Start();
+
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        auto frame = engine.GetNextFrame();
+        benchmark::DoNotOptimize(frame);
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    SetFrameCounters(state, state.iterations(), FrameBytes(side, bits), elapsedNs);
+}
+BENCHMARK(BM_ScenarioEngineGenerateFrame)->Apply(FrameSizes)->Unit(benchmark::kMicrosecond);
+
+// Same, with threads polling GetCurrentState()/IsComplete() as fast as they
+// can, like a UI status loop. Status is published lock-free, so CPU time per
+// frame should match the unpolled run (wall time too, given spare cores)
+static void BM_ScenarioEngineGenerateFramePolled(benchmark::State& state) {
+    const auto side = static_cast<uint32_t>(state.range(0));
+
+    ScenarioEngine engine;
+    if (!engine.LoadScenario(kEndlessAcquire)) {
+        state.SkipWithError("Failed to load scenario");
+        return;
+    }
+    engine.SetFrameConfig(side, side, 16);
+    engine.Start();
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> polls{0};
+    std::vector<std::thread> pollers;
+    for (int i = 0; i < 2; ++i) {
+        pollers.emplace_back([&] {
+            uint64_t count = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                benchmark::DoNotOptimize(engine.GetCurrentState());
+                benchmark::DoNotOptimize(engine.IsComplete());
+                ++count;
+            }
+            polls += count;
+        });
+    }
+
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        auto frame = engine.GetNextFrame();
+        benchmark::DoNotOptimize(frame);
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    done = true;
+    for (auto& poller : pollers) {
+        poller.join();
+    }
+    SetFrameCounters(state, state.iterations(), FrameBytes(side, 16), elapsedNs);
+    state.counters["polls"] = static_cast<double>(polls.load());
+}
+BENCHMARK(BM_ScenarioEngineGenerateFramePolled)->ArgName("side")->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+// 16-bit frames with per-frame variation and noise from the "generator" settings
+static void BM_ScenarioEngineGeneratorModes(benchmark::State& state, const char* generator) {
+    const auto side = static_cast<uint32_t>(state.range(0));
+    const std::string scenario = std::string(R"({"name": "bench", "generator": )") + generator +
+                                 R"(, "actions": [{"type": "acquire", "count": 0}]})";
+
+    ScenarioEngine engine;
+    if (!engine.LoadScenario(scenario)) {
+        state.SkipWithError("Failed to load scenario");
+        return;
+    }
+    engine.SetFrameConfig(side, side, 16);
+    engine.Start();
+    engine.GetNextFrame();  // Render the template outside the timed loop
+
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        auto frame = engine.GetNextFrame();
+        benchmark::DoNotOptimize(frame);
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    SetFrameCounters(state, state.iterations(), FrameBytes(side, 16), elapsedNs);
+}
+BENCHMARK_CAPTURE(BM_ScenarioEngineGeneratorModes, offset, R"({"variation": "offset"})")
+    ->ArgName("side")->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ScenarioEngineGeneratorModes, roll, R"({"variation": "roll"})")
+    ->ArgName("side")->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ScenarioEngineGeneratorModes, poisson, R"({"variation": "offset", "noise": "poisson", "noise_level": 1})")
+    ->ArgName("side")->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ScenarioEngineGeneratorModes, phantom, R"({"pattern": "phantom"})")
+    ->ArgName("side")->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// Phantom synthesis alone: a new exposure forces the template to be rendered again
+static void BM_ScenarioEnginePhantomSynthesis(benchmark::State& state) {
+    const auto side = static_cast<uint32_t>(state.range(0));
+
+    ScenarioEngine engine;
+    if (!engine.LoadScenario(R"({"name": "bench", "generator": {"pattern": "phantom", "noise": "none"},)"
+                             R"( "actions": [{"type": "acquire", "count": 0}]})")) {
+        state.SkipWithError("Failed to load scenario");
+        return;
+    }
+    engine.SetFrameConfig(side, side, 16);
+    engine.Start();
+
+    double exposureMs = 100.0;
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        exposureMs = exposureMs == 100.0 ? 50.0 : 100.0;
+        engine.SetExposure(exposureMs, 1.0);
+        auto frame = engine.GetNextFrame();
+        benchmark::DoNotOptimize(frame);
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    SetFrameCounters(state, state.iterations(), FrameBytes(side, 16), elapsedNs);
+}
+BENCHMARK(BM_ScenarioEnginePhantomSynthesis)->ArgName("side")->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// Long generated soak scenarios: one JSON pass regardless of the action count
+static void BM_ScenarioEngineLoadScenario(benchmark::State& state) {
+    const auto actions = static_cast<size_t>(state.range(0));
+    std::string scenario = R"({"name": "soak", "generator": {"variation": "offset"}, "actions": [)";
+    for (size_t i = 0; i < actions; ++i) {
+        scenario += i ? ",\n" : "\n";
+        scenario += (i % 2) ? R"({"type": "wait", "duration_ms": 5})"
+                            : R"({"type": "acquire", "count": 10, "interval_ms": 16.667, "pacing": "skip"})";
+    }
+    scenario += "]}";
+
+    ScenarioEngine engine;
+    for (auto _ : state) {
+        if (!engine.LoadScenario(scenario)) {
+            state.SkipWithError("Failed to load scenario");
+            return;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * scenario.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * actions));
+}
+BENCHMARK(BM_ScenarioEngineLoadScenario)->ArgName("actions")->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Nested blocks around one-frame acquires: the per-frame cost of stepping the
+// compiled program (loop ends, sweep updates, branch picks) on a tiny frame;
+// seeded so every run takes the same branches
+static void BM_ScenarioEngineNestedBlocks(benchmark::State& state) {
+    static const char* kNested = R"({"name": "nested", "seed": 1, "actions": [
+        {"type": "repeat", "count": 0, "actions": [
+            {"type": "sweep", "parameter": "kv", "from": 40, "to": 120, "step": 10, "actions": [
+                {"type": "random", "branches": [
+                    {"weight": 3, "actions": [{"type": "acquire", "count": 1}]},
+                    {"weight": 1, "actions": [{"type": "set_state", "state": "acquiring"},
+                                              {"type": "acquire", "count": 1}]}]}]}]}]})";
+
+    ScenarioEngine engine;
+    if (!engine.LoadScenario(kNested)) {
+        state.SkipWithError("Failed to load scenario");
+        return;
+    }
+    engine.SetFrameConfig(8, 8, 16);
+    engine.Start();
+
+    for (auto _ : state) {
+        auto frame = engine.GetNextFrame();
+        benchmark::DoNotOptimize(frame);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ScenarioEngineNestedBlocks)->Unit(benchmark::kNanosecond);
@@ -0,0 +1,61 @@
+#include "bench_common.h"
+#include "EmulDetector.h"
+#include "uxdi/IDetectorSynchronous.h"
+#include <thread>
+#include <vector>
+
+using namespace uxdi;
+using namespace uxdi::bench;
+
+// Synchronous acquireFrames() on the emulator with an endless, unpaced
+// scenario. The emulator's acquisition thread draws from the same scenario
+// while the sync interface is used, so this measures the sync path as it
+// behaves today, contention included. The emulator always produces 16-bit
+// frames, so only the resolution is swept.
+
+static const char* kEndlessScenario = R"({"scenario": {"name": "bench", "actions": [
+    {"type": "set_state", "state": "acquiring"},
+    {"type": "acquire", "count": 0}
+]}})";
+
+static void BM_EmulAcquireFrames(benchmark::State& state) {
+    const auto side = static_cast<uint32_t>(state.range(0));
+    const uint32_t batch = 8;
+
+    adapters::emul::EmulDetector detector(kEndlessScenario);
+    AcquisitionParams params = detector.getAcquisitionParams();
+    params.width = side;
+    params.height = side;
+    if (!detector.initialize() || !detector.setAcquisitionParams(params)) {
+        state.SkipWithError("Failed to configure emulator");
+        return;
+    }
+
+    // acquireFrames() restarts acquisition unless the scenario already
+    // reports ACQUIRING, so wait for the set_state action before timing
+    if (!detector.startAcquisition()) {
+        state.SkipWithError("Failed to start acquisition");
+        return;
+    }
+    while (detector.getState() != DetectorState::ACQUIRING) {
+        std::this_thread::yield();
+    }
+
+    auto sync = detector.getSynchronousInterface();
+    std::vector<ImageData> frames;
+    const uint64_t startNs = MonotonicNowNs();
+    for (auto _ : state) {
+        if (!sync->acquireFrames(batch, frames, 10000)) {
+            state.SkipWithError(("acquireFrames failed: " + detector.getLastError().message).c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(frames.data());
+    }
+    const uint64_t elapsedNs = MonotonicNowNs() - startNs;
+
+    detector.stopAcquisition();
+    detector.shutdown();
+    SetFrameCounters(state, state.iterations() * batch, FrameBytes(side, 16), elapsedNs);
+}
+BENCHMARK(BM_EmulAcquireFrames)->ArgName("side")->Arg(512)->Arg(1024)->Arg(2048)->Arg(4096)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,160 @@
+#include "instant_sdk.h"
+#include <cstring>
+
+namespace {
+
+template <typename ImageCallback>
+struct InstantDetector {
+    ImageCallback imageCallback = nullptr;
+    void* context = nullptr;
+    bool acquiring = false;
+};
+
+// Adapters under benchmark are created one at a time
+InstantDetector<AbyzImageCallback> g_abyz;
+InstantDetector<VarexImageCallback> g_varex;
+
+template <typename Info>
+void FillInfo(Info& info) {
+    std::memset(&info, 0, sizeof(info));
+    std::strncpy(info.model, "INSTANT", sizeof(info.model) - 1);
+    std::strncpy(info.serialNumber, "BENCH-0001", sizeof(info.serialNumber) - 1);
+    std::strncpy(info.firmwareVersion, "0.0.0", sizeof(info.firmwareVersion) - 1);
+    info.maxWidth = 4096;
+    info.maxHeight = 4096;
+    info.bitDepth = 16;
+}
+
+} // anonymous namespace
+
+namespace uxdi::bench {
+
+bool DeliverAbyzFrame(const AbyzImage& image) {
+    if (!g_abyz.imageCallback) {
+        return false;
+    }
+    g_abyz.imageCallback(&image, g_abyz.context);
+    return true;
+}
+
+bool DeliverVarexFrame(const VarexImage& image) {
+    if (!g_varex.imageCallback) {
+        return false;
+    }
+    g_varex.imageCallback(&image, g_varex.context);
+    return true;
+}
+
+} // namespace uxdi::bench
+
+//=============================================================================
+// ABYZ SDK
+//=============================================================================
+
+extern "C" {
+
+AbyzError Abyz_Initialize() { return ABYZ_OK; }
+AbyzError Abyz_Shutdown() { return ABYZ_OK; }
+
+AbyzError Abyz_CreateDetector(const char*, AbyzHandle* outHandle) {
+    g_abyz = {};
+    *outHandle = &g_abyz;
+    return ABYZ_OK;
+}
+
+AbyzError Abyz_DestroyDetector(AbyzHandle) {
+    g_abyz = {};
+    return ABYZ_OK;
+}
+
+AbyzError Abyz_InitializeDetector(AbyzHandle) { return ABYZ_OK; }
+AbyzError Abyz_ShutdownDetector(AbyzHandle) { return ABYZ_OK; }
+
+AbyzError Abyz_GetDetectorInfo(AbyzHandle, AbyzDetectorInfo* outInfo) {
+    FillInfo(*outInfo);
+    outInfo->vendor = ABYZ_VENDOR_RAYENCE;
+    std::strncpy(outInfo->vendorName, "Instant", sizeof(outInfo->vendorName) - 1);
+    return ABYZ_OK;
+}
+
+AbyzError Abyz_GetState(AbyzHandle, AbyzState* outState) {
+    *outState = g_abyz.acquiring ? ABYZ_STATE_ACQUIRING : ABYZ_STATE_READY;
+    return ABYZ_OK;
+}
+
+AbyzError Abyz_SetAcquisitionParams(AbyzHandle, const AbyzAcqParams*) { return ABYZ_OK; }
+AbyzError Abyz_GetAcquisitionParams(AbyzHandle, AbyzAcqParams*) { return ABYZ_OK; }
+
+AbyzError Abyz_RegisterCallbacks(AbyzHandle, AbyzImageCallback imageCallback,
+                                 AbyzStateCallback, AbyzErrorCallback, void* userContext) {
+    g_abyz.imageCallback = imageCallback;
+    g_abyz.context = userContext;
+    return ABYZ_OK;
+}
+
+AbyzError Abyz_StartAcquisition(AbyzHandle) { g_abyz.acquiring = true; return ABYZ_OK; }
+AbyzError Abyz_StopAcquisition(AbyzHandle) { g_abyz.acquiring = false; return ABYZ_OK; }
+
+AbyzError Abyz_IsAcquiring(AbyzHandle, int* outAcquiring) {
+    *outAcquiring = g_abyz.acquiring ? 1 : 0;
+    return ABYZ_OK;
+}
+
+const char* Abyz_ErrorToString(AbyzError) { return "ABYZ_INSTANT"; }
+const char* Abyz_StateToString(AbyzState) { return "ABYZ_INSTANT"; }
+const char* Abyz_VendorToString(AbyzVendor) { return "Instant"; }
+
+//=============================================================================
+// Varex SDK
+//=============================================================================
+
+VarexError Varex_Initialize() { return VAREX_OK; }
+VarexError Varex_Shutdown() { return VAREX_OK; }
+
+VarexError Varex_CreateDetector(const char*, VarexHandle* outHandle) {
+    g_varex = {};
+    *outHandle = &g_varex;
+    return VAREX_OK;
+}
+
+VarexError Varex_DestroyDetector(VarexHandle) {
+    g_varex = {};
+    return VAREX_OK;
+}
+
+VarexError Varex_InitializeDetector(VarexHandle) { return VAREX_OK; }
+VarexError Varex_ShutdownDetector(VarexHandle) { return VAREX_OK; }
+
+VarexError Varex_GetDetectorInfo(VarexHandle, VarexDetectorInfo* outInfo) {
+    FillInfo(*outInfo);
+    std::strncpy(outInfo->vendor, "Instant", sizeof(outInfo->vendor) - 1);
+    return VAREX_OK;
+}
+
+VarexError Varex_GetState(VarexHandle, VarexState* outState) {
+    *outState = g_varex.acquiring ? VAREX_STATE_ACQUIRING : VAREX_STATE_READY;
+    return VAREX_OK;
+}
+
+VarexError Varex_SetAcquisitionParams(VarexHandle, const VarexAcqParams*) { return VAREX_OK; }
+VarexError Varex_GetAcquisitionParams(VarexHandle, VarexAcqParams*) { return VAREX_OK; }
+
+VarexError Varex_RegisterCallbacks(VarexHandle, VarexImageCallback imageCallback,
+                                   VarexStateCallback, VarexErrorCallback, void* userContext) {
+    g_varex.imageCallback = imageCallback;
+    g_varex.context = userContext;
+    return VAREX_OK;
+}
+
+VarexError Varex_StartAcquisition(VarexHandle) { g_varex.acquiring = true; return VAREX_OK; }
+VarexError Varex_StopAcquisition(VarexHandle) { g_varex.acquiring = false; return VAREX_OK; }
+
+VarexError Varex_IsAcquiring(VarexHandle, int* outAcquiring) {
+    *outAcquiring = g_varex.acquiring ? 1 : 0;
+    return VAREX_OK;
+}
+
+const char* Varex_ErrorToString(VarexError) { return "VAREX_INSTANT"; }
+const char* Varex_StateToString(VarexState) { return "VAREX_INSTANT"; }
+
+} // extern "C"
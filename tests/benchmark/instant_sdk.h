@@ -0,0 +1,26 @@
+#pragma once
+
+// Instant vendor SDKs for benchmarking
+//
+// Link-compatible replacements for the ABYZ and Varex mock SDKs that never
+// generate frames on their own. The benchmark hands a prebuilt SDK image to
+// the callback an adapter registered, so only adapter code is timed.
+
+#include "abyz_sdk.h"
+#include "varex_sdk.h"
+
+namespace uxdi::bench {
+
+/**
+ * @brief Deliver an image through the most recently registered ABYZ image callback
+ * @return false if no detector has registered callbacks
+ */
+bool DeliverAbyzFrame(const AbyzImage& image);
+
+/**
+ * @brief Deliver an image through the most recently registered Varex image callback
+ * @return false if no detector has registered callbacks
+ */
+bool DeliverVarexFrame(const VarexImage& image);
+
+} // namespace uxdi::bench
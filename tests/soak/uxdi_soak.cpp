@@ -0,0 +1,520 @@
+// uxdi_soak - sustained-load harness
+//
+// Runs several detectors concurrently for a long period and checks that the
+// stack keeps up: frameNumber continuity (dropped, duplicated, out-of-order),
+// inter-frame jitter, resident memory growth and thread count over time.
+// Headless; exits non-zero when a check fails so it can gate a deployment.
+
+#include "uxdi/AllocationTracker.h"
+#include "uxdi/DetectorManager.h"
+#include "uxdi/FrameSequenceTracker.h"
+#include "uxdi/IDetectorListener.h"
+#include "uxdi/ProcessStats.h"
+#include "uxdi/TraceRecorder.h"
+#include "uxdi/Types.h"
+#include "ABYZDetector.h"
+#include "EmulDetector.h"
+#include "VarexDetector.h"
+#include "VieworksDetector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Windows macro workaround - ERROR conflicts with DetectorState::ERROR
+#ifdef ERROR
+#undef ERROR
+#endif
+
+using namespace uxdi;
+
+namespace {
+
+// ============================================================================
+// Options
+// ============================================================================
+
+struct DetectorSpec {
+    std::string kind;   // emul, abyz, varex, vieworks
+    double fps = 0.0;   // Target rate; 0 = adapter default
+};
+
+struct SoakOptions {
+    double durationSec = 60.0;
+    double reportSec = 10.0;
+    double drainSec = 5.0;
+    uint32_t emulSide = 512;
+    uint64_t seed = 0;  // Emulator scenario seed; 0 = nondeterministic
+    std::vector<DetectorSpec> detectors;
+    std::string csvPath;
+    std::string tracePath;
+    double maxRssGrowthMb = 64.0;
+    int maxThreadGrowth = 0;
+    bool allowDrops = false;
+    bool farm = false;
+};
+
+void PrintUsage() {
+    std::cout <<
+        "Usage: uxdi_soak [options]\n"
+        "\n"
+        "  --detector <kind>[:<fps>[x<n>]]\n"
+        "                              Add a detector, or n alike (repeatable); kind\n"
+        "                              is emul, abyz, varex or vieworks. Mock SDKs run\n"
+        "                              at their native rate without <fps> or with 0.\n"
+        "                              Default: one of each, emul at 30 fps\n"
+        "  --farm                      Run emulated detectors on the shared emulator\n"
+        "                              farm instead of a thread each\n"
+        "  --duration <time>           Run length, e.g. 90, 30s, 15m, 8h (default 60s)\n"
+        "  --report <time>             Report interval (default 10s)\n"
+        "  --emul-size <side>          Emulator frame side in pixels (default 512)\n"
+        "  --seed <n>                  Seed emulator i with n + i so runs are\n"
+        "                              reproducible (default: random)\n"
+        "  --csv <file>                Append one row per detector per report\n"
+        "  --trace <file>              Write the last events of every thread as\n"
+        "                              Chrome trace JSON at the end (needs a build\n"
+        "                              with -DUXDI_ENABLE_TRACING=ON)\n"
+        "  --max-rss-growth <MB>       Fail if RSS grows more after the first\n"
+        "                              report (default 64)\n"
+        "  --max-thread-growth <n>     Fail if more threads remain after stop\n"
+        "                              than before start (default 0)\n"
+        "  --allow-drops               Report continuity errors without failing\n";
+}
+
+// Seconds, with optional s/m/h suffix; negative on parse error
+double ParseDuration(const std::string& text) {
+    try {
+        size_t used = 0;
+        double value = std::stod(text, &used);
+        const std::string suffix = text.substr(used);
+        if (suffix.empty() || suffix == "s") {
+            return value;
+        }
+        if (suffix == "m") {
+            return value * 60.0;
+        }
+        if (suffix == "h") {
+            return value * 3600.0;
+        }
+    } catch (const std::exception&) {
+    }
+    return -1.0;
+}
+
+// <kind>[:<fps>[x<count>]], e.g. emul:30x32 for 32 emulators at 30 fps
+bool ParseDetectorSpec(const std::string& text, DetectorSpec& spec, int& count) {
+    const size_t colon = text.find(':');
+    spec.kind = text.substr(0, colon);
+    spec.fps = 0.0;
+    count = 1;
+    if (colon != std::string::npos) {
+        std::string rate = text.substr(colon + 1);
+        try {
+            if (const size_t times = rate.find('x'); times != std::string::npos) {
+                count = std::stoi(rate.substr(times + 1));
+                rate.resize(times);
+            }
+            spec.fps = std::stod(rate);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return count > 0 && (spec.kind == "emul" || spec.kind == "abyz" ||
+                         spec.kind == "varex" || spec.kind == "vieworks");
+}
+
+bool ParseOptions(int argc, char* argv[], SoakOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--allow-drops") {
+            options.allowDrops = true;
+        } else if (arg == "--farm") {
+            options.farm = true;
+        } else if (arg == "--detector" && hasValue) {
+            DetectorSpec spec;
+            int count = 0;
+            if (!ParseDetectorSpec(argv[++i], spec, count)) {
+                std::cerr << "Invalid detector: " << argv[i] << std::endl;
+                return false;
+            }
+            options.detectors.insert(options.detectors.end(), count, spec);
+        } else if (arg == "--duration" && hasValue) {
+            options.durationSec = ParseDuration(argv[++i]);
+        } else if (arg == "--report" && hasValue) {
+            options.reportSec = ParseDuration(argv[++i]);
+        } else if (arg == "--emul-size" && hasValue) {
+            options.emulSide = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::stoull(argv[++i]);
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--max-rss-growth" && hasValue) {
+            options.maxRssGrowthMb = std::stod(argv[++i]);
+        } else if (arg == "--max-thread-growth" && hasValue) {
+            options.maxThreadGrowth = std::stoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+
+    if (options.durationSec <= 0.0 || options.reportSec <= 0.0) {
+        std::cerr << "Invalid duration or report interval" << std::endl;
+        return false;
+    }
+    if (options.detectors.empty()) {
+        options.detectors = {{"emul", 30.0}, {"abyz", 0.0}, {"varex", 0.0}, {"vieworks", 0.0}};
+    }
+    return true;
+}
+
+// ============================================================================
+// Detectors
+// ============================================================================
+
+class SoakListener : public IDetectorListener {
+public:
+    FrameSequenceTracker tracker;
+    std::atomic<uint64_t> errors{0};
+
+    void onImageReceived(const ImageData& image) override {
+        tracker.Record(image.frameNumber, MonotonicNowNs());
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override {
+        errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+};
+
+struct SoakDetector {
+    DetectorSpec spec;
+    std::string label;
+    size_t id = 0;
+    std::unique_ptr<SoakListener> listener;
+    uint64_t lastReceived = 0;
+};
+
+void DestroySoakDetector(IDetector* detector) {
+    if (detector->isInitialized()) {
+        detector->shutdown();
+    }
+    delete detector;
+}
+
+std::string EmulScenario(double fps, bool farm, uint64_t seed) {
+    const double intervalMs = fps > 0.0 ? 1000.0 / fps : 0.0;
+    const std::string seedField = seed != 0 ? R"("seed": )" + std::to_string(seed) + ", " : std::string{};
+    return std::string(farm ? R"({"farm": true, )" : "{") +
+           R"("scenario": {"name": "soak", )" + seedField + R"("actions": [)"
+           R"({"type": "set_state", "state": "acquiring"},)"
+           R"({"type": "acquire", "count": 0, "interval_ms": )" + std::to_string(intervalMs) + "}]}}";
+}
+
+std::string MockSdkConfig(double fps) {
+    return fps > 0.0 ? R"({"frame_rate": )" + std::to_string(fps) + "}" : std::string{};
+}
+
+std::unique_ptr<IDetector, DetectorFactoryDeleter> CreateSoakDetector(const DetectorSpec& spec,
+                                                                      const SoakOptions& options,
+                                                                      uint64_t seed) {
+    IDetector* detector = nullptr;
+    if (spec.kind == "emul") {
+        detector = new adapters::emul::EmulDetector(EmulScenario(spec.fps, options.farm, seed));
+    } else if (spec.kind == "abyz") {
+        detector = new adapters::abyz::ABYZDetector(MockSdkConfig(spec.fps));
+    } else if (spec.kind == "varex") {
+        detector = new adapters::varex::VarexDetector(MockSdkConfig(spec.fps));
+    } else if (spec.kind == "vieworks") {
+        detector = new adapters::vieworks::VieworksDetector(MockSdkConfig(spec.fps));
+    }
+
+    std::unique_ptr<IDetector, DetectorFactoryDeleter> owned(detector, DetectorFactoryDeleter{DestroySoakDetector, 0});
+    if (!owned || !owned->initialize()) {
+        return nullptr;
+    }
+
+    if (spec.kind == "emul") {
+        AcquisitionParams params = owned->getAcquisitionParams();
+        params.width = options.emulSide;
+        params.height = options.emulSide;
+        if (!owned->setAcquisitionParams(params)) {
+            return nullptr;
+        }
+    }
+    return owned;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+double ToMb(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+double ToMs(double ns) {
+    return ns / 1e6;
+}
+
+std::atomic<bool> g_interrupted{false};
+
+void OnSignal(int) {
+    g_interrupted = true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
+        PrintUsage();
+        return 0;
+    }
+
+    SoakOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    std::ofstream csv;
+    if (!options.csvPath.empty()) {
+        const bool exists = std::ifstream(options.csvPath).good();
+        csv.open(options.csvPath, std::ios::app);
+        if (!csv) {
+            std::cerr << "Cannot open " << options.csvPath << std::endl;
+            return 2;
+        }
+        if (!exists) {
+            csv << "elapsed_s,detector,received,fps,dropped,duplicated,out_of_order,errors,"
+                   "interval_p50_ms,interval_p99_ms,interval_max_ms,interval_stddev_ms,rss_mb,threads\n";
+        }
+    }
+
+    // Listeners must outlive the manager's detectors
+    std::vector<SoakDetector> detectors;
+    DetectorManager manager;
+    uint64_t nextSeed = options.seed;
+    for (const auto& spec : options.detectors) {
+        // Each emulator gets its own seed so their frames differ
+        const uint64_t seed = options.seed != 0 && spec.kind == "emul" ? nextSeed++ : 0;
+        auto detector = CreateSoakDetector(spec, options, seed);
+        if (!detector) {
+            std::cerr << "Failed to create " << spec.kind << " detector" << std::endl;
+            return 1;
+        }
+
+        SoakDetector entry;
+        entry.spec = spec;
+        entry.listener = std::make_unique<SoakListener>();
+        entry.id = manager.RegisterDetector(std::move(detector));
+        entry.label = spec.kind + "#" + std::to_string(entry.id);
+        manager.AddListener(entry.id, entry.listener.get());
+        detectors.push_back(std::move(entry));
+    }
+
+    const ProcessStats baseline = SampleProcessStats();
+
+    if (!options.tracePath.empty()) {
+#if !defined(UXDI_ENABLE_TRACING)
+        std::cerr << "Built without UXDI_ENABLE_TRACING; the trace will be empty" << std::endl;
+#endif
+        TraceRecorder::Global().SetEnabled(true);
+    }
+
+    for (const auto& entry : detectors) {
+        if (!manager.GetDetector(entry.id)->startAcquisition()) {
+            std::cerr << "Failed to start " << entry.label << ": "
+                      << manager.GetDetector(entry.id)->getLastError().message << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Soaking " << detectors.size() << " detector(s) for " << options.durationSec
+              << " s, baseline RSS " << ToMb(baseline.residentBytes) << " MB, "
+              << baseline.threadCount << " threads" << std::endl;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto lastReport = start;
+    ProcessStats firstReport{};
+    AllocationSnapshot firstReportAllocations;
+    AllocationSnapshot lastReportAllocations;
+    uint64_t maxRssGrowthBytes = 0;
+    uint32_t maxThreads = baseline.threadCount;
+    bool reported = false;
+
+    while (!g_interrupted.load()) {
+        const auto deadline = lastReport + std::chrono::duration<double>(options.reportSec);
+        const auto end = start + std::chrono::duration<double>(options.durationSec);
+        const auto wake = std::min(deadline, end);
+        while (!g_interrupted.load() && std::chrono::steady_clock::now() < wake) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - start).count();
+        const double window = std::chrono::duration<double>(now - lastReport).count();
+        lastReport = now;
+
+        const ProcessStats process = SampleProcessStats();
+        lastReportAllocations = AllocationTracker::Current().Snapshot();
+        if (!reported) {
+            firstReport = process;
+            firstReportAllocations = lastReportAllocations;
+            reported = true;
+        } else if (process.residentBytes > firstReport.residentBytes) {
+            maxRssGrowthBytes = std::max(maxRssGrowthBytes, process.residentBytes - firstReport.residentBytes);
+        }
+        maxThreads = std::max(maxThreads, process.threadCount);
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "[%8.1fs] rss %.1f MB (%+.1f)  threads %u (%+d)",
+                      elapsed, ToMb(process.residentBytes),
+                      ToMb(process.residentBytes) - ToMb(baseline.residentBytes),
+                      process.threadCount,
+                      static_cast<int>(process.threadCount) - static_cast<int>(baseline.threadCount));
+        std::cout << line << std::endl;
+
+        for (auto& entry : detectors) {
+            const FrameSequenceStats stats = entry.listener->tracker.GetStats();
+            const double fps = window > 0.0 ? static_cast<double>(stats.received - entry.lastReceived) / window : 0.0;
+            entry.lastReceived = stats.received;
+            const uint64_t errors = entry.listener->errors.load();
+
+            std::snprintf(line, sizeof(line),
+                          "  %-12s %10llu frames %8.1f fps  drop %llu dup %llu ooo %llu err %llu  "
+                          "interval p50 %.2f p99 %.2f max %.2f sd %.2f ms",
+                          entry.label.c_str(), static_cast<unsigned long long>(stats.received), fps,
+                          static_cast<unsigned long long>(stats.dropped),
+                          static_cast<unsigned long long>(stats.duplicated),
+                          static_cast<unsigned long long>(stats.outOfOrder),
+                          static_cast<unsigned long long>(errors),
+                          ToMs(static_cast<double>(stats.interval.p50Ns)),
+                          ToMs(static_cast<double>(stats.interval.p99Ns)),
+                          ToMs(static_cast<double>(stats.interval.maxNs)),
+                          ToMs(stats.intervalStdDevNs));
+            std::cout << line << std::endl;
+
+            if (csv) {
+                csv << elapsed << ',' << entry.label << ',' << stats.received << ',' << fps << ','
+                    << stats.dropped << ',' << stats.duplicated << ',' << stats.outOfOrder << ','
+                    << errors << ',' << ToMs(static_cast<double>(stats.interval.p50Ns)) << ','
+                    << ToMs(static_cast<double>(stats.interval.p99Ns)) << ','
+                    << ToMs(static_cast<double>(stats.interval.maxNs)) << ','
+                    << ToMs(stats.intervalStdDevNs) << ',' << ToMb(process.residentBytes) << ','
+                    << process.threadCount << '\n';
+            }
+        }
+        if (csv) {
+            csv.flush();
+        }
+
+        if (now >= end) {
+            break;
+        }
+    }
+
+    for (const auto& entry : detectors) {
+        IDetector* detector = manager.GetDetector(entry.id);
+        if (detector->isAcquiring()) {
+            detector->stopAcquisition();
+        }
+    }
+
+    if (!options.tracePath.empty()) {
+        TraceRecorder::Global().SetEnabled(false);
+        if (!TraceRecorder::Global().WriteChromeTrace(options.tracePath)) {
+            std::cerr << "Cannot write " << options.tracePath << std::endl;
+        }
+    }
+
+    // Give SDK worker threads time to wind down before counting them
+    const auto drainEnd = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.drainSec);
+    ProcessStats stopped = SampleProcessStats();
+    while (static_cast<int>(stopped.threadCount) - static_cast<int>(baseline.threadCount) > options.maxThreadGrowth &&
+           std::chrono::steady_clock::now() < drainEnd) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stopped = SampleProcessStats();
+    }
+
+    // ========================================================================
+    // Verdict
+    // ========================================================================
+
+    bool passed = true;
+    std::cout << "\nSummary" << std::endl;
+
+    for (const auto& entry : detectors) {
+        const FrameSequenceStats stats = entry.listener->tracker.GetStats();
+        const uint64_t continuity = stats.dropped + stats.duplicated + stats.outOfOrder;
+        std::cout << "  " << entry.label << ": " << stats.received << " frames, "
+                  << stats.dropped << " dropped, " << stats.duplicated << " duplicated, "
+                  << stats.outOfOrder << " out of order, " << entry.listener->errors.load()
+                  << " errors";
+        if (entry.spec.fps > 0.0) {
+            std::cout << " (target " << entry.spec.fps << " fps)";
+        }
+        std::cout << std::endl;
+
+        if (stats.received == 0) {
+            std::cout << "  FAIL " << entry.label << " delivered no frames" << std::endl;
+            passed = false;
+        }
+        if (continuity > 0 && !options.allowDrops) {
+            std::cout << "  FAIL " << entry.label << " frameNumber continuity broken" << std::endl;
+            passed = false;
+        }
+    }
+
+    const int threadGrowth = static_cast<int>(stopped.threadCount) - static_cast<int>(baseline.threadCount);
+    std::cout << "  threads: " << baseline.threadCount << " before start, peak " << maxThreads
+              << ", " << stopped.threadCount << " after stop" << std::endl;
+    if (threadGrowth > options.maxThreadGrowth) {
+        std::cout << "  FAIL " << threadGrowth << " thread(s) outlived acquisition" << std::endl;
+        passed = false;
+    }
+
+    std::cout << "  rss: " << ToMb(baseline.residentBytes) << " MB before start, growth after first report "
+              << ToMb(maxRssGrowthBytes) << " MB, peak " << ToMb(stopped.peakResidentBytes) << " MB" << std::endl;
+    if (ToMb(maxRssGrowthBytes) > options.maxRssGrowthMb) {
+        std::cout << "  FAIL rss grew by more than " << options.maxRssGrowthMb << " MB" << std::endl;
+        passed = false;
+    }
+
+    // Informational: steady state should not allocate inside UXDI
+    if (AllocationTracker::IsHooked()) {
+        const AllocationSnapshot allocations = lastReportAllocations - firstReportAllocations;
+        std::cout << "  allocations between first and last report: "
+                  << allocations.UxdiTotal().allocations << " in UXDI subsystems" << std::endl;
+        std::cout << allocations.Format();
+    }
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+
+    // Destroying detectors under still-running SDK threads would crash
+    // rather than report, so leave without tearing down
+    if (threadGrowth > options.maxThreadGrowth) {
+        std::cout.flush();
+        if (csv) {
+            csv.close();
+        }
+        std::_Exit(1);
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "uxdi/AllocationTracker.h"
+#include <memory>
+#include <thread>
+
+using namespace uxdi;
+
+// ============================================================================
+// Attribution
+// ============================================================================
+
+TEST(AllocationTracker, CountsAgainstThreadSubsystem) {
+    AllocationTracker tracker;
+    EXPECT_EQ(tracker.GetThreadSubsystem(), AllocationSubsystem::Untagged);
+
+    tracker.RecordAllocation(16);
+    const AllocationSubsystem previous = tracker.SetThreadSubsystem(AllocationSubsystem::Adapter);
+    tracker.RecordAllocation(100);
+    tracker.RecordAllocation(28);
+    tracker.RecordFree();
+    tracker.SetThreadSubsystem(previous);
+
+    const AllocationSnapshot snapshot = tracker.Snapshot();
+    EXPECT_EQ(snapshot[AllocationSubsystem::Untagged].allocations, 1u);
+    EXPECT_EQ(snapshot[AllocationSubsystem::Adapter].allocations, 2u);
+    EXPECT_EQ(snapshot[AllocationSubsystem::Adapter].bytes, 128u);
+    EXPECT_EQ(snapshot[AllocationSubsystem::Adapter].frees, 1u);
+    EXPECT_EQ(snapshot[AllocationSubsystem::Listener].allocations, 0u);
+    EXPECT_EQ(snapshot.UxdiTotal().allocations, 2u);
+}
+
+TEST(AllocationTracker, TagsArePerThread) {
+    AllocationTracker tracker;
+    tracker.SetThreadSubsystem(AllocationSubsystem::Dispatch);
+
+    std::thread([&tracker] {
+        EXPECT_EQ(tracker.GetThreadSubsystem(), AllocationSubsystem::Untagged);
+        tracker.RecordAllocation(8);
+    }).join();
+    tracker.RecordAllocation(8);
+    tracker.SetThreadSubsystem(AllocationSubsystem::Untagged);
+
+    const AllocationSnapshot snapshot = tracker.Snapshot();
+    EXPECT_EQ(snapshot[AllocationSubsystem::Untagged].allocations, 1u);
+    EXPECT_EQ(snapshot[AllocationSubsystem::Dispatch].allocations, 1u);
+}
+
+TEST(AllocationTracker, ScopesNestOnAttachedTracker) {
+    AllocationTracker tracker;
+    AllocationTracker::Attach(&tracker);
+    EXPECT_EQ(&AllocationTracker::Current(), &tracker);
+
+    {
+        AllocationScope outer(AllocationSubsystem::Dispatch);
+        {
+            AllocationScope inner(AllocationSubsystem::Listener);
+            tracker.RecordAllocation(1);
+        }
+        tracker.RecordAllocation(1);
+    }
+    EXPECT_EQ(tracker.GetThreadSubsystem(), AllocationSubsystem::Untagged);
+
+    AllocationTracker::Attach(nullptr);
+    EXPECT_EQ(&AllocationTracker::Current(), &AllocationTracker::Global());
+
+    const AllocationSnapshot snapshot = tracker.Snapshot();
+    EXPECT_EQ(snapshot[AllocationSubsystem::Listener].allocations, 1u);
+    EXPECT_EQ(snapshot[AllocationSubsystem::Dispatch].allocations, 1u);
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+
+TEST(AllocationTracker, SnapshotDifference) {
+    AllocationTracker tracker;
+    tracker.SetThreadSubsystem(AllocationSubsystem::Scenario);
+    tracker.RecordAllocation(10);
+    const AllocationSnapshot before = tracker.Snapshot();
+    tracker.RecordAllocation(20);
+    tracker.RecordAllocation(30);
+    tracker.SetThreadSubsystem(AllocationSubsystem::Untagged);
+
+    const AllocationSnapshot delta = tracker.Snapshot() - before;
+    EXPECT_EQ(delta[AllocationSubsystem::Scenario].allocations, 2u);
+    EXPECT_EQ(delta[AllocationSubsystem::Scenario].bytes, 50u);
+
+    const std::string text = delta.Format();
+    EXPECT_NE(text.find("scenario"), std::string::npos);
+    EXPECT_EQ(text.find("adapter"), std::string::npos);
+
+    tracker.Reset();
+    EXPECT_EQ(tracker.Snapshot()[AllocationSubsystem::Scenario].allocations, 0u);
+}
+
+// ============================================================================
+// Hooks
+// ============================================================================
+
+TEST(AllocationTracker, OperatorNewIsCountedWhenHooked) {
+    if (!AllocationTracker::IsHooked()) {
+        GTEST_SKIP() << "Built without UXDI_TRACK_ALLOCATIONS";
+    }
+
+    AllocationTracker& tracker = AllocationTracker::Current();
+    const AllocationSnapshot before = tracker.Snapshot();
+    {
+        AllocationScope scope(AllocationSubsystem::Recording);
+        auto block = std::make_unique<uint8_t[]>(4096);
+        block[0] = 1;
+    }
+    const AllocationSnapshot delta = tracker.Snapshot() - before;
+    EXPECT_GE(delta[AllocationSubsystem::Recording].allocations, 1u);
+    EXPECT_GE(delta[AllocationSubsystem::Recording].bytes, 4096u);
+    EXPECT_GE(delta[AllocationSubsystem::Recording].frees, 1u);
+}
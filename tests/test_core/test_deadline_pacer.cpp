@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "uxdi/DeadlinePacer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using namespace uxdi;
+
+namespace {
+
+constexpr uint64_t kMs = 1'000'000;
+constexpr uint64_t kStartNs = 1'000'000 * kMs;  // Arbitrary, well past zero
+
+} // anonymous namespace
+
+// ============================================================================
+// Schedule
+// ============================================================================
+
+TEST(DeadlinePacer, DeadlinesFollowAbsoluteGrid) {
+    DeadlinePacer pacer(10 * kMs);
+    pacer.Start(kStartNs);
+
+    // Producing a frame takes 3 ms; the grid does not move with it
+    uint64_t nowNs = kStartNs;
+    for (uint64_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + i * 10 * kMs);
+        nowNs = kStartNs + i * 10 * kMs + 3 * kMs;
+    }
+    EXPECT_EQ(pacer.GetStats().frames, 5u);
+    EXPECT_EQ(pacer.GetStats().lateFrames, 0u);
+}
+
+TEST(DeadlinePacer, ZeroIntervalDisablesPacing) {
+    DeadlinePacer pacer;
+    pacer.Start(kStartNs);
+    EXPECT_EQ(pacer.NextDeadline(kStartNs + 7), kStartNs + 7);
+    EXPECT_EQ(pacer.NextDeadline(kStartNs + 9), kStartNs + 9);
+}
+
+TEST(DeadlinePacer, CatchUpDeliversMissedFrames) {
+    DeadlinePacer pacer(10 * kMs, PacingPolicy::CatchUp);
+    pacer.Start(kStartNs);
+    pacer.NextDeadline(kStartNs);
+
+    // A 35 ms stall: frames 1-3 are overdue and handed out back to back
+    const uint64_t nowNs = kStartNs + 35 * kMs;
+    EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + 10 * kMs);
+    EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + 20 * kMs);
+    EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + 30 * kMs);
+    EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + 40 * kMs);
+    EXPECT_EQ(pacer.GetStats().lateFrames, 3u);
+    EXPECT_EQ(pacer.GetStats().skippedSlots, 0u);
+}
+
+TEST(DeadlinePacer, SkipDropsMissedSlots) {
+    DeadlinePacer pacer(10 * kMs, PacingPolicy::Skip);
+    pacer.Start(kStartNs);
+    pacer.NextDeadline(kStartNs);
+
+    // Slots 1 and 2 are gone; slot 3 is delivered late, then back on the grid
+    const uint64_t nowNs = kStartNs + 35 * kMs;
+    EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + 30 * kMs);
+    EXPECT_EQ(pacer.NextDeadline(nowNs), kStartNs + 40 * kMs);
+    EXPECT_EQ(pacer.GetStats().skippedSlots, 2u);
+    EXPECT_EQ(pacer.GetStats().lateFrames, 1u);
+}
+
+TEST(DeadlinePacer, LongStallRebasesSchedule) {
+    DeadlinePacer pacer(10 * kMs, PacingPolicy::CatchUp);
+    pacer.Start(kStartNs);
+    pacer.NextDeadline(kStartNs);
+
+    const uint64_t nowNs = kStartNs + 2 * DeadlinePacer::kRebaseNs;
+    EXPECT_EQ(pacer.NextDeadline(nowNs), nowNs);
+    EXPECT_EQ(pacer.NextDeadline(nowNs), nowNs + 10 * kMs);
+    EXPECT_EQ(pacer.GetStats().rebases, 1u);
+}
+
+// ============================================================================
+// Waiting
+// ============================================================================
+
+TEST(DeadlinePacer, SleepUntilWakesAtDeadline) {
+    std::atomic<bool> running{true};
+    uint64_t bestLateNs = UINT64_MAX;
+    for (int i = 0; i < 5; ++i) {
+        const uint64_t deadlineNs = MonotonicNowNs() + 5 * kMs;
+        ASSERT_TRUE(DeadlinePacer::SleepUntil(deadlineNs, running));
+        const uint64_t wokeNs = MonotonicNowNs();
+        ASSERT_GE(wokeNs, deadlineNs);
+        bestLateNs = std::min(bestLateNs, wokeNs - deadlineNs);
+    }
+    // Preemption can delay any single wake-up; the spin keeps typical ones
+    // within microseconds
+    EXPECT_LT(bestLateNs, 1 * kMs);
+}
+
+TEST(DeadlinePacer, SleepUntilStopsWhenCleared) {
+    std::atomic<bool> running{true};
+    std::thread stopper([&running] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        running = false;
+    });
+
+    const uint64_t startNs = MonotonicNowNs();
+    EXPECT_FALSE(DeadlinePacer::SleepUntil(startNs + 10'000 * kMs, running));
+    EXPECT_LT(MonotonicNowNs() - startNs, 1'000 * kMs);
+    stopper.join();
+}
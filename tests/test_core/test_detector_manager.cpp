@@ -3,7 +3,10 @@
 #include "uxdi/DetectorFactory.h"
 #include "uxdi/IDetector.h"
 #include "uxdi/IDetectorListener.h"
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <vector>
 
 // Windows macro workaround - ERROR conflicts with DetectorState::ERROR
@@ -120,6 +123,12 @@ public:
     void clearError() override {
         lastError = ErrorInfo{};
     }
+
+    DetectorStatistics getStatistics() const override {
+        return statistics;
+    }
+
+    DetectorStatistics statistics;
 };
 
 // ============================================================================
@@ -578,6 +587,173 @@ TEST_F(DetectorManagerTest, StateConsistencyAfterFailedOperations) {
     EXPECT_EQ(idsBefore.size(), idsAfter.size());
 }
 
+// ============================================================================
+// Registered detector tests (listener fan-out and latency)
+// ============================================================================
+
+// Deleter without a destroy function: the test keeps ownership, so each test
+// uses a local manager declared after its detectors
+static std::unique_ptr<IDetector, DetectorFactoryDeleter> Borrow(MockDetector& detector) {
+    return std::unique_ptr<IDetector, DetectorFactoryDeleter>(&detector, DetectorFactoryDeleter{});
+}
+
+TEST_F(DetectorManagerTest, RegisterDetectorInstallsDispatcher) {
+    MockDetector detector;
+    DetectorManager mgr;
+    size_t detectorId = mgr.RegisterDetector(Borrow(detector));
+    ASSERT_GT(detectorId, 0);
+    EXPECT_EQ(mgr.GetDetector(detectorId), &detector);
+    EXPECT_NE(detector.listener, nullptr);
+
+    mgr.DestroyDetector(detectorId);
+    EXPECT_EQ(detector.listener, nullptr);
+}
+
+TEST_F(DetectorManagerTest, RegisterDetectorRejectsNull) {
+    EXPECT_EQ(manager.RegisterDetector(nullptr), 0);
+}
+
+TEST_F(DetectorManagerTest, ListenersReceiveDetectorEvents) {
+    MockDetector detector;
+    DetectorManager mgr;
+    size_t detectorId = mgr.RegisterDetector(Borrow(detector));
+    ASSERT_TRUE(mgr.AddListener(detectorId, &listener1));
+    ASSERT_TRUE(mgr.AddListener(detectorId, &listener2));
+    EXPECT_FALSE(mgr.AddListener(detectorId, &listener1));
+
+    ImageData image;
+    image.frameNumber = 7;
+    detector.listener->onImageReceived(image);
+    detector.listener->onStateChanged(DetectorState::ACQUIRING);
+
+    EXPECT_EQ(listener1.imageCount, 1);
+    EXPECT_EQ(listener2.imageCount, 1);
+    EXPECT_EQ(listener1.lastImage.frameNumber, 7u);
+    EXPECT_EQ(listener2.stateChangeCount, 1);
+
+    EXPECT_TRUE(mgr.RemoveListener(detectorId, &listener1));
+    detector.listener->onImageReceived(image);
+    EXPECT_EQ(listener1.imageCount, 1);
+    EXPECT_EQ(listener2.imageCount, 2);
+    EXPECT_EQ(mgr.RemoveAllListeners(detectorId), 1u);
+}
+
+// Queries the manager from inside its image callback
+class QueryingListener : public MockListener {
+public:
+    DetectorManager* manager = nullptr;
+    size_t detectorId = 0;
+    std::atomic<bool> entered{false};
+    std::atomic<DetectorState> seenState{DetectorState::UNKNOWN};
+
+    void onImageReceived(const ImageData& image) override {
+        entered = true;
+        // Give the remover time to start waiting for this callback
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        seenState = manager->GetState(detectorId);
+        MockListener::onImageReceived(image);
+    }
+};
+
+TEST_F(DetectorManagerTest, RemoveListenerWaitsWithoutBlockingCallbacks) {
+    MockDetector detector;
+    detector.state = DetectorState::ACQUIRING;
+    DetectorManager mgr;
+    QueryingListener querying;
+    querying.manager = &mgr;
+    querying.detectorId = mgr.RegisterDetector(Borrow(detector));
+    ASSERT_TRUE(mgr.AddListener(querying.detectorId, &querying));
+
+    std::thread delivery([&] { detector.listener->onImageReceived(ImageData{}); });
+    while (!querying.entered) {
+        std::this_thread::yield();
+    }
+
+    // Returns once the callback, which needs the manager, has finished
+    EXPECT_TRUE(mgr.RemoveListener(querying.detectorId, &querying));
+    EXPECT_EQ(querying.imageCount, 1);
+    EXPECT_EQ(querying.seenState.load(), DetectorState::ACQUIRING);
+    delivery.join();
+}
+
+TEST_F(DetectorManagerTest, DestroyingOneDetectorKeepsOthersWired) {
+    MockDetector first;
+    MockDetector second;
+    DetectorManager mgr;
+    size_t firstId = mgr.RegisterDetector(Borrow(first));
+    size_t secondId = mgr.RegisterDetector(Borrow(second));
+    ASSERT_TRUE(mgr.AddListener(secondId, &listener1));
+
+    mgr.DestroyDetector(firstId);
+    EXPECT_EQ(first.listener, nullptr);
+    ASSERT_NE(second.listener, nullptr);
+
+    second.listener->onImageReceived(ImageData{});
+    EXPECT_EQ(listener1.imageCount, 1);
+}
+
+TEST_F(DetectorManagerTest, GetDetectorIdsIntoReusedVector) {
+    MockDetector first;
+    MockDetector second;
+    DetectorManager mgr;
+    size_t firstId = mgr.RegisterDetector(Borrow(first));
+    size_t secondId = mgr.RegisterDetector(Borrow(second));
+
+    std::vector<size_t> ids = {42, 43, 44};
+    mgr.GetDetectorIds(ids);
+    EXPECT_EQ(ids, (std::vector<size_t>{firstId, secondId}));
+    const size_t* storage = ids.data();
+
+    mgr.DestroyDetector(firstId);
+    mgr.GetDetectorIds(ids);
+    EXPECT_EQ(ids, std::vector<size_t>{secondId});
+    EXPECT_EQ(ids.data(), storage);
+}
+
+TEST_F(DetectorManagerTest, LatencyStatsPerDetector) {
+    MockDetector first;
+    MockDetector second;
+    DetectorManager mgr;
+    size_t firstId = mgr.RegisterDetector(Borrow(first));
+    size_t secondId = mgr.RegisterDetector(Borrow(second));
+    mgr.AddListener(firstId, &listener1);
+
+    ImageData image;
+    const uint64_t now = MonotonicNowNs();
+    image.latency.sdkDeliveryNs = now - 5000;
+    image.latency.adapterConvertedNs = now - 4000;
+    image.latency.dispatchNs = now - 1000;
+    for (int i = 0; i < 10; ++i) {
+        first.listener->onImageReceived(image);
+    }
+
+    LatencyStats stats = mgr.GetLatencyStats(firstId);
+    EXPECT_EQ(stats.sdkToAdapter.count, 10u);
+    EXPECT_EQ(stats.sdkToAdapter.p50Ns, 1000u);
+    EXPECT_EQ(stats.adapterToDispatch.count, 10u);
+    EXPECT_EQ(stats.endToEnd.count, 10u);
+    EXPECT_GE(stats.endToEnd.p50Ns, 5000u);
+    EXPECT_EQ(mgr.GetLatencyStats(secondId).endToEnd.count, 0u);
+
+    EXPECT_TRUE(mgr.ResetLatencyStats(firstId));
+    EXPECT_EQ(mgr.GetLatencyStats(firstId).endToEnd.count, 0u);
+    EXPECT_FALSE(mgr.ResetLatencyStats(999));
+    EXPECT_EQ(mgr.GetLatencyStats(999).endToEnd.count, 0u);
+}
+
+TEST_F(DetectorManagerTest, StatisticsForwardedFromDetector) {
+    MockDetector detector;
+    detector.statistics.framesDelivered = 42;
+    detector.statistics.windowFps = 29.5;
+    DetectorManager mgr;
+    size_t detectorId = mgr.RegisterDetector(Borrow(detector));
+
+    DetectorStatistics stats = mgr.GetStatistics(detectorId);
+    EXPECT_EQ(stats.framesDelivered, 42u);
+    EXPECT_DOUBLE_EQ(stats.windowFps, 29.5);
+    EXPECT_EQ(mgr.GetStatistics(999).framesDelivered, 0u);
+}
+
 // ============================================================================
 // Note on integration tests
 // ============================================================================
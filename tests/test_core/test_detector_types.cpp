@@ -229,6 +229,22 @@ TEST(DetectorTypes, ImageDataZeroCopy) {
     EXPECT_EQ(image2.data.get()[0], 42);
 }
 
+TEST(DetectorTypes, ImageDataBorrowedBuffer) {
+    uint8_t sdkMemory[16] = {};
+    ImageData borrowed;
+    borrowed.data = BorrowBuffer(sdkMemory);
+    EXPECT_EQ(borrowed.data.get(), sdkMemory);
+    EXPECT_TRUE(IsBorrowedBuffer(borrowed));
+
+    ImageData copy = borrowed;  // Copies stay borrowed
+    EXPECT_TRUE(IsBorrowedBuffer(copy));
+
+    ImageData owned;
+    owned.data = std::make_shared<uint8_t[]>(16);
+    EXPECT_FALSE(IsBorrowedBuffer(owned));
+    EXPECT_FALSE(IsBorrowedBuffer(ImageData{}));
+}
+
 TEST(DetectorTypes, ImageDataFrameNumber) {
     // Test frame number tracking
     ImageData image1;
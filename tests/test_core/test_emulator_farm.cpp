@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "EmulatorFarm.h"
+#include "uxdi/Types.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace uxdi;
+using namespace uxdi::adapters::emul;
+
+namespace {
+
+constexpr uint64_t kMs = 1'000'000;
+
+// Services itself every periodNs until it has run ticks times
+class PeriodicClient : public EmulatorFarm::Client {
+public:
+    PeriodicClient(uint64_t periodNs, int ticks) : periodNs_(periodNs), ticksLeft_(ticks) {}
+
+    std::optional<uint64_t> ServiceFarmTick(uint64_t nowNs) override {
+        if (inService_.exchange(true)) {
+            overlapped_ = true;
+        }
+        // Handed over at most a tick (plus scheduling slack) early
+        if (nowNs + 2 * kMs < dueNs_) {
+            early_ = true;
+        }
+        serviced_++;
+        inService_ = false;
+
+        if (--ticksLeft_ == 0) {
+            return std::nullopt;
+        }
+        dueNs_ += periodNs_;
+        return dueNs_;
+    }
+
+    void Start(EmulatorFarm& farm) {
+        dueNs_ = MonotonicNowNs();
+        farm.Add(this, dueNs_);
+    }
+
+    std::atomic<int> serviced_{0};
+    std::atomic<bool> overlapped_{false};
+    std::atomic<bool> early_{false};
+
+private:
+    uint64_t periodNs_;
+    int ticksLeft_;
+    uint64_t dueNs_ = 0;
+    std::atomic<bool> inService_{false};
+};
+
+bool WaitForEmpty(const EmulatorFarm& farm, std::chrono::milliseconds timeout) {
+    const auto until = std::chrono::steady_clock::now() + timeout;
+    while (farm.GetClientCount() != 0) {
+        if (std::chrono::steady_clock::now() > until) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+TEST(EmulatorFarm, ServicesManyClientsOnFewThreads) {
+    EmulatorFarm farm(2);
+    EXPECT_EQ(farm.GetWorkerCount(), 2u);
+
+    std::vector<std::unique_ptr<PeriodicClient>> clients;
+    for (int i = 0; i < 32; ++i) {
+        clients.push_back(std::make_unique<PeriodicClient>(5 * kMs, 20));
+        clients.back()->Start(farm);
+    }
+
+    ASSERT_TRUE(WaitForEmpty(farm, std::chrono::seconds(10)));
+    for (const auto& client : clients) {
+        EXPECT_EQ(client->serviced_.load(), 20);
+        EXPECT_FALSE(client->overlapped_.load());
+        EXPECT_FALSE(client->early_.load());
+    }
+}
+
+TEST(EmulatorFarm, AddingAgainReschedules) {
+    EmulatorFarm farm(1);
+    PeriodicClient client(kMs, 1);
+
+    // Far in the future, then moved to now
+    farm.Add(&client, MonotonicNowNs() + 3600'000 * kMs);
+    client.Start(farm);
+
+    ASSERT_TRUE(WaitForEmpty(farm, std::chrono::seconds(5)));
+    EXPECT_EQ(client.serviced_.load(), 1);
+}
+
+// ============================================================================
+// Removal
+// ============================================================================
+
+TEST(EmulatorFarm, RemoveWaitsForServiceInProgress) {
+    class SlowClient : public EmulatorFarm::Client {
+    public:
+        std::optional<uint64_t> ServiceFarmTick(uint64_t nowNs) override {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            finished = true;
+            return nowNs;
+        }
+        std::atomic<bool> started{false};
+        std::atomic<bool> finished{false};
+    };
+
+    EmulatorFarm farm(2);
+    auto client = std::make_unique<SlowClient>();
+    farm.Add(client.get(), MonotonicNowNs());
+    while (!client->started.load()) {
+        std::this_thread::yield();
+    }
+
+    farm.Remove(client.get());
+    EXPECT_TRUE(client->finished.load());
+    EXPECT_EQ(farm.GetClientCount(), 0u);
+    client.reset();  // No further calls may touch it
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    farm.Remove(nullptr);  // Unknown clients are ignored
+}
+
+TEST(EmulatorFarm, ClientCanRemoveItselfDuringService) {
+    class SelfRemovingClient : public EmulatorFarm::Client {
+    public:
+        explicit SelfRemovingClient(EmulatorFarm& farm) : farm_(farm) {}
+        std::optional<uint64_t> ServiceFarmTick(uint64_t nowNs) override {
+            serviced++;
+            farm_.Remove(this);  // Must not wait for itself
+            return nowNs + kMs;
+        }
+        std::atomic<int> serviced{0};
+
+    private:
+        EmulatorFarm& farm_;
+    };
+
+    EmulatorFarm farm(1);
+    SelfRemovingClient client(farm);
+    farm.Add(&client, MonotonicNowNs());
+
+    ASSERT_TRUE(WaitForEmpty(farm, std::chrono::seconds(5)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(client.serviced.load(), 1);
+}
+
+TEST(EmulatorFarm, AcquireSharesOneFarm) {
+    std::shared_ptr<EmulatorFarm> first = EmulatorFarm::Acquire();
+    std::shared_ptr<EmulatorFarm> second = EmulatorFarm::Acquire();
+    EXPECT_EQ(first, second);
+    EXPECT_GE(first->GetWorkerCount(), 2u);
+    EXPECT_LE(first->GetWorkerCount(), EmulatorFarm::kMaxWorkers);
+}
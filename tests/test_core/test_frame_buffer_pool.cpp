@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameBufferPool.h"
+
+using namespace uxdi;
+
+TEST(FrameBufferPool, ReusesReleasedBuffer) {
+    FrameBufferPool pool;
+    auto first = pool.Acquire(1024);
+    ASSERT_NE(first, nullptr);
+    uint8_t* address = first.get();
+    first.reset();
+
+    auto second = pool.Acquire(1024);
+    EXPECT_EQ(second.get(), address);
+    EXPECT_EQ(pool.GetAllocationCount(), 1u);
+    EXPECT_EQ(pool.GetBufferCount(), 1u);
+}
+
+TEST(FrameBufferPool, HeldBufferIsNotReused) {
+    FrameBufferPool pool;
+    auto held = pool.Acquire(256);
+    held[0] = 42;
+
+    auto other = pool.Acquire(256);
+    EXPECT_NE(other.get(), held.get());
+    EXPECT_EQ(held[0], 42);
+    EXPECT_EQ(pool.GetBufferCount(), 2u);
+}
+
+TEST(FrameBufferPool, SteadyStateDoesNotAllocate) {
+    FrameBufferPool pool;
+    for (int i = 0; i < 100; ++i) {
+        auto frame = pool.Acquire(4096);
+        auto listenerCopy = frame;  // A listener holding the frame for one callback
+    }
+    EXPECT_EQ(pool.GetAllocationCount(), 1u);
+}
+
+TEST(FrameBufferPool, ReplacesUndersizedBuffer) {
+    FrameBufferPool pool;
+    pool.Acquire(100);
+    auto larger = pool.Acquire(200);
+    EXPECT_EQ(pool.GetBufferCount(), 1u);
+    EXPECT_EQ(pool.GetAllocationCount(), 2u);
+    larger.reset();
+
+    // The larger buffer now serves smaller requests too
+    auto smaller = pool.Acquire(50);
+    EXPECT_EQ(pool.GetAllocationCount(), 2u);
+}
+
+TEST(FrameBufferPool, FallsBackBeyondMaxBuffers) {
+    FrameBufferPool pool(2);
+    auto a = pool.Acquire(64);
+    auto b = pool.Acquire(64);
+    auto c = pool.Acquire(64);
+
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(pool.GetBufferCount(), 2u);
+    EXPECT_EQ(pool.GetAllocationCount(), 3u);
+
+    pool.Clear();
+    EXPECT_EQ(pool.GetBufferCount(), 0u);
+    a[0] = 1;  // Frames still held stay valid
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameDeduplicator.h"
+#include "test_helpers.h"
+
+using namespace uxdi;
+
+// ============================================================================
+// Test fixture for FrameDeduplicator tests
+// ============================================================================
+
+class FrameDeduplicatorTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kWidth = 64;
+    static constexpr uint32_t kHeight = 48;
+
+    static ImageData MakeFrame(uint64_t frameNumber, uint16_t base, uint32_t bitDepth = 16) {
+        ImageData image = test::MakeTestFrame(frameNumber, 0.0, {kWidth, kHeight, bitDepth});
+        for (size_t i = 0; i < kWidth * kHeight; ++i) {
+            const uint16_t value = static_cast<uint16_t>(base + (i % 7));
+            if (bitDepth > 8) {
+                SetPixel(image, i, value);
+            } else {
+                image.data[i] = static_cast<uint8_t>(value);
+            }
+        }
+        return image;
+    }
+
+    static void SetPixel(ImageData& image, size_t index, uint16_t value) {
+        reinterpret_cast<uint16_t*>(image.data.get())[index] = value;
+    }
+};
+
+// ============================================================================
+// Metric tests
+// ============================================================================
+
+TEST_F(FrameDeduplicatorTest, MeanAbsDifferenceOfIdenticalFramesIsZero) {
+    EXPECT_DOUBLE_EQ(FrameDeduplicator::ComputeMeanAbsDifference(MakeFrame(1, 1000), MakeFrame(2, 1000)), 0.0);
+}
+
+TEST_F(FrameDeduplicatorTest, MeanAbsDifferenceOfOffsetFrames) {
+    EXPECT_DOUBLE_EQ(FrameDeduplicator::ComputeMeanAbsDifference(MakeFrame(1, 1000), MakeFrame(2, 1003)), 3.0);
+    EXPECT_DOUBLE_EQ(FrameDeduplicator::ComputeMeanAbsDifference(MakeFrame(1, 1003), MakeFrame(2, 1000)), 3.0);
+}
+
+TEST_F(FrameDeduplicatorTest, MeanAbsDifferenceRejectsMismatchedFormat) {
+    EXPECT_LT(FrameDeduplicator::ComputeMeanAbsDifference(MakeFrame(1, 10, 16), MakeFrame(2, 10, 8)), 0.0);
+}
+
+TEST_F(FrameDeduplicatorTest, FingerprintTracksCellMeans) {
+    FrameFingerprint low = FrameDeduplicator::ComputeFingerprint(MakeFrame(1, 100));
+    FrameFingerprint high = FrameDeduplicator::ComputeFingerprint(MakeFrame(1, 200));
+    for (size_t i = 0; i < low.cellMeans.size(); ++i) {
+        EXPECT_NEAR(static_cast<double>(high.cellMeans[i]) - low.cellMeans[i], 100.0, 1.0);
+    }
+}
+
+// ============================================================================
+// Classification tests
+// ============================================================================
+
+TEST_F(FrameDeduplicatorTest, FirstFrameIsKeyFrame) {
+    FrameDeduplicator dedup;
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(1, 500)).isStatic);
+    EXPECT_EQ(dedup.GetKeyFrameCount(), 1u);
+}
+
+TEST_F(FrameDeduplicatorTest, StaticFramesReferenceKeyFrame) {
+    FrameDeduplicator dedup;
+    dedup.Analyze(MakeFrame(10, 500));
+
+    DedupResult result = dedup.Analyze(MakeFrame(11, 500));
+    EXPECT_TRUE(result.isStatic);
+    EXPECT_EQ(result.referenceFrame, 10u);
+
+    result = dedup.Analyze(MakeFrame(12, 501));
+    EXPECT_TRUE(result.isStatic);
+    EXPECT_EQ(result.referenceFrame, 10u);
+    EXPECT_EQ(dedup.GetStaticFrameCount(), 2u);
+}
+
+TEST_F(FrameDeduplicatorTest, ChangedFrameBecomesNewKeyFrame) {
+    FrameDeduplicator dedup;
+    dedup.Analyze(MakeFrame(1, 500));
+
+    DedupResult result = dedup.Analyze(MakeFrame(2, 900));
+    EXPECT_FALSE(result.isStatic);
+    EXPECT_GT(result.meanAbsDifference, 1.0);
+
+    result = dedup.Analyze(MakeFrame(3, 900));
+    EXPECT_TRUE(result.isStatic);
+    EXPECT_EQ(result.referenceFrame, 2u);
+}
+
+TEST_F(FrameDeduplicatorTest, ClassifyLeavesKeyFrameUntilAdopted) {
+    FrameDeduplicator dedup;
+    dedup.Analyze(MakeFrame(1, 500));
+
+    // Frame 2 was never stored, so frame 3 must not refer to it
+    DedupResult result = dedup.Classify(MakeFrame(2, 900));
+    EXPECT_FALSE(result.isStatic);
+    result = dedup.Classify(MakeFrame(3, 900));
+    EXPECT_FALSE(result.isStatic);
+
+    dedup.AdoptKeyFrame(MakeFrame(3, 900), result);
+    result = dedup.Classify(MakeFrame(4, 900));
+    EXPECT_TRUE(result.isStatic);
+    EXPECT_EQ(result.referenceFrame, 3u);
+    EXPECT_EQ(dedup.GetKeyFrameCount(), 2u);
+}
+
+TEST_F(FrameDeduplicatorTest, SmallLocalChangeBelowThresholdIsStatic) {
+    DedupOptions options;
+    options.changeThreshold = 2.0;
+    FrameDeduplicator dedup(options);
+    dedup.Analyze(MakeFrame(1, 500));
+
+    ImageData frame = MakeFrame(2, 500);
+    SetPixel(frame, 100, 4000);  // One hot pixel: ~1.1 mean difference
+    EXPECT_TRUE(dedup.Analyze(frame).isStatic);
+}
+
+TEST_F(FrameDeduplicatorTest, DriftIsMeasuredAgainstKeyFrame) {
+    DedupOptions options;
+    options.changeThreshold = 2.0;
+    FrameDeduplicator dedup(options);
+    dedup.Analyze(MakeFrame(1, 500));
+
+    // Each step is below the threshold, but the total drift is not
+    EXPECT_TRUE(dedup.Analyze(MakeFrame(2, 501)).isStatic);
+    EXPECT_TRUE(dedup.Analyze(MakeFrame(3, 502)).isStatic);
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(4, 503)).isStatic);
+}
+
+TEST_F(FrameDeduplicatorTest, MaxStaticRunForcesKeyFrame) {
+    DedupOptions options;
+    options.maxStaticRun = 2;
+    FrameDeduplicator dedup(options);
+
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(1, 500)).isStatic);
+    EXPECT_TRUE(dedup.Analyze(MakeFrame(2, 500)).isStatic);
+    EXPECT_TRUE(dedup.Analyze(MakeFrame(3, 500)).isStatic);
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(4, 500)).isStatic);
+    EXPECT_TRUE(dedup.Analyze(MakeFrame(5, 500)).isStatic);
+}
+
+TEST_F(FrameDeduplicatorTest, SizeChangeStartsNewKeyFrame) {
+    FrameDeduplicator dedup;
+    dedup.Analyze(MakeFrame(1, 500, 16));
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(2, 500, 8)).isStatic);
+}
+
+TEST_F(FrameDeduplicatorTest, EightBitFrames) {
+    FrameDeduplicator dedup;
+    dedup.Analyze(MakeFrame(1, 50, 8));
+    EXPECT_TRUE(dedup.Analyze(MakeFrame(2, 50, 8)).isStatic);
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(3, 80, 8)).isStatic);
+}
+
+TEST_F(FrameDeduplicatorTest, ResetForgetsKeyFrame) {
+    FrameDeduplicator dedup;
+    dedup.Analyze(MakeFrame(1, 500));
+    dedup.Reset();
+    EXPECT_FALSE(dedup.Analyze(MakeFrame(2, 500)).isStatic);
+}
+
+TEST_F(FrameDeduplicatorTest, FrameWithoutPixelsIsNeverStatic) {
+    FrameDeduplicator dedup;
+    ImageData empty;
+    EXPECT_FALSE(dedup.Analyze(empty).isStatic);
+    EXPECT_FALSE(dedup.Analyze(empty).isStatic);
+}
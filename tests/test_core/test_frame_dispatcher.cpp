@@ -0,0 +1,405 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameDispatcher.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Windows macro workaround - ERROR conflicts with DetectorState::ERROR
+#ifdef ERROR
+#undef ERROR
+#endif
+
+using namespace uxdi;
+
+// ============================================================================
+// Recording listener
+// ============================================================================
+
+class RecordingListener : public IDetectorListener {
+public:
+    int imageCount = 0;
+    int stateChangeCount = 0;
+    int errorCount = 0;
+    int acqStartedCount = 0;
+    int acqStoppedCount = 0;
+    std::vector<uint64_t> frameNumbers;
+    std::chrono::microseconds callbackDelay{0};
+
+    void onImageReceived(const ImageData& image) override {
+        imageCount++;
+        frameNumbers.push_back(image.frameNumber);
+        if (callbackDelay.count() > 0) {
+            std::this_thread::sleep_for(callbackDelay);
+        }
+    }
+    void onStateChanged(DetectorState) override { stateChangeCount++; }
+    void onError(const ErrorInfo&) override { errorCount++; }
+    void onAcquisitionStarted() override { acqStartedCount++; }
+    void onAcquisitionStopped() override { acqStoppedCount++; }
+};
+
+// Listener that removes itself from the dispatcher on its first frame
+class SelfRemovingListener : public IDetectorListener {
+public:
+    FrameDispatcher* dispatcher = nullptr;
+    int imageCount = 0;
+
+    void onImageReceived(const ImageData&) override {
+        imageCount++;
+        dispatcher->RemoveListener(this);
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override {}
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+};
+
+// Thread-safe listener whose callbacks take a fixed time
+class SlowListener : public IDetectorListener {
+public:
+    std::atomic<int> imageCount{0};
+    std::atomic<uint64_t> lastFrame{0};
+    std::chrono::microseconds callbackDelay{0};
+
+    void onImageReceived(const ImageData& image) override {
+        std::this_thread::sleep_for(callbackDelay);
+        lastFrame = image.frameNumber;
+        imageCount++;
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override {}
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+};
+
+// Overruns on its first frame, then waits for the test before reading pixels
+class GatedListener : public IDetectorListener {
+public:
+    std::atomic<bool> open{false};
+    std::atomic<int> imageCount{0};
+    std::atomic<int> firstPixel{-1};
+
+    void onImageReceived(const ImageData& image) override {
+        if (imageCount == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        } else {
+            while (!open) {
+                std::this_thread::yield();
+            }
+            firstPixel = image.data[0];
+        }
+        imageCount++;
+    }
+    void onStateChanged(DetectorState) override {}
+    void onError(const ErrorInfo&) override {}
+    void onAcquisitionStarted() override {}
+    void onAcquisitionStopped() override {}
+};
+
+static bool WaitFor(const std::atomic<int>& value, int target) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (value < target) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static ImageData MakeStampedFrame(uint64_t frameNumber) {
+    ImageData image;
+    image.frameNumber = frameNumber;
+    const uint64_t now = MonotonicNowNs();
+    image.latency.sdkDeliveryNs = now - 3000;
+    image.latency.adapterConvertedNs = now - 2000;
+    image.latency.dispatchNs = now - 1000;
+    return image;
+}
+
+// ============================================================================
+// Listener registry tests
+// ============================================================================
+
+TEST(FrameDispatcher, AddRejectsNullAndDuplicates) {
+    FrameDispatcher dispatcher;
+    RecordingListener listener;
+    EXPECT_FALSE(dispatcher.AddListener(nullptr));
+    EXPECT_TRUE(dispatcher.AddListener(&listener));
+    EXPECT_FALSE(dispatcher.AddListener(&listener));
+    EXPECT_EQ(dispatcher.GetListenerCount(), 1u);
+}
+
+TEST(FrameDispatcher, RemoveListener) {
+    FrameDispatcher dispatcher;
+    RecordingListener a;
+    RecordingListener b;
+    dispatcher.AddListener(&a);
+    dispatcher.AddListener(&b);
+
+    EXPECT_TRUE(dispatcher.RemoveListener(&a));
+    EXPECT_FALSE(dispatcher.RemoveListener(&a));
+    EXPECT_FALSE(dispatcher.RemoveListener(nullptr));
+    EXPECT_EQ(dispatcher.RemoveAllListeners(), 1u);
+    EXPECT_EQ(dispatcher.GetListenerCount(), 0u);
+}
+
+TEST(FrameDispatcher, FansOutAllEvents) {
+    FrameDispatcher dispatcher;
+    RecordingListener a;
+    RecordingListener b;
+    dispatcher.AddListener(&a);
+    dispatcher.AddListener(&b);
+
+    dispatcher.onImageReceived(MakeStampedFrame(1));
+    dispatcher.onStateChanged(DetectorState::ACQUIRING);
+    dispatcher.onError(ErrorInfo{});
+    dispatcher.onAcquisitionStarted();
+    dispatcher.onAcquisitionStopped();
+
+    for (RecordingListener* listener : {&a, &b}) {
+        EXPECT_EQ(listener->imageCount, 1);
+        EXPECT_EQ(listener->stateChangeCount, 1);
+        EXPECT_EQ(listener->errorCount, 1);
+        EXPECT_EQ(listener->acqStartedCount, 1);
+        EXPECT_EQ(listener->acqStoppedCount, 1);
+    }
+}
+
+TEST(FrameDispatcher, ListenerMayRemoveItselfDuringDispatch) {
+    FrameDispatcher dispatcher;
+    SelfRemovingListener self;
+    self.dispatcher = &dispatcher;
+    RecordingListener other;
+    dispatcher.AddListener(&self);
+    dispatcher.AddListener(&other);
+
+    dispatcher.onImageReceived(MakeStampedFrame(1));
+    dispatcher.onImageReceived(MakeStampedFrame(2));
+
+    EXPECT_EQ(self.imageCount, 1);
+    EXPECT_EQ(other.imageCount, 2);
+}
+
+TEST(FrameDispatcher, ListenerCanBeDeletedOnceRemoved) {
+    // Outlives the listeners so late callbacks can be detected
+    struct Lifetime {
+        std::atomic<bool> destroyed{false};
+        std::atomic<bool> calledAfterDestroy{false};
+        std::atomic<int> frames{0};
+    };
+    class GuardedListener : public IDetectorListener {
+    public:
+        explicit GuardedListener(Lifetime& lifetime) : lifetime_(lifetime) {}
+        ~GuardedListener() override { lifetime_.destroyed = true; }
+
+        void onImageReceived(const ImageData&) override {
+            Check();
+            lifetime_.frames++;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            Check();
+        }
+        void onStateChanged(DetectorState) override { Check(); }
+        void onError(const ErrorInfo&) override {}
+        void onAcquisitionStarted() override {}
+        void onAcquisitionStopped() override {}
+
+    private:
+        void Check() {
+            if (lifetime_.destroyed) {
+                lifetime_.calledAfterDestroy = true;
+            }
+        }
+        Lifetime& lifetime_;
+    };
+
+    FrameDispatcher dispatcher;
+    std::atomic<bool> stop{false};
+    std::thread detector([&] {
+        for (uint64_t i = 1; !stop.load(); ++i) {
+            dispatcher.onImageReceived(MakeStampedFrame(i));
+            dispatcher.onStateChanged(DetectorState::ACQUIRING);
+        }
+    });
+
+    for (int round = 0; round < 50; ++round) {
+        Lifetime lifetime;
+        auto listener = std::make_unique<GuardedListener>(lifetime);
+        ASSERT_TRUE(dispatcher.AddListener(listener.get()));
+        while (lifetime.frames.load() == 0) {
+            std::this_thread::yield();
+        }
+        ASSERT_TRUE(dispatcher.RemoveListener(listener.get()));
+        listener.reset();
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        EXPECT_FALSE(lifetime.calledAfterDestroy.load()) << "round " << round;
+    }
+
+    stop = true;
+    detector.join();
+}
+
+// ============================================================================
+// Latency tests
+// ============================================================================
+
+TEST(FrameDispatcher, AggregatesStageLatencies) {
+    FrameDispatcher dispatcher;
+    RecordingListener listener;
+    listener.callbackDelay = std::chrono::microseconds(200);
+    dispatcher.AddListener(&listener);
+
+    for (uint64_t i = 0; i < 20; ++i) {
+        dispatcher.onImageReceived(MakeStampedFrame(i));
+    }
+
+    LatencyStats stats = dispatcher.GetLatencyStats();
+    EXPECT_EQ(stats.sdkToAdapter.count, 20u);
+    EXPECT_EQ(stats.sdkToAdapter.p50Ns, 1000u);
+    EXPECT_EQ(stats.adapterToDispatch.p99Ns, 1000u);
+    EXPECT_EQ(stats.dispatchToListener.count, 20u);
+    EXPECT_GE(stats.dispatchToListener.minNs, 1000u);
+    EXPECT_EQ(stats.listenerCallback.count, 20u);
+    EXPECT_GE(stats.listenerCallback.minNs, 200000u);
+    EXPECT_EQ(stats.endToEnd.count, 20u);
+    EXPECT_GE(stats.endToEnd.minNs, 203000u);
+}
+
+TEST(FrameDispatcher, UnstampedStagesStayEmpty) {
+    FrameDispatcher dispatcher;
+    RecordingListener listener;
+    dispatcher.AddListener(&listener);
+
+    dispatcher.onImageReceived(ImageData{});
+
+    LatencyStats stats = dispatcher.GetLatencyStats();
+    EXPECT_EQ(stats.sdkToAdapter.count, 0u);
+    EXPECT_EQ(stats.dispatchToListener.count, 0u);
+    EXPECT_EQ(stats.endToEnd.count, 0u);
+    EXPECT_EQ(stats.listenerCallback.count, 1u);
+}
+
+TEST(FrameDispatcher, ResetLatencyStats) {
+    FrameDispatcher dispatcher;
+    dispatcher.onImageReceived(MakeStampedFrame(1));
+    EXPECT_EQ(dispatcher.GetLatencyStats().endToEnd.count, 1u);
+
+    dispatcher.ResetLatencyStats();
+    LatencyStats stats = dispatcher.GetLatencyStats();
+    EXPECT_EQ(stats.sdkToAdapter.count, 0u);
+    EXPECT_EQ(stats.endToEnd.count, 0u);
+}
+
+// ============================================================================
+// Callback budget tests
+// ============================================================================
+
+TEST(FrameDispatcher, CountsBudgetOverruns) {
+    FrameDispatcher dispatcher;
+    RecordingListener listener;
+    listener.callbackDelay = std::chrono::microseconds(500);
+    ListenerOptions options;
+    options.callbackBudgetNs = 100000;
+    dispatcher.AddListener(&listener, options);
+
+    for (uint64_t i = 1; i <= 5; ++i) {
+        dispatcher.onImageReceived(MakeStampedFrame(i));
+    }
+
+    ListenerStats stats = dispatcher.GetListenerStats(&listener);
+    EXPECT_EQ(stats.frames, 5u);
+    EXPECT_EQ(stats.overruns, 5u);
+    EXPECT_GE(stats.maxCallbackNs, 500000u);
+    EXPECT_FALSE(stats.demoted);
+    EXPECT_EQ(listener.imageCount, 5);
+
+    EXPECT_EQ(dispatcher.GetListenerStats(nullptr).frames, 0u);
+}
+
+TEST(FrameDispatcher, SlowListenerIsDemotedToItsOwnQueue) {
+    MetricsRegistry registry;
+    FrameDispatcher dispatcher;
+    dispatcher.BindMetrics(registry, {{"detector", "1"}});
+
+    SlowListener slow;
+    slow.callbackDelay = std::chrono::milliseconds(20);
+    ListenerOptions options;
+    options.name = "analytics";
+    options.callbackBudgetNs = 1000000;
+    options.demoteAfterOverruns = 2;
+    options.asyncQueueDepth = 2;
+    dispatcher.AddListener(&slow, options);
+
+    RecordingListener display;
+    dispatcher.AddListener(&display);
+
+    // Two overruns on the dispatching thread, then the slow listener moves off it
+    dispatcher.onImageReceived(MakeStampedFrame(1));
+    dispatcher.onImageReceived(MakeStampedFrame(2));
+    EXPECT_TRUE(dispatcher.GetListenerStats(&slow).demoted);
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 3; i <= 12; ++i) {
+        dispatcher.onImageReceived(MakeStampedFrame(i));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(20));
+    EXPECT_EQ(display.imageCount, 12);
+
+    // The newest frames survive; older ones were dropped from the full queue
+    ListenerStats stats = dispatcher.GetListenerStats(&slow);
+    EXPECT_EQ(stats.frames, 12u);
+    EXPECT_GT(stats.droppedFrames, 0u);
+    ASSERT_TRUE(WaitFor(slow.imageCount, static_cast<int>(12 - stats.droppedFrames)));
+    EXPECT_EQ(slow.lastFrame, 12u);
+
+    const MetricLabels labels = {{"detector", "1"}, {"listener", "analytics"}};
+    EXPECT_GE(registry.GetCounter("uxdi_listener_overruns_total", "", labels).GetValue(), 2u);
+    EXPECT_EQ(registry.GetCounter("uxdi_listener_demotions_total", "", labels).GetValue(), 1u);
+    EXPECT_EQ(registry.GetCounter("uxdi_listener_dropped_frames_total", "", labels).GetValue(),
+              stats.droppedFrames);
+}
+
+TEST(FrameDispatcher, QueuedZeroCopyFramesAreCopied) {
+    FrameDispatcher dispatcher;
+    GatedListener listener;
+    ListenerOptions options;
+    options.callbackBudgetNs = 100000;
+    options.demoteAfterOverruns = 1;
+    dispatcher.AddListener(&listener, options);
+
+    dispatcher.onImageReceived(MakeStampedFrame(1));
+    ASSERT_TRUE(dispatcher.GetListenerStats(&listener).demoted);
+
+    // Non-owning view of SDK memory, reused by the next frame
+    uint8_t sdkBuffer[16] = {7};
+    ImageData image = MakeStampedFrame(2);
+    image.data = BorrowBuffer(sdkBuffer);
+    image.dataLength = sizeof(sdkBuffer);
+    dispatcher.onImageReceived(image);
+    sdkBuffer[0] = 9;
+
+    listener.open = true;
+    ASSERT_TRUE(WaitFor(listener.imageCount, 2));
+    EXPECT_EQ(listener.firstPixel, 7);
+}
+
+TEST(FrameDispatcher, RemovingDemotedListenerStopsItsQueue) {
+    FrameDispatcher dispatcher;
+    SlowListener slow;
+    slow.callbackDelay = std::chrono::milliseconds(5);
+    ListenerOptions options;
+    options.callbackBudgetNs = 1000000;
+    options.demoteAfterOverruns = 1;
+    dispatcher.AddListener(&slow, options);
+
+    for (uint64_t i = 1; i <= 5; ++i) {
+        dispatcher.onImageReceived(MakeStampedFrame(i));
+    }
+    EXPECT_TRUE(dispatcher.RemoveListener(&slow));
+
+    // No callbacks arrive once RemoveListener has returned
+    const int count = slow.imageCount;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(slow.imageCount, count);
+    EXPECT_EQ(dispatcher.GetListenerCount(), 0u);
+}
@@ -0,0 +1,317 @@
+#include <gtest/gtest.h>
+#include "FrameGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace uxdi::adapters::emul;
+
+namespace {
+
+std::vector<uint16_t> Render16(FrameGenerator& generator, uint64_t frameIndex) {
+    std::vector<uint16_t> pixels(generator.FrameBytes() / sizeof(uint16_t));
+    generator.Render(frameIndex, reinterpret_cast<uint8_t*>(pixels.data()));
+    return pixels;
+}
+
+// Mean and standard deviation of a flat frame after noise
+void Moments(const std::vector<uint16_t>& pixels, double& mean, double& stddev) {
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (uint16_t value : pixels) {
+        sum += value;
+        sumSquares += static_cast<double>(value) * value;
+    }
+    mean = sum / pixels.size();
+    stddev = std::sqrt(sumSquares / pixels.size() - mean * mean);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Patterns and variation
+// ============================================================================
+
+TEST(FrameGenerator, GradientMatchesLegacyPattern) {
+    FrameGenerator generator;
+    generator.SetFrameConfig(64, 32, 16);
+    ASSERT_EQ(generator.FrameBytes(), 64u * 32u * 2u);
+
+    const std::vector<uint16_t> pixels = Render16(generator, 0);
+    for (uint32_t y = 0; y < 32; ++y) {
+        for (uint32_t x = 0; x < 64; ++x) {
+            const auto expected = static_cast<uint16_t>((x * 65535 / 64 + y * 16384 / 32) % 65536);
+            ASSERT_EQ(pixels[y * 64 + x], expected) << "x=" << x << " y=" << y;
+        }
+    }
+    EXPECT_EQ(Render16(generator, 7), pixels);
+}
+
+TEST(FrameGenerator, EightBitFrames) {
+    FrameGenerator generator;
+    generator.SetFrameConfig(16, 4, 8);
+    ASSERT_EQ(generator.FrameBytes(), 64u);
+
+    std::vector<uint8_t> pixels(generator.FrameBytes());
+    generator.Render(0, pixels.data());
+    EXPECT_EQ(pixels[0], 0);
+    EXPECT_EQ(pixels[15], static_cast<uint8_t>(15 * 255 / 16));
+    EXPECT_EQ(pixels[3 * 16], static_cast<uint8_t>(3 * 64 / 4));
+}
+
+TEST(FrameGenerator, OffsetVariationWraps) {
+    GeneratorConfig config;
+    config.pattern = FramePattern::Flat;
+    config.variation = FrameVariation::Offset;
+    config.step = 20000;
+
+    FrameGenerator generator;
+    generator.Configure(config);
+    generator.SetFrameConfig(8, 8, 16);
+
+    EXPECT_EQ(Render16(generator, 0)[0], 32767);
+    EXPECT_EQ(Render16(generator, 1)[5], 52767);
+    EXPECT_EQ(Render16(generator, 2)[9], static_cast<uint16_t>(32767 + 40000));
+}
+
+TEST(FrameGenerator, RollVariationRotatesRows) {
+    GeneratorConfig config;
+    config.variation = FrameVariation::Roll;
+    config.step = 3;
+
+    FrameGenerator generator;
+    generator.Configure(config);
+    generator.SetFrameConfig(10, 2, 16);
+
+    const std::vector<uint16_t> base = Render16(generator, 0);
+    const std::vector<uint16_t> rolled = Render16(generator, 1);
+    for (uint32_t y = 0; y < 2; ++y) {
+        for (uint32_t x = 0; x < 10; ++x) {
+            EXPECT_EQ(rolled[y * 10 + x], base[y * 10 + (x + 3) % 10]);
+        }
+    }
+}
+
+// ============================================================================
+// Noise
+// ============================================================================
+
+TEST(FrameGenerator, GaussianNoiseHasRequestedSigma) {
+    GeneratorConfig config;
+    config.pattern = FramePattern::Flat;
+    config.noise = FrameNoise::Gaussian;
+    config.noise_level = 100.0;
+    config.seed = 7;
+
+    FrameGenerator generator;
+    generator.Configure(config);
+    generator.SetFrameConfig(256, 256, 16);
+
+    double mean = 0.0;
+    double stddev = 0.0;
+    Moments(Render16(generator, 0), mean, stddev);
+    EXPECT_NEAR(mean, 32767.0, 2.0);
+    EXPECT_NEAR(stddev, 100.0, 3.0);
+}
+
+TEST(FrameGenerator, PoissonNoiseFollowsSignal) {
+    GeneratorConfig config;
+    config.pattern = FramePattern::Flat;
+    config.noise = FrameNoise::Poisson;
+    config.noise_level = 2.0;  // Counts per photon
+    config.seed = 7;
+
+    FrameGenerator generator;
+    generator.Configure(config);
+    generator.SetFrameConfig(256, 256, 16);
+
+    double mean = 0.0;
+    double stddev = 0.0;
+    Moments(Render16(generator, 0), mean, stddev);
+    EXPECT_NEAR(mean, 32767.0, 2.0);
+    EXPECT_NEAR(stddev, std::sqrt(32767.0 * 2.0), 8.0);
+}
+
+TEST(FrameGenerator, SeededNoiseIsReproducible) {
+    GeneratorConfig config;
+    config.noise = FrameNoise::Gaussian;
+    config.noise_level = 50.0;
+    config.seed = 42;
+
+    FrameGenerator first;
+    first.Configure(config);
+    first.SetFrameConfig(64, 64, 16);
+    FrameGenerator second;
+    second.Configure(config);
+    second.SetFrameConfig(64, 64, 16);
+
+    const std::vector<uint16_t> a0 = Render16(first, 0);
+    const std::vector<uint16_t> a1 = Render16(first, 1);
+    EXPECT_EQ(a0, Render16(second, 0));
+    EXPECT_EQ(a1, Render16(second, 1));
+    EXPECT_NE(a0, a1);
+}
+
+TEST(FrameGenerator, SeededNoiseDependsOnFrameNumberOnly) {
+    GeneratorConfig config;
+    config.variation = FrameVariation::Offset;
+    config.noise = FrameNoise::Poisson;
+    config.noise_level = 1.0;
+    config.seed = 42;
+
+    FrameGenerator streamed;
+    streamed.Configure(config);
+    streamed.SetFrameConfig(64, 64, 16);
+    FrameGenerator skipped;
+    skipped.Configure(config);
+    skipped.SetFrameConfig(64, 64, 16);
+
+    // Frames dropped or rendered out of order do not shift the noise
+    Render16(streamed, 0);
+    Render16(streamed, 1);
+    const std::vector<uint16_t> frame2 = Render16(streamed, 2);
+    EXPECT_EQ(Render16(skipped, 2), frame2);
+    EXPECT_EQ(Render16(skipped, 2), frame2);
+}
+
+// ============================================================================
+// Phantom
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t kPhantomSide = 512;
+
+// Mean over a square block of a phantom frame
+double BlockMean(const std::vector<uint16_t>& pixels, uint32_t x0, uint32_t y0, uint32_t size) {
+    double sum = 0.0;
+    for (uint32_t y = y0; y < y0 + size; ++y) {
+        for (uint32_t x = x0; x < x0 + size; ++x) {
+            sum += pixels[y * kPhantomSide + x];
+        }
+    }
+    return sum / (size * size);
+}
+
+void ConfigurePhantom(FrameGenerator& generator, double exposureMs, FrameNoise noise) {
+    GeneratorConfig config;
+    config.pattern = FramePattern::Phantom;
+    config.noise = noise;
+    config.seed = 3;
+
+    generator.Configure(config);
+    generator.SetFrameConfig(kPhantomSide, kPhantomSide, 16);
+    generator.SetExposure(exposureMs, 1.0);
+}
+
+std::vector<uint16_t> RenderPhantom(double exposureMs) {
+    FrameGenerator generator;
+    ConfigurePhantom(generator, exposureMs, FrameNoise::None);
+    return Render16(generator, 0);
+}
+
+} // anonymous namespace
+
+TEST(FrameGenerator, PhantomShowsAnatomyAndHeelEffect) {
+    const std::vector<uint16_t> pixels = RenderPhantom(100.0);
+    EXPECT_EQ(RenderPhantom(100.0), pixels);
+
+    const double airTop = BlockMean(pixels, 8, 8, 32);
+    const double airBottom = BlockMean(pixels, 8, 472, 32);
+    const double lung = BlockMean(pixels, 160, 220, 16);
+    const double spine = BlockMean(pixels, 250, 300, 8);
+
+    EXPECT_GT(airTop, 30000.0);
+    EXPECT_GT(airTop, airBottom * 1.1);  // Anode side is darker
+    EXPECT_GT(airBottom, lung);
+    EXPECT_GT(lung, spine * 2.0);
+    EXPECT_GT(spine, 0.0);
+}
+
+TEST(FrameGenerator, PhantomDefectsStayOnThePanel) {
+    GeneratorConfig config;
+    config.pattern = FramePattern::Phantom;
+    config.variation = FrameVariation::Roll;
+    config.step = 5;
+
+    FrameGenerator generator;
+    generator.Configure(config);
+    generator.SetFrameConfig(kPhantomSide, kPhantomSide, 16);
+
+    for (uint64_t frame : {0u, 3u}) {
+        const std::vector<uint16_t> pixels = Render16(generator, frame);
+        const uint32_t deadColumn = kPhantomSide * 7 / 10;
+        for (uint32_t y = 0; y < kPhantomSide; ++y) {
+            ASSERT_EQ(pixels[y * kPhantomSide + deadColumn], 0) << "frame " << frame << " y=" << y;
+        }
+        const auto hot = std::count(pixels.begin(), pixels.end(), uint16_t{65535});
+        EXPECT_GE(hot, 3) << "frame " << frame;
+    }
+}
+
+TEST(FrameGenerator, PhantomSignalScalesWithExposure) {
+    const std::vector<uint16_t> full = RenderPhantom(100.0);
+    const std::vector<uint16_t> half = RenderPhantom(50.0);
+    const std::vector<uint16_t> quarter = RenderPhantom(25.0);
+
+    // The dark offset cancels in differences of the same pixels
+    for (uint32_t x0 : {8u, 160u, 250u}) {
+        const double upper = BlockMean(full, x0, 220, 8) - BlockMean(half, x0, 220, 8);
+        const double lower = BlockMean(half, x0, 220, 8) - BlockMean(quarter, x0, 220, 8);
+        EXPECT_NEAR(upper / lower, 2.0, 0.05) << "x0=" << x0;
+    }
+}
+
+TEST(FrameGenerator, PhantomQuantumNoiseFollowsExposure) {
+    // Standard deviation of the difference of two frames over an open-beam block
+    const auto frameNoise = [](double exposureMs, double& mean) {
+        FrameGenerator generator;
+        ConfigurePhantom(generator, exposureMs, FrameNoise::Poisson);
+        const std::vector<uint16_t> a = Render16(generator, 0);
+        const std::vector<uint16_t> b = Render16(generator, 1);
+        mean = BlockMean(a, 8, 8, 32);
+        double sumSquares = 0.0;
+        for (uint32_t y = 8; y < 40; ++y) {
+            for (uint32_t x = 8; x < 40; ++x) {
+                const double d = static_cast<double>(a[y * kPhantomSide + x]) - b[y * kPhantomSide + x];
+                sumSquares += d * d;
+            }
+        }
+        return std::sqrt(sumSquares / (32 * 32) / 2.0);
+    };
+
+    double fullMean = 0.0;
+    double quarterMean = 0.0;
+    const double fullSigma = frameNoise(100.0, fullMean);
+    const double quarterSigma = frameNoise(25.0, quarterMean);
+
+    // Four counts per photon at gain 1
+    EXPECT_NEAR(fullSigma / std::sqrt(4.0 * fullMean), 1.0, 0.1);
+    EXPECT_NEAR(fullSigma / quarterSigma, std::sqrt(fullMean / quarterMean), 0.2);
+}
+
+// ============================================================================
+// Template sharing
+// ============================================================================
+
+TEST(FrameGenerator, SameSettingsShareOneTemplate) {
+    FrameGenerator first;
+    FrameGenerator second;
+    FrameGenerator brighter;
+    for (FrameGenerator* generator : {&first, &second, &brighter}) {
+        ConfigurePhantom(*generator, generator == &brighter ? 200.0 : 100.0, FrameNoise::None);
+    }
+
+    const std::vector<uint16_t> a = Render16(first, 0);
+    Render16(second, 0);
+    Render16(brighter, 0);
+    EXPECT_EQ(first.GetTemplate(), second.GetTemplate());
+    EXPECT_NE(first.GetTemplate(), brighter.GetTemplate());
+
+    // Retuning one generator leaves the other's frames alone
+    second.SetExposure(200.0, 1.0);
+    Render16(second, 0);
+    EXPECT_EQ(second.GetTemplate(), brighter.GetTemplate());
+    EXPECT_EQ(Render16(first, 0), a);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameRateMeter.h"
+
+using namespace uxdi;
+
+namespace {
+
+constexpr uint64_t kMs = 1'000'000;
+constexpr uint64_t kStartNs = 1'000'000 * kMs;  // Arbitrary, well past zero
+
+// Feed frames at a fixed interval and return the time of the last one
+uint64_t FeedFrames(FrameRateMeter& meter, uint64_t startNs, uint64_t intervalNs, int count, size_t bytes) {
+    uint64_t nowNs = startNs;
+    for (int i = 0; i < count; ++i) {
+        nowNs = startNs + static_cast<uint64_t>(i) * intervalNs;
+        meter.RecordFrame(bytes, nowNs);
+    }
+    return nowNs;
+}
+
+} // anonymous namespace
+
+TEST(FrameRateMeter, EmptyMeterReportsZero) {
+    FrameRateMeter meter;
+    DetectorStatistics stats = meter.GetStatistics(kStartNs);
+    EXPECT_EQ(stats.framesDelivered, 0u);
+    EXPECT_DOUBLE_EQ(stats.instantFps, 0.0);
+    EXPECT_DOUBLE_EQ(stats.windowFps, 0.0);
+    EXPECT_DOUBLE_EQ(stats.lastFrameAgeSec, 0.0);
+    EXPECT_EQ(stats.callbackCount, 0u);
+}
+
+TEST(FrameRateMeter, SteadyRate) {
+    FrameRateMeter meter;
+    // 30 fps for 5 s, 1 MB frames
+    const uint64_t lastNs = FeedFrames(meter, kStartNs, 1000 * kMs / 30, 150, 1'000'000);
+
+    DetectorStatistics stats = meter.GetStatistics(lastNs);
+    EXPECT_EQ(stats.framesDelivered, 150u);
+    EXPECT_EQ(stats.bytesDelivered, 150'000'000u);
+    EXPECT_NEAR(stats.instantFps, 30.0, 0.1);
+    EXPECT_NEAR(stats.windowFps, 30.0, 1.5);
+    EXPECT_NEAR(stats.windowMBps, 30.0, 1.5);
+    EXPECT_GT(stats.windowSec, 1.8);
+    EXPECT_LE(stats.windowSec, 2.0);
+    EXPECT_DOUBLE_EQ(stats.lastFrameAgeSec, 0.0);
+}
+
+TEST(FrameRateMeter, ShortRunMeasuresFromFirstFrame) {
+    FrameRateMeter meter;
+    // 11 frames 10 ms apart = 100 fps over 100 ms
+    const uint64_t lastNs = FeedFrames(meter, kStartNs, 10 * kMs, 11, 100);
+
+    DetectorStatistics stats = meter.GetStatistics(lastNs);
+    EXPECT_NEAR(stats.windowFps, 100.0, 0.01);
+    EXPECT_NEAR(stats.windowSec, 0.1, 1e-9);
+}
+
+TEST(FrameRateMeter, RateChangeShowsInWindow) {
+    FrameRateMeter meter;
+    uint64_t nowNs = FeedFrames(meter, kStartNs, 10 * kMs, 500, 100);     // 100 fps for 5 s
+    nowNs = FeedFrames(meter, nowNs + 100 * kMs, 100 * kMs, 30, 100);     // then 10 fps for 3 s
+
+    DetectorStatistics stats = meter.GetStatistics(nowNs);
+    EXPECT_NEAR(stats.instantFps, 10.0, 0.01);
+    EXPECT_NEAR(stats.windowFps, 10.0, 1.0);
+}
+
+TEST(FrameRateMeter, StallLowersInstantRate) {
+    FrameRateMeter meter;
+    const uint64_t lastNs = FeedFrames(meter, kStartNs, 10 * kMs, 100, 100);
+
+    DetectorStatistics stats = meter.GetStatistics(lastNs + 500 * kMs);
+    EXPECT_NEAR(stats.instantFps, 2.0, 0.01);
+    EXPECT_NEAR(stats.lastFrameAgeSec, 0.5, 1e-9);
+
+    // Nothing in the window once it has passed
+    stats = meter.GetStatistics(lastNs + 10'000 * kMs);
+    EXPECT_DOUBLE_EQ(stats.windowFps, 0.0);
+    EXPECT_EQ(stats.framesDelivered, 100u);
+}
+
+TEST(FrameRateMeter, CallbackTime) {
+    FrameRateMeter meter;
+    meter.RecordCallback(1000);
+    meter.RecordCallback(3000);
+
+    DetectorStatistics stats = meter.GetStatistics(kStartNs);
+    EXPECT_EQ(stats.callbackCount, 2u);
+    EXPECT_EQ(stats.callbackMeanNs, 2000u);
+    EXPECT_GE(stats.callbackMaxNs, 2950u);
+}
+
+TEST(FrameRateMeter, Reset) {
+    FrameRateMeter meter;
+    const uint64_t lastNs = FeedFrames(meter, kStartNs, 10 * kMs, 50, 100);
+    meter.RecordCallback(1000);
+    meter.Reset();
+
+    DetectorStatistics stats = meter.GetStatistics(lastNs);
+    EXPECT_EQ(stats.framesDelivered, 0u);
+    EXPECT_DOUBLE_EQ(stats.windowFps, 0.0);
+    EXPECT_EQ(stats.callbackCount, 0u);
+}
@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameRecorder.h"
+#include "uxdi/RecordingFormat.h"
+#include "test_helpers.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+using namespace uxdi;
+using namespace uxdi::recording;
+
+// ============================================================================
+// Test fixture for FrameRecorder tests
+// ============================================================================
+
+class FrameRecorderTest : public test::TempDirTest {
+protected:
+    FrameRecorderTest() : TempDirTest("uxdi_recorder_") {}
+
+    std::string path;
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        path = (dir / "recording.uxdr").string();
+    }
+
+    static ImageData MakeFrame(uint64_t frameNumber, uint32_t width = 16, uint32_t height = 8) {
+        return test::MakeTestFrame(frameNumber, 1000.0 + static_cast<double>(frameNumber) / 30.0,
+                                   {width, height, 16}, [&](size_t i) { return i + frameNumber; });
+    }
+
+    static uint64_t FrameRecordSize(const ImageData& image) {
+        return sizeof(FrameRecordHeader) + image.dataLength;
+    }
+
+    // Journal byte offset just after the given number of records
+    static uint64_t JournalOffset(uint64_t records) {
+        return sizeof(JournalHeader) + records * sizeof(JournalRecord);
+    }
+};
+
+// ============================================================================
+// CRC tests
+// ============================================================================
+
+TEST_F(FrameRecorderTest, Crc32KnownVector) {
+    const char* input = "123456789";
+    EXPECT_EQ(ComputeCrc32(input, std::strlen(input)), 0xCBF43926u);
+}
+
+TEST_F(FrameRecorderTest, Crc32Incremental) {
+    const char* input = "The quick brown fox jumps over the lazy dog";
+    const size_t length = std::strlen(input);
+    uint32_t whole = ComputeCrc32(input, length);
+    uint32_t partial = ComputeCrc32(input, 13);
+    partial = ComputeCrc32(input + 13, length - 13, partial);
+    EXPECT_EQ(whole, partial);
+}
+
+// ============================================================================
+// Recording tests
+// ============================================================================
+
+TEST_F(FrameRecorderTest, WriteRequiresOpen) {
+    FrameRecorder recorder;
+    EXPECT_FALSE(recorder.IsOpen());
+    EXPECT_FALSE(recorder.WriteFrame(MakeFrame(1)));
+    EXPECT_EQ(recorder.GetLastError().code, ErrorCode::STATE_ERROR);
+}
+
+TEST_F(FrameRecorderTest, OpenTwiceFails) {
+    FrameRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+    EXPECT_FALSE(recorder.Open(path));
+    EXPECT_TRUE(recorder.Close());
+}
+
+TEST_F(FrameRecorderTest, CheckpointsAtFrameInterval) {
+    RecorderOptions options;
+    options.checkpointIntervalFrames = 4;
+    options.checkpointIntervalMs = 0;
+    FrameRecorder recorder(options);
+    ASSERT_TRUE(recorder.Open(path));
+
+    for (uint64_t i = 1; i <= 10; ++i) {
+        ASSERT_TRUE(recorder.WriteFrame(MakeFrame(i)));
+    }
+
+    EXPECT_EQ(recorder.GetFrameCount(), 10u);
+    EXPECT_EQ(recorder.GetCheckpointedFrameCount(), 8u);
+    EXPECT_TRUE(recorder.Close());
+}
+
+TEST_F(FrameRecorderTest, WriteErrorStopsRecording) {
+#if defined(__linux__)
+    RecorderOptions options;
+    options.checkpointIntervalFrames = 0;
+    options.checkpointIntervalMs = 0;
+    options.writeBufferBytes = 4096;  // Payloads bypass the buffer
+    FrameRecorder recorder(options);
+    ASSERT_TRUE(recorder.Open(path));
+    ASSERT_TRUE(recorder.WriteFrame(MakeFrame(1, 256, 256)));
+    ASSERT_TRUE(recorder.WriteFrame(MakeFrame(2, 256, 256)));
+    ASSERT_TRUE(recorder.Checkpoint());
+
+    // A file size limit stands in for a full disk: the next payload is torn
+    rlimit saved{};
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &saved), 0);
+    const auto savedHandler = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit limited = saved;
+    limited.rlim_cur = static_cast<rlim_t>(std::filesystem::file_size(path) + 4096);
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limited), 0);
+    const bool thirdWritten = recorder.WriteFrame(MakeFrame(3, 256, 256));
+    setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, savedHandler);
+
+    EXPECT_FALSE(thirdWritten);
+    EXPECT_EQ(recorder.GetLastError().code, ErrorCode::HARDWARE_ERROR);
+
+    // Writing on would index frames at the wrong offsets
+    EXPECT_FALSE(recorder.WriteFrame(MakeFrame(4, 256, 256)));
+    EXPECT_FALSE(recorder.WriteReference(MakeFrame(5, 256, 256), 4));
+    EXPECT_FALSE(recorder.Checkpoint());
+    EXPECT_EQ(recorder.GetLastError().code, ErrorCode::STATE_ERROR);
+    EXPECT_EQ(recorder.GetFrameCount(), 2u);
+    EXPECT_FALSE(recorder.Close());
+    EXPECT_FALSE(recorder.IsOpen());
+
+    RecoveryReport report;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &report));
+    EXPECT_EQ(report.framesRecovered, 2u);
+    EXPECT_EQ(report.framesFromJournal, 2u);
+    EXPECT_GT(report.bytesTruncated, 0u);
+
+    // Reopening starts a fresh recording
+    ASSERT_TRUE(recorder.Open(path));
+    EXPECT_TRUE(recorder.WriteFrame(MakeFrame(1)));
+    EXPECT_TRUE(recorder.Close());
+#else
+    GTEST_SKIP() << "Needs RLIMIT_FSIZE to simulate a full disk";
+#endif
+}
+
+TEST_F(FrameRecorderTest, CleanRecordingRecoversFromJournalOnly) {
+    {
+        FrameRecorder recorder;
+        ASSERT_TRUE(recorder.Open(path));
+        for (uint64_t i = 1; i <= 10; ++i) {
+            ASSERT_TRUE(recorder.WriteFrame(MakeFrame(i)));
+        }
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    RecoveryReport report;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &report));
+    EXPECT_TRUE(report.journalFound);
+    EXPECT_EQ(report.framesRecovered, 10u);
+    EXPECT_EQ(report.framesFromJournal, 10u);
+    EXPECT_EQ(report.framesRescanned, 0u);
+    EXPECT_EQ(report.bytesScanned, 0u);
+    EXPECT_EQ(report.bytesTruncated, 0u);
+}
+
+TEST_F(FrameRecorderTest, RecoverTornTailScansOnlySinceCheckpoint) {
+    RecorderOptions options;
+    options.checkpointIntervalFrames = 8;
+    options.checkpointIntervalMs = 0;
+    const ImageData sample = MakeFrame(0);
+
+    {
+        FrameRecorder recorder(options);
+        ASSERT_TRUE(recorder.Open(path));
+        for (uint64_t i = 1; i <= 20; ++i) {
+            ASSERT_TRUE(recorder.WriteFrame(MakeFrame(i)));
+        }
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    // Simulate a crash: journal loses everything after the checkpoint at
+    // frame 16 and the container is torn in the middle of frame 20.
+    // Journal: 8 index, ckpt, 8 index, ckpt, 4 index, ckpt
+    std::filesystem::resize_file(path + kJournalSuffix, JournalOffset(18));
+    const uint64_t frame20Start = sizeof(ContainerHeader) + 19 * FrameRecordSize(sample);
+    std::filesystem::resize_file(path, frame20Start + sizeof(FrameRecordHeader) + 10);
+
+    RecoveryReport report;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &report));
+    EXPECT_EQ(report.framesFromJournal, 16u);
+    EXPECT_EQ(report.framesRescanned, 3u);
+    EXPECT_EQ(report.framesRecovered, 19u);
+    EXPECT_EQ(report.bytesScanned, 3 * FrameRecordSize(sample));
+    EXPECT_EQ(report.bytesTruncated, sizeof(FrameRecordHeader) + 10);
+    EXPECT_EQ(std::filesystem::file_size(path), frame20Start);
+
+    // A second recovery finds a clean recording
+    RecoveryReport second;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &second));
+    EXPECT_EQ(second.framesFromJournal, 19u);
+    EXPECT_EQ(second.framesRescanned, 0u);
+    EXPECT_EQ(second.bytesTruncated, 0u);
+}
+
+TEST_F(FrameRecorderTest, RecoverStopsAtCorruptPayload) {
+    RecorderOptions options;
+    options.checkpointIntervalFrames = 0;
+    options.checkpointIntervalMs = 0;
+    const ImageData sample = MakeFrame(0);
+
+    {
+        FrameRecorder recorder(options);
+        ASSERT_TRUE(recorder.Open(path));
+        for (uint64_t i = 1; i <= 6; ++i) {
+            ASSERT_TRUE(recorder.WriteFrame(MakeFrame(i)));
+        }
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    // Drop the final checkpoint so recovery must scan, and flip a payload
+    // byte in frame 4
+    std::filesystem::resize_file(path + kJournalSuffix, JournalOffset(6));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const uint64_t offset = sizeof(ContainerHeader) + 3 * FrameRecordSize(sample) +
+                                sizeof(FrameRecordHeader) + 5;
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put(static_cast<char>(0x5A));
+    }
+
+    RecoveryReport report;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &report));
+    EXPECT_EQ(report.framesFromJournal, 0u);
+    EXPECT_EQ(report.framesRecovered, 3u);
+    EXPECT_EQ(report.bytesTruncated, 3 * FrameRecordSize(sample));
+}
+
+TEST_F(FrameRecorderTest, RecoverWithoutJournalRescansContainer) {
+    {
+        FrameRecorder recorder;
+        ASSERT_TRUE(recorder.Open(path));
+        for (uint64_t i = 1; i <= 5; ++i) {
+            ASSERT_TRUE(recorder.WriteFrame(MakeFrame(i)));
+        }
+        ASSERT_TRUE(recorder.Close());
+    }
+    std::filesystem::remove(path + kJournalSuffix);
+
+    RecoveryReport report;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &report));
+    EXPECT_FALSE(report.journalFound);
+    EXPECT_EQ(report.framesRescanned, 5u);
+    EXPECT_TRUE(std::filesystem::exists(path + kJournalSuffix));
+
+    RecoveryReport second;
+    ASSERT_TRUE(FrameRecorder::Recover(path, &second));
+    EXPECT_TRUE(second.journalFound);
+    EXPECT_EQ(second.framesFromJournal, 5u);
+}
+
+TEST_F(FrameRecorderTest, RecoverRejectsMissingOrForeignFile) {
+    EXPECT_FALSE(FrameRecorder::Recover((dir / "missing.uxdr").string()));
+
+    std::ofstream((dir / "foreign.bin").string(), std::ios::binary)
+        << std::string(128, 'x');
+    EXPECT_FALSE(FrameRecorder::Recover((dir / "foreign.bin").string()));
+}
+
+TEST_F(FrameRecorderTest, ReferenceFramesHaveNoPayload) {
+    {
+        FrameRecorder recorder;
+        ASSERT_TRUE(recorder.Open(path));
+        ASSERT_TRUE(recorder.WriteFrame(MakeFrame(1)));
+        ASSERT_TRUE(recorder.WriteReference(MakeFrame(2), 1));
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(path),
+              sizeof(ContainerHeader) + FrameRecordSize(MakeFrame(1)) + sizeof(FrameRecordHeader));
+}
+
+TEST_F(FrameRecorderTest, ListenerRecordsReceivedFrames) {
+    FrameRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    IDetectorListener* listener = &recorder;
+    listener->onAcquisitionStarted();
+    listener->onImageReceived(MakeFrame(1));
+    listener->onImageReceived(MakeFrame(2));
+    listener->onAcquisitionStopped();
+
+    EXPECT_EQ(recorder.GetFrameCount(), 2u);
+    EXPECT_EQ(recorder.GetCheckpointedFrameCount(), 2u);
+}
+
+TEST_F(FrameRecorderTest, DeduplicationWritesReferences) {
+    RecorderOptions options;
+    options.deduplicate = true;
+    {
+        FrameRecorder recorder(options);
+        ASSERT_TRUE(recorder.Open(path));
+        for (int i = 0; i < 5; ++i) {
+            ImageData image = MakeFrame(1);
+            image.frameNumber = 1 + i;
+            ASSERT_TRUE(recorder.WriteFrame(image));
+        }
+        EXPECT_EQ(recorder.GetFrameCount(), 5u);
+        EXPECT_EQ(recorder.GetStaticFrameCount(), 4u);
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(path),
+              sizeof(ContainerHeader) + FrameRecordSize(MakeFrame(1)) + 4 * sizeof(FrameRecordHeader));
+}
+
+TEST_F(FrameRecorderTest, DeduplicationCanSkipStaticFrames) {
+    RecorderOptions options;
+    options.deduplicate = true;
+    options.skipStaticFrames = true;
+    FrameRecorder recorder(options);
+    ASSERT_TRUE(recorder.Open(path));
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(recorder.WriteFrame(MakeFrame(1)));
+    }
+    ASSERT_TRUE(recorder.WriteFrame(MakeFrame(50)));
+
+    EXPECT_EQ(recorder.GetFrameCount(), 2u);
+    EXPECT_EQ(recorder.GetStaticFrameCount(), 4u);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameSequenceTracker.h"
+#include <cmath>
+
+using namespace uxdi;
+
+// Feeds frame numbers 1 ms apart
+static void Feed(FrameSequenceTracker& tracker, std::initializer_list<uint64_t> frames) {
+    static uint64_t nowNs = 0;
+    for (uint64_t n : frames) {
+        nowNs += 1000000;
+        tracker.Record(n, nowNs);
+    }
+}
+
+// ============================================================================
+// Continuity
+// ============================================================================
+
+TEST(FrameSequenceTracker, ContiguousStreamIsClean) {
+    FrameSequenceTracker tracker;
+    Feed(tracker, {5, 6, 7, 8, 9});
+
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.received, 5u);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.duplicated, 0u);
+    EXPECT_EQ(stats.outOfOrder, 0u);
+    EXPECT_EQ(stats.firstFrameNumber, 5u);
+    EXPECT_EQ(stats.highestFrameNumber, 9u);
+}
+
+TEST(FrameSequenceTracker, GapsCountAsDropped) {
+    FrameSequenceTracker tracker;
+    Feed(tracker, {0, 1, 4, 5, 9});
+
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.dropped, 5u);
+    EXPECT_EQ(stats.outOfOrder, 0u);
+}
+
+TEST(FrameSequenceTracker, LateFrameFillsGap) {
+    FrameSequenceTracker tracker;
+    Feed(tracker, {1, 2, 4, 3, 5});
+
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.outOfOrder, 1u);
+    EXPECT_EQ(stats.duplicated, 0u);
+}
+
+TEST(FrameSequenceTracker, RepeatsCountAsDuplicated) {
+    FrameSequenceTracker tracker;
+    Feed(tracker, {1, 2, 2, 3, 1, 4});
+
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.received, 6u);
+    EXPECT_EQ(stats.duplicated, 2u);
+    EXPECT_EQ(stats.outOfOrder, 0u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(FrameSequenceTracker, LargeJumpAndStaleFrames) {
+    FrameSequenceTracker tracker;
+    Feed(tracker, {10, 5000});
+    EXPECT_EQ(tracker.GetStats().dropped, 4989u);
+
+    // Beyond the reorder window: cannot tell late from duplicate
+    Feed(tracker, {11, 10});
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.outOfOrder, 2u);
+    EXPECT_EQ(stats.duplicated, 0u);
+    EXPECT_EQ(stats.dropped, 4989u);
+
+    // Inside the window after the jump, 4999 was never seen
+    Feed(tracker, {4999, 4999});
+    stats = tracker.GetStats();
+    EXPECT_EQ(stats.outOfOrder, 3u);
+    EXPECT_EQ(stats.duplicated, 1u);
+    EXPECT_EQ(stats.dropped, 4988u);
+}
+
+// ============================================================================
+// Inter-arrival statistics
+// ============================================================================
+
+TEST(FrameSequenceTracker, IntervalsAndJitter) {
+    FrameSequenceTracker tracker;
+    const uint64_t arrivals[] = {0, 10000, 20000, 30000, 40000};
+    for (uint64_t i = 0; i < 5; ++i) {
+        tracker.Record(i, 1000000 + arrivals[i]);
+    }
+
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.interval.count, 4u);
+    EXPECT_EQ(stats.interval.minNs, 10000u);
+    EXPECT_EQ(stats.interval.maxNs, 10000u);
+    EXPECT_DOUBLE_EQ(stats.intervalStdDevNs, 0.0);
+
+    tracker.Record(5, 1000000 + 70000);  // One 30 us interval
+    stats = tracker.GetStats();
+    EXPECT_EQ(stats.interval.maxNs, 30000u);
+    // Intervals 10,10,10,10,30 us: sample stddev is sqrt(80) us
+    EXPECT_NEAR(stats.intervalStdDevNs, std::sqrt(80.0) * 1000.0, 1.0);
+}
+
+TEST(FrameSequenceTracker, ResetStartsNewStream) {
+    FrameSequenceTracker tracker;
+    Feed(tracker, {1, 3, 3});
+    tracker.Reset();
+
+    FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_EQ(stats.received, 0u);
+    EXPECT_EQ(stats.interval.count, 0u);
+
+    Feed(tracker, {100, 101});
+    stats = tracker.GetStats();
+    EXPECT_EQ(stats.firstFrameNumber, 100u);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.duplicated, 0u);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <uxdi/Types.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace uxdi::test {
+
+// ============================================================================
+// Scratch directories
+// ============================================================================
+
+/**
+ * @brief Fixture giving each test an empty directory named after the test
+ *
+ * The directory is prefix + test name under the system temp directory,
+ * created in SetUp() and removed with everything in it in TearDown().
+ */
+class TempDirTest : public ::testing::Test {
+protected:
+    explicit TempDirTest(std::string prefix) : m_prefix(std::move(prefix)) {}
+
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        dir = std::filesystem::temp_directory_path() / (m_prefix + info->name());
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+private:
+    std::string m_prefix;
+};
+
+// ============================================================================
+// Frames
+// ============================================================================
+
+/**
+ * @brief Geometry of a test frame; pixels wider than 8 bits take two bytes
+ */
+struct TestFrameShape {
+    uint32_t width = 16;
+    uint32_t height = 8;
+    uint32_t bitDepth = 16;
+};
+
+/**
+ * @brief Build an owned frame whose byte i is fill(i)
+ *
+ * A shape with no pixels gives a frame without a buffer.
+ */
+template <typename Fill>
+ImageData MakeTestFrame(uint64_t frameNumber, double timestamp, const TestFrameShape& shape, Fill&& fill) {
+    ImageData image;
+    image.width = shape.width;
+    image.height = shape.height;
+    image.bitDepth = shape.bitDepth;
+    image.frameNumber = frameNumber;
+    image.timestamp = timestamp;
+    image.dataLength = static_cast<size_t>(shape.width) * shape.height * (shape.bitDepth > 8 ? 2 : 1);
+    if (image.dataLength > 0) {
+        image.data = std::shared_ptr<uint8_t[]>(new uint8_t[image.dataLength]);
+        for (size_t i = 0; i < image.dataLength; ++i) {
+            image.data[i] = static_cast<uint8_t>(fill(i));
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Build an owned, zero-filled frame
+ */
+inline ImageData MakeTestFrame(uint64_t frameNumber, double timestamp = 0.0, const TestFrameShape& shape = {}) {
+    return MakeTestFrame(frameNumber, timestamp, shape, [](size_t) { return 0; });
+}
+
+} // namespace uxdi::test
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "uxdi/JsonReader.h"
+#include <string>
+#include <vector>
+
+using namespace uxdi;
+
+// ============================================================================
+// Values
+// ============================================================================
+
+TEST(JsonReader, ReadsScalarsAndNesting) {
+    const std::string text = R"({"name": "soak", "count": 12, "ratio": -2.5e-1, "on": true,
+                                 "off": false, "none": null,
+                                 "generator": {"seed": 42, "noise": "poisson"}})";
+    JsonDocument document;
+    ASSERT_TRUE(document.Parse(text)) << document.GetError().Format();
+
+    const JsonValue root = document.Root();
+    ASSERT_TRUE(root.IsObject());
+    EXPECT_EQ(root.Size(), 7u);
+    EXPECT_EQ(root["name"].AsString(), "soak");
+    EXPECT_EQ(root["count"].AsInt(), 12);
+    EXPECT_DOUBLE_EQ(*root["ratio"].AsDouble(), -0.25);
+    EXPECT_EQ(root["on"].AsBool(), true);
+    EXPECT_EQ(root["off"].AsBool(), false);
+    EXPECT_EQ(root["none"].GetType(), JsonType::Null);
+    EXPECT_EQ(root["generator"]["seed"].AsInt(), 42);
+
+    // Lookups are per object: nested keys are not found from the root
+    EXPECT_FALSE(root["seed"]);
+    EXPECT_FALSE(root["missing"]["deeper"]);
+    EXPECT_EQ(root["name"].AsInt(), std::nullopt);
+    EXPECT_EQ(root["count"].AsString(), std::nullopt);
+}
+
+TEST(JsonReader, IteratesArraysSkippingNestedValues) {
+    const std::string text = R"({"actions": [{"type": "wait", "extra": [1, [2, 3], {"a": {}}]},
+                                             {"type": "acquire"}, 7, "x"]})";
+    JsonDocument document;
+    ASSERT_TRUE(document.Parse(text));
+
+    const JsonValue actions = document.Root()["actions"];
+    ASSERT_TRUE(actions.IsArray());
+    EXPECT_EQ(actions.Size(), 4u);
+
+    std::vector<std::string> raw;
+    for (const JsonValue action : actions) {
+        raw.emplace_back(action.IsObject() ? action["type"].Raw() : action.Raw());
+    }
+    EXPECT_EQ(raw, (std::vector<std::string>{"wait", "acquire", "7", "x"}));
+
+    std::vector<std::string> keys;
+    const JsonValue first = *actions.begin();
+    for (const JsonValue member : first) {
+        keys.emplace_back(member.Key());
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"type", "extra"}));
+}
+
+TEST(JsonReader, DecodesEscapes) {
+    const std::string text = R"({"path": "C:\\scenarios\\a.json", "quote": "say \"hi\"\n",
+                                 "unicode": "\u00e9\ud83d\ude00", "k\u0065y": 1})";
+    JsonDocument document;
+    ASSERT_TRUE(document.Parse(text));
+
+    const JsonValue root = document.Root();
+    EXPECT_EQ(root["path"].AsString(), "C:\\scenarios\\a.json");
+    EXPECT_EQ(root["quote"].AsString(), "say \"hi\"\n");
+    EXPECT_EQ(root["unicode"].AsString(), "\xC3\xA9\xF0\x9F\x98\x80");
+    EXPECT_EQ(root["key"].AsInt(), 1);
+}
+
+TEST(JsonReader, IntegersFromIntegralNumbers) {
+    JsonDocument document;
+    ASSERT_TRUE(document.Parse(R"([5, 5.0, 1e3, 5.5, -0, 99999999999999999999])"));
+
+    std::vector<std::optional<int64_t>> values;
+    for (const JsonValue value : document.Root()) {
+        values.push_back(value.AsInt());
+    }
+    EXPECT_EQ(values[0], 5);
+    EXPECT_EQ(values[1], 5);
+    EXPECT_EQ(values[2], 1000);
+    EXPECT_EQ(values[3], std::nullopt);
+    EXPECT_EQ(values[4], 0);
+    EXPECT_EQ(values[5], std::nullopt);
+}
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+TEST(JsonReader, ReportsErrorPosition) {
+    const std::string text = "{\n  \"name\": \"broken\",\n  \"count\" 3\n}";
+    JsonDocument document;
+    EXPECT_FALSE(document.Parse(text));
+    EXPECT_FALSE(document.Root());
+
+    const JsonError& error = document.GetError();
+    EXPECT_EQ(error.line, 3u);
+    EXPECT_EQ(error.column, 11u);
+    EXPECT_EQ(error.offset, text.find(" 3") + 1);
+    EXPECT_EQ(error.Format(), "line 3, column 11: expected ':'");
+}
+
+TEST(JsonReader, RejectsMalformedDocuments) {
+    const char* malformed[] = {
+        "",
+        "{",
+        R"({"a": 1,})",
+        R"([1, 2)",
+        R"({"a": 01})",
+        R"({"a": 1.})",
+        R"({"a": tru})",
+        R"({"a": "unterminated})",
+        R"({"a": "bad \q escape"})",
+        R"({a: 1})",
+        R"({"a": 1} trailing)",
+        "\"tab\tinside\"",
+    };
+    for (const char* text : malformed) {
+        JsonDocument document;
+        EXPECT_FALSE(document.Parse(text)) << text;
+        EXPECT_FALSE(document.GetError().message.empty()) << text;
+    }
+}
+
+TEST(JsonReader, RejectsExcessiveNesting) {
+    const std::string deep(JsonDocument::kMaxDepth + 1, '[');
+    JsonDocument document;
+    EXPECT_FALSE(document.Parse(deep + std::string(JsonDocument::kMaxDepth + 1, ']')));
+    EXPECT_EQ(document.GetError().message, "nesting too deep");
+
+    const std::string allowed(JsonDocument::kMaxDepth, '[');
+    EXPECT_TRUE(document.Parse(allowed + std::string(JsonDocument::kMaxDepth, ']')));
+}
+
+// ============================================================================
+// Scale
+// ============================================================================
+
+TEST(JsonReader, LargeScenarioIsOneValuePerNode) {
+    std::string text = R"({"name": "long soak", "actions": [)";
+    constexpr size_t kActions = 10000;
+    for (size_t i = 0; i < kActions; ++i) {
+        text += i ? "," : "";
+        text += R"({"type": "acquire", "count": 10, "interval_ms": 16.667})";
+    }
+    text += "]}";
+
+    JsonDocument document;
+    ASSERT_TRUE(document.Parse(text));
+    EXPECT_EQ(document.GetValueCount(), 3 + kActions * 4);
+
+    size_t frames = 0;
+    for (const JsonValue action : document.Root()["actions"]) {
+        frames += static_cast<size_t>(action["count"].AsInt().value_or(0));
+    }
+    EXPECT_EQ(frames, kActions * 10);
+}
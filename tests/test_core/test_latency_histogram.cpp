@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "uxdi/LatencyHistogram.h"
+#include <thread>
+#include <vector>
+
+using namespace uxdi;
+
+// Percentiles are bucket upper bounds: exact below 128 ns, within 1/64 above
+static void ExpectWithinPrecision(uint64_t actual, uint64_t expected) {
+    EXPECT_GE(actual, expected);
+    EXPECT_LE(static_cast<double>(actual), static_cast<double>(expected) * (1.0 + 1.0 / 64.0) + 1.0);
+}
+
+// ============================================================================
+// Basic statistics
+// ============================================================================
+
+TEST(LatencyHistogram, EmptyHistogramReportsZeros) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetCount(), 0u);
+    EXPECT_EQ(histogram.GetMin(), 0u);
+    EXPECT_EQ(histogram.GetMax(), 0u);
+    EXPECT_EQ(histogram.GetPercentile(50.0), 0u);
+
+    LatencySummary summary = histogram.Summarize();
+    EXPECT_EQ(summary.count, 0u);
+    EXPECT_EQ(summary.p999Ns, 0u);
+}
+
+TEST(LatencyHistogram, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 100; ++v) {
+        histogram.Record(v);
+    }
+    EXPECT_EQ(histogram.GetCount(), 100u);
+    EXPECT_EQ(histogram.GetMin(), 1u);
+    EXPECT_EQ(histogram.GetMax(), 100u);
+    EXPECT_DOUBLE_EQ(histogram.GetMean(), 50.5);
+    EXPECT_EQ(histogram.GetPercentile(50.0), 50u);
+    EXPECT_EQ(histogram.GetPercentile(99.0), 99u);
+    EXPECT_EQ(histogram.GetPercentile(100.0), 100u);
+}
+
+TEST(LatencyHistogram, LargeValuesWithinRelativePrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        histogram.Record(v * 1000);  // 1 us .. 10 ms
+    }
+    ExpectWithinPrecision(histogram.GetPercentile(50.0), 5000 * 1000);
+    ExpectWithinPrecision(histogram.GetPercentile(99.0), 9900 * 1000);
+    ExpectWithinPrecision(histogram.GetPercentile(99.9), 9990 * 1000);
+    EXPECT_EQ(histogram.GetPercentile(100.0), 10000u * 1000);
+}
+
+TEST(LatencyHistogram, SummaryMatchesPercentiles) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 0; v < 5000; ++v) {
+        histogram.Record(200 + v * 37);
+    }
+    LatencySummary summary = histogram.Summarize();
+    EXPECT_EQ(summary.count, 5000u);
+    EXPECT_EQ(summary.minNs, 200u);
+    EXPECT_EQ(summary.p50Ns, histogram.GetPercentile(50.0));
+    EXPECT_EQ(summary.p99Ns, histogram.GetPercentile(99.0));
+    EXPECT_EQ(summary.p999Ns, histogram.GetPercentile(99.9));
+    EXPECT_LE(summary.p50Ns, summary.p99Ns);
+    EXPECT_LE(summary.p99Ns, summary.p999Ns);
+    EXPECT_LE(summary.p999Ns, summary.maxNs);
+}
+
+TEST(LatencyHistogram, TailIsNotHiddenByMedian) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 990; ++i) {
+        histogram.Record(1000);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.Record(5000000);
+    }
+    ExpectWithinPrecision(histogram.GetPercentile(50.0), 1000);
+    ExpectWithinPrecision(histogram.GetPercentile(99.0), 1000);
+    ExpectWithinPrecision(histogram.GetPercentile(99.9), 5000000);
+}
+
+TEST(LatencyHistogram, HugeValuesAreClamped) {
+    LatencyHistogram histogram;
+    histogram.Record(UINT64_MAX);
+    EXPECT_EQ(histogram.GetCount(), 1u);
+    EXPECT_EQ(histogram.GetMax(), UINT64_MAX);
+    EXPECT_GE(histogram.GetPercentile(50.0), LatencyHistogram::kMaxTrackableNs / 2);
+}
+
+TEST(LatencyHistogram, ResetDiscardsSamples) {
+    LatencyHistogram histogram;
+    histogram.Record(42);
+    histogram.Reset();
+    EXPECT_EQ(histogram.GetCount(), 0u);
+    EXPECT_EQ(histogram.GetMin(), 0u);
+    histogram.Record(7);
+    EXPECT_EQ(histogram.GetMin(), 7u);
+    EXPECT_EQ(histogram.GetMax(), 7u);
+}
+
+TEST(LatencyHistogram, ConcurrentRecording) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram]() {
+            for (uint64_t v = 1; v <= 10000; ++v) {
+                histogram.Record(v);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(histogram.GetCount(), 40000u);
+    EXPECT_EQ(histogram.Summarize().count, 40000u);
+    EXPECT_EQ(histogram.GetMin(), 1u);
+    EXPECT_EQ(histogram.GetMax(), 10000u);
+}
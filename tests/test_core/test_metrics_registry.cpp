@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameDispatcher.h"
+#include "uxdi/MetricsRegistry.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace uxdi;
+
+static bool Contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+// ============================================================================
+// Series registration
+// ============================================================================
+
+TEST(MetricsRegistry, SameNameAndLabelsReturnSameSeries) {
+    MetricsRegistry registry;
+    MetricCounter& a = registry.GetCounter("frames_total", "Frames", {{"detector", "1"}});
+    MetricCounter& b = registry.GetCounter("frames_total", "Frames", {{"detector", "1"}});
+    MetricCounter& c = registry.GetCounter("frames_total", "Frames", {{"detector", "2"}});
+
+    EXPECT_EQ(&a, &b);
+    EXPECT_NE(&a, &c);
+}
+
+TEST(MetricsRegistry, RejectsTypeConflictsAndBadNames) {
+    MetricsRegistry registry;
+    registry.GetCounter("frames_total", "Frames");
+
+    EXPECT_THROW(registry.GetGauge("frames_total", "Frames"), std::invalid_argument);
+    EXPECT_THROW(registry.GetCounter("9frames", "Frames"), std::invalid_argument);
+    EXPECT_THROW(registry.GetCounter("frames-total", "Frames"), std::invalid_argument);
+    EXPECT_THROW(registry.GetHistogram("latency_seconds", "Latency", {{"quantile", "x"}}), std::invalid_argument);
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+TEST(MetricsRegistry, CounterSumsAcrossThreads) {
+    MetricsRegistry registry;
+    MetricCounter& counter = registry.GetCounter("events_total", "Events");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&counter] {
+            for (int i = 0; i < 10000; ++i) {
+                counter.Increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    counter.Increment(5);
+
+    EXPECT_EQ(counter.GetValue(), 80005u);
+}
+
+TEST(MetricsRegistry, GaugeSetAndAdd) {
+    MetricsRegistry registry;
+    MetricGauge& gauge = registry.GetGauge("queue_depth", "Depth");
+    gauge.Set(10);
+    gauge.Add(-3);
+    EXPECT_EQ(gauge.GetValue(), 7);
+}
+
+TEST(MetricsRegistry, SnapshotIsOrderedByName) {
+    MetricsRegistry registry;
+    registry.GetGauge("b_gauge", "B").Set(2);
+    registry.GetCounter("a_total", "A").Increment(3);
+    registry.GetHistogram("c_seconds", "C").Record(1000);
+
+    std::vector<MetricSample> samples = registry.Snapshot();
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_EQ(samples[0].name, "a_total");
+    EXPECT_DOUBLE_EQ(samples[0].value, 3.0);
+    EXPECT_EQ(samples[1].type, MetricType::Gauge);
+    EXPECT_DOUBLE_EQ(samples[1].value, 2.0);
+    EXPECT_EQ(samples[2].type, MetricType::Summary);
+    EXPECT_EQ(samples[2].summary.count, 1u);
+}
+
+// ============================================================================
+// Prometheus export
+// ============================================================================
+
+TEST(MetricsRegistry, FormatPrometheus) {
+    MetricsRegistry registry;
+    registry.GetCounter("uxdi_frames_total", "Frames delivered", {{"detector", "1"}}).Increment(42);
+    registry.GetCounter("uxdi_frames_total", "Frames delivered", {{"detector", "2"}}).Increment(7);
+    registry.GetGauge("uxdi_label_test", "Escaping", {{"path", "a\"b\\c"}}).Set(-1);
+    LatencyHistogram& latency = registry.GetHistogram("uxdi_latency_seconds", "Latency");
+    latency.Record(1000000);
+    latency.Record(3000000);
+
+    const std::string text = registry.FormatPrometheus();
+    EXPECT_TRUE(Contains(text, "# HELP uxdi_frames_total Frames delivered\n# TYPE uxdi_frames_total counter\n"));
+    EXPECT_TRUE(Contains(text, "uxdi_frames_total{detector=\"1\"} 42\n"));
+    EXPECT_TRUE(Contains(text, "uxdi_frames_total{detector=\"2\"} 7\n"));
+    EXPECT_TRUE(Contains(text, "uxdi_label_test{path=\"a\\\"b\\\\c\"} -1\n"));
+    EXPECT_TRUE(Contains(text, "# TYPE uxdi_latency_seconds summary\n"));
+    EXPECT_TRUE(Contains(text, "uxdi_latency_seconds{quantile=\"0.5\"} 0.001"));
+    EXPECT_TRUE(Contains(text, "uxdi_latency_seconds_sum 0.004"));
+    EXPECT_TRUE(Contains(text, "uxdi_latency_seconds_count 2\n"));
+
+    // One HELP line per family, not per series
+    EXPECT_EQ(text.find("# HELP uxdi_frames_total"), text.rfind("# HELP uxdi_frames_total"));
+}
+
+TEST(MetricsRegistry, WritePrometheusReplacesFile) {
+    const auto path = std::filesystem::temp_directory_path() / "uxdi_metrics_test.prom";
+    MetricsRegistry registry;
+    registry.GetCounter("uxdi_written_total", "Written").Increment();
+
+    ASSERT_TRUE(registry.WritePrometheus(path.string()));
+    registry.GetCounter("uxdi_written_total", "Written").Increment();
+    ASSERT_TRUE(registry.WritePrometheus(path.string()));
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_TRUE(Contains(contents.str(), "uxdi_written_total 2\n"));
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(registry.WritePrometheus("/nonexistent_dir/uxdi/metrics.prom"));
+}
+
+// ============================================================================
+// FrameDispatcher reporting
+// ============================================================================
+
+TEST(MetricsRegistry, DispatcherReportsFramesErrorsAndStates) {
+    MetricsRegistry registry;
+    FrameDispatcher dispatcher;
+    dispatcher.BindMetrics(registry, {{"detector", "7"}});
+
+    ImageData image;
+    image.dataLength = 1024;
+    image.latency.sdkDeliveryNs = MonotonicNowNs();
+    dispatcher.onImageReceived(image);
+    dispatcher.onImageReceived(image);
+
+    ErrorInfo error;
+    error.code = ErrorCode::TIMEOUT;
+    dispatcher.onError(error);
+    dispatcher.onStateChanged(DetectorState::ACQUIRING);
+
+    const MetricLabels labels = {{"detector", "7"}};
+    EXPECT_EQ(registry.GetCounter("uxdi_frames_delivered_total", "", labels).GetValue(), 2u);
+    EXPECT_EQ(registry.GetCounter("uxdi_frame_bytes_total", "", labels).GetValue(), 2048u);
+    EXPECT_EQ(registry.GetHistogram("uxdi_frame_latency_seconds", "", labels).GetCount(), 2u);
+    EXPECT_EQ(registry.GetCounter("uxdi_detector_errors_total", "",
+                                  {{"detector", "7"}, {"code", "TIMEOUT"}}).GetValue(), 1u);
+    EXPECT_EQ(registry.GetCounter("uxdi_state_transitions_total", "",
+                                  {{"detector", "7"}, {"state", "ACQUIRING"}}).GetValue(), 1u);
+    EXPECT_EQ(registry.GetGauge("uxdi_detector_state", "", labels).GetValue(),
+              static_cast<int64_t>(DetectorState::ACQUIRING));
+}
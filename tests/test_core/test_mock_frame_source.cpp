@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "mock_frame_source.h"
+#include <atomic>
+#include <chrono>
+
+using namespace mock_sdk;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// Config parsing
+// ============================================================================
+
+TEST(MockFrameSource, ParsesTimingKeys) {
+    const FrameTimingConfig timing = parseFrameTimingConfig(
+        R"({"vendor": "samsung", "Frame_Rate": 250, "jitter": "normal", "jitter_ms": 1.5,)"
+        R"( "burst": 4, "max_rate": true, "pattern_frames": 2, "seed": 7})", 40.0);
+
+    EXPECT_DOUBLE_EQ(timing.frameRate, 250.0);
+    EXPECT_EQ(timing.jitter, JitterMode::Normal);
+    EXPECT_DOUBLE_EQ(timing.jitterMs, 1.5);
+    EXPECT_EQ(timing.burstSize, 4u);
+    EXPECT_TRUE(timing.maxRate);
+    EXPECT_EQ(timing.patternFrames, 2u);
+    EXPECT_EQ(timing.seed, 7u);
+}
+
+TEST(MockFrameSource, MissingOrInvalidKeysKeepDefaults) {
+    const FrameTimingConfig empty = parseFrameTimingConfig(nullptr, 40.0);
+    EXPECT_DOUBLE_EQ(empty.frameRate, 40.0);
+    EXPECT_EQ(empty.jitter, JitterMode::None);
+    EXPECT_EQ(empty.burstSize, 1u);
+    EXPECT_FALSE(empty.maxRate);
+
+    const FrameTimingConfig invalid = parseFrameTimingConfig(
+        R"({"frame_rate": -5, "burst": 0, "jitter": "sometimes"})", 50.0);
+    EXPECT_DOUBLE_EQ(invalid.frameRate, 50.0);
+    EXPECT_EQ(invalid.burstSize, 1u);
+    EXPECT_EQ(invalid.jitter, JitterMode::None);
+}
+
+// ============================================================================
+// Pacing
+// ============================================================================
+
+TEST(MockFrameSource, DeadlinesAreAbsolute) {
+    FrameTimingConfig timing;
+    timing.frameRate = 100.0;
+    FramePacer pacer(timing);
+    const auto start = FramePacer::Clock::time_point{} + 1s;
+    pacer.start(start);
+
+    for (int n = 1; n <= 1000; ++n) {
+        EXPECT_EQ(pacer.nextDeadline() - start, std::chrono::duration_cast<FramePacer::Clock::duration>(n * 10ms));
+    }
+}
+
+TEST(MockFrameSource, BurstsKeepAverageRate) {
+    FrameTimingConfig timing;
+    timing.frameRate = 100.0;
+    timing.burstSize = 3;
+    FramePacer pacer(timing);
+    const auto start = FramePacer::Clock::time_point{} + 1s;
+    pacer.start(start);
+
+    // Three frames due together every 30 ms
+    for (int burst = 1; burst <= 3; ++burst) {
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_EQ(pacer.nextDeadline() - start, burst * 30ms);
+        }
+    }
+}
+
+TEST(MockFrameSource, JitterNeverReordersFrames) {
+    FrameTimingConfig timing;
+    timing.frameRate = 1000.0;
+    timing.jitter = JitterMode::Uniform;
+    timing.jitterMs = 5.0;
+    timing.seed = 1;
+    FramePacer pacer(timing);
+    const auto start = FramePacer::Clock::time_point{} + 1s;
+    pacer.start(start);
+
+    auto previous = start;
+    for (int n = 1; n <= 1000; ++n) {
+        const auto deadline = pacer.nextDeadline();
+        EXPECT_GE(deadline, previous);
+        EXPECT_LE(deadline - start, n * 1ms + 5ms);
+        previous = deadline;
+    }
+    // Jitter is per frame, so the schedule has not drifted
+    EXPECT_GE(previous - start, 995ms);
+}
+
+TEST(MockFrameSource, MaxRateDoesNotWait) {
+    FrameTimingConfig timing;
+    timing.frameRate = 1.0;
+    timing.maxRate = true;
+    FramePacer pacer(timing);
+    pacer.start();
+
+    std::atomic<bool> running{true};
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(pacer.waitForNextFrame(running));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 1s);
+
+    running = false;
+    EXPECT_FALSE(pacer.waitForNextFrame(running));
+}
+
+// ============================================================================
+// Precomputed content
+// ============================================================================
+
+TEST(MockFrameSource, PatternBankCyclesImmutableSlots) {
+    PatternBank bank;
+    int evaluations = 0;
+    auto pattern = [&evaluations](uint32_t x, uint32_t y) {
+        ++evaluations;
+        return x + y * 10;
+    };
+
+    bank.prepare(4, 2, 3, 100, pattern);
+    EXPECT_EQ(evaluations, 8);
+    EXPECT_EQ(bank.slotCount(), 3u);
+    EXPECT_EQ(bank.frame(0)[5], 11);
+    EXPECT_EQ(bank.frame(1)[5], 111);
+    EXPECT_EQ(bank.frame(2)[5], 211);
+    EXPECT_EQ(bank.frame(3), bank.frame(0));
+
+    // Same resolution is not recomputed
+    bank.prepare(4, 2, 3, 100, pattern);
+    EXPECT_EQ(evaluations, 8);
+}
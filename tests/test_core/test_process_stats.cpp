@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "uxdi/ProcessStats.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace uxdi;
+
+#if defined(_WIN32) || defined(__linux__)
+
+TEST(ProcessStats, ReportsMemoryAndThreads) {
+    ProcessStats stats = SampleProcessStats();
+    EXPECT_GT(stats.residentBytes, 0u);
+    EXPECT_GE(stats.peakResidentBytes, stats.residentBytes);
+    EXPECT_GE(stats.threadCount, 1u);
+}
+
+TEST(ProcessStats, CountsNewThreads) {
+    const uint32_t before = SampleProcessStats().threadCount;
+
+    std::atomic<bool> release{false};
+    std::thread worker([&release] {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    const uint32_t during = SampleProcessStats().threadCount;
+    release = true;
+    worker.join();
+
+    EXPECT_EQ(during, before + 1);
+}
+
+TEST(ProcessStats, CpuTimeAdvancesWhileBusy) {
+    const uint64_t before = SampleProcessStats().cpuTimeNs;
+
+    // Spin until 20 ms of CPU time are reported; a loaded machine may
+    // need more wall time than that, so only give up after a few seconds
+    volatile uint64_t sink = 0;
+    uint64_t after = before;
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (after - before < 20'000'000u && std::chrono::steady_clock::now() < giveUp) {
+        for (int i = 0; i < 100000; ++i) {
+            sink = sink + 1;
+        }
+        after = SampleProcessStats().cpuTimeNs;
+    }
+
+    EXPECT_GE(after - before, 20'000'000u);
+}
+
+#endif
@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameRecorder.h"
+#include "uxdi/RecordingReader.h"
+#include "test_helpers.h"
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+using namespace uxdi;
+using namespace uxdi::recording;
+
+// ============================================================================
+// Test fixture for RecordingReader tests
+// ============================================================================
+
+class RecordingReaderTest : public test::TempDirTest {
+protected:
+    RecordingReaderTest() : TempDirTest("uxdi_reader_") {}
+
+    static constexpr size_t kFrameBytes = 256;
+
+    std::string path;
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        path = (dir / "recording.uxdr").string();
+    }
+
+    // Frame i has timestamp 10 + i * 0.1 and pixel bytes derived from fill
+    static ImageData MakeFrame(uint64_t frameNumber, uint8_t fill) {
+        return test::MakeTestFrame(frameNumber, 10.0 + static_cast<double>(frameNumber) * 0.1, {16, 8, 16},
+                                   [&](size_t i) { return fill + i; });
+    }
+
+    void WriteRecording(uint64_t frames, bool close = true) {
+        FrameRecorder recorder;
+        ASSERT_TRUE(recorder.Open(path));
+        for (uint64_t i = 0; i < frames; ++i) {
+            ASSERT_TRUE(recorder.WriteFrame(MakeFrame(i, static_cast<uint8_t>(i))));
+        }
+        if (close) {
+            ASSERT_TRUE(recorder.Close());
+        }
+    }
+
+    static bool HasFill(const ImageData& image, uint8_t fill) {
+        if (!image.data || image.dataLength != kFrameBytes) {
+            return false;
+        }
+        for (size_t i = 0; i < kFrameBytes; ++i) {
+            if (image.data[i] != static_cast<uint8_t>(fill + i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ============================================================================
+// Index tests
+// ============================================================================
+
+TEST_F(RecordingReaderTest, OpenLoadsIndex) {
+    WriteRecording(25);
+
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    EXPECT_EQ(reader.GetFrameCount(), 25u);
+
+    RecordingIndexEntry entry;
+    ASSERT_TRUE(reader.GetEntry(3, entry));
+    EXPECT_EQ(entry.frameNumber, 3u);
+    EXPECT_EQ(entry.length, kFrameBytes);
+    EXPECT_FALSE(reader.GetEntry(25, entry));
+}
+
+TEST_F(RecordingReaderTest, OpenRejectsForeignFile) {
+    std::ofstream(path, std::ios::binary) << std::string(64, 'z');
+    RecordingReader reader;
+    EXPECT_FALSE(reader.Open(path));
+    EXPECT_FALSE(reader.Open((dir / "missing.uxdr").string()));
+}
+
+TEST_F(RecordingReaderTest, OpenWithoutJournalScansContainer) {
+    WriteRecording(12);
+    std::filesystem::remove(path + kJournalSuffix);
+
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    EXPECT_EQ(reader.GetFrameCount(), 12u);
+}
+
+TEST_F(RecordingReaderTest, OpenIgnoresTornTail) {
+    WriteRecording(10);
+    const uint64_t size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 20);
+
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    EXPECT_EQ(reader.GetFrameCount(), 9u);
+}
+
+// ============================================================================
+// Query tests
+// ============================================================================
+
+TEST_F(RecordingReaderTest, FindByTimestamp) {
+    WriteRecording(50);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    EXPECT_EQ(reader.FindByTimestamp(0.0), 0u);
+    EXPECT_EQ(reader.FindByTimestamp(10.0), 0u);
+    EXPECT_EQ(reader.FindByTimestamp(11.05), 11u);
+    EXPECT_EQ(reader.FindByTimestamp(100.0), 50u);
+}
+
+TEST_F(RecordingReaderTest, QueryTimeRangeWithStride) {
+    WriteRecording(50);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    std::vector<size_t> all = reader.QueryTimeRange(11.0 - 1e-9, 12.0 - 1e-9);
+    ASSERT_EQ(all.size(), 10u);
+    EXPECT_EQ(all.front(), 10u);
+    EXPECT_EQ(all.back(), 19u);
+
+    std::vector<size_t> strided = reader.QueryTimeRange(10.0, 15.0, 10);
+    EXPECT_EQ(strided, (std::vector<size_t>{0, 10, 20, 30, 40}));
+
+    EXPECT_TRUE(reader.QueryTimeRange(20.0, 30.0).empty());
+    EXPECT_TRUE(reader.QueryTimeRange(12.0, 11.0).empty());
+}
+
+TEST_F(RecordingReaderTest, QueryTimeRangeHandlesUnorderedTimestamps) {
+    {
+        FrameRecorder recorder;
+        ASSERT_TRUE(recorder.Open(path));
+        for (uint64_t n : {3, 1, 2, 0}) {
+            ASSERT_TRUE(recorder.WriteFrame(MakeFrame(n, 0)));
+        }
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    EXPECT_EQ(reader.QueryTimeRange(0.0, 100.0), (std::vector<size_t>{3, 1, 2, 0}));
+    EXPECT_EQ(reader.FindByTimestamp(10.15), 2u);
+}
+
+TEST_F(RecordingReaderTest, QueryIndexRange) {
+    WriteRecording(20);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    EXPECT_EQ(reader.QueryIndexRange(0, 20, 5), (std::vector<size_t>{0, 5, 10, 15}));
+    EXPECT_EQ(reader.QueryIndexRange(18, 100), (std::vector<size_t>{18, 19}));
+    EXPECT_EQ(reader.QueryIndexRange(2, 5, 0), (std::vector<size_t>{2, 3, 4}));
+    EXPECT_TRUE(reader.QueryIndexRange(30, 40).empty());
+}
+
+// ============================================================================
+// Frame access tests
+// ============================================================================
+
+TEST_F(RecordingReaderTest, ReadFrameReturnsPixels) {
+    WriteRecording(8);
+    RecordingReaderOptions options;
+    options.verifyPayloadChecksums = true;
+    RecordingReader reader(options);
+    ASSERT_TRUE(reader.Open(path));
+
+    for (size_t i = 0; i < 8; ++i) {
+        ImageData image;
+        ASSERT_TRUE(reader.ReadFrame(i, image));
+        EXPECT_EQ(image.frameNumber, i);
+        EXPECT_TRUE(HasFill(image, static_cast<uint8_t>(i)));
+    }
+    ImageData image;
+    EXPECT_FALSE(reader.ReadFrame(8, image));
+}
+
+TEST_F(RecordingReaderTest, ReferenceFramesResolveToKeyFrame) {
+    {
+        FrameRecorder recorder;
+        ASSERT_TRUE(recorder.Open(path));
+        ASSERT_TRUE(recorder.WriteFrame(MakeFrame(0, 42)));
+        ASSERT_TRUE(recorder.WriteReference(MakeFrame(1, 0), 0));
+        ASSERT_TRUE(recorder.WriteReference(MakeFrame(2, 0), 0));
+        ASSERT_TRUE(recorder.Close());
+    }
+
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    ImageData first;
+    ImageData second;
+    ASSERT_TRUE(reader.ReadFrame(1, first));
+    ASSERT_TRUE(reader.ReadFrame(2, second));
+    EXPECT_EQ(first.frameNumber, 1u);
+    EXPECT_EQ(second.frameNumber, 2u);
+    EXPECT_TRUE(HasFill(first, 42));
+    EXPECT_EQ(first.data.get(), second.data.get());  // Payload is shared, not re-read
+}
+
+TEST_F(RecordingReaderTest, PrefetchingIteratorVisitsFramesInOrder) {
+    WriteRecording(40);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    auto iterator = reader.Iterate(reader.QueryIndexRange(0, 40, 3), 4);
+    EXPECT_EQ(iterator->GetRemaining(), 14u);
+
+    size_t expected = 0;
+    ImageData image;
+    while (iterator->Next(image)) {
+        EXPECT_EQ(image.frameNumber, expected);
+        EXPECT_TRUE(HasFill(image, static_cast<uint8_t>(expected)));
+        expected += 3;
+    }
+    EXPECT_EQ(expected, 42u);
+    EXPECT_EQ(iterator->GetRemaining(), 0u);
+}
+
+TEST_F(RecordingReaderTest, PrefetchingIteratorCanBeAbandoned) {
+    WriteRecording(40);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    auto iterator = reader.Iterate(reader.QueryIndexRange(0, 40), 2);
+    ImageData image;
+    ASSERT_TRUE(iterator->Next(image));
+    iterator.reset();  // Must stop the readahead thread cleanly
+}
+
+TEST_F(RecordingReaderTest, CloseIsRefusedWhileIterating) {
+    WriteRecording(10);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    auto iterator = reader.Iterate(reader.QueryIndexRange(0, 10), 2);
+    EXPECT_FALSE(reader.Close());
+    EXPECT_FALSE(reader.Open(path));
+
+    ImageData image;
+    size_t visited = 0;
+    while (iterator->Next(image)) {
+        ++visited;
+    }
+    EXPECT_EQ(visited, 10u);
+
+    iterator.reset();
+    EXPECT_TRUE(reader.Close());
+    EXPECT_FALSE(reader.IsOpen());
+}
+
+TEST_F(RecordingReaderTest, LookupsRunAlongsideReopen) {
+    WriteRecording(50);
+    RecordingReader reader;
+    ASSERT_TRUE(reader.Open(path));
+
+    // Lookups see either no recording or all of it
+    std::atomic<bool> stop{false};
+    std::atomic<bool> torn{false};
+    std::thread lookups([&] {
+        while (!stop.load()) {
+            const size_t count = reader.GetFrameCount();
+            const size_t matches = reader.QueryTimeRange(0.0, 100.0).size();
+            if ((count != 0 && count != 50) || (matches != 0 && matches != 50)) {
+                torn = true;
+            }
+            ImageData image;
+            if (reader.ReadFrame(49, image) && !HasFill(image, 49)) {
+                torn = true;
+            }
+        }
+    });
+
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(reader.Close());
+        EXPECT_TRUE(reader.Open(path));
+    }
+    stop = true;
+    lookups.join();
+    EXPECT_FALSE(torn.load());
+}
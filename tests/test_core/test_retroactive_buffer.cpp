@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "uxdi/FrameRecorder.h"
+#include "uxdi/RetroactiveBuffer.h"
+#include "test_helpers.h"
+#include <filesystem>
+#include <string>
+
+using namespace uxdi;
+
+// ============================================================================
+// Test fixture for RetroactiveBuffer tests
+// ============================================================================
+
+class RetroactiveBufferTest : public test::TempDirTest {
+protected:
+    RetroactiveBufferTest() : TempDirTest("uxdi_retro_") {}
+
+    static constexpr size_t kFrameBytes = 16 * 8 * 2;
+
+    std::string path;
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        path = (dir / "event.uxdr").string();
+    }
+
+    static ImageData MakeFrame(uint64_t frameNumber, size_t bytes = kFrameBytes) {
+        return test::MakeTestFrame(frameNumber, static_cast<double>(frameNumber) * 0.1,
+                                   {16, static_cast<uint32_t>(bytes / 32), 16}, [&](size_t) { return frameNumber; });
+    }
+
+    static void Feed(RetroactiveBuffer& buffer, uint64_t first, uint64_t last) {
+        for (uint64_t i = first; i <= last; ++i) {
+            buffer.onImageReceived(MakeFrame(i));
+        }
+    }
+};
+
+// ============================================================================
+// Ring tests
+// ============================================================================
+
+TEST_F(RetroactiveBufferTest, KeepsOnlyLastFrames) {
+    RetroactiveBufferOptions options;
+    options.maxFrames = 4;
+    RetroactiveBuffer buffer(options);
+
+    Feed(buffer, 1, 10);
+
+    EXPECT_EQ(buffer.GetCapacityFrames(), 4u);
+    EXPECT_EQ(buffer.GetBufferedFrameCount(), 4u);
+    EXPECT_EQ(buffer.GetDroppedFrameCount(), 0u);
+}
+
+TEST_F(RetroactiveBufferTest, CapacityFollowsByteBudget) {
+    RetroactiveBufferOptions options;
+    options.maxBytes = kFrameBytes * 3 + 10;
+    RetroactiveBuffer buffer(options);
+
+    Feed(buffer, 1, 5);
+
+    EXPECT_EQ(buffer.GetCapacityFrames(), 3u);
+    EXPECT_EQ(buffer.GetBufferedBytes(), kFrameBytes * 3);
+}
+
+TEST_F(RetroactiveBufferTest, FrameLargerThanBudgetIsDropped) {
+    RetroactiveBufferOptions options;
+    options.maxBytes = kFrameBytes / 2;
+    RetroactiveBuffer buffer(options);
+
+    buffer.onImageReceived(MakeFrame(1));
+
+    EXPECT_EQ(buffer.GetBufferedFrameCount(), 0u);
+    EXPECT_EQ(buffer.GetDroppedFrameCount(), 1u);
+}
+
+TEST_F(RetroactiveBufferTest, FrameSizeChangeResetsRing) {
+    RetroactiveBuffer buffer;
+    Feed(buffer, 1, 3);
+    buffer.onImageReceived(MakeFrame(4, kFrameBytes * 2));
+
+    EXPECT_EQ(buffer.GetBufferedFrameCount(), 1u);
+}
+
+TEST_F(RetroactiveBufferTest, ClearDiscardsFrames) {
+    RetroactiveBuffer buffer;
+    Feed(buffer, 1, 3);
+    buffer.Clear();
+
+    EXPECT_EQ(buffer.GetBufferedFrameCount(), 0u);
+}
+
+// ============================================================================
+// Trigger tests
+// ============================================================================
+
+TEST_F(RetroactiveBufferTest, TriggerRequiresOpenRecorder) {
+    RetroactiveBuffer buffer;
+    FrameRecorder recorder;
+    EXPECT_FALSE(buffer.Trigger(recorder, 0));
+}
+
+TEST_F(RetroactiveBufferTest, TriggerCommitsRingAndPostFrames) {
+    RetroactiveBufferOptions options;
+    options.maxFrames = 32;
+    RetroactiveBuffer buffer(options);
+    FrameRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    Feed(buffer, 1, 5);
+    ASSERT_TRUE(buffer.Trigger(recorder, 3));
+    EXPECT_TRUE(buffer.IsCapturing());
+
+    Feed(buffer, 6, 12);
+    ASSERT_TRUE(buffer.WaitForCapture(5000));
+
+    EXPECT_FALSE(buffer.IsCapturing());
+    EXPECT_EQ(recorder.GetFrameCount(), 8u);
+    EXPECT_EQ(buffer.GetDroppedFrameCount(), 0u);
+}
+
+TEST_F(RetroactiveBufferTest, SecondTriggerWhileCapturingFails) {
+    RetroactiveBuffer buffer;
+    FrameRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    ASSERT_TRUE(buffer.Trigger(recorder, 5));
+    EXPECT_FALSE(buffer.Trigger(recorder, 5));
+
+    buffer.Cancel();
+    EXPECT_FALSE(buffer.IsCapturing());
+}
+
+TEST_F(RetroactiveBufferTest, RetriggerDoesNotRewriteCommittedFrames) {
+    RetroactiveBufferOptions options;
+    options.maxFrames = 16;
+    RetroactiveBuffer buffer(options);
+    FrameRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    Feed(buffer, 1, 4);
+    ASSERT_TRUE(buffer.Trigger(recorder, 2));
+    Feed(buffer, 5, 6);
+    ASSERT_TRUE(buffer.WaitForCapture(5000));
+    EXPECT_EQ(recorder.GetFrameCount(), 6u);
+
+    Feed(buffer, 7, 9);
+    ASSERT_TRUE(buffer.Trigger(recorder, 0));
+    ASSERT_TRUE(buffer.WaitForCapture(5000));
+    EXPECT_EQ(recorder.GetFrameCount(), 9u);
+}
+
+TEST_F(RetroactiveBufferTest, AgeWindowLimitsPreTriggerFrames) {
+    RetroactiveBufferOptions options;
+    options.maxFrames = 32;
+    options.maxAgeSeconds = 0.45;  // Frames are 0.1 s apart
+    RetroactiveBuffer buffer(options);
+    FrameRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    Feed(buffer, 1, 20);
+    ASSERT_TRUE(buffer.Trigger(recorder, 0));
+    ASSERT_TRUE(buffer.WaitForCapture(5000));
+
+    EXPECT_EQ(recorder.GetFrameCount(), 5u);
+}
@@ -0,0 +1,581 @@
+#include <gtest/gtest.h>
+#include "ScenarioEngine.h"
+#include "uxdi/FrameSequenceTracker.h"
+#include "uxdi/TimingTrace.h"
+#include "test_helpers.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace uxdi;
+using namespace uxdi::adapters::emul;
+
+namespace {
+
+void LoadAndStart(ScenarioEngine& engine, const std::string& json) {
+    engine.SetFrameConfig(8, 8, 16);
+    ASSERT_TRUE(engine.LoadScenario(json)) << engine.GetParseError();
+    engine.Start();
+}
+
+// Frames delivered until the scenario ends, calling at most maxCalls times
+size_t DrainFrames(ScenarioEngine& engine, size_t maxCalls = 100000) {
+    size_t frames = 0;
+    for (size_t call = 0; call < maxCalls && !engine.IsComplete(); ++call) {
+        if (engine.GetNextFrame()) {
+            ++frames;
+        }
+    }
+    return frames;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Blocks
+// ============================================================================
+
+TEST(ScenarioEngine, RepeatRunsBodyCountTimes) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "repeat", "count": 3, "actions": [{"type": "acquire", "count": 2}]}
+    ]})");
+
+    EXPECT_EQ(DrainFrames(engine), 6u);
+    EXPECT_TRUE(engine.IsComplete());
+    EXPECT_FALSE(engine.GetNextFrame());
+}
+
+TEST(ScenarioEngine, NestedBlocksMultiply) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "repeat", "count": 4, "actions": [
+            {"type": "set_state", "state": "acquiring"},
+            {"type": "repeat", "count": 5, "actions": [{"type": "acquire", "count": 1}]},
+            {"type": "acquire", "count": 1}
+        ]},
+        {"type": "set_state", "state": "ready"}
+    ]})");
+
+    EXPECT_EQ(DrainFrames(engine), 4u * (5u + 1u));
+    EXPECT_EQ(engine.GetCurrentState(), DetectorState::READY);
+}
+
+TEST(ScenarioEngine, SweepStepsParameterEachIteration) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "sweep", "parameter": "exposure_ms", "from": 10, "to": 40, "step": 10,
+         "actions": [{"type": "acquire", "count": 2}]}
+    ]})");
+
+    std::vector<std::string> values;
+    while (!engine.IsComplete()) {
+        if (engine.GetNextFrame()) {
+            values.push_back(engine.GetParameter("exposure_ms"));
+        }
+    }
+    EXPECT_EQ(values, (std::vector<std::string>{"10", "10", "20", "20", "30", "30", "40", "40"}));
+}
+
+TEST(ScenarioEngine, SweepIncludesEndDespiteRounding) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "sweep", "parameter": "kv", "from": 0, "to": 1, "step": 0.1,
+         "actions": [{"type": "acquire", "count": 1}]},
+        {"type": "sweep", "parameter": "kv", "from": 5, "to": 1, "step": -2,
+         "actions": [{"type": "acquire", "count": 1}]},
+        {"type": "sweep", "parameter": "kv", "from": 0, "to": 1, "step": -1,
+         "actions": [{"type": "acquire", "count": 1}]}
+    ]})");
+
+    // 11 values up, 5 3 1 down; the last sweep never reaches its end
+    EXPECT_EQ(DrainFrames(engine), 11u + 3u);
+    EXPECT_EQ(engine.GetParameter("kv"), "1");
+}
+
+TEST(ScenarioEngine, RandomBranchFollowsWeights) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "repeat", "count": 2000, "actions": [
+            {"type": "random", "branches": [
+                {"weight": 3, "actions": [{"type": "set_parameter", "parameter": "arm", "value": "a"}]},
+                {"weight": 0, "actions": [{"type": "set_parameter", "parameter": "arm", "value": "never"}]},
+                {"weight": 1, "actions": [{"type": "set_parameter", "parameter": "arm", "value": "b"}]}
+            ]},
+            {"type": "acquire", "count": 1}
+        ]}
+    ]})");
+
+    size_t a = 0;
+    size_t b = 0;
+    while (!engine.IsComplete()) {
+        if (engine.GetNextFrame()) {
+            const std::string arm = engine.GetParameter("arm");
+            a += arm == "a";
+            b += arm == "b";
+        }
+    }
+    EXPECT_EQ(a + b, 2000u);
+    EXPECT_NEAR(static_cast<double>(a) / 2000.0, 0.75, 0.06);
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+TEST(ScenarioEngine, LongScenarioCompilesToFewInstructions) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "repeat", "count": 1000000, "actions": [
+            {"type": "sweep", "parameter": "gain", "from": 1, "to": 8,
+             "actions": [{"type": "acquire", "count": 1}]}
+        ]}
+    ]})");
+
+    const Scenario& scenario = engine.GetScenario();
+    ASSERT_EQ(scenario.program.size(), 5u);
+    EXPECT_EQ(scenario.program[0].op, OpCode::LoopBegin);
+    EXPECT_EQ(scenario.program[1].op, OpCode::SweepBegin);
+    EXPECT_EQ(scenario.program[2].op, OpCode::Acquire);
+    EXPECT_EQ(scenario.program[3].op, OpCode::SweepEnd);
+    EXPECT_EQ(scenario.program[4].op, OpCode::LoopEnd);
+    EXPECT_EQ(scenario.loop_count, 2u);
+    EXPECT_EQ(scenario.parameter_names[Scenario::kGainSlot], "gain");
+}
+
+TEST(ScenarioEngine, DropsEntriesThatCannotRun) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "set_state", "state": "bogus"},
+        {"type": "inject_error", "error": "bogus", "probability": 1},
+        {"type": "teleport"},
+        {"type": "repeat", "count": 0, "actions": []},
+        {"type": "sweep", "parameter": "kv", "from": 0, "to": 1, "step": 0,
+         "actions": [{"type": "acquire", "count": 1}]},
+        {"type": "random", "branches": [{"weight": 0, "actions": [{"type": "acquire"}]}]},
+        {"type": "acquire", "count": 1}
+    ]})");
+
+    ASSERT_EQ(engine.GetScenario().program.size(), 1u);
+    EXPECT_EQ(DrainFrames(engine), 1u);
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+TEST(ScenarioEngine, EndlessLoopWithoutFramesYields) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "repeat", "count": 0, "actions": [
+            {"type": "set_parameter", "parameter": "spin", "value": 1}
+        ]}
+    ]})");
+
+    EXPECT_FALSE(engine.GetNextFrame());
+    EXPECT_FALSE(engine.IsComplete());
+    EXPECT_EQ(engine.GetParameter("spin"), "1");
+}
+
+TEST(ScenarioEngine, WaitEndsAfterDuration) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "wait", "duration_ms": 5},
+        {"type": "acquire", "count": 1}
+    ]})");
+
+    EXPECT_FALSE(engine.GetNextFrame());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(engine.GetNextFrame());
+    EXPECT_TRUE(engine.IsComplete());
+}
+
+TEST(ScenarioEngine, InjectedErrorInsideLoopIsDelivered) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "repeat", "count": 3, "actions": [
+            {"type": "acquire", "count": 1},
+            {"type": "inject_error", "error": "timeout", "probability": 1}
+        ]}
+    ]})");
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(engine.GetNextError());
+        EXPECT_TRUE(engine.GetNextFrame());
+        EXPECT_FALSE(engine.GetNextFrame());  // Stops at the raised error
+        EXPECT_EQ(engine.GetNextError(), ErrorCode::TIMEOUT);
+    }
+    EXPECT_FALSE(engine.GetNextFrame());
+    EXPECT_TRUE(engine.IsComplete());
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+TEST(ScenarioEngine, StatusPollingRunsAlongsideFrames) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"generator": {"pattern": "phantom"}, "actions": [
+        {"type": "set_state", "state": "acquiring"},
+        {"type": "repeat", "count": 20, "actions": [
+            {"type": "sweep", "parameter": "exposure_ms", "from": 50, "to": 100, "step": 50,
+             "actions": [{"type": "acquire", "count": 1}]}
+        ]},
+        {"type": "set_state", "state": "ready"}
+    ]})");
+    engine.SetFrameConfig(256, 256, 16);
+
+    // Pollers read status and retune the exposure while frames render
+    std::atomic<bool> done{false};
+    std::atomic<size_t> acquiringSeen{0};
+    std::vector<std::thread> pollers;
+    for (int i = 0; i < 2; ++i) {
+        pollers.emplace_back([&, i] {
+            while (!done.load()) {
+                acquiringSeen += engine.GetCurrentState() == DetectorState::ACQUIRING;
+                (void)engine.IsComplete();
+                if (i == 1) {
+                    engine.SetExposure(100.0, 1.0);
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    const size_t frames = DrainFrames(engine);
+    done = true;
+    for (auto& poller : pollers) {
+        poller.join();
+    }
+
+    EXPECT_EQ(frames, 40u);
+    EXPECT_GT(acquiringSeen.load(), 0u);
+    EXPECT_EQ(engine.GetCurrentState(), DetectorState::READY);
+    EXPECT_TRUE(engine.IsComplete());
+}
+
+// ============================================================================
+// Performance faults
+// ============================================================================
+
+TEST(ScenarioEngine, FaultAccountingMatchesSequenceTracker) {
+    constexpr uint64_t kFrames = 3000;
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "acquire", "count": 3000, "faults": {
+            "drop_probability": 0.05, "duplicate_probability": 0.03, "reorder_probability": 0.03}}
+    ]})");
+
+    // Frames are tracked one up behind a made-up frame 0, so faults on the
+    // first frames are counted like any other
+    FrameSequenceTracker tracker;
+    tracker.Record(0, MonotonicNowNs());
+    while (!engine.IsComplete()) {
+        if (auto frame = engine.GetNextFrame()) {
+            tracker.Record(frame->frameNumber + 1, MonotonicNowNs());
+        }
+    }
+
+    const FaultStats faults = engine.GetFaultStats();
+    const FrameSequenceStats stats = tracker.GetStats();
+    EXPECT_GT(faults.dropped, 0u);
+    EXPECT_GT(faults.duplicated, 0u);
+    EXPECT_GT(faults.reordered, 0u);
+    EXPECT_EQ(stats.received - 1, kFrames - faults.dropped + faults.duplicated);
+
+    // Drops after the last delivered frame are invisible
+    EXPECT_EQ(stats.dropped + (kFrames - stats.highestFrameNumber), faults.dropped);
+    EXPECT_EQ(stats.duplicated, faults.duplicated);
+    EXPECT_EQ(stats.outOfOrder, faults.reordered);
+}
+
+TEST(ScenarioEngine, FaultsWithoutEffectCompileAway) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "acquire", "count": 1, "faults": {"latency_ms": 0, "latency_probability": 1}},
+        {"type": "acquire", "count": 1, "faults": {"stall_ms": 5, "drop_probability": -1,
+                                                   "bandwidth_mbps": 50}}
+    ]})");
+
+    const Scenario& scenario = engine.GetScenario();
+    ASSERT_EQ(scenario.faults.size(), 2u);
+    EXPECT_EQ(scenario.program[0].slot, 0u);
+    EXPECT_EQ(scenario.program[1].slot, 1u);
+    EXPECT_EQ(scenario.faults[1].stall_probability, 0.0);  // Named without a probability
+    EXPECT_EQ(scenario.faults[1].drop_probability, 0.0);
+}
+
+TEST(ScenarioEngine, BandwidthLimitQueuesFrames) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "acquire", "count": 6, "interval_ms": 1, "faults": {"bandwidth_mbps": 100}}
+    ]})");
+    engine.SetFrameConfig(256, 256, 16);  // 1 Mbit: 10.5 ms a frame at 100 Mbit/s
+
+    // Frames due every millisecond queue behind the one on the link
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(DrainFrames(engine), 6u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(60));
+    EXPECT_EQ(engine.GetFaultStats().throttled, 5u);
+}
+
+TEST(ScenarioEngine, LatencyBackdatesTimestampAndStallDelaysNextFrame) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [
+        {"type": "acquire", "count": 1, "faults": {"latency_ms": 30, "latency_probability": 1}},
+        {"type": "acquire", "count": 2, "faults": {"stall_ms": 30, "stall_probability": 1}}
+    ]})");
+
+    const auto secondsNow = [] {
+        return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    };
+
+    // Arrives late, stamped with its slot
+    auto start = std::chrono::steady_clock::now();
+    auto delayed = engine.GetNextFrame();
+    ASSERT_TRUE(delayed);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+    EXPECT_LE(delayed->timestamp, secondsNow() - 0.025);
+
+    // Arrives on time, then holds up the next one
+    start = std::chrono::steady_clock::now();
+    auto stalled = engine.GetNextFrame();
+    ASSERT_TRUE(stalled);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(25));
+    EXPECT_NEAR(stalled->timestamp, secondsNow(), 0.005);
+    ASSERT_TRUE(engine.GetNextFrame());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+
+    const FaultStats faults = engine.GetFaultStats();
+    EXPECT_EQ(faults.delayed, 1u);
+    EXPECT_EQ(faults.stalls, 2u);
+}
+
+// ============================================================================
+// Deterministic mode
+// ============================================================================
+
+namespace {
+
+struct RecordedFrame {
+    uint64_t frameNumber;
+    double timestamp;
+    std::vector<uint8_t> pixels;
+
+    bool operator==(const RecordedFrame&) const = default;
+};
+
+std::vector<RecordedFrame> RunToCompletion(const std::string& json) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, json);
+    std::vector<RecordedFrame> frames;
+    for (size_t call = 0; call < 100000 && !engine.IsComplete(); ++call) {
+        if (auto frame = engine.GetNextFrame()) {
+            frames.push_back({frame->frameNumber, frame->timestamp,
+                              std::vector<uint8_t>(frame->data.get(), frame->data.get() + frame->dataLength)});
+        }
+    }
+    return frames;
+}
+
+} // anonymous namespace
+
+TEST(ScenarioEngine, SeededRunsRepeatExactly) {
+    const auto scenario = [](int seed) {
+        return R"({"seed": )" + std::to_string(seed) + R"(, "clock": "virtual",
+            "generator": {"pattern": "phantom", "noise": "gaussian"},
+            "actions": [{"type": "repeat", "count": 40, "actions": [
+                {"type": "random", "branches": [
+                    {"weight": 1, "actions": [{"type": "acquire", "count": 1, "interval_ms": 10}]},
+                    {"weight": 1, "actions": [{"type": "acquire", "count": 3, "interval_ms": 5, "faults": {
+                        "drop_probability": 0.2, "duplicate_probability": 0.2, "reorder_probability": 0.2,
+                        "latency_ms": 2, "latency_probability": 0.2}}]}]}]}]})";
+    };
+
+    const std::vector<RecordedFrame> first = RunToCompletion(scenario(7));
+    ASSERT_GE(first.size(), 40u);
+    EXPECT_EQ(RunToCompletion(scenario(7)), first);
+    EXPECT_NE(RunToCompletion(scenario(8)), first);
+}
+
+TEST(ScenarioEngine, VirtualClockRunsFasterThanRealTime) {
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"clock": "virtual", "actions": [
+        {"type": "acquire", "count": 300, "interval_ms": 33.333},
+        {"type": "wait", "duration_ms": 60000},
+        {"type": "acquire", "count": 1}
+    ]})");
+
+    // Ten seconds of frames and a minute's wait
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<double> timestamps;
+    while (!engine.IsComplete()) {
+        if (auto frame = engine.GetNextFrame()) {
+            timestamps.push_back(frame->timestamp);
+        }
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+    ASSERT_EQ(timestamps.size(), 301u);
+    for (size_t i = 1; i < 300; ++i) {
+        EXPECT_NEAR(timestamps[i] - timestamps[0], i * 0.033333, 1e-6);
+    }
+    EXPECT_GE(timestamps[300] - timestamps[299], 60.0);
+}
+
+// ============================================================================
+// Trace replay
+// ============================================================================
+
+class ScenarioReplayTest : public test::TempDirTest {
+protected:
+    static constexpr uint64_t kUs = 1'000;
+    static constexpr uint64_t kMs = 1'000'000;
+
+    ScenarioReplayTest() : TempDirTest("uxdi_replay_") {}
+
+    struct RecordedFrame {
+        uint64_t frameNumber;
+        uint64_t offsetNs;
+    };
+
+    struct RecordedState {
+        DetectorState state;
+        uint64_t offsetNs;
+    };
+
+    // A session that started acquiring, streamed frames, changed state in
+    // between and ended in an error
+    std::string WriteTrace(const std::string& name, const std::vector<RecordedFrame>& frames,
+                           std::optional<uint64_t> errorOffsetNs = std::nullopt,
+                           const std::vector<RecordedState>& states = {}) {
+        const std::string path = (dir / name).string();
+        TimingTraceRecorder recorder;
+        EXPECT_TRUE(recorder.Open(path));
+
+        const uint64_t startNs = 1'000'000 * kMs;
+        recorder.WriteEvent(TimingEventType::AcquisitionStarted, startNs);
+        recorder.WriteEvent(TimingEventType::StateChanged, startNs, static_cast<uint64_t>(DetectorState::ACQUIRING));
+        auto state = states.begin();
+        for (const RecordedFrame& frame : frames) {
+            for (; state != states.end() && state->offsetNs <= frame.offsetNs; ++state) {
+                recorder.WriteEvent(TimingEventType::StateChanged, startNs + state->offsetNs,
+                                    static_cast<uint64_t>(state->state));
+            }
+            recorder.WriteEvent(TimingEventType::Frame, startNs + frame.offsetNs, frame.frameNumber);
+        }
+        if (errorOffsetNs) {
+            recorder.WriteEvent(TimingEventType::Error, startNs + *errorOffsetNs,
+                                static_cast<uint64_t>(ErrorCode::TIMEOUT));
+        }
+        EXPECT_TRUE(recorder.Close());
+        return path;
+    }
+};
+
+TEST_F(ScenarioReplayTest, ReproducesRecordedTimingPathology) {
+    // A steady stream, a 40 ms hiccup, a burst, a lost frame and a late one
+    const std::vector<RecordedFrame> recorded = {
+        {10, 2 * kMs}, {11, 7 * kMs}, {12, 12 * kMs},
+        {14, 52 * kMs}, {13, 52 * kMs + 200 * kUs}, {15, 52 * kMs + 400 * kUs}, {16, 57 * kMs}};
+    const std::string trace = WriteTrace("pathology.uxdt", recorded, 70 * kMs);
+
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [{"type": "replay", "trace": ")" + trace + R"("}]})");
+
+    const uint64_t beginNs = MonotonicNowNs();
+    std::vector<uint64_t> frameNumbers;
+    std::vector<uint64_t> arrivalNs;
+    while (frameNumbers.size() < recorded.size() && MonotonicNowNs() - beginNs < 1000 * kMs) {
+        if (auto frame = engine.GetNextFrame()) {
+            arrivalNs.push_back(MonotonicNowNs() - beginNs);
+            frameNumbers.push_back(frame->frameNumber);
+        }
+    }
+    ASSERT_EQ(frameNumbers.size(), recorded.size());
+    EXPECT_EQ(engine.GetCurrentState(), DetectorState::ACQUIRING);
+
+    for (size_t i = 0; i < recorded.size(); ++i) {
+        EXPECT_EQ(frameNumbers[i], recorded[i].frameNumber);
+        EXPECT_GE(arrivalNs[i], recorded[i].offsetNs) << "frame " << i;
+        EXPECT_LE(arrivalNs[i], recorded[i].offsetNs + 3 * kMs) << "frame " << i;
+    }
+
+    // The session's error follows at its own time
+    std::optional<ErrorCode> error;
+    while (!error && MonotonicNowNs() - beginNs < 1000 * kMs) {
+        EXPECT_FALSE(engine.GetNextFrame());
+        error = engine.GetNextError();
+        if (!error) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ASSERT_EQ(error, ErrorCode::TIMEOUT);
+    EXPECT_GE(MonotonicNowNs() - beginNs, 70 * kMs);
+}
+
+TEST_F(ScenarioReplayTest, MidTraceStateChangeKeepsFrameSpacing) {
+    const std::vector<RecordedFrame> recorded = {
+        {0, 5 * kMs}, {1, 10 * kMs}, {2, 15 * kMs}, {3, 18 * kMs}, {4, 23 * kMs}, {5, 28 * kMs}};
+    const std::string trace = WriteTrace("state.uxdt", recorded, std::nullopt, {{DetectorState::READY, 16 * kMs}});
+
+    ScenarioEngine engine;
+    LoadAndStart(engine, R"({"actions": [{"type": "replay", "trace": ")" + trace + R"("}]})");
+
+    // Poll like the emulator's acquisition thread. Stepping the state change
+    // between frames 2 and 3 on the poll would deliver frame 3 about 8 ms
+    // late; on its deadline, no call comes back empty and every frame keeps
+    // its recorded time
+    const uint64_t beginNs = MonotonicNowNs();
+    std::vector<uint64_t> arrivalNs;
+    size_t emptyCalls = 0;
+    while (arrivalNs.size() < recorded.size() && MonotonicNowNs() - beginNs < 1000 * kMs) {
+        if (auto frame = engine.GetNextFrame()) {
+            arrivalNs.push_back(MonotonicNowNs() - beginNs);
+            EXPECT_EQ(engine.GetCurrentState(),
+                      frame->frameNumber < 3 ? DetectorState::ACQUIRING : DetectorState::READY);
+        } else {
+            ++emptyCalls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    ASSERT_EQ(arrivalNs.size(), recorded.size());
+    EXPECT_EQ(emptyCalls, 0u);
+
+    for (size_t i = 0; i < recorded.size(); ++i) {
+        EXPECT_GE(arrivalNs[i], recorded[i].offsetNs) << "frame " << i;
+    }
+}
+
+TEST_F(ScenarioReplayTest, RelativeTracePathsFollowTheScenarioFile) {
+    WriteTrace("short.uxdt", {{0, 0}, {1, kMs}, {2, 2 * kMs}});
+    const std::filesystem::path scenarioPath = dir / "scenario.json";
+    std::ofstream(scenarioPath) << R"({"actions": [
+        {"type": "replay", "trace": "short.uxdt"},
+        {"type": "repeat", "count": 2, "actions": [{"type": "replay", "trace": "short.uxdt"}]}
+    ]})";
+
+    ScenarioEngine engine;
+    engine.SetFrameConfig(8, 8, 16);
+    ASSERT_TRUE(engine.LoadScenarioFromFile(scenarioPath.string())) << engine.GetParseError();
+    EXPECT_EQ(engine.GetScenario().traces.size(), 1u);  // Read once, replayed three times
+
+    engine.Start();
+    EXPECT_EQ(DrainFrames(engine), 9u);
+    EXPECT_TRUE(engine.IsComplete());
+}
+
+TEST_F(ScenarioReplayTest, MissingTraceFailsTheScenario) {
+    ScenarioEngine engine;
+    EXPECT_FALSE(engine.LoadScenario(R"({"actions": [
+        {"type": "acquire", "count": 1},
+        {"type": "replay", "trace": "no/such/trace.uxdt"}
+    ]})"));
+    EXPECT_NE(engine.GetParseError().find("replay: cannot open"), std::string::npos) << engine.GetParseError();
+    EXPECT_TRUE(engine.GetScenario().program.empty());
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include "uxdi/SpillableFrameStore.h"
+#include "test_helpers.h"
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace uxdi;
+
+// ============================================================================
+// Mock synchronous detector for testing
+// ============================================================================
+
+class MockSynchronousDetector : public IDetectorSynchronous {
+public:
+    uint32_t framesAvailable = 0;
+    uint32_t framesDelivered = 0;
+
+    bool acquireFrame(ImageData& outImage, uint32_t) override {
+        if (framesDelivered >= framesAvailable) {
+            return false;
+        }
+        ++framesDelivered;
+        outImage.width = 8;
+        outImage.height = 8;
+        outImage.bitDepth = 16;
+        outImage.frameNumber = framesDelivered;
+        outImage.dataLength = 128;
+        outImage.data = std::shared_ptr<uint8_t[]>(new uint8_t[128]);
+        for (size_t i = 0; i < 128; ++i) {
+            outImage.data[i] = static_cast<uint8_t>(framesDelivered);
+        }
+        return true;
+    }
+
+    bool acquireFrames(uint32_t, std::vector<ImageData>&, uint32_t) override {
+        return false;
+    }
+
+    bool cancelAcquisition() override {
+        return true;
+    }
+};
+
+// ============================================================================
+// Test fixture for SpillableFrameStore tests
+// ============================================================================
+
+class SpillableFrameStoreTest : public test::TempDirTest {
+protected:
+    static constexpr size_t kFrameBytes = 1024;
+
+    SpillableFrameStoreTest() : TempDirTest("uxdi_spill_") {}
+
+    SpillOptions MakeOptions(size_t hotFrames) const {
+        SpillOptions options;
+        options.hotBytes = hotFrames * kFrameBytes;
+        options.maxPendingBytes = 8 * kFrameBytes;
+        options.scratchDirectory = dir.string();
+        return options;
+    }
+
+    static ImageData MakeFrame(uint64_t frameNumber) {
+        return test::MakeTestFrame(frameNumber, 0.0, {32, 16, 16}, [&](size_t i) { return i * 7 + frameNumber; });
+    }
+
+    static bool MatchesFrame(const ImageData& image, uint64_t frameNumber) {
+        if (image.frameNumber != frameNumber || image.dataLength != kFrameBytes || !image.data) {
+            return false;
+        }
+        for (size_t i = 0; i < kFrameBytes; ++i) {
+            if (image.data[i] != static_cast<uint8_t>(i * 7 + frameNumber)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ============================================================================
+// Store tests
+// ============================================================================
+
+TEST_F(SpillableFrameStoreTest, SmallBurstStaysInMemory) {
+    SpillableFrameStore store(MakeOptions(16));
+    for (uint64_t i = 0; i < 10; ++i) {
+        EXPECT_TRUE(store.Append(MakeFrame(i)).IsValid());
+    }
+    store.Flush();
+
+    EXPECT_EQ(store.GetFrameCount(), 10u);
+    EXPECT_EQ(store.GetSpilledFrameCount(), 0u);
+    EXPECT_TRUE(store.GetScratchPath().empty());
+}
+
+TEST_F(SpillableFrameStoreTest, OlderFramesSpillToDisk) {
+    SpillableFrameStore store(MakeOptions(4));
+    for (uint64_t i = 0; i < 50; ++i) {
+        store.Append(MakeFrame(i));
+    }
+    store.Flush();
+
+    EXPECT_EQ(store.GetFrameCount(), 50u);
+    EXPECT_EQ(store.GetSpilledFrameCount(), 46u);
+    EXPECT_EQ(store.GetResidentBytes(), 4 * kFrameBytes);
+    EXPECT_FALSE(store.GetHandle(0).IsResident());
+    EXPECT_TRUE(store.GetHandle(49).IsResident());
+    EXPECT_EQ(std::filesystem::file_size(store.GetScratchPath()), 46 * kFrameBytes);
+}
+
+TEST_F(SpillableFrameStoreTest, SpilledFramesPageBackIn) {
+    SpillableFrameStore store(MakeOptions(4));
+    for (uint64_t i = 0; i < 30; ++i) {
+        store.Append(MakeFrame(i));
+    }
+    store.Flush();
+
+    for (uint64_t i = 0; i < 30; ++i) {
+        ImageData image;
+        ASSERT_TRUE(store.Load(i, image)) << "frame " << i;
+        EXPECT_TRUE(MatchesFrame(image, i)) << "frame " << i;
+    }
+}
+
+TEST_F(SpillableFrameStoreTest, PagedInBufferIsSharedWhileHeld) {
+    SpillableFrameStore store(MakeOptions(1));
+    FrameHandle first = store.Append(MakeFrame(0));
+    store.Append(MakeFrame(1));
+    store.Flush();
+    ASSERT_FALSE(first.IsResident());
+
+    ImageData a;
+    ImageData b;
+    ASSERT_TRUE(first.Load(a));
+    ASSERT_TRUE(first.Load(b));
+    EXPECT_EQ(a.data.get(), b.data.get());
+}
+
+TEST_F(SpillableFrameStoreTest, InvalidIndex) {
+    SpillableFrameStore store(MakeOptions(4));
+    ImageData image;
+
+    EXPECT_FALSE(store.GetHandle(0).IsValid());
+    EXPECT_FALSE(store.Load(0, image));
+    EXPECT_FALSE(FrameHandle().Load(image));
+}
+
+TEST_F(SpillableFrameStoreTest, ScratchFileRemovedOnDestruction) {
+    std::string scratchPath;
+    {
+        SpillableFrameStore store(MakeOptions(1));
+        store.Append(MakeFrame(0));
+        store.Append(MakeFrame(1));
+        store.Flush();
+        scratchPath = store.GetScratchPath();
+        ASSERT_TRUE(std::filesystem::exists(scratchPath));
+    }
+    EXPECT_FALSE(std::filesystem::exists(scratchPath));
+}
+
+TEST_F(SpillableFrameStoreTest, UnwritableScratchRejectsFramesBeyondHotWindow) {
+    SpillOptions options = MakeOptions(2);
+    options.scratchDirectory = (dir / "missing" / "nested").string();
+    SpillableFrameStore store(options);
+
+    EXPECT_TRUE(store.Append(MakeFrame(0)).IsValid());
+    EXPECT_TRUE(store.Append(MakeFrame(1)).IsValid());
+    EXPECT_FALSE(store.Append(MakeFrame(2)).IsValid());
+    EXPECT_EQ(store.GetLastError().code, ErrorCode::HARDWARE_ERROR);
+    EXPECT_FALSE(store.Append(MakeFrame(3)).IsValid());
+    EXPECT_EQ(store.GetLastError().code, ErrorCode::OUT_OF_MEMORY);
+
+    EXPECT_EQ(store.GetFrameCount(), 2u);
+    EXPECT_EQ(store.GetSpilledFrameCount(), 0u);
+    EXPECT_EQ(store.GetResidentBytes(), 2 * kFrameBytes);
+
+    ImageData image;
+    ASSERT_TRUE(store.Load(0, image));
+    EXPECT_TRUE(MatchesFrame(image, 0));
+}
+
+TEST_F(SpillableFrameStoreTest, UnownedBuffersAreCopied) {
+    SpillableFrameStore store(MakeOptions(4));
+
+    // Zero-copy SDK memory is reused for the next frame
+    ImageData sdkFrame = MakeFrame(0);
+    std::shared_ptr<uint8_t[]> sdkMemory = sdkFrame.data;
+    sdkFrame.data = BorrowBuffer(sdkMemory.get());
+    FrameHandle handle = store.Append(sdkFrame);
+    std::memset(sdkMemory.get(), 0xFF, kFrameBytes);
+
+    ImageData image;
+    ASSERT_TRUE(handle.Load(image));
+    EXPECT_NE(image.data.get(), sdkMemory.get());
+    EXPECT_TRUE(MatchesFrame(image, 0));
+
+    // Owned buffers are shared as before
+    ImageData owned = MakeFrame(1);
+    ASSERT_TRUE(store.Append(owned).Load(image));
+    EXPECT_EQ(image.data.get(), owned.data.get());
+}
+
+// ============================================================================
+// Acquisition helper tests
+// ============================================================================
+
+TEST_F(SpillableFrameStoreTest, AcquireFramesToStore) {
+    MockSynchronousDetector detector;
+    detector.framesAvailable = 20;
+    SpillableFrameStore store(MakeOptions(1));
+
+    EXPECT_TRUE(AcquireFramesToStore(detector, 20, store));
+    EXPECT_EQ(store.GetFrameCount(), 20u);
+}
+
+TEST_F(SpillableFrameStoreTest, AcquireFramesToStoreStopsOnFailure) {
+    MockSynchronousDetector detector;
+    detector.framesAvailable = 5;
+    SpillableFrameStore store(MakeOptions(4));
+
+    EXPECT_FALSE(AcquireFramesToStore(detector, 10, store));
+    EXPECT_EQ(store.GetFrameCount(), 5u);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "uxdi/TimerWheel.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace uxdi;
+
+namespace {
+
+constexpr uint64_t kMs = 1'000'000;
+constexpr uint64_t kStartNs = 1'000'000 * kMs;  // Arbitrary, well past zero
+
+std::vector<uint64_t> Pop(TimerWheel& wheel, uint64_t nowNs) {
+    std::vector<uint64_t> keys;
+    wheel.PopDue(nowNs, keys);
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+TEST(TimerWheel, PopsEntriesWhenDue) {
+    TimerWheel wheel(kMs, 64);
+    EXPECT_TRUE(Pop(wheel, kStartNs).empty());
+
+    wheel.Schedule(1, kStartNs + 5 * kMs);
+    wheel.Schedule(2, kStartNs + 5 * kMs + kMs / 2);
+    wheel.Schedule(3, kStartNs + 20 * kMs);
+    EXPECT_EQ(wheel.Size(), 3u);
+    EXPECT_EQ(wheel.NextDeadline(), kStartNs + 5 * kMs);
+
+    EXPECT_TRUE(Pop(wheel, kStartNs + 4 * kMs).empty());
+    EXPECT_EQ(Pop(wheel, kStartNs + 5 * kMs), std::vector<uint64_t>{1});
+
+    // Later in the same tick
+    EXPECT_EQ(wheel.NextDeadline(), kStartNs + 5 * kMs + kMs / 2);
+    EXPECT_EQ(Pop(wheel, kStartNs + 5 * kMs + kMs / 2), std::vector<uint64_t>{2});
+
+    EXPECT_EQ(Pop(wheel, kStartNs + 30 * kMs), std::vector<uint64_t>{3});
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_EQ(wheel.NextDeadline(), std::nullopt);
+}
+
+TEST(TimerWheel, PastDeadlinesPopImmediately) {
+    TimerWheel wheel(kMs, 64);
+    Pop(wheel, kStartNs);
+
+    wheel.Schedule(7, kStartNs - 50 * kMs);
+    EXPECT_LE(*wheel.NextDeadline(), kStartNs);
+    EXPECT_EQ(Pop(wheel, kStartNs), std::vector<uint64_t>{7});
+}
+
+TEST(TimerWheel, EntriesBeyondOneRevolutionWaitTheirTurn) {
+    TimerWheel wheel(kMs, 16);
+    Pop(wheel, kStartNs);
+
+    // Same slot, three revolutions apart
+    wheel.Schedule(1, kStartNs + 3 * kMs);
+    wheel.Schedule(2, kStartNs + (3 + 16) * kMs);
+    wheel.Schedule(3, kStartNs + (3 + 48) * kMs);
+
+    EXPECT_EQ(Pop(wheel, kStartNs + 3 * kMs), std::vector<uint64_t>{1});
+    EXPECT_EQ(wheel.NextDeadline(), kStartNs + (3 + 16) * kMs);
+    EXPECT_EQ(Pop(wheel, kStartNs + 10 * kMs), std::vector<uint64_t>{});
+
+    // Nothing within the next revolution: wake at its end
+    EXPECT_EQ(Pop(wheel, kStartNs + (3 + 16) * kMs), std::vector<uint64_t>{2});
+    EXPECT_EQ(wheel.NextDeadline(), kStartNs + (3 + 16 + 16) * kMs);
+
+    // A long stall pops everything overdue at once
+    EXPECT_EQ(Pop(wheel, kStartNs + 500 * kMs), std::vector<uint64_t>{3});
+}
+
+TEST(TimerWheel, ManyEntriesSpreadAcrossTicks) {
+    TimerWheel wheel;
+    Pop(wheel, kStartNs);
+
+    // 32 streams at 30 fps, staggered by a millisecond
+    constexpr uint64_t kPeriodNs = 33'333'333;
+    for (uint64_t key = 0; key < 32; ++key) {
+        wheel.Schedule(key, kStartNs + key * kMs);
+    }
+
+    size_t popped = 0;
+    for (uint64_t nowNs = kStartNs; nowNs <= kStartNs + 1000 * kMs; nowNs += kMs) {
+        std::vector<uint64_t> keys;
+        wheel.PopDue(nowNs, keys);
+        for (uint64_t key : keys) {
+            wheel.Schedule(key, nowNs + kPeriodNs);
+        }
+        popped += keys.size();
+    }
+
+    // Each stream fires about 30 times a second
+    EXPECT_GE(popped, 32u * 29u);
+    EXPECT_LE(popped, 32u * 31u);
+    EXPECT_EQ(wheel.Size(), 32u);
+}
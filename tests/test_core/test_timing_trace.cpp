@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "uxdi/TimingTrace.h"
+#include "test_helpers.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace uxdi;
+
+// ============================================================================
+// Test fixture for TimingTraceRecorder tests
+// ============================================================================
+
+class TimingTraceTest : public test::TempDirTest {
+protected:
+    TimingTraceTest() : TempDirTest("uxdi_timing_") {}
+
+    static constexpr uint64_t kMs = 1'000'000;
+
+    std::string path;
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        path = (dir / "session.uxdt").string();
+    }
+
+    // Only the frame number and delivery time reach a timing trace
+    static ImageData MakeFrame(uint64_t frameNumber, uint64_t deliveredNs) {
+        ImageData image = test::MakeTestFrame(frameNumber, 0.0, {0, 0, 16});
+        image.latency.sdkDeliveryNs = deliveredNs;
+        return image;
+    }
+};
+
+// ============================================================================
+// Recording and reading
+// ============================================================================
+
+TEST_F(TimingTraceTest, RoundTripsTimingStatesAndErrors) {
+    TimingTraceRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    const uint64_t startNs = 1'000'000 * kMs;
+    recorder.WriteEvent(TimingEventType::AcquisitionStarted, startNs);
+    recorder.WriteEvent(TimingEventType::StateChanged, startNs, static_cast<uint64_t>(DetectorState::ACQUIRING));
+    recorder.onImageReceived(MakeFrame(100, startNs + 5 * kMs));
+    recorder.onImageReceived(MakeFrame(101, startNs + 38 * kMs + 333));
+    recorder.onImageReceived(MakeFrame(103, startNs + 72 * kMs));   // 102 lost
+    recorder.onImageReceived(MakeFrame(102, startNs + 72 * kMs));   // ... and late
+    recorder.WriteEvent(TimingEventType::Error, startNs + 90 * kMs, static_cast<uint64_t>(ErrorCode::TIMEOUT));
+    recorder.WriteEvent(TimingEventType::AcquisitionStopped, startNs + 91 * kMs);
+    EXPECT_EQ(recorder.GetEventCount(), 8u);
+    ASSERT_TRUE(recorder.Close());
+
+    std::vector<TimingEvent> events;
+    ASSERT_TRUE(TimingTraceRecorder::Read(path, events));
+    ASSERT_EQ(events.size(), 8u);
+
+    EXPECT_EQ(events[0].type, TimingEventType::AcquisitionStarted);
+    EXPECT_EQ(events[0].offsetNs, 0u);
+    EXPECT_EQ(events[1].type, TimingEventType::StateChanged);
+    EXPECT_EQ(events[1].code, static_cast<uint32_t>(DetectorState::ACQUIRING));
+
+    const std::vector<uint64_t> frameNumbers = {100, 101, 103, 102};
+    const std::vector<uint64_t> frameOffsets = {5 * kMs, 38 * kMs + 333, 72 * kMs, 72 * kMs};
+    for (size_t i = 0; i < frameNumbers.size(); ++i) {
+        EXPECT_EQ(events[2 + i].type, TimingEventType::Frame);
+        EXPECT_EQ(events[2 + i].frameNumber, frameNumbers[i]);
+        EXPECT_EQ(events[2 + i].offsetNs, frameOffsets[i]);
+    }
+
+    EXPECT_EQ(events[6].type, TimingEventType::Error);
+    EXPECT_EQ(events[6].code, static_cast<uint32_t>(ErrorCode::TIMEOUT));
+    EXPECT_EQ(events[7].type, TimingEventType::AcquisitionStopped);
+    EXPECT_EQ(events[7].offsetNs, 91 * kMs);
+}
+
+TEST_F(TimingTraceTest, ListenerCallbacksAreTimedOnArrival) {
+    TimingTraceRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    recorder.onAcquisitionStarted();
+    recorder.onStateChanged(DetectorState::ACQUIRING);
+    ImageData unstamped;
+    unstamped.frameNumber = 7;
+    recorder.onImageReceived(unstamped);
+    ErrorInfo error;
+    error.code = ErrorCode::HARDWARE_ERROR;
+    recorder.onError(error);
+    recorder.onAcquisitionStopped();
+    ASSERT_TRUE(recorder.Close());
+
+    std::vector<TimingEvent> events;
+    ASSERT_TRUE(TimingTraceRecorder::Read(path, events));
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[2].frameNumber, 7u);
+    EXPECT_EQ(events[3].code, static_cast<uint32_t>(ErrorCode::HARDWARE_ERROR));
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_GE(events[i].offsetNs, events[i - 1].offsetNs);
+    }
+}
+
+TEST_F(TimingTraceTest, SteadyStreamCostsAFewBytesPerFrame) {
+    TimingTraceRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+
+    // An hour-long 30 fps stream would take about 600 KB
+    constexpr uint64_t kFrames = 1000;
+    for (uint64_t i = 0; i < kFrames; ++i) {
+        recorder.onImageReceived(MakeFrame(i, 1'000'000 * kMs + i * 33'333'333));
+    }
+    ASSERT_TRUE(recorder.Close());
+
+    EXPECT_LE(std::filesystem::file_size(path), 16 + kFrames * 6);
+}
+
+TEST_F(TimingTraceTest, TornTailIsDropped) {
+    TimingTraceRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+    for (uint64_t i = 0; i < 10; ++i) {
+        recorder.onImageReceived(MakeFrame(i, 1'000'000 * kMs + i * 10 * kMs));
+    }
+    ASSERT_TRUE(recorder.Close());
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    std::vector<TimingEvent> events;
+    ASSERT_TRUE(TimingTraceRecorder::Read(path, events));
+    ASSERT_EQ(events.size(), 9u);
+    EXPECT_EQ(events.back().frameNumber, 8u);
+    EXPECT_EQ(events.back().offsetNs, 80 * kMs);
+}
+
+TEST_F(TimingTraceTest, RejectsOtherFiles) {
+    std::vector<TimingEvent> events;
+    std::string error;
+    EXPECT_FALSE(TimingTraceRecorder::Read(path, events, &error));
+    EXPECT_NE(error.find("cannot open"), std::string::npos);
+
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fputs("{\"not\": \"a trace\"}", file);
+        std::fclose(file);
+    }
+    EXPECT_FALSE(TimingTraceRecorder::Read(path, events, &error));
+    EXPECT_NE(error.find("not a timing trace"), std::string::npos);
+
+    TimingTraceRecorder recorder;
+    EXPECT_FALSE(recorder.WriteEvent(TimingEventType::Frame, 0, 0));
+    EXPECT_EQ(recorder.GetLastError().code, ErrorCode::STATE_ERROR);
+}
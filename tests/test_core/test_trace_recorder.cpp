@@ -0,0 +1,209 @@
+#ifndef UXDI_ENABLE_TRACING
+#define UXDI_ENABLE_TRACING
+#endif
+
+#include <gtest/gtest.h>
+#include "uxdi/TraceRecorder.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace uxdi;
+
+static bool Contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+static std::vector<TraceEvent> EventsOfOnlyThread(const TraceRecorder& recorder) {
+    auto traces = recorder.Collect();
+    EXPECT_EQ(traces.size(), 1u);
+    return traces.empty() ? std::vector<TraceEvent>{} : traces[0].events;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+TEST(TraceRecorder, DisabledRecorderRecordsNothing) {
+    TraceRecorder recorder;
+    recorder.Record(TraceCategory::Host, 'i', "ignored");
+
+    EXPECT_TRUE(recorder.Collect().empty());
+    EXPECT_EQ(recorder.GetThreadCount(), 0u);
+}
+
+TEST(TraceRecorder, RecordsEventsInOrder) {
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+    recorder.Record(TraceCategory::Acquisition, 'B', "read", 7);
+    recorder.Record(TraceCategory::State, 'i', "state", 4);
+    recorder.Record(TraceCategory::Acquisition, 'E', "read");
+
+    auto events = EventsOfOnlyThread(recorder);
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].phase, 'B');
+    EXPECT_STREQ(events[0].name, "read");
+    EXPECT_EQ(events[0].arg, 7u);
+    EXPECT_EQ(events[1].category, TraceCategory::State);
+    EXPECT_EQ(events[2].phase, 'E');
+    EXPECT_LE(events[0].timestampNs, events[1].timestampNs);
+    EXPECT_LE(events[1].timestampNs, events[2].timestampNs);
+}
+
+TEST(TraceRecorder, TruncatesLongNames) {
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+    const std::string longName(100, 'x');
+    recorder.Record(TraceCategory::Host, 'i', longName.c_str());
+
+    auto events = EventsOfOnlyThread(recorder);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(std::strlen(events[0].name), TraceEvent::kMaxNameLength);
+}
+
+TEST(TraceRecorder, RingBufferKeepsNewestEvents) {
+    TraceRecorder recorder(4);
+    recorder.SetEnabled(true);
+    for (uint64_t i = 0; i < 10; ++i) {
+        recorder.Record(TraceCategory::Host, 'i', "tick", i);
+    }
+
+    auto traces = recorder.Collect();
+    ASSERT_EQ(traces.size(), 1u);
+    ASSERT_EQ(traces[0].events.size(), 4u);
+    EXPECT_EQ(traces[0].events.front().arg, 6u);
+    EXPECT_EQ(traces[0].events.back().arg, 9u);
+    EXPECT_EQ(traces[0].overwritten, 6u);
+}
+
+TEST(TraceRecorder, ClearDiscardsEvents) {
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+    recorder.Record(TraceCategory::Host, 'i', "before");
+    recorder.Clear();
+    recorder.Record(TraceCategory::Host, 'i', "after");
+
+    auto events = EventsOfOnlyThread(recorder);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_STREQ(events[0].name, "after");
+}
+
+// ============================================================================
+// Threads
+// ============================================================================
+
+TEST(TraceRecorder, EachThreadGetsItsOwnBuffer) {
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&recorder, t] {
+            const std::string name = "worker " + std::to_string(t);
+            recorder.SetThreadName(name.c_str());
+            for (int i = 0; i < 100; ++i) {
+                recorder.Record(TraceCategory::Acquisition, 'i', "frame", static_cast<uint64_t>(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto traces = recorder.Collect();
+    ASSERT_EQ(traces.size(), 3u);
+    for (const auto& trace : traces) {
+        EXPECT_EQ(trace.events.size(), 100u);
+        EXPECT_EQ(trace.threadName.rfind("worker ", 0), 0u);
+        EXPECT_EQ(trace.events.back().arg, 99u);
+    }
+    EXPECT_NE(traces[0].threadId, traces[1].threadId);
+}
+
+TEST(TraceRecorder, ReusesBuffersOfExitedThreadsAtLimit) {
+    TraceRecorder recorder(16, 1);
+    recorder.SetEnabled(true);
+
+    for (int t = 0; t < 5; ++t) {
+        std::thread([&recorder] {
+            recorder.Record(TraceCategory::Host, 'i', "short-lived");
+        }).join();
+    }
+
+    EXPECT_EQ(recorder.GetThreadCount(), 1u);
+    auto traces = recorder.Collect();
+    ASSERT_EQ(traces.size(), 1u);
+    EXPECT_EQ(traces[0].events.size(), 1u);
+}
+
+// ============================================================================
+// Macros and attach
+// ============================================================================
+
+TEST(TraceRecorder, MacrosRecordIntoAttachedRecorder) {
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+    TraceRecorder::Attach(&recorder);
+    EXPECT_EQ(&TraceRecorder::Current(), &recorder);
+
+    {
+        UXDI_TRACE_SCOPE_ARG(Dispatch, "scope", 3);
+        UXDI_TRACE_INSTANT(State, "instant", 2);
+    }
+    UXDI_TRACE_BEGIN(Acquisition, "manual");
+    UXDI_TRACE_END(Acquisition, "manual");
+
+    TraceRecorder::Attach(nullptr);
+    EXPECT_EQ(&TraceRecorder::Current(), &TraceRecorder::Global());
+
+    auto events = EventsOfOnlyThread(recorder);
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[0].phase, 'B');
+    EXPECT_EQ(events[0].arg, 3u);
+    EXPECT_STREQ(events[1].name, "instant");
+    EXPECT_EQ(events[2].phase, 'E');
+    EXPECT_STREQ(events[3].name, "manual");
+}
+
+// ============================================================================
+// Chrome trace export
+// ============================================================================
+
+TEST(TraceRecorder, FormatChromeTrace) {
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+    recorder.SetThreadName("acq \"main\"");
+    recorder.Record(TraceCategory::Acquisition, 'B', "read", 5);
+    recorder.Record(TraceCategory::State, 'i', "state", 4);
+    recorder.Record(TraceCategory::Acquisition, 'E', "read");
+
+    const std::string json = recorder.FormatChromeTrace();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_TRUE(Contains(json, "\"ph\":\"M\""));
+    EXPECT_TRUE(Contains(json, "\"args\":{\"name\":\"acq \\\"main\\\"\"}"));
+    EXPECT_TRUE(Contains(json, "\"name\":\"read\",\"cat\":\"acquisition\",\"ph\":\"B\""));
+    EXPECT_TRUE(Contains(json, "\"args\":{\"value\":5}"));
+    EXPECT_TRUE(Contains(json, "\"ph\":\"i\""));
+    EXPECT_TRUE(Contains(json, "\"s\":\"t\""));
+    EXPECT_TRUE(Contains(json, "\"ph\":\"E\""));
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+TEST(TraceRecorder, WriteChromeTrace) {
+    const auto path = std::filesystem::temp_directory_path() / "uxdi_trace_test.json";
+    TraceRecorder recorder;
+    recorder.SetEnabled(true);
+    recorder.Record(TraceCategory::Host, 'i', "written");
+
+    ASSERT_TRUE(recorder.WriteChromeTrace(path.string()));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), recorder.FormatChromeTrace());
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(recorder.WriteChromeTrace("/nonexistent_dir/uxdi/trace.json"));
+}